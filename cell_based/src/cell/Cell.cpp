@@ -256,6 +256,13 @@ boost::shared_ptr<AbstractCellMutationState> Cell::GetMutationState() const
 
 boost::shared_ptr<CellData> Cell::GetCellData() const
 {
+    // Fast path: the collection caches its CellData property
+    const boost::shared_ptr<CellData>& p_cell_data = mCellPropertyCollection.GetCellData();
+    if (p_cell_data)
+    {
+        return p_cell_data;
+    }
+
     CellPropertyCollection cell_data_collection = mCellPropertyCollection.GetPropertiesType<CellData>();
 
     /*
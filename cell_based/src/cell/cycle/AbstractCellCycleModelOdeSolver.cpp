@@ -35,6 +35,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCellCycleModelOdeSolver.hpp"
 #include "CvodeAdaptor.hpp"
+#include "Exception.hpp"
+#include "ThreadTools.hpp"
 
 AbstractCellCycleModelOdeSolver::AbstractCellCycleModelOdeSolver()
     : mSizeOfOdeSystem(UNSIGNED_UNSET)
@@ -51,19 +53,19 @@ void AbstractCellCycleModelOdeSolver::SolveAndUpdateStateVariable(AbstractOdeSys
                                                                   double timeStep)
 {
     assert(IsSetUp());
-    mpOdeSolver->SolveAndUpdateStateVariable(pAbstractOdeSystem, startTime, endTime, timeStep);
+    GetOdeSolverForThisThread()->SolveAndUpdateStateVariable(pAbstractOdeSystem, startTime, endTime, timeStep);
 }
 
 bool AbstractCellCycleModelOdeSolver::StoppingEventOccurred()
 {
     assert(IsSetUp());
-    return mpOdeSolver->StoppingEventOccurred();
+    return GetOdeSolverForThisThread()->StoppingEventOccurred();
 }
 
 double AbstractCellCycleModelOdeSolver::GetStoppingTime()
 {
     assert(IsSetUp());
-    return mpOdeSolver->GetStoppingTime();
+    return GetOdeSolverForThisThread()->GetStoppingTime();
 }
 
 void AbstractCellCycleModelOdeSolver::SetSizeOfOdeSystem(unsigned sizeOfOdeSystem)
@@ -121,3 +123,51 @@ bool AbstractCellCycleModelOdeSolver::IsAdaptive()
 #endif //CHASTE_CVODE
     return adaptive;
 }
+
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::GetIvpOdeSolver()
+{
+    return mpOdeSolver;
+}
+
+AbstractIvpOdeSolver* AbstractCellCycleModelOdeSolver::GetOdeSolverForThisThread()
+{
+    unsigned thread = ThreadTools::GetThreadNum();
+    if (thread == 0)
+    {
+        return mpOdeSolver.get();
+    }
+    assert(thread <= mThreadOdeSolvers.size());
+    return mThreadOdeSolvers[thread - 1].get();
+}
+
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::CreateOdeSolver()
+{
+    EXCEPTION("This ODE solver wrapper does not support use from multiple threads.");
+}
+
+void AbstractCellCycleModelOdeSolver::SetUpThreadOdeSolvers(unsigned numThreads)
+{
+    assert(IsSetUp());
+    assert(numThreads > 0);
+    while (mThreadOdeSolvers.size() + 1 < numThreads)
+    {
+        mThreadOdeSolvers.push_back(CreateOdeSolver());
+    }
+
+#ifdef CHASTE_CVODE
+    boost::shared_ptr<CvodeAdaptor> p_master = boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver);
+    if (p_master)
+    {
+        for (unsigned i = 0; i < mThreadOdeSolvers.size(); i++)
+        {
+            boost::shared_ptr<CvodeAdaptor> p_copy = boost::static_pointer_cast<CvodeAdaptor>(mThreadOdeSolvers[i]);
+            p_copy->SetTolerances(p_master->GetRelativeTolerance(), p_master->GetAbsoluteTolerance());
+            p_copy->SetMaxSteps(p_master->GetMaxSteps());
+            if (p_master->GetCheckForStoppingEvents())
+            {
+                p_copy->CheckForStoppingEvents();
+            }
+        }
+    }
+#endif //CHASTE_CVODE
+}
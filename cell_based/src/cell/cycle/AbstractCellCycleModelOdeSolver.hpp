@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 #include "AbstractIvpOdeSolver.hpp"
 
@@ -80,6 +81,28 @@ protected:
     /** The size of the ODE system to be solved. */
     unsigned mSizeOfOdeSystem;
 
+    /**
+     * Private copies of the ODE solver for use by threads other than the
+     * master thread, which always uses mpOdeSolver.  Entry i is used by
+     * thread i+1.  Set up by SetUpThreadOdeSolvers() and not archived.
+     */
+    std::vector<boost::shared_ptr<AbstractIvpOdeSolver> > mThreadOdeSolvers;
+
+    /**
+     * @return the ODE solver that the calling thread should use, so that
+     * threads never share a solver's internal working memory.
+     */
+    AbstractIvpOdeSolver* GetOdeSolverForThisThread();
+
+    /**
+     * @return a new ODE solver of the same type as mpOdeSolver, for use by
+     * another thread.
+     *
+     * The base class version throws, as it does not know the solver type;
+     * it is overridden in CellCycleModelOdeSolver.
+     */
+    virtual boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver();
+
 public:
 
     /**
@@ -186,6 +209,22 @@ public:
      * The base class version just returns true iff the solver is the CvodeAdaptor class.
      */
     virtual bool IsAdaptive();
+
+    /**
+     * @return the underlying ODE solver, e.g. so that callers can check its type.
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> GetIvpOdeSolver();
+
+    /**
+     * Make sure there is a separate ODE solver for each of the given number
+     * of threads, so that cells sharing this wrapper can be updated
+     * concurrently.  Any CVODE settings (tolerances, maximum number of steps
+     * and stopping-event checking) on mpOdeSolver are copied to the other
+     * solvers, so this should be called again if they change.
+     *
+     * @param numThreads the number of threads that may call the solve methods concurrently
+     */
+    void SetUpThreadOdeSolvers(unsigned numThreads);
 };
 
 #endif /*ABSTRACTCELLCYCLEMODELODESOLVER_HPP_*/
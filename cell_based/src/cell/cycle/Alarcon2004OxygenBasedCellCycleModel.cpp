@@ -67,7 +67,9 @@ Alarcon2004OxygenBasedCellCycleModel::Alarcon2004OxygenBasedCellCycleModel(const
 
     assert(rModel.GetOdeSystem());
     bool is_labelled = rModel.mpCell->HasCellProperty<CellLabel>();
-    SetOdeSystem(new Alarcon2004OxygenBasedCellCycleOdeSystem(rModel.mpCell->GetCellData()->GetItem("oxygen"), is_labelled));
+    // Cell data item indices are fixed once registered, so look this one up only once
+    static const unsigned oxygen_index = CellData::GetItemIndex("oxygen");
+    SetOdeSystem(new Alarcon2004OxygenBasedCellCycleOdeSystem(rModel.mpCell->GetCellData()->GetItem(oxygen_index), is_labelled));
     SetStateVariables(rModel.GetOdeSystem()->rGetStateVariables());
 }
 
@@ -96,7 +98,8 @@ void Alarcon2004OxygenBasedCellCycleModel::Initialise()
     assert(mpCell != nullptr);
 
     bool is_labelled = mpCell->HasCellProperty<CellLabel>();
-    mpOdeSystem = new Alarcon2004OxygenBasedCellCycleOdeSystem(mpCell->GetCellData()->GetItem("oxygen"), is_labelled);
+    static const unsigned oxygen_index = CellData::GetItemIndex("oxygen");
+    mpOdeSystem = new Alarcon2004OxygenBasedCellCycleOdeSystem(mpCell->GetCellData()->GetItem(oxygen_index), is_labelled);
     mpOdeSystem->SetStateVariables(mpOdeSystem->GetInitialConditions());
 
     AbstractOdeBasedPhaseBasedCellCycleModel::Initialise();
@@ -105,7 +108,8 @@ void Alarcon2004OxygenBasedCellCycleModel::Initialise()
 void Alarcon2004OxygenBasedCellCycleModel::AdjustOdeParameters(double currentTime)
 {
     // Pass this time step's oxygen concentration into the solver as a constant over this time step
-    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem("oxygen");
+    static const unsigned oxygen_index = CellData::GetItemIndex("oxygen");
+    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem(oxygen_index);
 
     // Use whether the cell is currently labelled as another input
     bool is_labelled = mpCell->HasCellProperty<CellLabel>();
@@ -129,6 +129,11 @@ void CellCycleModelOdeHandler::SetLastTime(double lastTime)
     mLastTime = lastTime;
 }
 
+double CellCycleModelOdeHandler::GetLastTime() const
+{
+    return mLastTime;
+}
+
 void CellCycleModelOdeHandler::SetStateVariables(const std::vector<double>& rStateVariables)
 {
     assert(mpOdeSystem);
@@ -167,6 +167,11 @@ public:
      */
     void SetLastTime(double lastTime);
 
+    /**
+     * @return mLastTime
+     */
+    double GetLastTime() const;
+
     /**
      * @return #mDt.  This sets it to a default value if it hasn't
      * been set by calling SetDt.
@@ -79,6 +79,13 @@ private:
         archive & mpInstance;
     }
 
+    /**
+     * Overridden CreateOdeSolver() method.
+     *
+     * @return a new ODE solver, set up in the same way as by Initialise()
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > Instance();
@@ -139,16 +146,23 @@ bool CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::IsSetUp()
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
 void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::Initialise()
 {
-    mpOdeSolver.reset(new ODE_SOLVER);
+    mpOdeSolver = CreateOdeSolver();
+}
+
+template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::CreateOdeSolver()
+{
+    boost::shared_ptr<AbstractIvpOdeSolver> p_solver(new ODE_SOLVER);
     // If this is a CVODE solver we need to tell it to reset. Otherwise
     // the fact this is a singleton will lead to all sorts of problems
     // as CVODE will have the internal state for the wrong ODE system!
 #ifdef CHASTE_CVODE
-    if (boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver))
+    if (boost::dynamic_pointer_cast<CvodeAdaptor>(p_solver))
     {
-        (boost::static_pointer_cast<CvodeAdaptor>(mpOdeSolver))->SetForceReset(true);
+        (boost::static_pointer_cast<CvodeAdaptor>(p_solver))->SetForceReset(true);
     }
 #endif //CHASTE_CVODE
+    return p_solver;
 }
 
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
@@ -192,6 +206,13 @@ private:
         archive & mpInstance;
     }
 
+    /**
+     * Overridden CreateOdeSolver() method.
+     *
+     * @return a new ODE solver for a system of size mSizeOfOdeSystem
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > Instance();
@@ -238,7 +259,14 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Initi
     {
         EXCEPTION("SetSizeOfOdeSystem() must be called before calling Initialise()");
     }
-    mpOdeSolver.reset(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
+    mpOdeSolver = CreateOdeSolver();
+}
+
+template<class CELL_CYCLE_MODEL>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::CreateOdeSolver()
+{
+    assert(mSizeOfOdeSystem != UNSIGNED_UNSET);
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
 }
 
 template<class CELL_CYCLE_MODEL>
@@ -246,6 +274,7 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Reset
 {
     mSizeOfOdeSystem = UNSIGNED_UNSET;
     mpOdeSolver.reset();
+    mThreadOdeSolvers.clear();
 }
 
 #endif /*CELLCYCLEMODELODESOLVER_HPP_*/
@@ -77,7 +77,9 @@ void ContactInhibitionCellCycleModel::UpdateCellCyclePhase()
     }
 
     // Get cell volume
-    double cell_volume = mpCell->GetCellData()->GetItem("volume");
+    // Cell data item indices are fixed once registered, so look this one up only once
+    static const unsigned volume_index = CellData::GetItemIndex("volume");
+    double cell_volume = mpCell->GetCellData()->GetItem(volume_index);
 
     // Removes the cell label
     mpCell->RemoveCellProperty<CellLabel>();
@@ -67,7 +67,9 @@ void SimpleOxygenBasedCellCycleModel::UpdateCellCyclePhase()
         UpdateHypoxicDuration();
 
         // Get cell's oxygen concentration
-        double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+        // Cell data item indices are fixed once registered, so look this one up only once
+        static const unsigned oxygen_index = CellData::GetItemIndex("oxygen");
+        double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_index);
 
         AbstractSimplePhaseBasedCellCycleModel::UpdateCellCyclePhase();
 
@@ -119,7 +121,8 @@ void SimpleOxygenBasedCellCycleModel::UpdateHypoxicDuration()
     assert(!mpCell->HasApoptosisBegun());
 
     // Get cell's oxygen concentration
-    double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+    static const unsigned oxygen_index = CellData::GetItemIndex("oxygen");
+    double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_index);
 
     if (oxygen_concentration < mHypoxicConcentration)
     {
@@ -59,16 +59,33 @@ bool AbstractCellProperty::IsSame(boost::shared_ptr<const AbstractCellProperty>
 
 void AbstractCellProperty::IncrementCellCount()
 {
+    // Cell properties are shared between cells, whose models may be updated concurrently
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCellPropertyCount)
+#endif // CHASTE_OPENMP
     mCellCount++;
 }
 
 void AbstractCellProperty::DecrementCellCount()
 {
-    if (mCellCount == 0)
+    bool was_zero = false;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCellPropertyCount)
+#endif // CHASTE_OPENMP
+    {
+        if (mCellCount == 0)
+        {
+            was_zero = true;
+        }
+        else
+        {
+            mCellCount--;
+        }
+    }
+    if (was_zero)
     {
         EXCEPTION("Cannot decrement cell count: no cells have this cell property");
     }
-    mCellCount--;
 }
 
 unsigned AbstractCellProperty::GetCellCount() const
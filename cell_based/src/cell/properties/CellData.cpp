@@ -35,45 +35,92 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellData.hpp"
 
+#include <algorithm>
+
+#include "CellDataItemRegistry.hpp"
+
+CellData::CellData()
+    : mNumItems(0)
+{
+}
+
 CellData::~CellData()
 {
 }
 
+unsigned CellData::GetItemIndex(const std::string& rVariableName)
+{
+    return CellDataItemRegistry::Instance()->GetIndex(rVariableName);
+}
+
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(GetItemIndex(rVariableName), data);
+}
+
+void CellData::SetItem(unsigned index, double data)
+{
+    if (index >= mItemValues.size())
+    {
+        mItemValues.resize(index + 1, 0.0);
+        mItemIsSet.resize(index + 1, false);
+    }
+    if (!mItemIsSet[index])
+    {
+        mItemIsSet[index] = true;
+        mNumItems++;
+    }
+    mItemValues[index] = data;
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
     /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
+     * Use FindIndex() rather than GetIndex() so that looking up a name that
+     * has never been stored does not register it.
      */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    unsigned index = CellDataItemRegistry::Instance()->FindIndex(rVariableName);
+    if (index >= mItemIsSet.size() || !mItemIsSet[index])
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return mItemValues[index];
+}
+
+double CellData::GetItem(unsigned index) const
+{
+    if (index >= mItemIsSet.size() || !mItemIsSet[index])
+    {
+        EXCEPTION("The item " << CellDataItemRegistry::Instance()->GetName(index) << " is not stored");
+    }
+    return mItemValues[index];
+}
+
+bool CellData::HasItem(const std::string& rVariableName) const
+{
+    unsigned index = CellDataItemRegistry::Instance()->FindIndex(rVariableName);
+    return (index < mItemIsSet.size() && mItemIsSet[index]);
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    CellDataItemRegistry* p_registry = CellDataItemRegistry::Instance();
+    for (unsigned index=0; index<mItemIsSet.size(); index++)
     {
-        keys.push_back(it->first);
+        if (mItemIsSet[index])
+        {
+            keys.push_back(p_registry->GetName(index));
+        }
     }
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
+    // Items are stored in order of registration, so sort the keys to give a predictable ordering
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
 
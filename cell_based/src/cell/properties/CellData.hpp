@@ -45,6 +45,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include "Exception.hpp"
 
 /**
@@ -62,33 +63,85 @@ class CellData : public AbstractCellProperty
 private:
 
     /**
-     * The cell data.
+     * The cell data values, indexed by the item indices assigned by CellDataItemRegistry.
      */
-    std::map<std::string, double> mCellData;
+    std::vector<double> mItemValues;
+
+    /**
+     * Whether each entry of mItemValues has been set.
+     */
+    std::vector<bool> mItemIsSet;
+
+    /**
+     * The number of items set.
+     */
+    unsigned mNumItems;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Archive the member variables.
+     * Save the member variables.
+     *
+     * The items are archived by name as a std::map, since item indices
+     * are not guaranteed to be the same when the archive is loaded.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void save(Archive & archive, const unsigned int version) const
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+        std::map<std::string, double> cell_data;
+        std::vector<std::string> keys = GetKeys();
+        for (unsigned i=0; i<keys.size(); i++)
+        {
+            cell_data[keys[i]] = GetItem(keys[i]);
+        }
+        archive & cell_data;
+    }
+
+    /**
+     * Load the member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void load(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+        for (std::map<std::string, double>::const_iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
      */
     virtual ~CellData();
 
+    /**
+     * @return the index used to access the item with the given name via
+     * SetItem(unsigned, double) and GetItem(unsigned). Callers that access
+     * the same item for many cells should look up the index once.
+     *
+     * @param rVariableName the name of the data
+     */
+    static unsigned GetItemIndex(const std::string& rVariableName);
+
     /**
      * This assigns the cell data.
      *
@@ -97,6 +150,14 @@ public:
      */
     void SetItem(const std::string& rVariableName, double data);
 
+    /**
+     * This assigns the cell data.
+     *
+     * @param index the index of the data to be set, as returned by GetItemIndex().
+     * @param data the value to set it to.
+     */
+    void SetItem(unsigned index, double data);
+
     /**
      * @return data.
      *
@@ -105,6 +166,21 @@ public:
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * @return data.
+     *
+     * @param index the index of the data required, as returned by GetItemIndex().
+     * throws if the item has not been stored
+     */
+    double GetItem(unsigned index) const;
+
+    /**
+     * @return whether an item with the given name has been stored.
+     *
+     * @param rVariableName the name of the data
+     */
+    bool HasItem(const std::string& rVariableName) const;
+
     /**
      * @return number of data items
      */
@@ -113,7 +189,7 @@ public:
     /**
      * @return all keys.
      *
-     * According to STL these are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
+     * These are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
      */
     std::vector<std::string> GetKeys() const;
 };
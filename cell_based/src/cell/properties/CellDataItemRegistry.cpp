@@ -0,0 +1,92 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cassert>
+
+#include "CellDataItemRegistry.hpp"
+#include "Exception.hpp"
+#include "ThreadTools.hpp"
+
+CellDataItemRegistry* CellDataItemRegistry::Instance()
+{
+    // Initialisation of a function-local static is thread-safe
+    static CellDataItemRegistry registry;
+    return &registry;
+}
+
+CellDataItemRegistry::CellDataItemRegistry()
+{
+}
+
+unsigned CellDataItemRegistry::GetIndex(const std::string& rVariableName)
+{
+    std::unordered_map<std::string, unsigned>::const_iterator it = mIndices.find(rVariableName);
+    if (it != mIndices.end())
+    {
+        return it->second;
+    }
+
+    // Other threads read the registry without locking, so it may only change outside parallel regions
+    if (ThreadTools::IsInParallelRegion())
+    {
+        EXCEPTION("The cell data item " << rVariableName << " must be set before cell models are updated in parallel.");
+    }
+
+    unsigned index = mNames.size();
+    mIndices[rVariableName] = index;
+    mNames.push_back(rVariableName);
+    return index;
+}
+
+unsigned CellDataItemRegistry::FindIndex(const std::string& rVariableName) const
+{
+    std::unordered_map<std::string, unsigned>::const_iterator it = mIndices.find(rVariableName);
+    if (it == mIndices.end())
+    {
+        return UNSIGNED_UNSET;
+    }
+    return it->second;
+}
+
+std::string CellDataItemRegistry::GetName(unsigned index) const
+{
+    assert(index < mNames.size());
+    return mNames[index];
+}
+
+unsigned CellDataItemRegistry::GetNumItems() const
+{
+    return mNames.size();
+}
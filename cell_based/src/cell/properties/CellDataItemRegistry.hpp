@@ -0,0 +1,123 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLDATAITEMREGISTRY_HPP_
+#define CELLDATAITEMREGISTRY_HPP_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A singleton registry of the names of items stored in CellData.
+ *
+ * Each name is interned into a small integer index the first time it is seen,
+ * so that CellData can hold its values in a contiguous array and callers that
+ * access the same item for many cells can look the name up only once.
+ *
+ * Reads never lock, so that cell models may look up items concurrently (see
+ * AbstractCellBasedSimulation::UpdateCellModelsInParallel()). In return, new
+ * names may only be registered outside parallel regions; in practice they are
+ * registered when the item is first set, by a simulation modifier or when the
+ * cells are created.
+ *
+ * Indices are never reused or removed, since CellData objects hold values by
+ * index; the registry is therefore not cleared between simulations and is not
+ * archived (CellData archives its items by name).
+ */
+class CellDataItemRegistry
+{
+public:
+
+    /**
+     * @return the single instance of the registry.
+     */
+    static CellDataItemRegistry* Instance();
+
+    /**
+     * @return the index of the given item name, registering it if necessary.
+     * Throws if the name is not yet registered and the caller is inside a
+     * parallel region.
+     *
+     * @param rVariableName the name of the item
+     */
+    unsigned GetIndex(const std::string& rVariableName);
+
+    /**
+     * @return the index of the given item name, or UNSIGNED_UNSET if it has
+     * not been registered.
+     *
+     * @param rVariableName the name of the item
+     */
+    unsigned FindIndex(const std::string& rVariableName) const;
+
+    /**
+     * @return the name of the item with the given index.
+     *
+     * @param index the index of the item
+     */
+    std::string GetName(unsigned index) const;
+
+    /**
+     * @return the number of item names registered.
+     */
+    unsigned GetNumItems() const;
+
+private:
+
+    /**
+     * Default constructor.
+     */
+    CellDataItemRegistry();
+
+    /**
+     * Copy constructor.
+     */
+    CellDataItemRegistry(const CellDataItemRegistry&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    CellDataItemRegistry& operator= (const CellDataItemRegistry&);
+
+    /** Map from item name to index. */
+    std::unordered_map<std::string, unsigned> mIndices;
+
+    /** The item names, in order of index. */
+    std::vector<std::string> mNames;
+};
+
+#endif /* CELLDATAITEMREGISTRY_HPP_ */
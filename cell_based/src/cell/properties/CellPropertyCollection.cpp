@@ -35,8 +35,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellPropertyCollection.hpp"
 
+#include <map>
+#include <typeindex>
+
 CellPropertyCollection::CellPropertyCollection()
-    : mpCellPropertyRegistry(nullptr)
+    : mpCellPropertyRegistry(nullptr),
+      mPropertyTypeMask(0)
 {
 }
 
@@ -65,6 +69,17 @@ void CellPropertyCollection::AddProperty(const boost::shared_ptr<AbstractCellPro
         EXCEPTION("That property object is already in the collection.");
     }
     mProperties.insert(rProp);
+
+    // Update the cached properties incrementally, as sub-collections are built by repeated calls to this method
+    unsigned bit = GetPropertyTypeBit(typeid(*rProp));
+    if (bit != UNSIGNED_UNSET)
+    {
+        mPropertyTypeMask |= (boost::uint64_t(1) << bit);
+    }
+    if (!mpCellData && rProp->IsSubType<CellData>())
+    {
+        mpCellData = boost::static_pointer_cast<CellData>(rProp);
+    }
 }
 
 bool CellPropertyCollection::HasProperty(const boost::shared_ptr<AbstractCellProperty>& rProp) const
@@ -82,6 +97,7 @@ void CellPropertyCollection::RemoveProperty(const boost::shared_ptr<AbstractCell
     else
     {
         mProperties.erase(it);
+        UpdateCachedProperties();
     }
 }
 
@@ -111,3 +127,49 @@ boost::shared_ptr<AbstractCellProperty> CellPropertyCollection::GetProperty() co
         EXCEPTION("Can only call GetProperty on a collection of size 1.");
     }
 }
+
+const boost::shared_ptr<CellData>& CellPropertyCollection::GetCellData() const
+{
+    return mpCellData;
+}
+
+void CellPropertyCollection::UpdateCachedProperties()
+{
+    mPropertyTypeMask = 0;
+    mpCellData.reset();
+    for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
+    {
+        unsigned bit = GetPropertyTypeBit(typeid(**it));
+        if (bit != UNSIGNED_UNSET)
+        {
+            mPropertyTypeMask |= (boost::uint64_t(1) << bit);
+        }
+        if (!mpCellData && (*it)->IsSubType<CellData>())
+        {
+            mpCellData = boost::static_pointer_cast<CellData>(*it);
+        }
+    }
+}
+
+unsigned CellPropertyCollection::GetPropertyTypeBit(const std::type_info& rType)
+{
+    static std::map<std::type_index, unsigned> type_bits;
+
+    unsigned bit = UNSIGNED_UNSET;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellPropertyCollectionTypeBits)
+#endif // CHASTE_OPENMP
+    {
+        std::map<std::type_index, unsigned>::const_iterator it = type_bits.find(std::type_index(rType));
+        if (it != type_bits.end())
+        {
+            bit = it->second;
+        }
+        else if (type_bits.size() < 64)
+        {
+            bit = type_bits.size();
+            type_bits[std::type_index(rType)] = bit;
+        }
+    }
+    return bit;
+}
@@ -37,14 +37,18 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CELLPROPERTYCOLLECTION_HPP_
 
 #include <set>
+#include <typeinfo>
+#include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/set.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include "AbstractCellProperty.hpp"
 #include "CellPropertyRegistry.hpp"
+#include "CellData.hpp"
 #include "Exception.hpp"
 
 /**
@@ -70,21 +74,59 @@ private:
     /** Cell property registry. */
     CellPropertyRegistry* mpCellPropertyRegistry;
 
+    /**
+     * Bitmask of the exact types of the properties in this collection, using the
+     * bits assigned by GetPropertyTypeBit(). Allows HasProperty<CLASS>() to avoid
+     * walking the collection.
+     */
+    boost::uint64_t mPropertyTypeMask;
+
+    /** The CellData property in this collection, if any, cached for fast access. */
+    boost::shared_ptr<CellData> mpCellData;
+
+    /**
+     * Recompute #mPropertyTypeMask and #mpCellData from #mProperties.
+     * Must be called whenever #mProperties changes.
+     */
+    void UpdateCachedProperties();
+
+    /**
+     * @return the bit of #mPropertyTypeMask assigned to the given property type,
+     * assigning one if necessary, or UNSIGNED_UNSET if all bits are in use.
+     *
+     * @param rType  the type of the property
+     */
+    static unsigned GetPropertyTypeBit(const std::type_info& rType);
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Save/load our member variables.
+     * Save our member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mProperties;
         // archive & mpCellPropertyRegistry; Not required as archived by the CellPopulation.
     }
 
+    /**
+     * Load our member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mProperties;
+        UpdateCachedProperties();
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 public:
     /**
      * Create an empty collection of cell properties.
@@ -126,6 +168,13 @@ public:
     template<typename CLASS>
     bool HasProperty() const
     {
+        // Function-local statics are initialised once, in a thread-safe manner
+        static const unsigned bit = GetPropertyTypeBit(typeid(CLASS));
+        if (bit != UNSIGNED_UNSET)
+        {
+            return (mPropertyTypeMask & (boost::uint64_t(1) << bit)) != 0;
+        }
+
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
             if ((*it)->IsType<CLASS>())
@@ -166,6 +215,7 @@ public:
             if ((*it)->IsType<CLASS>())
             {
                 mProperties.erase(it);
+                UpdateCachedProperties();
                 return;
             }
         }
@@ -206,6 +256,12 @@ public:
      */
     boost::shared_ptr<AbstractCellProperty> GetProperty() const;
 
+    /**
+     * @return the CellData property in this collection, or an empty pointer if
+     * there is none. This is much cheaper than GetPropertiesType<CellData>().
+     */
+    const boost::shared_ptr<CellData>& GetCellData() const;
+
     /**
      * @return a sub-collection containing all our properties that are instances
      * of the given class.
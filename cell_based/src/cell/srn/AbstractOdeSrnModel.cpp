@@ -94,6 +94,29 @@ void AbstractOdeSrnModel::SimulateToCurrentTime()
     SetSimulatedToTime(current_time);
 }
 
+bool AbstractOdeSrnModel::CanSolveOdesInBatch()
+{
+    return false;
+}
+
+AbstractOdeSystem* AbstractOdeSrnModel::PrepareForBatchOdeSolve(double currentTime)
+{
+    assert(mpOdeSystem != nullptr);
+    if (currentTime <= mLastTime || this->mFinishedRunningOdes)
+    {
+        return nullptr;
+    }
+    AdjustOdeParameters(currentTime);
+    return mpOdeSystem;
+}
+
+void AbstractOdeSrnModel::FinishBatchOdeSolve(double currentTime, bool stoppingEventOccurred)
+{
+    this->mFinishedRunningOdes = stoppingEventOccurred;
+    mLastTime = currentTime;
+    SetSimulatedToTime(currentTime);
+}
+
 void AbstractOdeSrnModel::Initialise(AbstractOdeSystem* pOdeSystem)
 {
     assert(mpOdeSystem == nullptr);
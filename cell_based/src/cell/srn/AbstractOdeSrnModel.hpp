@@ -130,6 +130,33 @@ public:
      */
     virtual void SimulateToCurrentTime();
 
+    /**
+     * @return whether the ODEs of this model may be solved together with those
+     * of other cells by OdeSrnModelBatchSolver. This requires any parameters that
+     * SimulateToCurrentTime() sets before solving to be set in AdjustOdeParameters().
+     *
+     * The default implementation returns false.
+     */
+    virtual bool CanSolveOdesInBatch();
+
+    /**
+     * Prepare to solve the ODEs of this model up to the current time as part of a batch,
+     * adjusting any parameters as SimulateToCurrentTime() would.
+     *
+     * @param currentTime the time to which the ODEs will be solved
+     * @return the ODE system to solve from GetLastTime(), or nullptr if it does not need solving
+     */
+    AbstractOdeSystem* PrepareForBatchOdeSolve(double currentTime);
+
+    /**
+     * Record that the ODEs of this model have been solved up to the current time as part
+     * of a batch, so that the next call to SimulateToCurrentTime() does not solve them again.
+     *
+     * @param currentTime the time to which the ODEs were solved
+     * @param stoppingEventOccurred whether the ODE system's stopping event occurred
+     */
+    void FinishBatchOdeSolve(double currentTime, bool stoppingEventOccurred);
+
      /**
      * For a naturally cycling model this does not need to be overridden in the
      * subclasses. But most models should override this function and then
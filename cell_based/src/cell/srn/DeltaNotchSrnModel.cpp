@@ -82,11 +82,18 @@ AbstractSrnModel* DeltaNotchSrnModel::CreateSrnModel()
 
 void DeltaNotchSrnModel::SimulateToCurrentTime()
 {
-    // Custom behaviour
+    // Run the ODE simulation as needed; the mean Delta is updated in AdjustOdeParameters() before each solve
+    AbstractOdeSrnModel::SimulateToCurrentTime();
+}
+
+void DeltaNotchSrnModel::AdjustOdeParameters(double currentTime)
+{
     UpdateDeltaNotch();
+}
 
-    // Run the ODE simulation as needed
-    AbstractOdeSrnModel::SimulateToCurrentTime();
+bool DeltaNotchSrnModel::CanSolveOdesInBatch()
+{
+    return true;
 }
 
 void DeltaNotchSrnModel::Initialise()
@@ -99,7 +106,9 @@ void DeltaNotchSrnModel::UpdateDeltaNotch()
     assert(mpOdeSystem != nullptr);
     assert(mpCell != nullptr);
 
-    double mean_delta = mpCell->GetCellData()->GetItem("mean delta");
+    // Cell data item indices are fixed once registered, so look this one up only once
+    static const unsigned mean_delta_index = CellData::GetItemIndex("mean delta");
+    double mean_delta = mpCell->GetCellData()->GetItem(mean_delta_index);
     mpOdeSystem->SetParameter("Mean Delta", mean_delta);
 }
 
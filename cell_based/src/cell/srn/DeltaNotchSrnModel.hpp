@@ -107,10 +107,27 @@ public:
     /**
      * Overridden SimulateToTime() method for custom behaviour.
      *
-     * \todo #2752 say what it does in this class
+     * The mean Delta is copied from CellData by AdjustOdeParameters(), only
+     * when the ODEs are actually solved.
      */
     void SimulateToCurrentTime();
 
+    /**
+     * Overridden AdjustOdeParameters() method, which calls UpdateDeltaNotch()
+     * before each solve, whether the ODEs are solved individually or in a batch
+     * (see CanSolveOdesInBatch()).
+     *
+     * @param currentTime the time up to which the system will be solved
+     */
+    void AdjustOdeParameters(double currentTime);
+
+    /**
+     * Overridden CanSolveOdesInBatch() method.
+     *
+     * @return true, since the mean Delta parameter is set in AdjustOdeParameters()
+     */
+    bool CanSolveOdesInBatch();
+
     /**
      * Update the current levels of Delta and Notch in the cell.
      *
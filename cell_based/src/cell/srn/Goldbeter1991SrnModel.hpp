@@ -112,6 +112,13 @@ public:
      */
     void SimulateToCurrentTime();
 
+    /**
+     * Overridden CanSolveOdesInBatch() method.
+     *
+     * @return true, since this model needs no custom behaviour before solving its ODEs
+     */
+    bool CanSolveOdesInBatch();
+
     /**
      * Output SRN model parameters to file.
      *
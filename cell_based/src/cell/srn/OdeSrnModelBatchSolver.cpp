@@ -0,0 +1,92 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "OdeSrnModelBatchSolver.hpp"
+
+#include <map>
+#include <tuple>
+#include <typeindex>
+
+#include "AbstractOdeSrnModel.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "SimulationTime.hpp"
+
+void OdeSrnModelBatchSolver::SimulateToCurrentTime(const std::vector<CellPtr>& rCells)
+{
+    double current_time = SimulationTime::Instance()->GetTime();
+
+    // Group the models that can be batched by ODE system type, time step and start time
+    typedef std::tuple<std::type_index, double, double> BatchKey;
+    std::map<BatchKey, std::vector<AbstractOdeSrnModel*> > batch_models;
+    std::map<BatchKey, std::vector<AbstractOdeSystem*> > batch_systems;
+
+    for (unsigned i=0; i<rCells.size(); i++)
+    {
+        AbstractOdeSrnModel* p_model = dynamic_cast<AbstractOdeSrnModel*>(rCells[i]->GetSrnModel());
+        if (!p_model || !p_model->CanSolveOdesInBatch())
+        {
+            continue;
+        }
+
+        // Only batch models that would otherwise be solved with the same RK4 method
+        if (!boost::dynamic_pointer_cast<RungeKutta4IvpOdeSolver>(p_model->GetOdeSolver()->GetIvpOdeSolver()))
+        {
+            continue;
+        }
+
+        double start_time = p_model->GetLastTime();
+        AbstractOdeSystem* p_system = p_model->PrepareForBatchOdeSolve(current_time);
+        if (p_system)
+        {
+            BatchKey key(std::type_index(typeid(*p_system)), p_model->GetDt(), start_time);
+            batch_models[key].push_back(p_model);
+            batch_systems[key].push_back(p_system);
+        }
+    }
+
+    for (std::map<BatchKey, std::vector<AbstractOdeSystem*> >::iterator iter = batch_systems.begin();
+         iter != batch_systems.end();
+         ++iter)
+    {
+        const BatchKey& r_key = iter->first;
+        mBatchSolver.SolveAndUpdateStateVariables(iter->second, std::get<2>(r_key), current_time, std::get<1>(r_key));
+
+        std::vector<AbstractOdeSrnModel*>& r_models = batch_models[r_key];
+        for (unsigned i=0; i<r_models.size(); i++)
+        {
+            r_models[i]->FinishBatchOdeSolve(current_time, mBatchSolver.StoppingEventOccurred(i));
+        }
+    }
+}
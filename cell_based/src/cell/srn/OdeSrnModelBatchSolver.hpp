@@ -0,0 +1,75 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ODESRNMODELBATCHSOLVER_HPP_
+#define ODESRNMODELBATCHSOLVER_HPP_
+
+#include <vector>
+
+#include "Cell.hpp"
+#include "RungeKutta4BatchOdeSolver.hpp"
+
+/**
+ * Solves the ODEs of the SRN models of many cells together, rather than one
+ * cell at a time through AbstractOdeSrnModel::SimulateToCurrentTime().
+ *
+ * The SRN models are grouped by ODE system type, time step and the time they
+ * were last solved to, and each group is advanced to the current time with a
+ * RungeKutta4BatchOdeSolver. Afterwards each model's own SimulateToCurrentTime()
+ * finds its ODEs already up to date, but still carries out any other custom
+ * behaviour.
+ *
+ * Only models for which AbstractOdeSrnModel::CanSolveOdesInBatch() returns true
+ * and which use a RungeKutta4IvpOdeSolver are batched, so the results are the same
+ * as solving each cell separately. Other models are left untouched.
+ */
+class OdeSrnModelBatchSolver
+{
+private:
+
+    /** The solver used for each batch. */
+    RungeKutta4BatchOdeSolver mBatchSolver;
+
+public:
+
+    /**
+     * Solve the ODEs of the SRN models of the given cells up to the current time.
+     *
+     * @param rCells the cells whose SRN models should be updated
+     */
+    void SimulateToCurrentTime(const std::vector<CellPtr>& rCells);
+};
+
+#endif /* ODESRNMODELBATCHSOLVER_HPP_ */
@@ -50,7 +50,8 @@ AbstractBoxDomainPdeModifier<DIM>::AbstractBoxDomainPdeModifier(boost::shared_pt
                                solution),
       mpMeshCuboid(pMeshCuboid),
       mStepSize(stepSize),
-      mSetBcsOnBoxBoundary(true)
+      mSetBcsOnBoxBoundary(true),
+      mUseMultigridSolver(false)
 {
     if (pMeshCuboid)
     {
@@ -83,9 +84,33 @@ bool AbstractBoxDomainPdeModifier<DIM>::AreBcsSetOnBoxBoundary()
     return mSetBcsOnBoxBoundary;
 }
 
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::SetUseMultigridSolver(bool useMultigridSolver)
+{
+    mUseMultigridSolver = useMultigridSolver;
+}
+
+template<unsigned DIM>
+bool AbstractBoxDomainPdeModifier<DIM>::GetUseMultigridSolver()
+{
+    return mUseMultigridSolver;
+}
+
+template<unsigned DIM>
+BoxDomainMultigridSolver<DIM>& AbstractBoxDomainPdeModifier<DIM>::rGetMultigridSolver()
+{
+    if (!mpMultigridSolver)
+    {
+        mpMultigridSolver.reset(new BoxDomainMultigridSolver<DIM>(this->mpFeMesh, mStepSize));
+    }
+    return *mpMultigridSolver;
+}
+
 template<unsigned DIM>
 void AbstractBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
+    mpMultigridSolver.reset();
+
     AbstractPdeModifier<DIM>::SetupSolve(rCellPopulation, outputDirectory);
 
     InitialiseCellPdeElementMap(rCellPopulation);
@@ -134,6 +159,18 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the cell data item indices once, rather than by name for every cell
+    unsigned solution_index = CellData::GetItemIndex(this->mDependentVariableName);
+    std::vector<unsigned> gradient_indices;
+    if (this->mOutputGradient)
+    {
+        const std::string suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_indices.push_back(CellData::GetItemIndex(this->mDependentVariableName + suffixes[j]));
+        }
+    }
+
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
@@ -155,7 +192,7 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
             solution_at_cell += nodal_value * weights(i);
         }
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_cell);
+        cell_iter->GetCellData()->SetItem(solution_index, solution_at_cell);
 
         if (this->mOutputGradient)
         {
@@ -180,22 +217,9 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
                 }
             }
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                cell_iter->GetCellData()->SetItem(gradient_indices[j], solution_gradient(j));
             }
         }
     }
@@ -39,7 +39,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <memory>
+
 #include "AbstractPdeModifier.hpp"
+#include "BoxDomainMultigridSolver.hpp"
 
 /**
  * An abstract modifier class containing functionality common to EllipticBoxDomainPdeModifier
@@ -71,6 +74,7 @@ private:
         archive & mpMeshCuboid;
         archive & mStepSize;
         archive & mSetBcsOnBoxBoundary;
+        archive & mUseMultigridSolver;
     }
 
 protected:
@@ -96,6 +100,20 @@ protected:
      */
     bool mSetBcsOnBoxBoundary;
 
+    /**
+     * Whether to solve the PDE with a BoxDomainMultigridSolver on the regular grid underlying
+     * the FE mesh, rather than by FE assembly and a PETSc linear solve. Defaults to false.
+     */
+    bool mUseMultigridSolver;
+
+    /** The multigrid solver, created on first use if mUseMultigridSolver is true. */
+    std::unique_ptr<BoxDomainMultigridSolver<DIM> > mpMultigridSolver;
+
+    /**
+     * @return the multigrid solver for the FE mesh, creating it if necessary.
+     */
+    BoxDomainMultigridSolver<DIM>& rGetMultigridSolver();
+
 public:
 
     /**
@@ -138,6 +156,21 @@ public:
      */
     bool AreBcsSetOnBoxBoundary();
 
+    /**
+     * Set mUseMultigridSolver.
+     *
+     * The multigrid solver is usually much faster than the default FE solve for large
+     * box domains. Its solution agrees with the FE solution to second order in the step size.
+     *
+     * @param useMultigridSolver whether to solve the PDE with a BoxDomainMultigridSolver
+     */
+    void SetUseMultigridSolver(bool useMultigridSolver);
+
+    /**
+     * @return mUseMultigridSolver.
+     */
+    bool GetUseMultigridSolver();
+
     /**
      * Overridden SetupSolve() method.
      *
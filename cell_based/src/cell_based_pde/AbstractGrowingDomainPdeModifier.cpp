@@ -49,7 +49,8 @@ AbstractGrowingDomainPdeModifier<DIM>::AbstractGrowingDomainPdeModifier(boost::s
         : AbstractPdeModifier<DIM>(pPde,
                                    pBoundaryCondition,
                                    isNeumannBoundaryCondition,
-                                   solution)
+                                   solution),
+          mFeMeshTopologyIsUnchanged(false)
 {
 }
 
@@ -75,9 +76,39 @@ void AbstractGrowingDomainPdeModifier<DIM>::GenerateFeMesh(AbstractCellPopulatio
         this->mDeleteFeMesh = (dynamic_cast<MeshBasedCellPopulation<DIM>*>(&rCellPopulation) == nullptr);
     }
 
+    TetrahedralMesh<DIM,DIM>* p_previous_mesh = this->mpFeMesh;
+
     // Get the finite element mesh via the cell population. Set to NULL first in case mesh generation fails.
     this->mpFeMesh = nullptr;
     this->mpFeMesh = rCellPopulation.GetTetrahedralMeshForPdeModifier();
+
+    // Record the mesh connectivity, and whether it has changed since the last call
+    std::vector<unsigned> connectivity;
+    connectivity.reserve(1 + (DIM+1)*this->mpFeMesh->GetNumAllElements());
+    connectivity.push_back(this->mpFeMesh->GetNumAllNodes());
+    for (unsigned elem_index=0; elem_index<this->mpFeMesh->GetNumAllElements(); elem_index++)
+    {
+        Element<DIM,DIM>* p_element = this->mpFeMesh->GetElement(elem_index);
+        for (unsigned i=0; i<DIM+1; i++)
+        {
+            connectivity.push_back(p_element->IsDeleted() ? UNSIGNED_UNSET : p_element->GetNodeGlobalIndex(i));
+        }
+    }
+
+    /*
+     * A mesh that is deleted and regenerated at each time step is never treated as unchanged,
+     * even if it has the same topology, since the new mesh may be allocated at the same address.
+     */
+    mFeMeshTopologyIsUnchanged = (!this->mDeleteFeMesh)
+                                 && (this->mpFeMesh == p_previous_mesh)
+                                 && (connectivity == mFeMeshConnectivity);
+    mFeMeshConnectivity.swap(connectivity);
+}
+
+template<unsigned DIM>
+bool AbstractGrowingDomainPdeModifier<DIM>::FeMeshTopologyIsUnchanged() const
+{
+    return mFeMeshTopologyIsUnchanged;
 }
 
 template<unsigned DIM>
@@ -86,6 +117,18 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the cell data item indices once, rather than by name for every cell
+    unsigned solution_index = CellData::GetItemIndex(this->mDependentVariableName);
+    std::vector<unsigned> gradient_indices;
+    if (this->mOutputGradient)
+    {
+        const std::string suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_indices.push_back(CellData::GetItemIndex(this->mDependentVariableName + suffixes[j]));
+        }
+    }
+
     // Local cell index used by the CA simulation
     unsigned cell_index = 0;
 
@@ -116,7 +159,7 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
 
         double solution_at_node = solution_repl[tet_node_index];
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_node);
+        cell_iter->GetCellData()->SetItem(solution_index, solution_at_node);
 
         if (this->mOutputGradient)
         {
@@ -153,22 +196,9 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
             // Divide by number of containing elements
             solution_gradient /= p_tet_node->GetNumContainingElements();
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                cell_iter->GetCellData()->SetItem(gradient_indices[j], solution_gradient(j));
             }
         }
     }
@@ -39,6 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <vector>
+
 #include "AbstractPdeModifier.hpp"
 
 /**
@@ -54,6 +56,18 @@ class AbstractGrowingDomainPdeModifier : public AbstractPdeModifier<DIM>
 
 private:
 
+    /**
+     * The FE mesh connectivity (the number of nodes followed by the node indices of each
+     * element) when GenerateFeMesh() was last called, used to detect topology changes.
+     */
+    std::vector<unsigned> mFeMeshConnectivity;
+
+    /**
+     * Whether the FE mesh generated by the last call to GenerateFeMesh() is the same
+     * object, with the same topology, as that generated by the previous call.
+     */
+    bool mFeMeshTopologyIsUnchanged;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -97,6 +111,15 @@ public:
      */
     void GenerateFeMesh(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
 
+    /**
+     * @return whether the FE mesh generated by the last call to GenerateFeMesh() is the
+     * same object, with the same topology, as that generated by the previous call. If so,
+     * a PDE solver set up on the previous mesh (and the sparsity pattern of its linear
+     * system) may be reused. This is only ever the case for cell populations that retain
+     * ownership of the FE mesh, such as MeshBasedCellPopulation.
+     */
+    bool FeMeshTopologyIsUnchanged() const;
+
     /**
      * Helper method to copy the PDE solution to CellData
      *
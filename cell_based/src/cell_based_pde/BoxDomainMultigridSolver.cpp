@@ -0,0 +1,726 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BoxDomainMultigridSolver.hpp"
+#include "ReplicatableVector.hpp"
+#include "Exception.hpp"
+#include "Warnings.hpp"
+
+/** The number of Gauss-Seidel sweeps carried out before and after each coarse grid correction. */
+static const unsigned NUM_SMOOTHING_SWEEPS = 2;
+
+/** The maximum number of Gauss-Seidel sweeps carried out on the coarsest level in each V-cycle. */
+static const unsigned MAX_NUM_COARSEST_LEVEL_SWEEPS = 10000;
+
+/**
+ * The largest number of floating point operations (roughly the number of nodes times the
+ * square of the bandwidth) to spend on factorising the coarsest level for a direct solve.
+ */
+static const double MAX_COARSEST_LEVEL_FACTORISATION_WORK = 1e8;
+
+template<unsigned DIM>
+BoxDomainMultigridSolver<DIM>::BoxDomainMultigridSolver(TetrahedralMesh<DIM,DIM>* pMesh, double stepSize)
+    : mpMesh(pMesh),
+      mTolerance(1e-10),
+      mMaxNumCycles(100),
+      mNumCyclesInLastSolve(0),
+      mCoarsestLevelBandwidth(0),
+      mSolveCoarsestLevelDirectly(false)
+{
+    assert(pMesh);
+    assert(stepSize > 0.0);
+
+    // Infer the grid dimensions from the extent of the mesh
+    ChasteCuboid<DIM> bounding_box = pMesh->CalculateBoundingBox();
+    GridLevel finest;
+    finest.mStepSize = stepSize;
+    finest.mTotalNumNodes = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        finest.mNumNodes[d] = (unsigned)(bounding_box.GetWidth(d)/stepSize + 0.5) + 1;
+        finest.mStrides[d] = finest.mTotalNumNodes;
+        finest.mTotalNumNodes *= finest.mNumNodes[d];
+    }
+    if (finest.mTotalNumNodes != pMesh->GetNumNodes())
+    {
+        EXCEPTION("The mesh is not a regular slab mesh with the given step size");
+    }
+
+    // Check that the nodes of the mesh are ordered as the nodes of the grid
+    c_vector<double,DIM> lower_corner = bounding_box.rGetLowerCorner().rGetLocation();
+    for (unsigned node_index=0; node_index<pMesh->GetNumNodes(); node_index++)
+    {
+        c_vector<double,DIM> offset = (pMesh->GetNode(node_index)->rGetLocation() - lower_corner)/stepSize;
+        unsigned grid_index = 0;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            grid_index += (unsigned)(offset(d) + 0.5)*finest.mStrides[d];
+        }
+        if (grid_index != node_index)
+        {
+            EXCEPTION("The mesh is not a regular slab mesh with the given step size");
+        }
+    }
+    mLevels.push_back(finest);
+
+    // Coarsen by a factor of two while every dimension has an even number of (at least four) intervals
+    while (true)
+    {
+        GridLevel coarse;
+        coarse.mStepSize = 2.0*mLevels.back().mStepSize;
+        coarse.mTotalNumNodes = 1;
+        bool can_coarsen = true;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            unsigned num_intervals = mLevels.back().mNumNodes[d] - 1;
+            if (num_intervals%2 != 0 || num_intervals < 4)
+            {
+                can_coarsen = false;
+            }
+            coarse.mNumNodes[d] = num_intervals/2 + 1;
+            coarse.mStrides[d] = coarse.mTotalNumNodes;
+            coarse.mTotalNumNodes *= coarse.mNumNodes[d];
+        }
+        if (!can_coarsen)
+        {
+            break;
+        }
+        mLevels.push_back(coarse);
+    }
+
+    for (unsigned level=0; level<mLevels.size(); level++)
+    {
+        GridLevel& r_level = mLevels[level];
+        r_level.mDiffusionCoefficients.resize(r_level.mTotalNumNodes, 0.0);
+        r_level.mReactionCoefficients.resize(r_level.mTotalNumNodes, 0.0);
+        r_level.mRhs.resize(r_level.mTotalNumNodes, 0.0);
+        r_level.mSolution.resize(r_level.mTotalNumNodes, 0.0);
+        r_level.mResidual.resize(r_level.mTotalNumNodes, 0.0);
+        r_level.mIsFixed.resize(r_level.mTotalNumNodes, false);
+    }
+    mAssembledRhs.resize(finest.mTotalNumNodes, 0.0);
+
+    // Grids whose number of intervals is not a power of two leave a large coarsest level, which is solved directly if possible
+    const GridLevel& r_coarsest = mLevels.back();
+    mCoarsestLevelBandwidth = r_coarsest.mStrides[DIM-1];
+    double factorisation_work = (double)r_coarsest.mTotalNumNodes*mCoarsestLevelBandwidth*mCoarsestLevelBandwidth;
+    mSolveCoarsestLevelDirectly = (factorisation_work <= MAX_COARSEST_LEVEL_FACTORISATION_WORK);
+    if (!mSolveCoarsestLevelDirectly)
+    {
+        WARN_ONCE_ONLY("The coarsest multigrid level has " << r_coarsest.mTotalNumNodes << " nodes, too many to solve directly,"
+                       << " so it is solved by Gauss-Seidel iteration and the solver may be slow."
+                       << " Use a box with 2^k intervals in each direction for best performance.");
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::GetGridIndices(const GridLevel& rLevel, unsigned nodeIndex, unsigned* pIndices) const
+{
+    for (unsigned d=0; d<DIM; d++)
+    {
+        pIndices[d] = (nodeIndex/rLevel.mStrides[d])%rLevel.mNumNodes[d];
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::ComputeStencil(const GridLevel& rLevel, unsigned nodeIndex, double& rDiagonal, double& rOffDiagonalSum) const
+{
+    unsigned indices[DIM];
+    GetGridIndices(rLevel, nodeIndex, indices);
+
+    double inverse_h_squared = 1.0/(rLevel.mStepSize*rLevel.mStepSize);
+    double diffusion_coefficient = rLevel.mDiffusionCoefficients[nodeIndex];
+
+    rDiagonal = rLevel.mReactionCoefficients[nodeIndex];
+    rOffDiagonalSum = 0.0;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        // On the box boundary the missing neighbour is replaced by its reflection
+        unsigned stride = rLevel.mStrides[d];
+        unsigned lower = (indices[d] > 0) ? nodeIndex - stride : nodeIndex + stride;
+        unsigned upper = (indices[d] + 1 < rLevel.mNumNodes[d]) ? nodeIndex + stride : nodeIndex - stride;
+
+        double lower_weight = 0.5*(diffusion_coefficient + rLevel.mDiffusionCoefficients[lower])*inverse_h_squared;
+        double upper_weight = 0.5*(diffusion_coefficient + rLevel.mDiffusionCoefficients[upper])*inverse_h_squared;
+
+        rDiagonal += lower_weight + upper_weight;
+        rOffDiagonalSum += lower_weight*rLevel.mSolution[lower] + upper_weight*rLevel.mSolution[upper];
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::Smooth(GridLevel& rLevel, unsigned numSweeps)
+{
+    for (unsigned sweep=0; sweep<numSweeps; sweep++)
+    {
+        // Nodes of one colour only neighbour nodes of the other, so each half-sweep may be done in parallel
+        for (unsigned colour=0; colour<2; colour++)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for
+#endif // CHASTE_OPENMP
+            for (unsigned node_index=0; node_index<rLevel.mTotalNumNodes; node_index++)
+            {
+                unsigned indices[DIM];
+                GetGridIndices(rLevel, node_index, indices);
+                unsigned index_sum = 0;
+                for (unsigned d=0; d<DIM; d++)
+                {
+                    index_sum += indices[d];
+                }
+
+                if (index_sum%2 == colour && !rLevel.mIsFixed[node_index])
+                {
+                    double diagonal;
+                    double off_diagonal_sum;
+                    ComputeStencil(rLevel, node_index, diagonal, off_diagonal_sum);
+                    rLevel.mSolution[node_index] = (rLevel.mRhs[node_index] + off_diagonal_sum)/diagonal;
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+double BoxDomainMultigridSolver<DIM>::ComputeResidual(GridLevel& rLevel)
+{
+    double norm_squared = 0.0;
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for reduction(+:norm_squared)
+#endif // CHASTE_OPENMP
+    for (unsigned node_index=0; node_index<rLevel.mTotalNumNodes; node_index++)
+    {
+        if (rLevel.mIsFixed[node_index])
+        {
+            rLevel.mResidual[node_index] = 0.0;
+        }
+        else
+        {
+            double diagonal;
+            double off_diagonal_sum;
+            ComputeStencil(rLevel, node_index, diagonal, off_diagonal_sum);
+            double residual = rLevel.mRhs[node_index] - diagonal*rLevel.mSolution[node_index] + off_diagonal_sum;
+            rLevel.mResidual[node_index] = residual;
+            norm_squared += residual*residual;
+        }
+    }
+    return sqrt(norm_squared);
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::Restrict(const GridLevel& rFine, GridLevel& rCoarse)
+{
+    unsigned num_offsets = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        num_offsets *= 3;
+    }
+
+    for (unsigned coarse_index=0; coarse_index<rCoarse.mTotalNumNodes; coarse_index++)
+    {
+        if (rCoarse.mIsFixed[coarse_index])
+        {
+            rCoarse.mRhs[coarse_index] = 0.0;
+            continue;
+        }
+
+        unsigned coarse_indices[DIM];
+        GetGridIndices(rCoarse, coarse_index, coarse_indices);
+
+        // Full weighting: the tensor product of the weights (1/4, 1/2, 1/4)
+        double value = 0.0;
+        for (unsigned offset=0; offset<num_offsets; offset++)
+        {
+            unsigned fine_index = 0;
+            double weight = 1.0;
+            unsigned remainder = offset;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                int shift = (int)(remainder%3) - 1;
+                remainder /= 3;
+
+                int fine_grid_index = 2*(int)coarse_indices[d] + shift;
+                if (fine_grid_index < 0 || fine_grid_index >= (int)rFine.mNumNodes[d])
+                {
+                    // Reflect through the box boundary, consistent with ComputeStencil()
+                    fine_grid_index = 2*(int)coarse_indices[d] - shift;
+                }
+                weight *= (shift == 0) ? 0.5 : 0.25;
+                fine_index += (unsigned)fine_grid_index*rFine.mStrides[d];
+            }
+            value += weight*rFine.mResidual[fine_index];
+        }
+        rCoarse.mRhs[coarse_index] = value;
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::ProlongateAndCorrect(const GridLevel& rCoarse, GridLevel& rFine)
+{
+    for (unsigned fine_index=0; fine_index<rFine.mTotalNumNodes; fine_index++)
+    {
+        if (rFine.mIsFixed[fine_index])
+        {
+            continue;
+        }
+
+        unsigned fine_indices[DIM];
+        GetGridIndices(rFine, fine_index, fine_indices);
+
+        // Interpolate from the corners of the coarse cell containing this node
+        double correction = 0.0;
+        for (unsigned corner=0; corner<(1u << DIM); corner++)
+        {
+            double weight = 1.0;
+            unsigned coarse_index = 0;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned coarse_grid_index = fine_indices[d]/2;
+                if (fine_indices[d]%2 == 1)
+                {
+                    weight *= 0.5;
+                    if ((corner >> d) & 1)
+                    {
+                        coarse_grid_index++;
+                    }
+                }
+                else if ((corner >> d) & 1)
+                {
+                    // This node is aligned with the coarse grid in dimension d
+                    weight = 0.0;
+                }
+                coarse_index += coarse_grid_index*rCoarse.mStrides[d];
+            }
+            if (weight > 0.0)
+            {
+                correction += weight*rCoarse.mSolution[coarse_index];
+            }
+        }
+        rFine.mSolution[fine_index] += correction;
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::VCycle(unsigned levelIndex)
+{
+    GridLevel& r_level = mLevels[levelIndex];
+
+    if (levelIndex + 1 == mLevels.size() && !mCoarsestLevelFactors.empty())
+    {
+        SolveCoarsestLevel();
+    }
+    else if (levelIndex + 1 == mLevels.size())
+    {
+        // The coarsest level cannot be solved directly, so iterate until the residual is substantially reduced
+        double initial_residual = ComputeResidual(r_level);
+        double residual = initial_residual;
+        for (unsigned sweep=0;
+             sweep<MAX_NUM_COARSEST_LEVEL_SWEEPS && residual > 1e-4*initial_residual;
+             sweep += 10)
+        {
+            Smooth(r_level, 10);
+            residual = ComputeResidual(r_level);
+        }
+    }
+    else
+    {
+        GridLevel& r_coarse = mLevels[levelIndex + 1];
+
+        Smooth(r_level, NUM_SMOOTHING_SWEEPS);
+        ComputeResidual(r_level);
+        Restrict(r_level, r_coarse);
+
+        std::fill(r_coarse.mSolution.begin(), r_coarse.mSolution.end(), 0.0);
+        VCycle(levelIndex + 1);
+
+        ProlongateAndCorrect(r_coarse, r_level);
+        Smooth(r_level, NUM_SMOOTHING_SWEEPS);
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetUpCoarseLevels()
+{
+    for (unsigned level=1; level<mLevels.size(); level++)
+    {
+        const GridLevel& r_fine = mLevels[level-1];
+        GridLevel& r_coarse = mLevels[level];
+
+        for (unsigned coarse_index=0; coarse_index<r_coarse.mTotalNumNodes; coarse_index++)
+        {
+            unsigned coarse_indices[DIM];
+            GetGridIndices(r_coarse, coarse_index, coarse_indices);
+            unsigned fine_index = 0;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                fine_index += 2*coarse_indices[d]*r_fine.mStrides[d];
+            }
+
+            r_coarse.mDiffusionCoefficients[coarse_index] = r_fine.mDiffusionCoefficients[fine_index];
+            r_coarse.mReactionCoefficients[coarse_index] = r_fine.mReactionCoefficients[fine_index];
+            r_coarse.mIsFixed[coarse_index] = r_fine.mIsFixed[fine_index];
+        }
+    }
+
+    FactoriseCoarsestLevel();
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::FactoriseCoarsestLevel()
+{
+    mCoarsestLevelFactors.clear();
+    if (!mSolveCoarsestLevelDirectly)
+    {
+        return;
+    }
+
+    const GridLevel& r_level = mLevels.back();
+    const unsigned num_nodes = r_level.mTotalNumNodes;
+    const unsigned bandwidth = mCoarsestLevelBandwidth;
+    const unsigned row_length = 2*bandwidth + 1;
+    std::vector<double> band(num_nodes*row_length, 0.0);
+
+    // Assemble the same operator as ComputeStencil(), with identity rows at fixed nodes
+    double inverse_h_squared = 1.0/(r_level.mStepSize*r_level.mStepSize);
+    double max_diagonal = 0.0;
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        double* p_row = &band[node_index*row_length + bandwidth - node_index];
+        if (r_level.mIsFixed[node_index])
+        {
+            p_row[node_index] = 1.0;
+        }
+        else
+        {
+            unsigned indices[DIM];
+            GetGridIndices(r_level, node_index, indices);
+            double diffusion_coefficient = r_level.mDiffusionCoefficients[node_index];
+
+            p_row[node_index] = r_level.mReactionCoefficients[node_index];
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned stride = r_level.mStrides[d];
+                unsigned lower = (indices[d] > 0) ? node_index - stride : node_index + stride;
+                unsigned upper = (indices[d] + 1 < r_level.mNumNodes[d]) ? node_index + stride : node_index - stride;
+
+                double lower_weight = 0.5*(diffusion_coefficient + r_level.mDiffusionCoefficients[lower])*inverse_h_squared;
+                double upper_weight = 0.5*(diffusion_coefficient + r_level.mDiffusionCoefficients[upper])*inverse_h_squared;
+
+                p_row[node_index] += lower_weight + upper_weight;
+                p_row[lower] -= lower_weight;
+                p_row[upper] -= upper_weight;
+            }
+        }
+        max_diagonal = std::max(max_diagonal, fabs(p_row[node_index]));
+    }
+
+    // Gaussian elimination within the band, overwriting it with the unit lower and upper triangular factors
+    for (unsigned k=0; k<num_nodes; k++)
+    {
+        double* p_pivot_row = &band[k*row_length + bandwidth - k];
+        double pivot = p_pivot_row[k];
+        if (fabs(pivot) <= 1e-12*max_diagonal)
+        {
+            // The matrix is singular, which Gauss-Seidel iteration copes with
+            return;
+        }
+
+        unsigned last = std::min(num_nodes - 1, k + bandwidth);
+        for (unsigned i=k+1; i<=last; i++)
+        {
+            double* p_row = &band[i*row_length + bandwidth - i];
+            if (p_row[k] != 0.0)
+            {
+                double multiplier = p_row[k]/pivot;
+                p_row[k] = multiplier;
+                for (unsigned j=k+1; j<=last; j++)
+                {
+                    p_row[j] -= multiplier*p_pivot_row[j];
+                }
+            }
+        }
+    }
+    mCoarsestLevelFactors.swap(band);
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SolveCoarsestLevel()
+{
+    GridLevel& r_level = mLevels.back();
+    const unsigned num_nodes = r_level.mTotalNumNodes;
+    const unsigned bandwidth = mCoarsestLevelBandwidth;
+    const unsigned row_length = 2*bandwidth + 1;
+    assert(mCoarsestLevelFactors.size() == num_nodes*row_length);
+    std::vector<double>& r_solution = r_level.mSolution;
+
+    // Forward substitution with the unit lower triangular factor
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        const double* p_row = &mCoarsestLevelFactors[i*row_length + bandwidth - i];
+        double value = r_level.mRhs[i];
+        for (unsigned j=(i > bandwidth ? i - bandwidth : 0); j<i; j++)
+        {
+            value -= p_row[j]*r_solution[j];
+        }
+        r_solution[i] = value;
+    }
+
+    // Back substitution with the upper triangular factor
+    for (unsigned i=num_nodes; i-- > 0; )
+    {
+        const double* p_row = &mCoarsestLevelFactors[i*row_length + bandwidth - i];
+        double value = r_solution[i];
+        unsigned last = std::min(num_nodes - 1, i + bandwidth);
+        for (unsigned j=i+1; j<=last; j++)
+        {
+            value -= p_row[j]*r_solution[j];
+        }
+        r_solution[i] = value/p_row[i];
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetUpEllipticPde(AbstractLinearEllipticPde<DIM,DIM>* pPde)
+{
+    GridLevel& r_finest = mLevels[0];
+    std::fill(r_finest.mDiffusionCoefficients.begin(), r_finest.mDiffusionCoefficients.end(), 0.0);
+    std::fill(r_finest.mReactionCoefficients.begin(), r_finest.mReactionCoefficients.end(), 0.0);
+    std::fill(mAssembledRhs.begin(), mAssembledRhs.end(), 0.0);
+    std::vector<unsigned> num_containing_elements(r_finest.mTotalNumNodes, 0);
+
+    // Evaluate the coefficients once per element, and average them onto the nodes (all elements have the same volume)
+    for (unsigned elem_index=0; elem_index<mpMesh->GetNumElements(); elem_index++)
+    {
+        Element<DIM,DIM>* p_element = mpMesh->GetElement(elem_index);
+        ChastePoint<DIM> centroid(p_element->CalculateCentroid());
+
+        double diffusion_coefficient = pPde->ComputeDiffusionTerm(centroid)(0,0);
+        double linear_in_u_coefficient = pPde->ComputeLinearInUCoeffInSourceTerm(centroid, p_element);
+        double constant_in_u_term = pPde->ComputeConstantInUSourceTerm(centroid, p_element);
+
+        for (unsigned i=0; i<DIM+1; i++)
+        {
+            unsigned node_index = p_element->GetNodeGlobalIndex(i);
+            r_finest.mDiffusionCoefficients[node_index] += diffusion_coefficient;
+            r_finest.mReactionCoefficients[node_index] -= linear_in_u_coefficient;
+            mAssembledRhs[node_index] += constant_in_u_term;
+            num_containing_elements[node_index]++;
+        }
+    }
+
+    for (unsigned node_index=0; node_index<r_finest.mTotalNumNodes; node_index++)
+    {
+        r_finest.mDiffusionCoefficients[node_index] /= num_containing_elements[node_index];
+        r_finest.mReactionCoefficients[node_index] /= num_containing_elements[node_index];
+        mAssembledRhs[node_index] /= num_containing_elements[node_index];
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetUpParabolicPde(AbstractLinearParabolicPde<DIM,DIM>* pPde, Vec previousSolution, double dt)
+{
+    assert(dt > 0.0);
+    ReplicatableVector previous_solution_repl(previousSolution);
+
+    GridLevel& r_finest = mLevels[0];
+    assert(previous_solution_repl.GetSize() == r_finest.mTotalNumNodes);
+    std::fill(r_finest.mDiffusionCoefficients.begin(), r_finest.mDiffusionCoefficients.end(), 0.0);
+    std::fill(r_finest.mReactionCoefficients.begin(), r_finest.mReactionCoefficients.end(), 0.0);
+    std::fill(mAssembledRhs.begin(), mAssembledRhs.end(), 0.0);
+    std::vector<unsigned> num_containing_elements(r_finest.mTotalNumNodes, 0);
+
+    // Evaluate the coefficients once per element, and average them onto the nodes (all elements have the same volume)
+    for (unsigned elem_index=0; elem_index<mpMesh->GetNumElements(); elem_index++)
+    {
+        Element<DIM,DIM>* p_element = mpMesh->GetElement(elem_index);
+        ChastePoint<DIM> centroid(p_element->CalculateCentroid());
+
+        double diffusion_coefficient = pPde->ComputeDiffusionTerm(centroid, p_element)(0,0);
+        double du_dt_coefficient = pPde->ComputeDuDtCoefficientFunction(centroid);
+
+        for (unsigned i=0; i<DIM+1; i++)
+        {
+            unsigned node_index = p_element->GetNodeGlobalIndex(i);
+            double previous_u = previous_solution_repl[node_index];
+
+            // The source term is treated explicitly, as in SimpleLinearParabolicSolver
+            double source_term = pPde->ComputeSourceTerm(p_element->GetNode(i)->GetPoint(), previous_u, p_element);
+
+            r_finest.mDiffusionCoefficients[node_index] += diffusion_coefficient;
+            r_finest.mReactionCoefficients[node_index] += du_dt_coefficient/dt;
+            mAssembledRhs[node_index] += du_dt_coefficient*previous_u/dt + source_term;
+            num_containing_elements[node_index]++;
+        }
+    }
+
+    for (unsigned node_index=0; node_index<r_finest.mTotalNumNodes; node_index++)
+    {
+        r_finest.mDiffusionCoefficients[node_index] /= num_containing_elements[node_index];
+        r_finest.mReactionCoefficients[node_index] /= num_containing_elements[node_index];
+        mAssembledRhs[node_index] /= num_containing_elements[node_index];
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetBoundaryConditions(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions)
+{
+    GridLevel& r_finest = mLevels[0];
+    r_finest.mRhs = mAssembledRhs;
+
+    // Find the Neumann flux at each node lying on a boundary element with a Neumann condition
+    std::vector<double> neumann_fluxes(r_finest.mTotalNumNodes, 0.0);
+    std::vector<bool> has_neumann_flux(r_finest.mTotalNumNodes, false);
+    for (typename BoundaryConditionsContainer<DIM,DIM,1>::NeumannMapIterator neumann_iter = pBoundaryConditions->BeginNeumann();
+         neumann_iter != pBoundaryConditions->EndNeumann();
+         ++neumann_iter)
+    {
+        const BoundaryElement<DIM-1,DIM>* p_boundary_element = neumann_iter->first;
+        for (unsigned i=0; i<p_boundary_element->GetNumNodes(); i++)
+        {
+            Node<DIM>* p_node = p_boundary_element->GetNode(i);
+            neumann_fluxes[p_node->GetIndex()] = neumann_iter->second->GetValue(p_node->GetPoint());
+            has_neumann_flux[p_node->GetIndex()] = true;
+        }
+    }
+
+    for (unsigned node_index=0; node_index<r_finest.mTotalNumNodes; node_index++)
+    {
+        Node<DIM>* p_node = mpMesh->GetNode(node_index);
+        if (pBoundaryConditions->HasDirichletBoundaryCondition(p_node))
+        {
+            // Fixed nodes hold their prescribed value in the right-hand side
+            r_finest.mIsFixed[node_index] = true;
+            r_finest.mRhs[node_index] = pBoundaryConditions->GetDirichletBCValue(p_node);
+        }
+        else
+        {
+            r_finest.mIsFixed[node_index] = false;
+
+            if (has_neumann_flux[node_index])
+            {
+                // A flux g on a box face enters the reflected stencil as 2g/h, once for each face the node lies on
+                unsigned indices[DIM];
+                GetGridIndices(r_finest, node_index, indices);
+                for (unsigned d=0; d<DIM; d++)
+                {
+                    if (indices[d] == 0 || indices[d] + 1 == r_finest.mNumNodes[d])
+                    {
+                        r_finest.mRhs[node_index] += 2.0*neumann_fluxes[node_index]/r_finest.mStepSize;
+                    }
+                }
+            }
+        }
+    }
+
+    SetUpCoarseLevels();
+}
+
+template<unsigned DIM>
+Vec BoxDomainMultigridSolver<DIM>::Solve(Vec initialGuess)
+{
+    GridLevel& r_finest = mLevels[0];
+
+    if (initialGuess != nullptr)
+    {
+        ReplicatableVector initial_guess_repl(initialGuess);
+        assert(initial_guess_repl.GetSize() == r_finest.mTotalNumNodes);
+        for (unsigned node_index=0; node_index<r_finest.mTotalNumNodes; node_index++)
+        {
+            r_finest.mSolution[node_index] = initial_guess_repl[node_index];
+        }
+    }
+    else
+    {
+        std::fill(r_finest.mSolution.begin(), r_finest.mSolution.end(), 0.0);
+    }
+
+    double rhs_norm_squared = 0.0;
+    for (unsigned node_index=0; node_index<r_finest.mTotalNumNodes; node_index++)
+    {
+        if (r_finest.mIsFixed[node_index])
+        {
+            r_finest.mSolution[node_index] = r_finest.mRhs[node_index];
+        }
+        rhs_norm_squared += r_finest.mRhs[node_index]*r_finest.mRhs[node_index];
+    }
+
+    double residual = ComputeResidual(r_finest);
+    double tolerance = mTolerance*std::max(residual, sqrt(rhs_norm_squared));
+
+    mNumCyclesInLastSolve = 0;
+    while (residual > tolerance)
+    {
+        if (mNumCyclesInLastSolve == mMaxNumCycles)
+        {
+            EXCEPTION("Multigrid solver did not converge in " << mMaxNumCycles << " V-cycles");
+        }
+        VCycle(0);
+        residual = ComputeResidual(r_finest);
+        mNumCyclesInLastSolve++;
+    }
+
+    // Every process holds the whole (replicated) grid, so just copy out the locally owned part
+    return PetscTools::CreateVec(r_finest.mSolution);
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetTolerance(double tolerance)
+{
+    assert(tolerance > 0.0);
+    mTolerance = tolerance;
+}
+
+template<unsigned DIM>
+void BoxDomainMultigridSolver<DIM>::SetMaxNumCycles(unsigned maxNumCycles)
+{
+    mMaxNumCycles = maxNumCycles;
+}
+
+template<unsigned DIM>
+unsigned BoxDomainMultigridSolver<DIM>::GetNumLevels() const
+{
+    return mLevels.size();
+}
+
+template<unsigned DIM>
+unsigned BoxDomainMultigridSolver<DIM>::GetNumCyclesInLastSolve() const
+{
+    return mNumCyclesInLastSolve;
+}
+
+// Explicit instantiation
+template class BoxDomainMultigridSolver<1>;
+template class BoxDomainMultigridSolver<2>;
+template class BoxDomainMultigridSolver<3>;
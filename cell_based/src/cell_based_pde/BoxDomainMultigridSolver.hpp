@@ -0,0 +1,297 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BOXDOMAINMULTIGRIDSOLVER_HPP_
+#define BOXDOMAINMULTIGRIDSOLVER_HPP_
+
+#include <vector>
+
+#include "TetrahedralMesh.hpp"
+#include "AbstractLinearEllipticPde.hpp"
+#include "AbstractLinearParabolicPde.hpp"
+#include "BoundaryConditionsContainer.hpp"
+#include "PetscTools.hpp"
+
+/**
+ * A geometric multigrid solver for linear elliptic and (backward Euler) parabolic
+ * PDEs on the regular box domain meshes used by AbstractBoxDomainPdeModifier.
+ *
+ * The nodes of a mesh created by ConstructRegularSlabMesh() lie on a regular grid,
+ * so rather than assembling a sparse FE matrix and calling a Krylov solver, this class
+ * discretises the PDE with the standard (2*DIM+1)-point stencil, with the PDE
+ * coefficients averaged onto the nodes from the elements containing them (mass
+ * lumping), and solves the resulting system by multigrid V-cycles on contiguous arrays.
+ * The solution agrees with the linear FE solution to O(h^2).
+ *
+ * The grid is coarsened while the number of intervals in every dimension is even,
+ * so the solver is most efficient for boxes with 2^k intervals in each direction.
+ * The coarsest level is solved directly by banded LU factorisation unless it is too
+ * large, in which case a warning is given and it is solved by Gauss-Seidel iteration.
+ * Dirichlet conditions may be imposed at any node, which allows the boundary condition
+ * to be set on the edge of a cell population; Neumann conditions may be imposed at
+ * nodes on the boundary of the box. Box boundary nodes with neither have a zero-flux
+ * condition, as in the FE formulation.
+ */
+template<unsigned DIM>
+class BoxDomainMultigridSolver
+{
+    friend class TestBoxDomainMultigridSolver;
+
+private:
+
+    /**
+     * The discrete problem on one level of the multigrid hierarchy. Node (i,j,k) of a
+     * level is stored at index i + j*mStrides[1] + k*mStrides[2], which on the finest
+     * level matches the node ordering of ConstructRegularSlabMesh().
+     */
+    struct GridLevel
+    {
+        /** The number of nodes in each dimension. */
+        unsigned mNumNodes[DIM];
+
+        /** The index offset between neighbouring nodes in each dimension. */
+        unsigned mStrides[DIM];
+
+        /** The total number of nodes. */
+        unsigned mTotalNumNodes;
+
+        /** The grid spacing. */
+        double mStepSize;
+
+        /** The (isotropic) diffusion coefficient at each node. */
+        std::vector<double> mDiffusionCoefficients;
+
+        /** The coefficient c of the zeroth order term c*u at each node. */
+        std::vector<double> mReactionCoefficients;
+
+        /** The right-hand side at each node (the prescribed value at Dirichlet nodes). */
+        std::vector<double> mRhs;
+
+        /** The current iterate at each node. */
+        std::vector<double> mSolution;
+
+        /** The residual at each node. */
+        std::vector<double> mResidual;
+
+        /** Whether each node has its value fixed by a Dirichlet condition. */
+        std::vector<bool> mIsFixed;
+    };
+
+    /** The box domain mesh. */
+    TetrahedralMesh<DIM,DIM>* mpMesh;
+
+    /** The multigrid hierarchy, from finest (the mesh nodes) to coarsest. */
+    std::vector<GridLevel> mLevels;
+
+    /** The right-hand side on the finest level before boundary conditions are imposed. */
+    std::vector<double> mAssembledRhs;
+
+    /**
+     * Tolerance at which to stop iterating, relative to the larger of the initial
+     * residual norm and the norm of the right-hand side.
+     */
+    double mTolerance;
+
+    /** The maximum number of V-cycles to carry out in a single call to Solve(). */
+    unsigned mMaxNumCycles;
+
+    /** The number of V-cycles carried out in the last call to Solve(). */
+    unsigned mNumCyclesInLastSolve;
+
+    /** The half-bandwidth of the matrix on the coarsest level (the largest node index stride). */
+    unsigned mCoarsestLevelBandwidth;
+
+    /** Whether the coarsest level is small enough to be solved directly. */
+    bool mSolveCoarsestLevelDirectly;
+
+    /**
+     * The LU factors of the matrix on the coarsest level, stored row by row within its
+     * band, so that entry (i,j) is at i*(2*mCoarsestLevelBandwidth+1) + j-i+mCoarsestLevelBandwidth.
+     * Empty if the coarsest level is solved iteratively.
+     */
+    std::vector<double> mCoarsestLevelFactors;
+
+    /**
+     * Compute the grid indices of a node on a given level.
+     *
+     * @param rLevel the grid level
+     * @param nodeIndex the index of the node on this level
+     * @param pIndices array to be filled with the index of the node in each dimension
+     */
+    void GetGridIndices(const GridLevel& rLevel, unsigned nodeIndex, unsigned* pIndices) const;
+
+    /**
+     * Compute the action of the discrete operator at a node, split into the diagonal
+     * entry and the sum of the off-diagonal contributions (with sign reversed).
+     * Box boundary nodes use a reflected neighbour, giving a zero-flux condition.
+     *
+     * @param rLevel the grid level
+     * @param nodeIndex the node
+     * @param rDiagonal filled in with the diagonal entry of the operator at this node
+     * @param rOffDiagonalSum filled in with minus the sum of the off-diagonal terms
+     */
+    void ComputeStencil(const GridLevel& rLevel, unsigned nodeIndex, double& rDiagonal, double& rOffDiagonalSum) const;
+
+    /**
+     * Carry out red-black Gauss-Seidel sweeps on a level.
+     *
+     * @param rLevel the grid level
+     * @param numSweeps the number of sweeps
+     */
+    void Smooth(GridLevel& rLevel, unsigned numSweeps);
+
+    /**
+     * Compute the residual on a level.
+     *
+     * @param rLevel the grid level
+     * @return the 2-norm of the residual
+     */
+    double ComputeResidual(GridLevel& rLevel);
+
+    /**
+     * Restrict the residual on a level to the right-hand side of the next coarser level,
+     * using full weighting.
+     *
+     * @param rFine the fine level
+     * @param rCoarse the coarse level
+     */
+    void Restrict(const GridLevel& rFine, GridLevel& rCoarse);
+
+    /**
+     * Interpolate the solution on a coarse level (multi)linearly and add it to the
+     * solution on the next finer level as a correction.
+     *
+     * @param rCoarse the coarse level
+     * @param rFine the fine level
+     */
+    void ProlongateAndCorrect(const GridLevel& rCoarse, GridLevel& rFine);
+
+    /**
+     * Carry out a V-cycle starting from a given level.
+     *
+     * @param levelIndex the index of the level in mLevels
+     */
+    void VCycle(unsigned levelIndex);
+
+    /**
+     * Inject the coefficients and Dirichlet nodes on the finest level onto the coarser levels.
+     */
+    void SetUpCoarseLevels();
+
+    /**
+     * Assemble the matrix on the coarsest level and compute its LU factors, without
+     * pivoting since the matrix is diagonally dominant. If the matrix is singular (zero
+     * flux on the whole boundary and no zeroth order term) the factors are left empty,
+     * and the coarsest level is solved iteratively.
+     */
+    void FactoriseCoarsestLevel();
+
+    /**
+     * Solve the problem on the coarsest level using the factors from FactoriseCoarsestLevel().
+     */
+    void SolveCoarsestLevel();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pMesh pointer to a mesh created by ConstructRegularSlabMesh() (and possibly translated)
+     * @param stepSize the step size used to create the mesh
+     */
+    BoxDomainMultigridSolver(TetrahedralMesh<DIM,DIM>* pMesh, double stepSize);
+
+    /**
+     * Set the coefficients of the discrete problem for the linear elliptic PDE
+     * div(D grad u) + a u + b = 0. The diffusion tensor is assumed to be isotropic.
+     *
+     * @param pPde pointer to the PDE
+     */
+    void SetUpEllipticPde(AbstractLinearEllipticPde<DIM,DIM>* pPde);
+
+    /**
+     * Set the coefficients of the discrete problem for one backward Euler time step of
+     * the linear parabolic PDE c du/dt = div(D grad u) + f(u), with the source term
+     * evaluated at the previous time, as in SimpleLinearParabolicSolver. The diffusion
+     * tensor is assumed to be isotropic.
+     *
+     * @param pPde pointer to the PDE
+     * @param previousSolution the solution at the previous time
+     * @param dt the time step
+     */
+    void SetUpParabolicPde(AbstractLinearParabolicPde<DIM,DIM>* pPde, Vec previousSolution, double dt);
+
+    /**
+     * Impose the boundary conditions in a boundary conditions container. Must be called
+     * after SetUpEllipticPde() or SetUpParabolicPde().
+     *
+     * @param pBoundaryConditions pointer to the boundary conditions container
+     */
+    void SetBoundaryConditions(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions);
+
+    /**
+     * Solve the discrete problem.
+     *
+     * @param initialGuess an initial guess for the solution (defaults to NULL, meaning zero)
+     * @return the solution at the nodes of the mesh, which the caller must destroy
+     */
+    Vec Solve(Vec initialGuess=nullptr);
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the relative residual norm at which to stop iterating
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * Set mMaxNumCycles.
+     *
+     * @param maxNumCycles the maximum number of V-cycles to carry out in a single solve
+     */
+    void SetMaxNumCycles(unsigned maxNumCycles);
+
+    /**
+     * @return the number of levels in the multigrid hierarchy.
+     */
+    unsigned GetNumLevels() const;
+
+    /**
+     * @return mNumCyclesInLastSolve.
+     */
+    unsigned GetNumCyclesInLastSolve() const;
+};
+
+#endif /*BOXDOMAINMULTIGRIDSOLVER_HPP_*/
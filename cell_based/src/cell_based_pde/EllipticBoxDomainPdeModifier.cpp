@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "EllipticBoxDomainPdeModifier.hpp"
-#include "SimpleLinearEllipticSolver.hpp"
 
 template<unsigned DIM>
 EllipticBoxDomainPdeModifier<DIM>::EllipticBoxDomainPdeModifier(boost::shared_ptr<AbstractLinearPde<DIM,DIM> > pPde,
@@ -69,15 +68,36 @@ void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopula
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearEllipticSolver as Averaged Source PDE
-    ///\todo allow other PDE classes to be used with this modifier
-    SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
-                                               boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                               p_bcc.get());
-
-    ///\todo Use solution at previous time step as an initial guess for Solve()
+    // Use the solution at the previous time step as an initial guess
     Vec old_solution_copy = this->mSolution;
-    this->mSolution = solver.Solve();
+
+    if (this->mUseMultigridSolver)
+    {
+        BoxDomainMultigridSolver<DIM>& r_solver = this->rGetMultigridSolver();
+        r_solver.SetUpEllipticPde(boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get());
+        r_solver.SetBoundaryConditions(p_bcc.get());
+        this->mSolution = r_solver.Solve(old_solution_copy);
+    }
+    else
+    {
+        // Use SimpleLinearEllipticSolver as Averaged Source PDE
+        ///\todo allow other PDE classes to be used with this modifier
+        if (!mpSolver)
+        {
+            mpSolver.reset(new SimpleLinearEllipticSolver<DIM,DIM>(this->mpFeMesh,
+                                                                   boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                   p_bcc.get()));
+        }
+        else
+        {
+            // The mesh is unchanged, so reuse the solver and its linear system with the new boundary conditions
+            mpSolver->ResetBoundaryConditionsContainer(p_bcc.get());
+        }
+        mpBoundaryConditionsContainer = p_bcc;
+
+        this->mSolution = mpSolver->Solve(old_solution_copy);
+    }
+
     if (old_solution_copy != nullptr)
     {
         PetscTools::Destroy(old_solution_copy);
@@ -89,6 +109,9 @@ void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopula
 template<unsigned DIM>
 void EllipticBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
+    // The FE mesh is regenerated here, so any existing solver must not be reused
+    mpSolver.reset();
+
     AbstractBoxDomainPdeModifier<DIM>::SetupSolve(rCellPopulation,outputDirectory);
 
     // Call these  methods to solve the PDE on the initial step and output the results
@@ -39,8 +39,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <memory>
+
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "SimpleLinearEllipticSolver.hpp"
 #include "PetscTools.hpp"
 #include "FileFinder.hpp"
 
@@ -69,6 +72,16 @@ class EllipticBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
 
 private:
 
+    /**
+     * The PDE solver, which is created on the first solve and reused on subsequent
+     * time steps, since the FE mesh is fixed. This avoids reallocating the linear
+     * system and allows the KSP solver to be reused.
+     */
+    std::unique_ptr<SimpleLinearEllipticSolver<DIM,DIM> > mpSolver;
+
+    /** The boundary conditions container used by #mpSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "EllipticGrowingDomainPdeModifier.hpp"
-#include "CellBasedEllipticPdeSolver.hpp"
 #include "AveragedSourceEllipticPde.hpp"
 
 template<unsigned DIM>
@@ -82,15 +81,23 @@ void EllipticGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPo
     // Add the BCs to the BCs container
     std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = this->ConstructBoundaryConditionsContainer();
 
-    // Use CellBasedEllipticPdeSolver as cell wise PDE
-    CellBasedEllipticPdeSolver<DIM> solver(this->mpFeMesh,
-                                           boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                           p_bcc.get());
+    // Use CellBasedEllipticPdeSolver as cell wise PDE, reusing the existing solver if the mesh topology is unchanged
+    if (mpSolver && this->FeMeshTopologyIsUnchanged())
+    {
+        mpSolver->ResetBoundaryConditionsContainer(p_bcc.get());
+    }
+    else
+    {
+        mpSolver.reset(new CellBasedEllipticPdeSolver<DIM>(this->mpFeMesh,
+                                                           boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                           p_bcc.get()));
+    }
+    mpBoundaryConditionsContainer = p_bcc;
 
     // If we have an initial guess, use this when solving the system...
     if (is_previous_solution_size_correct)
     {
-        this->mSolution = solver.Solve(initial_guess);
+        this->mSolution = mpSolver->Solve(initial_guess);
         PetscTools::Destroy(initial_guess);
     }
     else // ...otherwise do not supply one
@@ -98,7 +105,7 @@ void EllipticGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPo
         // The solver creates a Vec, so we have to keep a handle on the old one to destroy it
         Vec old_solution_copy = this->mSolution;
 
-        this->mSolution = solver.Solve();
+        this->mSolution = mpSolver->Solve();
 
         // On the first go round the vector has yet to be initialised, so we don't destroy it
         if (old_solution_copy != nullptr)
@@ -118,6 +125,9 @@ void EllipticGrowingDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DI
         EXCEPTION("EllipticGrowingDomainPdeModifier cannot be used with an AveragedSourceEllipticPde. Use an EllipticBoxDomainPdeModifier instead.");
     }
 
+    // Any solver from a previous simulation must not be reused
+    mpSolver.reset();
+
     AbstractGrowingDomainPdeModifier<DIM>::SetupSolve(rCellPopulation, outputDirectory);
 
     // Call these methods to solve the PDE on the initial step and output the results
@@ -39,8 +39,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <memory>
+
 #include "AbstractGrowingDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "CellBasedEllipticPdeSolver.hpp"
 
 /**
  * A modifier class in which a linear elliptic PDE coupled to a cell-based simulation
@@ -64,6 +67,16 @@ class EllipticGrowingDomainPdeModifier : public AbstractGrowingDomainPdeModifier
 
 private:
 
+    /**
+     * The PDE solver, which is reused on subsequent time steps while the FE mesh
+     * topology is unchanged (see FeMeshTopologyIsUnchanged()), so that the linear
+     * system, its sparsity pattern and the KSP solver are not reallocated.
+     */
+    std::unique_ptr<CellBasedEllipticPdeSolver<DIM> > mpSolver;
+
+    /** The boundary conditions container used by #mpSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ParabolicBoxDomainPdeModifier.hpp"
-#include "SimpleLinearParabolicSolver.hpp"
 
 template<unsigned DIM>
 ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_ptr<AbstractLinearPde<DIM,DIM> > pPde,
@@ -48,7 +47,8 @@ ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_
                                         isNeumannBoundaryCondition,
                                         pMeshCuboid,
                                         stepSize,
-                                        solution)
+                                        solution),
+      mSolverTimeStep(DOUBLE_UNSET)
 {
 }
 
@@ -57,9 +57,24 @@ ParabolicBoxDomainPdeModifier<DIM>::~ParabolicBoxDomainPdeModifier()
 {
 }
 
+template<unsigned DIM>
+ParabolicPdeTimeStepController& ParabolicBoxDomainPdeModifier<DIM>::rGetPdeTimeStepController()
+{
+    return mTimeStepController;
+}
+
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    double current_time = p_simulation_time->GetTime();
+
+    // If the PDE time step is longer than the cell-based time step, only advance the PDE once it is due
+    if (!mTimeStepController.IsUpdateDue(current_time, p_simulation_time->GetTimeStep()))
+    {
+        return;
+    }
+
     // Set up boundary conditions
     std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
 
@@ -69,25 +84,69 @@ void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopul
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearParabolicSolver as averaged Source PDE
-    SimpleLinearParabolicSolver<DIM,DIM> solver(this->mpFeMesh,
-                                                boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
-                                                p_bcc.get());
-
-    ///\todo Investigate more than one PDE time step per spatial step
-    SimulationTime* p_simulation_time = SimulationTime::Instance();
-    double current_time = p_simulation_time->GetTime();
-    double dt = p_simulation_time->GetTimeStep();
-    solver.SetTimes(current_time,current_time + dt);
-    solver.SetTimeStep(dt);
+    /*
+     * Advance the PDE over the interval since it was last advanced, subcycling if the PDE time
+     * step is shorter than this. The source terms are frozen at the current cell configuration.
+     */
+    double interval = current_time - mTimeStepController.GetLastUpdateTime();
+    unsigned num_sub_steps = mTimeStepController.GetNumSubSteps(interval);
+    double dt = interval/num_sub_steps;
 
     // Use previous solution as the initial condition
     Vec previous_solution = this->mSolution;
-    solver.SetInitialCondition(previous_solution);
 
-    // Note that the linear solver creates a vector, so we have to keep a handle on the old one
-    // in order to destroy it
-    this->mSolution = solver.Solve();
+    if (this->mUseMultigridSolver)
+    {
+        BoxDomainMultigridSolver<DIM>& r_solver = this->rGetMultigridSolver();
+        Vec solution = previous_solution;
+        for (unsigned step=0; step<num_sub_steps; step++)
+        {
+            r_solver.SetUpParabolicPde(boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                       solution,
+                                       dt);
+            r_solver.SetBoundaryConditions(p_bcc.get());
+            Vec next_solution = r_solver.Solve(solution);
+            if (solution != previous_solution)
+            {
+                PetscTools::Destroy(solution);
+            }
+            solution = next_solution;
+        }
+        this->mSolution = solution;
+    }
+    else
+    {
+        // Use SimpleLinearParabolicSolver as averaged Source PDE
+        if (!mpSolver)
+        {
+            mpSolver.reset(new SimpleLinearParabolicSolver<DIM,DIM>(this->mpFeMesh,
+                                                                    boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                    p_bcc.get()));
+        }
+        else
+        {
+            // The mesh is unchanged, so reuse the solver, its linear system and (if the time step is unchanged) its LHS matrix
+            mpSolver->ResetBoundaryConditionsContainer(p_bcc.get());
+        }
+        mpBoundaryConditionsContainer = p_bcc;
+
+        mpSolver->SetTimes(current_time, current_time + interval);
+        mpSolver->SetTimeStep(dt);
+
+        // The LHS matrix depends on the time step, so must be reassembled if this changes
+        if (dt != mSolverTimeStep)
+        {
+            mpSolver->SetMatrixIsNotAssembled();
+            mSolverTimeStep = dt;
+        }
+
+        mpSolver->SetInitialCondition(previous_solution);
+
+        // Note that the linear solver creates a vector, so we have to keep a handle on the old one
+        // in order to destroy it
+        this->mSolution = mpSolver->Solve();
+    }
+    mTimeStepController.RecordUpdate(current_time, previous_solution, this->mSolution);
     PetscTools::Destroy(previous_solution);
     this->UpdateCellData(rCellPopulation);
 }
@@ -95,6 +154,11 @@ void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopul
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
+    // The FE mesh is regenerated here, so any existing solver must not be reused
+    mpSolver.reset();
+    mSolverTimeStep = DOUBLE_UNSET;
+    mTimeStepController.Reset(SimulationTime::Instance()->GetTime());
+
     AbstractBoxDomainPdeModifier<DIM>::SetupSolve(rCellPopulation,outputDirectory);
 
     // Copy the cell data to mSolution (this is the initial condition)
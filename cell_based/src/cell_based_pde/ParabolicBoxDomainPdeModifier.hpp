@@ -39,8 +39,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <memory>
+
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "ParabolicPdeTimeStepController.hpp"
+#include "SimpleLinearParabolicSolver.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -57,6 +61,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * AbstractBoxDomainPdeModifier method SetBcsOnBoxBoundary(), which is inherited by this
  * class.
  *
+ * By default the PDE is advanced by one time step of the cell-based simulation at
+ * the end of each time step. The PDE time step may instead be decoupled from the
+ * cell-based time step using the ParabolicPdeTimeStepController returned by
+ * rGetPdeTimeStepController().
+ *
  * Examples of PDEs in the source folder that can be solved using this class are
  * AveragedSourceParabolicPde and UniformSourceParabolicPde.
  */
@@ -67,6 +76,24 @@ class ParabolicBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
 
 private:
 
+    /**
+     * The PDE solver, which is created on the first solve and reused on subsequent
+     * time steps. Since the FE mesh and boundary nodes are fixed, the LHS matrix
+     * is only assembled once (unless the time step changes), so at each time step only
+     * the RHS vector, which contains the cell-dependent source terms, is reassembled
+     * and the preconditioner is reused.
+     */
+    std::unique_ptr<SimpleLinearParabolicSolver<DIM,DIM> > mpSolver;
+
+    /** The boundary conditions container used by #mpSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
+    /** The time step used by #mpSolver when its matrix was last assembled. */
+    double mSolverTimeStep;
+
+    /** Controls when, and with what time step, the PDE is advanced. */
+    ParabolicPdeTimeStepController mTimeStepController;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -80,6 +107,7 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
+        archive & mTimeStepController;
     }
 
 public:
@@ -107,10 +135,18 @@ public:
      */
     virtual ~ParabolicBoxDomainPdeModifier();
 
+    /**
+     * @return reference to mTimeStepController, which may be used to decouple the PDE
+     *     time step from the cell-based time step.
+     */
+    ParabolicPdeTimeStepController& rGetPdeTimeStepController();
+
     /**
      * Overridden UpdateAtEndOfTimeStep() method.
      *
      * Specifies what to do in the simulation at the end of each time step.
+     * If the PDE is not due to be advanced (see ParabolicPdeTimeStepController),
+     * this does nothing and the cells keep the last computed solution.
      *
      * @param rCellPopulation reference to the cell population
      */
@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ParabolicGrowingDomainPdeModifier.hpp"
-#include "CellBasedParabolicPdeSolver.hpp"
 #include "AveragedSourceParabolicPde.hpp"
 
 template<unsigned DIM>
@@ -54,9 +53,24 @@ ParabolicGrowingDomainPdeModifier<DIM>::~ParabolicGrowingDomainPdeModifier()
 {
 }
 
+template<unsigned DIM>
+ParabolicPdeTimeStepController& ParabolicGrowingDomainPdeModifier<DIM>::rGetPdeTimeStepController()
+{
+    return mTimeStepController;
+}
+
 template<unsigned DIM>
 void ParabolicGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    double current_time = p_simulation_time->GetTime();
+
+    // If the PDE time step is longer than the cell-based time step, only advance the PDE once it is due
+    if (!mTimeStepController.IsUpdateDue(current_time, p_simulation_time->GetTimeStep()))
+    {
+        return;
+    }
+
     this->GenerateFeMesh(rCellPopulation);
 
     // Set up boundary conditions
@@ -65,25 +79,39 @@ void ParabolicGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellP
     // Construct the solution vector from cell data (takes care of cells dividing);
     UpdateSolutionVector(rCellPopulation);
 
-    // Use CellBasedParabolicPdeSolver as cell wise PDE
-    CellBasedParabolicPdeSolver<DIM> solver(this->mpFeMesh,
-                                            boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->mpPde).get(),
-                                            p_bcc.get());
+    // Use CellBasedParabolicPdeSolver as cell wise PDE, reusing the existing solver if the mesh topology is unchanged
+    if (mpSolver && this->FeMeshTopologyIsUnchanged())
+    {
+        mpSolver->ResetBoundaryConditionsContainer(p_bcc.get());
 
-    ///\todo Investigate more than one PDE time step per spatial step
-    SimulationTime* p_simulation_time = SimulationTime::Instance();
-    double current_time = p_simulation_time->GetTime();
-    double dt = p_simulation_time->GetTimeStep();
-    solver.SetTimes(current_time,current_time + dt);
-    solver.SetTimeStep(dt);
+        // The mesh nodes may have moved, so the LHS matrix must be reassembled
+        mpSolver->SetMatrixIsNotAssembled();
+    }
+    else
+    {
+        mpSolver.reset(new CellBasedParabolicPdeSolver<DIM>(this->mpFeMesh,
+                                                            boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->mpPde).get(),
+                                                            p_bcc.get()));
+    }
+    mpBoundaryConditionsContainer = p_bcc;
+
+    /*
+     * Advance the PDE over the interval since it was last advanced, subcycling if the PDE time
+     * step is shorter than this. The mesh and source terms are frozen at the current cell configuration.
+     */
+    double interval = current_time - mTimeStepController.GetLastUpdateTime();
+    double dt = interval/mTimeStepController.GetNumSubSteps(interval);
+    mpSolver->SetTimes(current_time, current_time + interval);
+    mpSolver->SetTimeStep(dt);
 
     // Use previous solution as the initial condition
     Vec previous_solution = this->mSolution;
-    solver.SetInitialCondition(previous_solution);
+    mpSolver->SetInitialCondition(previous_solution);
 
     // Note that the linear solver creates a vector, so we have to keep a handle on the old one
     // in order to destroy it
-    this->mSolution = solver.Solve();
+    this->mSolution = mpSolver->Solve();
+    mTimeStepController.RecordUpdate(current_time, previous_solution, this->mSolution);
     PetscTools::Destroy(previous_solution);
     this->UpdateCellData(rCellPopulation);
 }
@@ -91,6 +119,10 @@ void ParabolicGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellP
 template<unsigned DIM>
 void ParabolicGrowingDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
+    // Any solver from a previous simulation must not be reused
+    mpSolver.reset();
+    mTimeStepController.Reset(SimulationTime::Instance()->GetTime());
+
     AbstractGrowingDomainPdeModifier<DIM>::SetupSolve(rCellPopulation, outputDirectory);
 
     if (boost::dynamic_pointer_cast<AveragedSourceParabolicPde<DIM> >(this->mpPde))
@@ -39,8 +39,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <memory>
+
 #include "AbstractGrowingDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "CellBasedParabolicPdeSolver.hpp"
+#include "ParabolicPdeTimeStepController.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -54,6 +58,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * class and is used in the AbstractGrowingDomainPdeModifier method GenerateFeMesh()
  * that is inherited by this class.
  *
+ * By default the PDE is advanced by one time step of the cell-based simulation at
+ * the end of each time step. The PDE time step may instead be decoupled from the
+ * cell-based time step using the ParabolicPdeTimeStepController returned by
+ * rGetPdeTimeStepController().
+ *
  * Examples of PDEs in the source folder that can be solved using this class are
  * CellwiseSourceParabolicPde and UniformSourceParabolicPde.
  */
@@ -64,6 +73,20 @@ class ParabolicGrowingDomainPdeModifier : public AbstractGrowingDomainPdeModifie
 
 private:
 
+    /**
+     * The PDE solver, which is reused on subsequent time steps while the FE mesh
+     * topology is unchanged (see FeMeshTopologyIsUnchanged()), so that the linear
+     * system, its sparsity pattern and the KSP solver are not reallocated. Since the mesh nodes move, the LHS matrix is
+     * reassembled at each time step, but into the existing linear system.
+     */
+    std::unique_ptr<CellBasedParabolicPdeSolver<DIM> > mpSolver;
+
+    /** The boundary conditions container used by #mpSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
+    /** Controls when, and with what time step, the PDE is advanced. */
+    ParabolicPdeTimeStepController mTimeStepController;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -77,6 +100,7 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractGrowingDomainPdeModifier<DIM> >(*this);
+        archive & mTimeStepController;
     }
 
 public:
@@ -100,10 +124,18 @@ public:
      */
     virtual ~ParabolicGrowingDomainPdeModifier();
 
+    /**
+     * @return reference to mTimeStepController, which may be used to decouple the PDE
+     *     time step from the cell-based time step.
+     */
+    ParabolicPdeTimeStepController& rGetPdeTimeStepController();
+
     /**
      * Overridden UpdateAtEndOfTimeStep() method.
      *
      * Specifies what to do in the simulation at the end of each time step.
+     * If the PDE is not due to be advanced (see ParabolicPdeTimeStepController),
+     * this does nothing and the cells keep the last computed solution.
      *
      * @param rCellPopulation reference to the cell population
      */
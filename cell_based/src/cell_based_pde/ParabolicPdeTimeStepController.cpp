@@ -0,0 +1,179 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "ParabolicPdeTimeStepController.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "ReplicatableVector.hpp"
+
+ParabolicPdeTimeStepController::ParabolicPdeTimeStepController()
+    : mPdeTimeStep(DOUBLE_UNSET),
+      mIsAdaptive(false),
+      mTolerance(DOUBLE_UNSET),
+      mMinPdeTimeStep(DOUBLE_UNSET),
+      mMaxPdeTimeStep(DOUBLE_UNSET),
+      mQuasiSteadyTolerance(DOUBLE_UNSET),
+      mLastUpdateTime(0.0),
+      mIsQuasiSteady(false)
+{
+}
+
+void ParabolicPdeTimeStepController::SetPdeTimeStep(double pdeTimeStep)
+{
+    if (pdeTimeStep <= 0.0)
+    {
+        EXCEPTION("The PDE time step must be positive");
+    }
+    mPdeTimeStep = pdeTimeStep;
+    mIsAdaptive = false;
+}
+
+double ParabolicPdeTimeStepController::GetPdeTimeStep() const
+{
+    return mPdeTimeStep;
+}
+
+void ParabolicPdeTimeStepController::SetAdaptivePdeTimeStep(double tolerance, double minPdeTimeStep, double maxPdeTimeStep)
+{
+    if (tolerance <= 0.0 || minPdeTimeStep <= 0.0 || maxPdeTimeStep < minPdeTimeStep)
+    {
+        EXCEPTION("The tolerance and PDE time step bounds must be positive, with the minimum no larger than the maximum");
+    }
+    mIsAdaptive = true;
+    mTolerance = tolerance;
+    mMinPdeTimeStep = minPdeTimeStep;
+    mMaxPdeTimeStep = maxPdeTimeStep;
+    mPdeTimeStep = minPdeTimeStep;
+}
+
+bool ParabolicPdeTimeStepController::IsAdaptive() const
+{
+    return mIsAdaptive;
+}
+
+void ParabolicPdeTimeStepController::SetQuasiSteadyTolerance(double quasiSteadyTolerance)
+{
+    if (quasiSteadyTolerance <= 0.0)
+    {
+        EXCEPTION("The quasi-steady tolerance must be positive");
+    }
+    mQuasiSteadyTolerance = quasiSteadyTolerance;
+}
+
+bool ParabolicPdeTimeStepController::IsQuasiSteady() const
+{
+    return mIsQuasiSteady;
+}
+
+void ParabolicPdeTimeStepController::Reset(double startTime)
+{
+    mLastUpdateTime = startTime;
+    mIsQuasiSteady = false;
+    if (mIsAdaptive)
+    {
+        mPdeTimeStep = mMinPdeTimeStep;
+    }
+}
+
+double ParabolicPdeTimeStepController::GetLastUpdateTime() const
+{
+    return mLastUpdateTime;
+}
+
+bool ParabolicPdeTimeStepController::IsUpdateDue(double currentTime, double cellBasedTimeStep) const
+{
+    double update_interval = cellBasedTimeStep;
+    if (mPdeTimeStep != DOUBLE_UNSET)
+    {
+        update_interval = std::max(mPdeTimeStep, cellBasedTimeStep);
+    }
+
+    // Allow for rounding error in the accumulated cell-based times
+    return (currentTime - mLastUpdateTime + 1e-6*cellBasedTimeStep >= update_interval);
+}
+
+unsigned ParabolicPdeTimeStepController::GetNumSubSteps(double interval) const
+{
+    if (mPdeTimeStep == DOUBLE_UNSET || mIsQuasiSteady)
+    {
+        return 1;
+    }
+    return std::max(1u, (unsigned)ceil(interval/mPdeTimeStep - 1e-6));
+}
+
+void ParabolicPdeTimeStepController::RecordUpdate(double currentTime, Vec previousSolution, Vec solution)
+{
+    double interval = currentTime - mLastUpdateTime;
+    mLastUpdateTime = currentTime;
+
+    if ((!mIsAdaptive && mQuasiSteadyTolerance == DOUBLE_UNSET) || interval <= 0.0)
+    {
+        return;
+    }
+
+    // Compute the relative change in the solution (in the max norm) per unit time
+    ReplicatableVector previous_solution_repl(previousSolution);
+    ReplicatableVector solution_repl(solution);
+    assert(previous_solution_repl.GetSize() == solution_repl.GetSize());
+
+    double max_change = 0.0;
+    double max_value = 0.0;
+    for (unsigned i=0; i<solution_repl.GetSize(); i++)
+    {
+        max_change = std::max(max_change, fabs(solution_repl[i] - previous_solution_repl[i]));
+        max_value = std::max(max_value, fabs(solution_repl[i]));
+    }
+    double relative_rate_of_change = (max_value > 0.0) ? max_change/(max_value*interval) : 0.0;
+
+    if (mIsAdaptive)
+    {
+        // The change over a step is roughly proportional to its length, so aim for a change
+        // of mTolerance per step, limiting the growth or shrinkage of the step to a factor of two
+        double ideal_time_step = 2.0*mPdeTimeStep;
+        if (relative_rate_of_change > 0.0)
+        {
+            ideal_time_step = std::min(ideal_time_step, std::max(0.5*mPdeTimeStep, mTolerance/relative_rate_of_change));
+        }
+        mPdeTimeStep = std::min(mMaxPdeTimeStep, std::max(mMinPdeTimeStep, ideal_time_step));
+    }
+
+    if (mQuasiSteadyTolerance != DOUBLE_UNSET)
+    {
+        mIsQuasiSteady = (relative_rate_of_change < mQuasiSteadyTolerance);
+    }
+}
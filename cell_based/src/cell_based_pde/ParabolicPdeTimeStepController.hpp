@@ -0,0 +1,206 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef PARABOLICPDETIMESTEPCONTROLLER_HPP_
+#define PARABOLICPDETIMESTEPCONTROLLER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include "PetscTools.hpp"
+
+/**
+ * A class that decouples the time step used to advance the PDE in
+ * ParabolicBoxDomainPdeModifier and ParabolicGrowingDomainPdeModifier from the
+ * time step of the cell-based simulation.
+ *
+ * By default the PDE is advanced by a single step of the cell-based time step at the
+ * end of every cell-based time step. If a PDE time step is set, then:
+ *  - if it is smaller than the cell-based time step, the PDE is subcycled, taking as
+ *    many steps of (at most) this length as are needed to span each cell-based time step;
+ *  - if it is larger, the PDE is only advanced once this much time has elapsed since it
+ *    was last advanced, in a single step spanning the elapsed time.
+ * In either case the source terms are frozen at the cell configuration at the time of
+ * the update; in between updates the cells keep the last computed solution.
+ *
+ * The PDE time step may also be adapted so that the relative change in the solution over
+ * each PDE step is close to a tolerance, which subcycles while the solution is changing
+ * quickly and takes long steps once it is changing slowly. Finally, once the relative rate
+ * of change of the solution falls below a quasi-steady tolerance, the solution is taken to
+ * have equilibrated and each update uses a single implicit step rather than subcycling;
+ * as the step length grows this tends to the solution of the steady (elliptic) problem
+ * with the source term lagged.
+ *
+ * Note that the source term is treated explicitly by the parabolic solvers, so the PDE time
+ * step (and, when adaptive, the maximum PDE time step) must be small enough for this to be stable.
+ */
+class ParabolicPdeTimeStepController
+{
+    friend class TestParabolicPdeTimeStepController;
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & mPdeTimeStep;
+        archive & mIsAdaptive;
+        archive & mTolerance;
+        archive & mMinPdeTimeStep;
+        archive & mMaxPdeTimeStep;
+        archive & mQuasiSteadyTolerance;
+        archive & mLastUpdateTime;
+        archive & mIsQuasiSteady;
+    }
+
+    /** The PDE time step, or DOUBLE_UNSET to use the cell-based time step (the default). */
+    double mPdeTimeStep;
+
+    /** Whether to adapt mPdeTimeStep to the rate of change of the solution. Defaults to false. */
+    bool mIsAdaptive;
+
+    /** The target relative change in the solution over one PDE time step, if adaptive. */
+    double mTolerance;
+
+    /** The smallest PDE time step allowed, if adaptive. */
+    double mMinPdeTimeStep;
+
+    /** The largest PDE time step allowed, if adaptive. */
+    double mMaxPdeTimeStep;
+
+    /**
+     * The relative rate of change of the solution below which it is taken to have equilibrated,
+     * or DOUBLE_UNSET to never do so (the default).
+     */
+    double mQuasiSteadyTolerance;
+
+    /** The time at which the PDE was last advanced. */
+    double mLastUpdateTime;
+
+    /** Whether the solution has equilibrated. */
+    bool mIsQuasiSteady;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    ParabolicPdeTimeStepController();
+
+    /**
+     * Set mPdeTimeStep. This switches off adaptivity.
+     *
+     * @param pdeTimeStep the PDE time step
+     */
+    void SetPdeTimeStep(double pdeTimeStep);
+
+    /**
+     * @return mPdeTimeStep.
+     */
+    double GetPdeTimeStep() const;
+
+    /**
+     * Adapt the PDE time step to the rate of change of the solution.
+     *
+     * @param tolerance the target relative change in the solution over one PDE time step
+     * @param minPdeTimeStep the smallest PDE time step allowed (also used as the initial PDE time step)
+     * @param maxPdeTimeStep the largest PDE time step allowed
+     */
+    void SetAdaptivePdeTimeStep(double tolerance, double minPdeTimeStep, double maxPdeTimeStep);
+
+    /**
+     * @return mIsAdaptive.
+     */
+    bool IsAdaptive() const;
+
+    /**
+     * Set mQuasiSteadyTolerance.
+     *
+     * @param quasiSteadyTolerance the relative rate of change of the solution below which it is
+     *     taken to have equilibrated
+     */
+    void SetQuasiSteadyTolerance(double quasiSteadyTolerance);
+
+    /**
+     * @return mIsQuasiSteady.
+     */
+    bool IsQuasiSteady() const;
+
+    /**
+     * Reset the controller at the start of a simulation.
+     *
+     * @param startTime the time at which the initial condition applies
+     */
+    void Reset(double startTime);
+
+    /**
+     * @return mLastUpdateTime.
+     */
+    double GetLastUpdateTime() const;
+
+    /**
+     * @return whether the PDE should be advanced at the current time.
+     *
+     * @param currentTime the current time
+     * @param cellBasedTimeStep the time step of the cell-based simulation
+     */
+    bool IsUpdateDue(double currentTime, double cellBasedTimeStep) const;
+
+    /**
+     * @return the number of (equal) PDE time steps to take to advance the PDE over an interval.
+     *
+     * @param interval the length of the interval
+     */
+    unsigned GetNumSubSteps(double interval) const;
+
+    /**
+     * Record that the PDE has been advanced, and adapt the PDE time step and check whether the
+     * solution has equilibrated if required.
+     *
+     * @param currentTime the time to which the PDE has been advanced
+     * @param previousSolution the solution before the update
+     * @param solution the solution after the update
+     */
+    void RecordUpdate(double currentTime, Vec previousSolution, Vec solution);
+};
+
+#endif /*PARABOLICPDETIMESTEPCONTROLLER_HPP_*/
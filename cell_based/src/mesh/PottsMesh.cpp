@@ -51,8 +51,8 @@ PottsMesh<DIM>::PottsMesh(std::vector<Node<DIM>*> nodes,
     {
         EXCEPTION("Nodes and neighbour information for a Potts mesh need to be the same length.");
     }
-    mVonNeumannNeighbouringNodeIndices = vonNeumannNeighbouringNodeIndices;
-    mMooreNeighbouringNodeIndices = mooreNeighbouringNodeIndices;
+    mVonNeumannNeighbours.SetNeighbours(vonNeumannNeighbouringNodeIndices);
+    mMooreNeighbours.SetNeighbours(mooreNeighbouringNodeIndices);
 
     // Populate mNodes and mElements
     for (unsigned node_index=0; node_index<nodes.size(); node_index++)
@@ -134,10 +134,11 @@ void PottsMesh<DIM>::Clear()
     this->mNodes.clear();
 
     mDeletedElementIndices.clear();
+    mElementSurfaceAreas.clear();
 
     // Delete neighbour info
-    //mVonNeumannNeighbouringNodeIndices.clear();
-    //mMooreNeighbouringNodeIndices.clear();
+    //mVonNeumannNeighbours.SetNeighbours(std::vector<std::set<unsigned> >());
+    //mMooreNeighbours.SetNeighbours(std::vector<std::set<unsigned> >());
 }
 
 template<unsigned DIM>
@@ -200,6 +201,12 @@ double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
     ///\todo not implemented in 3d yet
     assert(DIM==2 || DIM==3); // LCOV_EXCL_LINE
 
+    if (!mElementSurfaceAreas.empty())
+    {
+        assert(index < mElementSurfaceAreas.size());
+        return mElementSurfaceAreas[index];
+    }
+
     // Helper variables
     PottsElement<DIM>* p_element = GetElement(index);
     unsigned num_nodes = p_element->GetNumNodes();
@@ -207,9 +214,9 @@ double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
     double surface_area = 0.0;
     for (unsigned node_index=0; node_index<num_nodes; node_index++)
     {
-        std::set<unsigned> neighbouring_node_indices = GetVonNeumannNeighbouringNodeIndices(p_element->GetNode(node_index)->GetIndex());
+        PottsNeighbourTable::Range neighbouring_node_indices = GetVonNeumannNeighbours(p_element->GetNode(node_index)->GetIndex());
         unsigned local_edges = 2*DIM;
-        for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
+        for (const unsigned* iter = neighbouring_node_indices.begin();
              iter != neighbouring_node_indices.end();
              iter++)
         {
@@ -229,21 +236,112 @@ double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
     return surface_area;
 }
 
+template<unsigned DIM>
+void PottsMesh<DIM>::CacheElementSurfaceAreas()
+{
+    if (DIM == 1)
+    {
+        return;
+    }
+
+    // Compute each surface area before storing any, as GetSurfaceAreaOfElement() uses the cache once it is non-empty
+    std::vector<double> element_surface_areas(mElements.size());
+    mElementSurfaceAreas.clear();
+    for (unsigned elem_index=0; elem_index<mElements.size(); elem_index++)
+    {
+        element_surface_areas[elem_index] = GetSurfaceAreaOfElement(elem_index);
+    }
+    mElementSurfaceAreas.swap(element_surface_areas);
+}
+
+template<unsigned DIM>
+void PottsMesh<DIM>::ClearElementSurfaceAreaCache()
+{
+    mElementSurfaceAreas.clear();
+}
+
+template<unsigned DIM>
+void PottsMesh<DIM>::MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex)
+{
+    Node<DIM>* p_node = this->mNodes[nodeIndex];
+    std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
+
+    // Each node in the mesh must be in at most one element
+    assert(containing_elements.size() <= 1);
+    unsigned old_element_index = containing_elements.empty() ? UNSIGNED_UNSET : *(containing_elements.begin());
+
+    if (old_element_index == elementIndex)
+    {
+        return;
+    }
+
+    if (!mElementSurfaceAreas.empty())
+    {
+        /*
+         * Each face of the node that is not shared with a Von Neumann neighbour in the same element
+         * contributes to that element's surface area, so moving the node from element A to element B
+         * changes the surface area of A by 2*(neighbours in A) - 2*DIM and that of B by 2*DIM - 2*(neighbours in B).
+         */
+        unsigned num_neighbours_in_old_element = 0;
+        unsigned num_neighbours_in_new_element = 0;
+        PottsNeighbourTable::Range neighbours = GetVonNeumannNeighbours(nodeIndex);
+        for (const unsigned* iter = neighbours.begin();
+             iter != neighbours.end();
+             ++iter)
+        {
+            const std::set<unsigned>& r_neighbour_elements = this->mNodes[*iter]->rGetContainingElementIndices();
+            if (!r_neighbour_elements.empty())
+            {
+                if (*(r_neighbour_elements.begin()) == old_element_index)
+                {
+                    num_neighbours_in_old_element++;
+                }
+                else if (*(r_neighbour_elements.begin()) == elementIndex)
+                {
+                    num_neighbours_in_new_element++;
+                }
+            }
+        }
+
+        if (old_element_index != UNSIGNED_UNSET)
+        {
+            mElementSurfaceAreas[old_element_index] += 2.0*num_neighbours_in_old_element - 2.0*DIM;
+        }
+        if (elementIndex != UNSIGNED_UNSET)
+        {
+            mElementSurfaceAreas[elementIndex] += 2.0*DIM - 2.0*num_neighbours_in_new_element;
+        }
+    }
+
+    if (old_element_index != UNSIGNED_UNSET)
+    {
+        mElements[old_element_index]->DeleteNode(mElements[old_element_index]->GetNodeLocalIndex(nodeIndex));
+    }
+    if (elementIndex != UNSIGNED_UNSET)
+    {
+        mElements[elementIndex]->AddNode(p_node);
+    }
+}
+
 template<unsigned DIM>
 std::set<unsigned> PottsMesh<DIM>::GetMooreNeighbouringNodeIndices(unsigned nodeIndex)
 {
-    return mMooreNeighbouringNodeIndices[nodeIndex];
+    PottsNeighbourTable::Range neighbours = GetMooreNeighbours(nodeIndex);
+    return std::set<unsigned>(neighbours.begin(), neighbours.end());
 }
 
 template<unsigned DIM>
 std::set<unsigned> PottsMesh<DIM>::GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex)
 {
-    return mVonNeumannNeighbouringNodeIndices[nodeIndex];
+    PottsNeighbourTable::Range neighbours = GetVonNeumannNeighbours(nodeIndex);
+    return std::set<unsigned>(neighbours.begin(), neighbours.end());
 }
 
 template<unsigned DIM>
 void PottsMesh<DIM>::DeleteElement(unsigned index)
 {
+    mElementSurfaceAreas.clear();
+
     // Mark this element as deleted; this also updates the nodes containing element indices
     this->mElements[index]->MarkAsDeleted();
     mDeletedElementIndices.push_back(index);
@@ -252,6 +350,8 @@ void PottsMesh<DIM>::DeleteElement(unsigned index)
 template<unsigned DIM>
 void PottsMesh<DIM>::RemoveDeletedElements()
 {
+    mElementSurfaceAreas.clear();
+
     // Remove any elements that have been removed and re-order the remaining ones
     unsigned num_deleted_elements = mDeletedElementIndices.size();
 
@@ -271,6 +371,8 @@ void PottsMesh<DIM>::RemoveDeletedElements()
 template<unsigned DIM>
 void PottsMesh<DIM>::DeleteNode(unsigned index)
 {
+    mElementSurfaceAreas.clear();
+
     //Mark node as deleted so we don't consider it when iterating over nodes
     this->mNodes[index]->MarkAsDeleted();
 
@@ -292,36 +394,15 @@ void PottsMesh<DIM>::DeleteNode(unsigned index)
         }
     }
 
-    // Remove from connectivity
-    mVonNeumannNeighbouringNodeIndices[index].clear();
-    mMooreNeighbouringNodeIndices[index].clear();
-
-    assert(mVonNeumannNeighbouringNodeIndices.size()==mMooreNeighbouringNodeIndices.size());
-    for (unsigned node_index = 0;
-         node_index < mVonNeumannNeighbouringNodeIndices.size();
-         node_index++)
-    {
-        // Remove node "index" from the Von Neuman neighbourhood of node "node_index".
-        mVonNeumannNeighbouringNodeIndices[node_index].erase(index);
-        mMooreNeighbouringNodeIndices[node_index].erase(index);
-
-        // Check there's still connectivity for the other non-deleted nodes
-        if (!this->mNodes[node_index]->IsDeleted())
-        {
-            assert(!mVonNeumannNeighbouringNodeIndices[node_index].empty());
-            assert(!mMooreNeighbouringNodeIndices[node_index].empty());
-        }
-    }
-
-    // Remove node from mNodes and renumber all the elements and nodes
+    // Remove node from mNodes, the Moore and Von Neumann neighbourhoods and renumber all the elements and nodes
     delete this->mNodes[index];
     this->mNodes.erase(this->mNodes.begin()+index);
-    unsigned num_nodes = GetNumNodes();
-    mVonNeumannNeighbouringNodeIndices.erase(mVonNeumannNeighbouringNodeIndices.begin()+index);
-    mMooreNeighbouringNodeIndices.erase(mMooreNeighbouringNodeIndices.begin()+index);
+    mVonNeumannNeighbours.RemoveNode(index);
+    mMooreNeighbours.RemoveNode(index);
 
-    assert(mVonNeumannNeighbouringNodeIndices.size()==num_nodes);
-    assert(mMooreNeighbouringNodeIndices.size()==num_nodes);
+    unsigned num_nodes = GetNumNodes();
+    assert(mVonNeumannNeighbours.GetNumNodes()==num_nodes);
+    assert(mMooreNeighbours.GetNumNodes()==num_nodes);
 
     for (unsigned node_index = 0; node_index < num_nodes; node_index++)
     {
@@ -333,37 +414,11 @@ void PottsMesh<DIM>::DeleteNode(unsigned index)
         }
         assert(this->mNodes[node_index]->GetIndex() == node_index);
 
-        // Reduce the index of all nodes greater than  node "index"
-        // in the Moore and Von Neuman neighbourhoods.
-        std::set<unsigned> von_neuman = mVonNeumannNeighbouringNodeIndices[node_index];
-        mVonNeumannNeighbouringNodeIndices[node_index].clear();
-        for (std::set<unsigned>::iterator iter = von_neuman.begin();
-             iter != von_neuman.end();
-             iter++)
-        {
-            if (*iter >= index)
-            {
-                mVonNeumannNeighbouringNodeIndices[node_index].insert(*iter-1);
-            }
-            else
-            {
-                mVonNeumannNeighbouringNodeIndices[node_index].insert(*iter);
-            }
-        }
-        std::set<unsigned> moore = mMooreNeighbouringNodeIndices[node_index];
-        mMooreNeighbouringNodeIndices[node_index].clear();
-        for (std::set<unsigned>::iterator iter = moore.begin();
-             iter != moore.end();
-             iter++)
+        // Check there's still connectivity for the other non-deleted nodes
+        if (!this->mNodes[node_index]->IsDeleted())
         {
-            if (*iter >= index)
-            {
-                mMooreNeighbouringNodeIndices[node_index].insert(*iter-1);
-            }
-            else
-            {
-                mMooreNeighbouringNodeIndices[node_index].insert(*iter);
-            }
+            assert(!GetVonNeumannNeighbours(node_index).empty());
+            assert(!GetMooreNeighbours(node_index).empty());
         }
     }
     // Finally remove any elememts that have been removed
@@ -389,6 +444,8 @@ unsigned PottsMesh<DIM>::DivideElement(PottsElement<DIM>* pElement,
     /// Not implemented in 1d
     assert(DIM==2 || DIM==3); // LCOV_EXCL_LINE
 
+    mElementSurfaceAreas.clear();
+
     // Store the number of nodes in the element (this changes when nodes are deleted from the element)
     unsigned num_nodes = pElement->GetNumNodes();
 
@@ -512,6 +569,8 @@ unsigned PottsMesh<DIM>::DivideElement(PottsElement<DIM>* pElement,
 template<unsigned DIM>
 unsigned PottsMesh<DIM>::AddElement(PottsElement<DIM>* pNewElement)
 {
+    mElementSurfaceAreas.clear();
+
     unsigned new_element_index = pNewElement->GetIndex();
 
     if (new_element_index == this->mElements.size())
@@ -545,10 +604,10 @@ std::set<unsigned> PottsMesh<DIM>::GetNeighbouringElementIndices(unsigned elemen
         // Find the indices of the elements owned by neighbours of this node
 
         // Loop over neighbouring nodes. Only want Von Neuman neighbours (i.e N,S,E,W) as need to share an edge
-        std::set<unsigned> neighbouring_node_indices = GetVonNeumannNeighbouringNodeIndices(p_node->GetIndex());
+        PottsNeighbourTable::Range neighbouring_node_indices = GetVonNeumannNeighbours(p_node->GetIndex());
 
          // Iterate over these neighbouring nodes
-         for (std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
+         for (const unsigned* neighbour_iter = neighbouring_node_indices.begin();
               neighbour_iter != neighbouring_node_indices.end();
               ++neighbour_iter)
          {
@@ -627,13 +686,13 @@ void PottsMesh<DIM>::ConstructFromMeshReader(AbstractMeshReader<DIM, DIM>& rMesh
     }
 
     // If we are just using a mesh reader, then there is no neighbour information (see #1932)
-    if (mVonNeumannNeighbouringNodeIndices.empty())
+    if (mVonNeumannNeighbours.GetNumNodes() == 0)
     {
-        mVonNeumannNeighbouringNodeIndices.resize(num_nodes);
+        mVonNeumannNeighbours.SetNeighbours(std::vector<std::set<unsigned> >(num_nodes));
     }
-    if (mMooreNeighbouringNodeIndices.empty())
+    if (mMooreNeighbours.GetNumNodes() == 0)
     {
-        mMooreNeighbouringNodeIndices.resize(num_nodes);
+        mMooreNeighbours.SetNeighbours(std::vector<std::set<unsigned> >(num_nodes));
     }
 }
 
@@ -55,6 +55,7 @@ class PottsMeshWriter;
 #include "PottsMeshReader.hpp"
 #include "PottsMeshWriter.hpp"
 #include "PottsElement.hpp"
+#include "PottsNeighbourTable.hpp"
 
 /**
  * A Potts-based mesh class, for use in Cellular Potts model simulations.
@@ -74,11 +75,17 @@ protected:
      */
     std::vector<unsigned> mDeletedElementIndices;
 
-    /** Vector of set of Von Neumann neighbours for each node. */
-    std::vector< std::set<unsigned> > mVonNeumannNeighbouringNodeIndices;
+    /** The Von Neumann neighbours of each node. */
+    PottsNeighbourTable mVonNeumannNeighbours;
 
-    /** Vector of set of Moore neighbours for each node. */
-    std::vector< std::set<unsigned> > mMooreNeighbouringNodeIndices;
+    /** The Moore neighbours of each node. */
+    PottsNeighbourTable mMooreNeighbours;
+
+    /**
+     * The surface area of each element, if these are being cached (see CacheElementSurfaceAreas()),
+     * in which case they are updated incrementally by MoveNodeToElement(). Empty otherwise.
+     */
+    std::vector<double> mElementSurfaceAreas;
 
     /**
      * Solve node mapping method. This overridden method is required
@@ -122,8 +129,10 @@ protected:
     {
         // NOTE - Subclasses must archive their member variables BEFORE calling this method.
         archive & mDeletedElementIndices;
-        archive & mVonNeumannNeighbouringNodeIndices;
-        archive & mMooreNeighbouringNodeIndices;
+        std::vector<std::set<unsigned> > von_neumann_neighbouring_node_indices = mVonNeumannNeighbours.GetNeighbourSets();
+        std::vector<std::set<unsigned> > moore_neighbouring_node_indices = mMooreNeighbours.GetNeighbourSets();
+        archive & von_neumann_neighbouring_node_indices;
+        archive & moore_neighbouring_node_indices;
         archive & boost::serialization::base_object<AbstractMesh<DIM, DIM> >(*this);
 
         // Create a mesh writer pointing to the correct file and directory
@@ -144,8 +153,12 @@ protected:
     {
         // NOTE - Subclasses must archive their member variables BEFORE calling this method.
         archive & mDeletedElementIndices;
-        archive & mVonNeumannNeighbouringNodeIndices;
-        archive & mMooreNeighbouringNodeIndices;
+        std::vector<std::set<unsigned> > von_neumann_neighbouring_node_indices;
+        std::vector<std::set<unsigned> > moore_neighbouring_node_indices;
+        archive & von_neumann_neighbouring_node_indices;
+        archive & moore_neighbouring_node_indices;
+        mVonNeumannNeighbours.SetNeighbours(von_neumann_neighbouring_node_indices);
+        mMooreNeighbours.SetNeighbours(moore_neighbouring_node_indices);
         archive & boost::serialization::base_object<AbstractMesh<DIM, DIM> >(*this);
 
         PottsMeshReader<DIM> mesh_reader(ArchiveLocationInfo::GetArchiveDirectory() + ArchiveLocationInfo::GetMeshFilename());
@@ -261,6 +274,7 @@ public:
      * Compute the surface area (or perimeter in 2D) of a PottsElement.
      *
      * This needs to be overridden in daughter classes for non-Euclidean metrics.
+     * If element surface areas are being cached, the cached value is returned.
      *
      * @param index  the global index of a specified PottsElement
      *
@@ -268,9 +282,36 @@ public:
      */
     virtual double GetSurfaceAreaOfElement(unsigned index);
 
+    /**
+     * Compute and cache the surface area of every element, so that subsequent calls to
+     * GetSurfaceAreaOfElement() are O(1). The cache is kept up to date by MoveNodeToElement(),
+     * so while it is in use nodes must only be reassigned between elements using that method.
+     * The cache is cleared by any other change to the elements of the mesh.
+     *
+     * This does nothing in 1D, where surface areas are not defined.
+     */
+    void CacheElementSurfaceAreas();
+
+    /**
+     * Stop caching element surface areas.
+     */
+    void ClearElementSurfaceAreaCache();
+
+    /**
+     * Move a node from the element containing it (if any) to another element (or to the medium),
+     * updating any cached element surface areas in O(1).
+     *
+     * @param nodeIndex the global index of the node
+     * @param elementIndex the global index of the element to move the node to, or UNSIGNED_UNSET
+     *     to move it to the medium
+     */
+    void MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex);
+
     /**
      * Given a node, return a set containing the indices of its Moore neighbouring nodes.
      *
+     * Note that this copies the indices; GetMooreNeighbours() should be preferred in inner loops.
+     *
      * @param nodeIndex global index of the node
      * @return neighbouring node indices in Moore neighbourhood
      */
@@ -279,11 +320,37 @@ public:
     /**
      * Given a node, return a set containing the indices of its Von Neumann neighbouring nodes.
      *
+     * Note that this copies the indices; GetVonNeumannNeighbours() should be preferred in inner loops.
+     *
      * @param nodeIndex global index of the node
      * @return neighbouring node indices in Von Neumann neighbourhood
      */
     std::set<unsigned> GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Given a node, return a view of the indices of its Moore neighbouring nodes, in increasing
+     * order, without copying them. The view is invalidated if a node is deleted.
+     *
+     * @param nodeIndex global index of the node
+     * @return neighbouring node indices in Moore neighbourhood
+     */
+    PottsNeighbourTable::Range GetMooreNeighbours(unsigned nodeIndex) const
+    {
+        return mMooreNeighbours.GetNeighbours(nodeIndex);
+    }
+
+    /**
+     * Given a node, return a view of the indices of its Von Neumann neighbouring nodes, in
+     * increasing order, without copying them. The view is invalidated if a node is deleted.
+     *
+     * @param nodeIndex global index of the node
+     * @return neighbouring node indices in Von Neumann neighbourhood
+     */
+    PottsNeighbourTable::Range GetVonNeumannNeighbours(unsigned nodeIndex) const
+    {
+        return mVonNeumannNeighbours.GetNeighbours(nodeIndex);
+    }
+
     /**
      * Mark a node as deleted. Note that in a Potts mesh this requires the elements and connectivity to be updated accordingley.
      *
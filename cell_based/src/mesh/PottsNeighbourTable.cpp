@@ -0,0 +1,99 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "PottsNeighbourTable.hpp"
+
+#include <cassert>
+
+PottsNeighbourTable::PottsNeighbourTable()
+    : mOffsets(1, 0)
+{
+}
+
+void PottsNeighbourTable::SetNeighbours(const std::vector<std::set<unsigned> >& rNeighbours)
+{
+    mOffsets.assign(1, 0);
+    mOffsets.reserve(rNeighbours.size() + 1);
+    mNeighbours.clear();
+    for (unsigned node_index=0; node_index<rNeighbours.size(); node_index++)
+    {
+        mNeighbours.insert(mNeighbours.end(), rNeighbours[node_index].begin(), rNeighbours[node_index].end());
+        mOffsets.push_back(mNeighbours.size());
+    }
+    mNeighbours.shrink_to_fit();
+}
+
+std::vector<std::set<unsigned> > PottsNeighbourTable::GetNeighbourSets() const
+{
+    std::vector<std::set<unsigned> > neighbours(GetNumNodes());
+    for (unsigned node_index=0; node_index<neighbours.size(); node_index++)
+    {
+        Range range = GetNeighbours(node_index);
+        neighbours[node_index].insert(range.begin(), range.end());
+    }
+    return neighbours;
+}
+
+unsigned PottsNeighbourTable::GetNumNodes() const
+{
+    return mOffsets.size() - 1;
+}
+
+void PottsNeighbourTable::RemoveNode(unsigned nodeIndex)
+{
+    assert(nodeIndex < GetNumNodes());
+
+    // Compact the table in place, since no entry moves forward
+    unsigned num_kept = 0;
+    unsigned old_start = mOffsets[0];
+    for (unsigned node_index=0; node_index<GetNumNodes(); node_index++)
+    {
+        unsigned old_end = mOffsets[node_index + 1];
+        if (node_index != nodeIndex)
+        {
+            for (unsigned i=old_start; i<old_end; i++)
+            {
+                if (mNeighbours[i] != nodeIndex)
+                {
+                    mNeighbours[num_kept++] = (mNeighbours[i] > nodeIndex) ? mNeighbours[i] - 1 : mNeighbours[i];
+                }
+            }
+        }
+        old_start = old_end;
+        mOffsets[node_index + 1] = num_kept;
+    }
+    mOffsets.erase(mOffsets.begin() + nodeIndex + 1);
+    mNeighbours.resize(num_kept);
+}
@@ -0,0 +1,168 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef POTTSNEIGHBOURTABLE_HPP_
+#define POTTSNEIGHBOURTABLE_HPP_
+
+#include <set>
+#include <vector>
+
+/**
+ * A compressed (CSR) table of the neighbours of each node of a PottsMesh.
+ *
+ * The neighbours of every node are stored, in increasing order, in a single
+ * contiguous array, with an array of offsets marking where the neighbours of
+ * each node start. Compared with a std::set per node this uses a small fraction
+ * of the memory, and the neighbours of a node can be iterated over without any
+ * allocation using GetNeighbours().
+ */
+class PottsNeighbourTable
+{
+private:
+
+    /** The offset in mNeighbours of the first neighbour of each node, followed by the total number of neighbours. */
+    std::vector<unsigned> mOffsets;
+
+    /** The neighbours of each node in turn, in increasing order for each node. */
+    std::vector<unsigned> mNeighbours;
+
+public:
+
+    /**
+     * A lightweight view of the neighbours of a node, which may be used in
+     * range-based for loops. It is invalidated by any change to the table.
+     */
+    class Range
+    {
+    private:
+
+        /** Pointer to the first neighbour. */
+        const unsigned* mpBegin;
+
+        /** Pointer to one past the last neighbour. */
+        const unsigned* mpEnd;
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param pBegin pointer to the first neighbour
+         * @param pEnd pointer to one past the last neighbour
+         */
+        Range(const unsigned* pBegin, const unsigned* pEnd)
+            : mpBegin(pBegin),
+              mpEnd(pEnd)
+        {
+        }
+
+        /** @return pointer to the first neighbour. */
+        const unsigned* begin() const
+        {
+            return mpBegin;
+        }
+
+        /** @return pointer to one past the last neighbour. */
+        const unsigned* end() const
+        {
+            return mpEnd;
+        }
+
+        /** @return the number of neighbours. */
+        unsigned size() const
+        {
+            return (unsigned)(mpEnd - mpBegin);
+        }
+
+        /** @return whether there are no neighbours. */
+        bool empty() const
+        {
+            return mpBegin == mpEnd;
+        }
+
+        /**
+         * @return a neighbour.
+         *
+         * @param i the position of the neighbour (in increasing order of index)
+         */
+        unsigned operator[](unsigned i) const
+        {
+            return mpBegin[i];
+        }
+    };
+
+    /**
+     * Default constructor, creating a table with no nodes.
+     */
+    PottsNeighbourTable();
+
+    /**
+     * Set the neighbours of every node.
+     *
+     * @param rNeighbours the set of neighbours of each node
+     */
+    void SetNeighbours(const std::vector<std::set<unsigned> >& rNeighbours);
+
+    /**
+     * @return the set of neighbours of every node (used in archiving).
+     */
+    std::vector<std::set<unsigned> > GetNeighbourSets() const;
+
+    /**
+     * @return the number of nodes in the table.
+     */
+    unsigned GetNumNodes() const;
+
+    /**
+     * @return the neighbours of a node, without copying them.
+     *
+     * @param nodeIndex the index of the node
+     */
+    Range GetNeighbours(unsigned nodeIndex) const
+    {
+        const unsigned* p_neighbours = mNeighbours.data();
+        return Range(p_neighbours + mOffsets[nodeIndex], p_neighbours + mOffsets[nodeIndex + 1]);
+    }
+
+    /**
+     * Remove a node from the table, removing it from the neighbours of all other
+     * nodes and reducing the indices of all nodes with a greater index by one.
+     *
+     * @param nodeIndex the index of the node
+     */
+    void RemoveNode(unsigned nodeIndex);
+};
+
+#endif /*POTTSNEIGHBOURTABLE_HPP_*/
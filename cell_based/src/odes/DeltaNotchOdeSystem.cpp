@@ -77,6 +77,30 @@ void DeltaNotchOdeSystem::EvaluateYDerivatives(double time, const std::vector<do
     rDY[1] = 1.0/(1.0 + 100.0*notch*notch) - delta;                   // d[Delta]/dt
 }
 
+void DeltaNotchOdeSystem::EvaluateYDerivativesBatch(double time,
+                                                    const std::vector<AbstractOdeSystem*>& rSystems,
+                                                    const double* pY,
+                                                    const double* pParameters,
+                                                    double* pDY)
+{
+    const unsigned batch_size = rSystems.size();
+    const double* p_notch = pY;
+    const double* p_delta = pY + batch_size;
+    const double* p_mean_delta = pParameters;
+    double* p_dnotch = pDY;
+    double* p_ddelta = pDY + batch_size;
+
+    for (unsigned i=0; i<batch_size; i++)
+    {
+        double notch = p_notch[i];
+        double delta = p_delta[i];
+        double mean_delta = p_mean_delta[i];
+
+        p_dnotch[i] = mean_delta*mean_delta/(0.01 + mean_delta*mean_delta) - notch;
+        p_ddelta[i] = 1.0/(1.0 + 100.0*notch*notch) - delta;
+    }
+}
+
 template<>
 void CellwiseOdeSystemInformation<DeltaNotchOdeSystem>::Initialise()
 {
@@ -94,6 +94,22 @@ public:
      * @param rDY filled in with the resulting derivatives (using  Collier et al. system of equations).
      */
     void EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY);
+
+    /**
+     * Overridden EvaluateYDerivativesBatch() method, which evaluates the same
+     * equations as EvaluateYDerivatives() in a single loop over the batch.
+     *
+     * @param time used to evaluate the RHS.
+     * @param rSystems the systems in the batch
+     * @param pY values of the state variables of the batch
+     * @param pParameters values of the parameters of the batch
+     * @param pDY filled in with the resulting derivatives of the batch
+     */
+    void EvaluateYDerivativesBatch(double time,
+                                   const std::vector<AbstractOdeSystem*>& rSystems,
+                                   const double* pY,
+                                   const double* pParameters,
+                                   double* pDY);
 };
 
 // Declare identifier for the serializer
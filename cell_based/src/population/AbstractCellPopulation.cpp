@@ -204,8 +204,8 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellMut
         }
     }
 
-    // Reduce results onto all processes
-    if (PetscTools::IsParallel())
+    // Reduce results onto all processes, unless each process already holds every cell
+    if (PetscTools::IsParallel() && !IsReplicatedOnEveryProcess())
     {
         // Make sure the vector on each process has the same size
         unsigned local_size = mutation_state_count.size();
@@ -238,8 +238,8 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellPro
         }
     }
 
-    // Reduce results onto all processes
-    if (PetscTools::IsParallel())
+    // Reduce results onto all processes, unless each process already holds every cell
+    if (PetscTools::IsParallel() && !IsReplicatedOnEveryProcess())
     {
         // Make sure the vector on each process has the same size
         unsigned local_size = proliferative_type_count.size();
@@ -304,8 +304,8 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
         }
     }
 
-    // Reduce results onto all processes
-    if (PetscTools::IsParallel())
+    // Reduce results onto all processes, unless each process already holds every cell
+    if (PetscTools::IsParallel() && !IsReplicatedOnEveryProcess())
     {
         std::vector<unsigned> phase_counts(cell_cycle_phase_count.size(), 0u);
         MPI_Allreduce(&cell_cycle_phase_count[0], &phase_counts[0], phase_counts.size(), MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
@@ -319,15 +319,21 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
+    // If there is no set of cells corresponding to this location index, then no cell is attached
+    if (index >= mLocationCellMap.size())
+    {
+        EXCEPTION("Location index input argument does not correspond to a Cell");
+    }
+
     // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    const std::set<CellPtr>& r_cells = mLocationCellMap[index];
 
     // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
+    if (r_cells.size() == 1)
     {
-        return *(cells.begin());
+        return *(r_cells.begin());
     }
-    if (cells.empty())
+    if (r_cells.empty())
     {
         EXCEPTION("Location index input argument does not correspond to a Cell");
     }
@@ -341,17 +347,18 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<CellPtr> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellsUsingLocationIndex(unsigned index)
 {
     // Return the set of pointers to cells corresponding to this location index, note the set may be empty.
+    if (index >= mLocationCellMap.size())
+    {
+        return std::set<CellPtr>();
+    }
     return mLocationCellMap[index];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
-
     // Return whether there is a cell attached to the location index
-    return !(cells.empty());
+    return (index < mLocationCellMap.size()) && !(mLocationCellMap[index].empty());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -362,6 +369,11 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteDataToVisualizerSetupF
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
+    if (index >= mLocationCellMap.size())
+    {
+        mLocationCellMap.resize(index + 1);
+    }
+
     // Clear the maps
     mLocationCellMap[index].clear();
     mCellLocationMap.erase(pCell.get());
@@ -376,6 +388,10 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(u
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
+    if (index >= mLocationCellMap.size())
+    {
+        mLocationCellMap.resize(index + 1);
+    }
     mLocationCellMap[index].insert(pCell);
     mCellLocationMap[pCell.get()] = index;
 }
@@ -383,6 +399,11 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(u
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
+    if (index >= mLocationCellMap.size())
+    {
+        EXCEPTION("Tried to remove a cell which is not attached to the given location index");
+    }
+
     std::set<CellPtr>::iterator cell_iter = mLocationCellMap[index].find(pCell);
 
     if (cell_iter == mLocationCellMap[index].end())
@@ -410,9 +431,10 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(CellPtr pCell)
 {
     // Check the cell is in the map
-    assert(this->mCellLocationMap.find(pCell.get()) != this->mCellLocationMap.end());
+    std::unordered_map<Cell*, unsigned>::const_iterator iter = mCellLocationMap.find(pCell.get());
+    assert(iter != mCellLocationMap.end());
 
-    return mCellLocationMap[pCell.get()];
+    return iter->second;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -594,14 +616,18 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
                 }
             }
 
-            for (typename std::vector<boost::shared_ptr<AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator pop_writer_iter = mCellPopulationWriters.begin();
-                 pop_writer_iter != mCellPopulationWriters.end();
-                 ++pop_writer_iter)
+            // A replicated population is written once, by the master process
+            if (PetscTools::AmMaster() || !IsReplicatedOnEveryProcess())
             {
-                AcceptPopulationWriter(*pop_writer_iter);
-            }
+                for (typename std::vector<boost::shared_ptr<AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator pop_writer_iter = mCellPopulationWriters.begin();
+                     pop_writer_iter != mCellPopulationWriters.end();
+                     ++pop_writer_iter)
+                {
+                    AcceptPopulationWriter(*pop_writer_iter);
+                }
 
-            AcceptCellWritersAcrossPopulation();
+                AcceptCellWritersAcrossPopulation();
+            }
 
             // The top-most process adds a newline
             if (PetscTools::AmTopMost())
@@ -672,6 +698,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AcceptCellWritersAcrossPopu
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsReplicatedOnEveryProcess()
+{
+    return false;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OutputCellPopulationInfo(out_stream& rParamsFile)
 {
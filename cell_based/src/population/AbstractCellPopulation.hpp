@@ -41,10 +41,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include "ClassIsAbstract.hpp"
 
 #include <boost/serialization/vector.hpp>
@@ -52,6 +54,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -80,17 +83,19 @@ private:
     friend class boost::serialization::access;
 
     /**
-     * Serialize the object and its member variables.
+     * Save the object and its member variables.
+     *
+     * Note that mCellLocationMap is not archived, since it is the inverse of
+     * mLocationCellMap and is reconstructed on loading.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mCells;
         archive & mLocationCellMap;
-        archive & mCellLocationMap;
         archive & mpCellPropertyRegistry;
         archive & mOutputResultsForChasteVisualizer;
         archive & mCellWriters;
@@ -98,6 +103,59 @@ private:
         archive & mCellPopulationCountWriters;
     }
 
+    /**
+     * Load the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mCells;
+        if (version >= 1)
+        {
+            archive & mLocationCellMap;
+        }
+        else
+        {
+            // Archives before version 1 hold both maps as std::maps
+            std::map<unsigned, std::set<CellPtr> > location_cell_map;
+            std::map<Cell*, unsigned> cell_location_map;
+            archive & location_cell_map;
+            archive & cell_location_map;
+
+            mLocationCellMap.clear();
+            for (std::map<unsigned, std::set<CellPtr> >::iterator iter = location_cell_map.begin();
+                 iter != location_cell_map.end();
+                 ++iter)
+            {
+                if (iter->first >= mLocationCellMap.size())
+                {
+                    mLocationCellMap.resize(iter->first + 1);
+                }
+                mLocationCellMap[iter->first] = iter->second;
+            }
+        }
+        archive & mpCellPropertyRegistry;
+        archive & mOutputResultsForChasteVisualizer;
+        archive & mCellWriters;
+        archive & mCellPopulationWriters;
+        archive & mCellPopulationCountWriters;
+
+        mCellLocationMap.clear();
+        for (unsigned index=0; index<mLocationCellMap.size(); index++)
+        {
+            for (std::set<CellPtr>::iterator iter = mLocationCellMap[index].begin();
+                 iter != mLocationCellMap[index].end();
+                 ++iter)
+            {
+                mCellLocationMap[iter->get()] = index;
+            }
+        }
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
     /**
      * Open all files in mCellPopulationWriters and mCellWriters in append mode for writing.
      *
@@ -119,11 +177,15 @@ private:
 
 protected:
 
-    /** Map location (node or VertexElement) indices back to cells. */
-    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
+    /**
+     * Map location (node or VertexElement) indices back to cells. This is a flat vector
+     * indexed by location index, which is grown as required when cells are attached to
+     * locations, so that lookups take constant time.
+     */
+    std::vector<std::set<CellPtr> > mLocationCellMap;
 
-    /** Map cells to location (node or VertexElement) indices. */
-    std::map<Cell*, unsigned> mCellLocationMap;
+    /** Map cells to location (node or VertexElement) indices, using a hash table for constant-time lookups. */
+    std::unordered_map<Cell*, unsigned> mCellLocationMap;
 
     /** Reference to the mesh. */
     AbstractMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
@@ -185,6 +247,16 @@ protected:
      */
     virtual void AcceptCellWritersAcrossPopulation();
 
+    /**
+     * @return whether every process holds a complete copy of the cell population, rather
+     * than only the cells it owns. When this is true, cell counts are not summed across
+     * processes and only the master process writes cell and population data.
+     *
+     * By default the cells are distributed between processes, so this returns false; it is
+     * overridden in populations that are replicated on every process.
+     */
+    virtual bool IsReplicatedOnEveryProcess();
+
 public:
 
     /**
@@ -997,4 +1069,23 @@ typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator AbstractCellPo
     return Iterator(*this, this->mCells.end());
 }
 
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(AbstractCellPopulation, 1)
+ * with a templated class.
+ */
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+struct version<AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 #endif /*ABSTRACTCELLPOPULATION_HPP_*/
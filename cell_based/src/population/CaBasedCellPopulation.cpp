@@ -33,6 +33,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
 #include <boost/scoped_array.hpp>
 
 #include "CaBasedCellPopulation.hpp"
@@ -64,7 +65,10 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
                                                         bool deleteMesh,
                                                         bool validate)
     : AbstractOnLatticeCellPopulation<DIM>(rMesh, rCells, locationIndices, deleteMesh),
-      mLatticeCarryingCapacity(latticeCarryingCapacity)
+      mLatticeCarryingCapacity(latticeCarryingCapacity),
+      mUseKineticMonteCarlo(false),
+      mEventPropensitiesOutOfDate(true),
+      mEventPropensitiesTimeStep(0.0)
 {
     mAvailableSpaces = std::vector<unsigned>(this->GetNumNodes(), latticeCarryingCapacity);
     mpCaBasedDivisionRule.reset(new ExclusionCaBasedDivisionRule<DIM>());
@@ -99,7 +103,10 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
 
 template<unsigned DIM>
 CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh)
-    : AbstractOnLatticeCellPopulation<DIM>(rMesh)
+    : AbstractOnLatticeCellPopulation<DIM>(rMesh),
+      mUseKineticMonteCarlo(false),
+      mEventPropensitiesOutOfDate(true),
+      mEventPropensitiesTimeStep(0.0)
 {
 }
 
@@ -209,6 +216,11 @@ void CaBasedCellPopulation<DIM>::AddCellUsingLocationIndex(unsigned index, CellP
 
     mAvailableSpaces[index]--;
     AbstractCellPopulation<DIM,DIM>::AddCellUsingLocationIndex(index, pCell);
+
+    if (mUseKineticMonteCarlo)
+    {
+        mNodesWithChangedOccupancy.push_back(index);
+    }
 }
 
 template<unsigned DIM>
@@ -219,6 +231,11 @@ void CaBasedCellPopulation<DIM>::RemoveCellUsingLocationIndex(unsigned index, Ce
     mAvailableSpaces[index]++;
 
     assert(mAvailableSpaces[index] <= mLatticeCarryingCapacity);
+
+    if (mUseKineticMonteCarlo)
+    {
+        mNodesWithChangedOccupancy.push_back(index);
+    }
 }
 
 template<unsigned DIM>
@@ -282,6 +299,12 @@ unsigned CaBasedCellPopulation<DIM>::RemoveDeadCells()
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 {
+    if (mUseKineticMonteCarlo)
+    {
+        UpdateCellLocationsUsingKineticMonteCarlo(dt);
+        return;
+    }
+
     /*
      * Here we loop over the nodes and calculate the probability of moving
      * and then select the node to move to.
@@ -451,43 +474,295 @@ void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 
                     if (random_number < probability_of_switch)
                     {
-                        if (is_cell_on_node_index && is_cell_on_neighbour_location_index)
-                        {
-                            // Swap the cells associated with the node and the neighbour node
-                            CellPtr p_cell = this->GetCellUsingLocationIndex(node_index);
-                            CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbour_location_index);
+                        SwitchCellsAtLocations(node_index, neighbour_location_index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::SwitchCellsAtLocations(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    assert(mLatticeCarryingCapacity == 1);
 
-                            // Remove the cells from their current location
-                            RemoveCellUsingLocationIndex(node_index, p_cell);
-                            RemoveCellUsingLocationIndex(neighbour_location_index, p_neighbour_cell);
+    bool is_cell_on_node_index = mAvailableSpaces[nodeIndex] == 0 ? true : false;
+    bool is_cell_on_neighbour_location_index = mAvailableSpaces[neighbourIndex] == 0 ? true : false;
 
-                            // Add cells to their new locations
-                            AddCellUsingLocationIndex(node_index, p_neighbour_cell);
-                            AddCellUsingLocationIndex(neighbour_location_index, p_cell);
-                        }
-                        else if (is_cell_on_node_index && !is_cell_on_neighbour_location_index)
-                        {
-                            // Move the cells associated with the node to the neighbour node
-                            CellPtr p_cell = this->GetCellUsingLocationIndex(node_index);
-                            RemoveCellUsingLocationIndex(node_index, p_cell);
-                            AddCellUsingLocationIndex(neighbour_location_index, p_cell);
-                        }
-                        else if (!is_cell_on_node_index && is_cell_on_neighbour_location_index)
-                        {
-                            // Move the cell associated with the neighbour node onto the node
-                            CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbour_location_index);
-                            RemoveCellUsingLocationIndex(neighbour_location_index, p_neighbour_cell);
-                            AddCellUsingLocationIndex(node_index, p_neighbour_cell);
-                        }
-                        else
-                        {
-                            NEVER_REACHED;
-                        }
+    if (is_cell_on_node_index && is_cell_on_neighbour_location_index)
+    {
+        // Swap the cells associated with the node and the neighbour node
+        CellPtr p_cell = this->GetCellUsingLocationIndex(nodeIndex);
+        CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbourIndex);
+
+        // Remove the cells from their current location
+        RemoveCellUsingLocationIndex(nodeIndex, p_cell);
+        RemoveCellUsingLocationIndex(neighbourIndex, p_neighbour_cell);
+
+        // Add cells to their new locations
+        AddCellUsingLocationIndex(nodeIndex, p_neighbour_cell);
+        AddCellUsingLocationIndex(neighbourIndex, p_cell);
+    }
+    else if (is_cell_on_node_index && !is_cell_on_neighbour_location_index)
+    {
+        // Move the cells associated with the node to the neighbour node
+        CellPtr p_cell = this->GetCellUsingLocationIndex(nodeIndex);
+        RemoveCellUsingLocationIndex(nodeIndex, p_cell);
+        AddCellUsingLocationIndex(neighbourIndex, p_cell);
+    }
+    else if (!is_cell_on_node_index && is_cell_on_neighbour_location_index)
+    {
+        // Move the cell associated with the neighbour node onto the node
+        CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbourIndex);
+        RemoveCellUsingLocationIndex(neighbourIndex, p_neighbour_cell);
+        AddCellUsingLocationIndex(nodeIndex, p_neighbour_cell);
+    }
+    else
+    {
+        NEVER_REACHED;
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::UpdateEventPropensitiesAtNode(unsigned nodeIndex, double dt)
+{
+    PottsNeighbourTable::Range neighbouring_node_indices = rGetMesh().GetMooreNeighbours(nodeIndex);
+    unsigned num_neighbours = neighbouring_node_indices.size();
+    unsigned num_movement_events = mEventOffsets.back();
+    unsigned first_event = mEventOffsets[nodeIndex];
+
+    // Only occupied nodes have movement events
+    std::set<CellPtr> cells_on_node;
+    if (!this->mUpdateRuleCollection.empty() && mAvailableSpaces[nodeIndex] < mLatticeCarryingCapacity)
+    {
+        cells_on_node = this->GetCellsUsingLocationIndex(nodeIndex);
+    }
+
+    for (unsigned neighbour=0; neighbour<num_neighbours; neighbour++)
+    {
+        unsigned neighbour_index = neighbouring_node_indices[neighbour];
+
+        // Sum the rates of each cell on the node moving to this neighbour
+        double movement_rate = 0.0;
+        for (std::set<CellPtr>::iterator cell_iter = cells_on_node.begin();
+             cell_iter != cells_on_node.end();
+             ++cell_iter)
+        {
+            if (IsSiteAvailable(neighbour_index, *cell_iter))
+            {
+                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
+                     iter_rule != this->mUpdateRuleCollection.end();
+                     ++iter_rule)
+                {
+                    // This static cast is fine, since we assert the update rule must be a CA update rule in AddUpdateRule()
+                    movement_rate += (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(nodeIndex, neighbour_index, *this, dt, 1, *cell_iter)/dt;
+                }
+            }
+        }
+        if (movement_rate < 0)
+        {
+            EXCEPTION("The rate of cellular movement is smaller than zero. In order to prevent it from happening you should change your parameters");
+        }
+        mEventPropensities.SetPropensity(first_event + neighbour, movement_rate);
+
+        /*
+         * In the lattice sweep each node is visited once per time step on average and
+         * tests a single randomly chosen neighbour, so the rate of each switching event
+         * is the switching probability divided by the time step and the number of neighbours.
+         */
+        double switching_rate = 0.0;
+        if (mAvailableSpaces[nodeIndex] == 0 || mAvailableSpaces[neighbour_index] == 0)
+        {
+            for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = mSwitchingUpdateRuleCollection.begin();
+                 iter_rule != mSwitchingUpdateRuleCollection.end();
+                 ++iter_rule)
+            {
+                // This static cast is fine, since we assert the update rule must be a CA switching update rule in AddUpdateRule()
+                switching_rate += (boost::static_pointer_cast<AbstractCaSwitchingUpdateRule<DIM> >(*iter_rule))->EvaluateSwitchingProbability(nodeIndex, neighbour_index, *this, dt, 1);
+            }
+            switching_rate /= dt*num_neighbours;
+        }
+        assert(switching_rate >= 0);
+        mEventPropensities.SetPropensity(num_movement_events + first_event + neighbour, switching_rate);
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::UpdateEventPropensitiesNearNodes(std::vector<unsigned>& rNodeIndices, double dt)
+{
+    PottsMesh<DIM>& r_mesh = rGetMesh();
+    unsigned num_changed_nodes = rNodeIndices.size();
+    for (unsigned i=0; i<num_changed_nodes; i++)
+    {
+        PottsNeighbourTable::Range neighbouring_node_indices = r_mesh.GetMooreNeighbours(rNodeIndices[i]);
+        rNodeIndices.insert(rNodeIndices.end(), neighbouring_node_indices.begin(), neighbouring_node_indices.end());
+    }
+    std::sort(rNodeIndices.begin(), rNodeIndices.end());
+    rNodeIndices.erase(std::unique(rNodeIndices.begin(), rNodeIndices.end()), rNodeIndices.end());
+
+    for (unsigned i=0; i<rNodeIndices.size(); i++)
+    {
+        UpdateEventPropensitiesAtNode(rNodeIndices[i], dt);
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::UpdateCellLocationsUsingKineticMonteCarlo(double dt)
+{
+    if (this->mUpdateRuleCollection.empty() && mSwitchingUpdateRuleCollection.empty())
+    {
+        mNodesWithChangedOccupancy.clear();
+        return;
+    }
+
+    // Switching currently only works for latticeCarryingCapacity = 1
+    assert(mSwitchingUpdateRuleCollection.empty() || mLatticeCarryingCapacity == 1);
+
+    PottsMesh<DIM>& r_mesh = rGetMesh();
+    unsigned num_nodes = r_mesh.GetNumNodes();
+
+    if (mEventOffsets.size() != num_nodes + 1 || dt != mEventPropensitiesTimeStep)
+    {
+        mEventPropensitiesOutOfDate = true;
+    }
+
+    if (mEventPropensitiesOutOfDate)
+    {
+        // Lay out one movement and one switching event per Moore neighbour of each node
+        mEventOffsets.assign(1, 0);
+        mEventOffsets.reserve(num_nodes + 1);
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            mEventOffsets.push_back(mEventOffsets.back() + r_mesh.GetMooreNeighbours(node_index).size());
+        }
+        mEventPropensities.Resize(2*mEventOffsets.back());
+
+        /*
+         * Compute the propensities of all events that may be non-zero: those originating
+         * from occupied nodes and, if there are switching update rules, from their neighbours.
+         */
+        std::vector<bool> is_event_source(num_nodes, false);
+        for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = this->Begin();
+             cell_iter != this->End();
+             ++cell_iter)
+        {
+            unsigned node_index = this->GetLocationIndexUsingCell(*cell_iter);
+            is_event_source[node_index] = true;
+
+            if (!mSwitchingUpdateRuleCollection.empty())
+            {
+                PottsNeighbourTable::Range neighbouring_node_indices = r_mesh.GetMooreNeighbours(node_index);
+                for (const unsigned* iter = neighbouring_node_indices.begin();
+                     iter != neighbouring_node_indices.end();
+                     ++iter)
+                {
+                    is_event_source[*iter] = true;
+                }
+            }
+        }
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            if (is_event_source[node_index])
+            {
+                UpdateEventPropensitiesAtNode(node_index, dt);
+            }
+        }
+
+        mEventPropensitiesOutOfDate = false;
+        mEventPropensitiesTimeStep = dt;
+    }
+    else if (!mNodesWithChangedOccupancy.empty())
+    {
+        // Cells added or removed since the last time step only affect events near their nodes
+        UpdateEventPropensitiesNearNodes(mNodesWithChangedOccupancy, dt);
+    }
+    mNodesWithChangedOccupancy.clear();
+    unsigned num_movement_events = mEventOffsets.back();
+
+    // Perform events until the end of the time step is reached
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    std::vector<unsigned> affected_nodes;
+    double time = 0.0;
+    while (mEventPropensities.GetTotalPropensity() > 0.0)
+    {
+        double total_propensity = mEventPropensities.GetTotalPropensity();
+
+        // Waiting times are memoryless, so the overshoot past the end of the time step may be discarded
+        time += p_gen->ExponentialRandomDeviate(total_propensity);
+        if (time > dt)
+        {
+            break;
+        }
+
+        // Sample the next event and identify the pair of nodes involved
+        unsigned event_index = mEventPropensities.SampleEvent(total_propensity*p_gen->ranf());
+        bool is_switching_event = (event_index >= num_movement_events);
+        if (is_switching_event)
+        {
+            event_index -= num_movement_events;
+        }
+
+        unsigned node_index = (std::upper_bound(mEventOffsets.begin(), mEventOffsets.end(), event_index) - mEventOffsets.begin()) - 1;
+        unsigned neighbour_index = r_mesh.GetMooreNeighbours(node_index)[event_index - mEventOffsets[node_index]];
+
+        if (is_switching_event)
+        {
+            SwitchCellsAtLocations(node_index, neighbour_index);
+        }
+        else
+        {
+            // If there is more than one cell on the node, choose which one moves according to its rate
+            std::set<CellPtr> cells_on_node = this->GetCellsUsingLocationIndex(node_index);
+            assert(!cells_on_node.empty());
+
+            CellPtr p_moving_cell = *(cells_on_node.begin());
+            if (cells_on_node.size() > 1)
+            {
+                std::vector<double> cell_rates;
+                double total_rate = 0.0;
+                for (std::set<CellPtr>::iterator cell_iter = cells_on_node.begin();
+                     cell_iter != cells_on_node.end();
+                     ++cell_iter)
+                {
+                    double rate = 0.0;
+                    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
+                         iter_rule != this->mUpdateRuleCollection.end();
+                         ++iter_rule)
+                    {
+                        rate += (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(node_index, neighbour_index, *this, dt, 1, *cell_iter)/dt;
+                    }
+                    cell_rates.push_back(rate);
+                    total_rate += rate;
+                }
+
+                double random_rate = total_rate*p_gen->ranf();
+                double cumulative_rate = 0.0;
+                unsigned counter = 0;
+                for (std::set<CellPtr>::iterator cell_iter = cells_on_node.begin();
+                     cell_iter != cells_on_node.end();
+                     ++cell_iter, ++counter)
+                {
+                    cumulative_rate += cell_rates[counter];
+                    p_moving_cell = *cell_iter;
+                    if (cumulative_rate > random_rate)
+                    {
+                        break;
                     }
                 }
             }
+
+            this->MoveCellInLocationMap(p_moving_cell, node_index, neighbour_index);
         }
+
+        // Only events originating from the two nodes and their neighbours can be affected
+        affected_nodes.assign(1, node_index);
+        affected_nodes.push_back(neighbour_index);
+        UpdateEventPropensitiesNearNodes(affected_nodes, dt);
     }
+
+    // The propensities are up to date with every change made during this time step
+    mNodesWithChangedOccupancy.clear();
 }
 
 template<unsigned DIM>
@@ -562,6 +837,7 @@ void CaBasedCellPopulation<DIM>::AddUpdateRule(boost::shared_ptr<AbstractUpdateR
     {
         mSwitchingUpdateRuleCollection.push_back(pUpdateRule);
     }
+    mEventPropensitiesOutOfDate = true;
 }
 
 template<unsigned DIM>
@@ -572,6 +848,7 @@ void CaBasedCellPopulation<DIM>::RemoveAllUpdateRules()
 
     // Clear mUpdateRuleCollection
     AbstractOnLatticeCellPopulation<DIM>::RemoveAllUpdateRules();
+    mEventPropensitiesOutOfDate = true;
 }
 
 template<unsigned DIM>
@@ -603,6 +880,26 @@ void CaBasedCellPopulation<DIM>::SetCaBasedDivisionRule(boost::shared_ptr<Abstra
     mpCaBasedDivisionRule = pCaBasedDivisionRule;
 }
 
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::SetUseKineticMonteCarlo(bool useKineticMonteCarlo)
+{
+    mUseKineticMonteCarlo = useKineticMonteCarlo;
+    mEventPropensitiesOutOfDate = true;
+    mNodesWithChangedOccupancy.clear();
+}
+
+template<unsigned DIM>
+bool CaBasedCellPopulation<DIM>::GetUseKineticMonteCarlo()
+{
+    return mUseKineticMonteCarlo;
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::MarkEventPropensitiesOutOfDate()
+{
+    mEventPropensitiesOutOfDate = true;
+}
+
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& rParamsFile)
 {
@@ -610,6 +907,7 @@ void CaBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& rPar
     *rParamsFile << "\t\t<CaBasedDivisionRule>\n";
     mpCaBasedDivisionRule->OutputCellCaBasedDivisionRuleInfo(rParamsFile);
     *rParamsFile << "\t\t</CaBasedDivisionRule>\n";
+    *rParamsFile << "\t\t<UseKineticMonteCarlo>" << mUseKineticMonteCarlo << "</UseKineticMonteCarlo>\n";
 
     // Call method on direct parent class
     AbstractOnLatticeCellPopulation<DIM>::OutputCellPopulationParameters(rParamsFile);
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOnLatticeCellPopulation.hpp"
 #include "PottsMesh.hpp"
+#include "PropensitySumTree.hpp"
 #include "VertexMesh.hpp"
 #include "AbstractUpdateRule.hpp"
 #include "AbstractCaBasedDivisionRule.hpp"
@@ -83,6 +84,43 @@ private:
      * This is a specialisation for CA models. */
     boost::shared_ptr<AbstractCaBasedDivisionRule<DIM> > mpCaBasedDivisionRule;
 
+    /**
+     * Whether to update cell locations using an event-driven kinetic Monte Carlo
+     * (Gillespie-type) scheme rather than sweeping over the lattice each time step.
+     * Defaults to false.
+     */
+    bool mUseKineticMonteCarlo;
+
+    /**
+     * The propensities of all candidate events when mUseKineticMonteCarlo is true.
+     * For each node there is one movement event and one switching event per Moore
+     * neighbour: movement events occupy the first mEventOffsets.back() entries, and
+     * switching events the remainder, in the same order.
+     */
+    PropensitySumTree mEventPropensities;
+
+    /**
+     * The index of the first event associated with each node, followed by the
+     * total number of movement events. Computed from the Moore neighbourhoods
+     * of the mesh.
+     */
+    std::vector<unsigned> mEventOffsets;
+
+    /**
+     * Whether every event propensity must be recomputed at the start of the next kinetic
+     * Monte Carlo time step, rather than only those near nodes whose occupancy has changed.
+     */
+    bool mEventPropensitiesOutOfDate;
+
+    /** The time step for which the event propensities were last computed. */
+    double mEventPropensitiesTimeStep;
+
+    /**
+     * The nodes at which a cell has been added or removed since the event propensities
+     * were last brought up to date (only recorded when mUseKineticMonteCarlo is true).
+     */
+    std::vector<unsigned> mNodesWithChangedOccupancy;
+
     /**
      * Set the empty sites by taking in a set of which nodes indices are empty sites.
      *
@@ -90,6 +128,54 @@ private:
      */
     void SetEmptySites(const std::set<unsigned>& rEmptySiteIndices);
 
+    /**
+     * Move, swap or exchange the cells associated with two neighbouring nodes, as
+     * specified by the switching update rules. At least one of the nodes must be
+     * occupied. Note this currently only works for a carrying capacity of 1.
+     *
+     * @param nodeIndex the index of a node
+     * @param neighbourIndex the index of a neighbouring node
+     */
+    void SwitchCellsAtLocations(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * Recompute the propensities of all movement and switching events originating
+     * from a given node, for use with the kinetic Monte Carlo scheme. The rate of
+     * each event is the probability returned by the relevant update rules over a
+     * time step, divided by the time step.
+     *
+     * @param nodeIndex the index of the node
+     * @param dt the time step
+     */
+    void UpdateEventPropensitiesAtNode(unsigned nodeIndex, double dt);
+
+    /**
+     * Recompute the propensities of all events originating from some nodes and their
+     * Moore neighbours, which are all the events affected by a change in occupancy of
+     * these nodes. Each node is only updated once.
+     *
+     * @param rNodeIndices the indices of the nodes (sorted and extended with their neighbours on return)
+     * @param dt the time step
+     */
+    void UpdateEventPropensitiesNearNodes(std::vector<unsigned>& rNodeIndices, double dt);
+
+    /**
+     * Update cell locations over a time step using the kinetic Monte Carlo scheme.
+     *
+     * Events are sampled with probability proportional to their propensities, with
+     * exponentially distributed waiting times, until the end of the time step is
+     * reached. After each event only the propensities of events originating from
+     * the two nodes involved and their Moore neighbours are recomputed, so update
+     * rules are assumed to depend only on the occupancy of sites within this
+     * neighbourhood. At the start of each time step the same is done around nodes
+     * where cells have been added or removed since the last (e.g. by division or
+     * death). All propensities are only recomputed on the first time step, when the
+     * time step or update rules change, or after MarkEventPropensitiesOutOfDate().
+     *
+     * @param dt the time step
+     */
+    void UpdateCellLocationsUsingKineticMonteCarlo(double dt);
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -110,6 +196,7 @@ private:
         archive & mLatticeCarryingCapacity;
         archive & mAvailableSpaces;
         archive & mpCaBasedDivisionRule;
+        archive & mUseKineticMonteCarlo;
     }
 
     /**
@@ -314,6 +401,8 @@ public:
     /**
      * Overridden UpdateCellLocations() method.
      *
+     * If mUseKineticMonteCarlo is true, calls UpdateCellLocationsUsingKineticMonteCarlo().
+     *
      * @param dt time step
      */
     void UpdateCellLocations(double dt);
@@ -421,6 +510,25 @@ public:
      */
     void SetCaBasedDivisionRule(boost::shared_ptr<AbstractCaBasedDivisionRule<DIM> > pCaBasedDivisionRule);
 
+    /**
+     * Set mUseKineticMonteCarlo.
+     *
+     * @param useKineticMonteCarlo whether to update cell locations using the kinetic Monte Carlo scheme
+     */
+    void SetUseKineticMonteCarlo(bool useKineticMonteCarlo);
+
+    /**
+     * @return mUseKineticMonteCarlo
+     */
+    bool GetUseKineticMonteCarlo();
+
+    /**
+     * Make the kinetic Monte Carlo scheme recompute the propensities of all events at the
+     * start of the next time step. This is needed if the update rules depend on cell
+     * properties that have changed other than by cells moving, dividing or dying.
+     */
+    void MarkEventPropensitiesOutOfDate();
+
     /**
      * Overridden AddUpdateRule() method.
      *
@@ -328,7 +328,8 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
         UpdateGhostNodesAfterReMesh(node_map);
 
         // Update the mappings between cells and location indices
-        std::map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_cell_location_map;
+        old_cell_location_map.swap(this->mCellLocationMap);
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
         this->mLocationCellMap.clear();
@@ -200,7 +200,8 @@ void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
 
         // Update the mappings between cells and location indices
         ///\todo we want to make mCellLocationMap private - we need to find a better way of doing this
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_map;
+        old_map.swap(this->mCellLocationMap);
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
         this->mLocationCellMap.clear();
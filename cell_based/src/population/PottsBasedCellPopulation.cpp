@@ -34,6 +34,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "PottsBasedCellPopulation.hpp"
+
+#include <climits>
+#include <cstdint>
+
 #include "RandomNumberGenerator.hpp"
 #include "AbstractPottsUpdateRule.hpp"
 #include "NodesOnlyMesh.hpp"
@@ -81,7 +85,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh,
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweeps(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
     // Check each element has only one cell associated with it
@@ -97,7 +102,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh)
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweeps(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
 }
@@ -260,92 +266,228 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         p_gen->Shuffle(this->mUpdateRuleCollection);
     }
 
-    for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
-    {
-        unsigned node_index;
+    // Cache the element surface areas, which are then updated in O(1) as each node is switched
+    mpPottsMesh->CacheElementSurfaceAreas();
 
-        if (this->mUpdateNodesInRandomOrder)
+    if (mUseCheckerboardSweeps)
+    {
+        for (unsigned sweep=0; sweep<mNumSweepsPerTimestep; sweep++)
         {
-            node_index = p_gen->randMod(num_nodes);
+            PerformCheckerboardSweep();
         }
-        else
+    }
+    else
+    {
+        for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
         {
-            // Loop over nodes in index order.
-            node_index = i%num_nodes;
-        }
+            unsigned node_index;
 
-        Node<DIM>* p_node = this->mrMesh.GetNode(node_index);
+            if (this->mUpdateNodesInRandomOrder)
+            {
+                node_index = p_gen->randMod(num_nodes);
+            }
+            else
+            {
+                // Loop over nodes in index order.
+                node_index = i%num_nodes;
+            }
 
-        // Each node in the mesh must be in at most one element
-        assert(p_node->GetNumContainingElements() <= 1);
+            Node<DIM>* p_node = this->mrMesh.GetNode(node_index);
 
-        // Find a random available neighbouring node to overwrite current site
-        std::set<unsigned> neighbouring_node_indices = mpPottsMesh->GetMooreNeighbouringNodeIndices(node_index);
-        unsigned neighbour_location_index;
+            // Each node in the mesh must be in at most one element
+            assert(p_node->GetNumContainingElements() <= 1);
 
-        if (!neighbouring_node_indices.empty())
-        {
-            unsigned num_neighbours = neighbouring_node_indices.size();
-            unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
+            // Find a random available neighbouring node to overwrite current site
+            PottsNeighbourTable::Range neighbouring_node_indices = mpPottsMesh->GetMooreNeighbours(node_index);
+            unsigned neighbour_location_index;
 
-            std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-            for (unsigned j=0; j<chosen_neighbour; j++)
+            if (!neighbouring_node_indices.empty())
             {
-                neighbour_iter++;
-            }
-
-            neighbour_location_index = *neighbour_iter;
+                unsigned num_neighbours = neighbouring_node_indices.size();
+                unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
 
-            std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
-            std::set<unsigned> neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
-            // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
-            if ((!containing_elements.empty() && neighbour_containing_elements.empty())
-                || (containing_elements.empty() && !neighbour_containing_elements.empty())
-                || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
-            {
-                double delta_H = 0.0; // This is H_1-H_0.
+                neighbour_location_index = neighbouring_node_indices[chosen_neighbour];
 
-                // Now add contributions to the Hamiltonian from each AbstractPottsUpdateRule
-                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
-                     iter != this->mUpdateRuleCollection.end();
-                     ++iter)
+                const std::set<unsigned>& containing_elements = p_node->rGetContainingElementIndices();
+                const std::set<unsigned>& neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
+                // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
+                if ((!containing_elements.empty() && neighbour_containing_elements.empty())
+                    || (containing_elements.empty() && !neighbour_containing_elements.empty())
+                    || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
                 {
-                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
-                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, p_node->GetIndex(), *this);
-                    delta_H += dH;
-                }
-
-                // Generate a uniform random number to do the random motion
-                double random_number = p_gen->ranf();
+                    double delta_H = EvaluateHamiltonianChange(neighbour_location_index, node_index); // This is H_1-H_0.
 
-                double p = exp(-delta_H/mTemperature);
-                if (delta_H <= 0 || random_number < p)
-                {
-                    // Do swap
+                    // Generate a uniform random number to do the random motion
+                    double random_number = p_gen->ranf();
 
-                    // Remove the current node from any elements containing it (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = containing_elements.begin();
-                         iter != containing_elements.end();
-                         ++iter)
+                    double p = exp(-delta_H/mTemperature);
+                    if (delta_H <= 0 || random_number < p)
                     {
-                        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(node_index));
+                        // Do swap, moving the current node to the element containing the neighbouring node (if any)
+                        unsigned new_element_index = neighbour_containing_elements.empty() ? UNSIGNED_UNSET : *neighbour_containing_elements.begin();
+                        mpPottsMesh->MoveNodeToElement(node_index, new_element_index);
 
                         ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
                     }
+                }
+            }
+        }
+    }
 
-                    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
-                         iter != neighbour_containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->AddNode(this->mrMesh.GetNode(node_index));
-                    }
+    mpPottsMesh->ClearElementSurfaceAreaCache();
+}
+
+template<unsigned DIM>
+double PottsBasedCellPopulation<DIM>::EvaluateHamiltonianChange(unsigned currentNodeIndex, unsigned targetNodeIndex)
+{
+    double delta_H = 0.0;
+
+    // Add contributions to the Hamiltonian from each AbstractPottsUpdateRule
+    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+         iter != this->mUpdateRuleCollection.end();
+         ++iter)
+    {
+        // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+        double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(currentNodeIndex, targetNodeIndex, *this);
+        delta_H += dH;
+    }
+
+    return delta_H;
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::ComputeSublattices()
+{
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+    std::vector<unsigned> node_colours(num_nodes, UNSIGNED_UNSET);
+
+    mSublattices.clear();
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        // Find the colours already used by the Moore neighbours of this node
+        std::vector<bool> is_colour_used(mSublattices.size() + 1, false);
+        PottsNeighbourTable::Range neighbouring_node_indices = mpPottsMesh->GetMooreNeighbours(node_index);
+        for (const unsigned* iter = neighbouring_node_indices.begin();
+             iter != neighbouring_node_indices.end();
+             ++iter)
+        {
+            if (node_colours[*iter] != UNSIGNED_UNSET)
+            {
+                is_colour_used[node_colours[*iter]] = true;
+            }
+        }
+
+        // Use the first unused colour, adding a sublattice if necessary
+        unsigned colour = 0;
+        while (is_colour_used[colour])
+        {
+            colour++;
+        }
+        if (colour == mSublattices.size())
+        {
+            mSublattices.push_back(std::vector<unsigned>());
+        }
+        node_colours[node_index] = colour;
+        mSublattices[colour].push_back(node_index);
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::PerformCheckerboardSweep()
+{
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+
+    unsigned num_sublattice_nodes = 0;
+    for (unsigned i=0; i<mSublattices.size(); i++)
+    {
+        num_sublattice_nodes += mSublattices[i].size();
+    }
+    if (num_sublattice_nodes != this->mrMesh.GetNumNodes())
+    {
+        ComputeSublattices();
+    }
+
+    // Visit the sublattices in a random order if specified
+    std::vector<unsigned> sublattice_order(mSublattices.size());
+    if (this->mUpdateNodesInRandomOrder)
+    {
+        p_gen->Shuffle(mSublattices.size(), sublattice_order);
+    }
+    else
+    {
+        for (unsigned i=0; i<sublattice_order.size(); i++)
+        {
+            sublattice_order[i] = i;
+        }
+    }
+
+    for (unsigned i=0; i<sublattice_order.size(); i++)
+    {
+        const std::vector<unsigned>& r_sublattice = mSublattices[sublattice_order[i]];
+        unsigned seed = p_gen->randMod(UINT_MAX);
+
+        /*
+         * Decide whether to switch each node of the sublattice. These updates only read the
+         * configuration, so may be evaluated concurrently; we record the neighbour chosen by
+         * each accepted update, which is not in this sublattice and so is unaffected by the others.
+         */
+        std::vector<unsigned> accepted_neighbour_indices(r_sublattice.size(), UNSIGNED_UNSET);
+
+#ifdef CHASTE_OPENMP
+        #pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+        for (int local_index=0; local_index<(int)r_sublattice.size(); local_index++)
+        {
+            unsigned node_index = r_sublattice[local_index];
+
+            PottsNeighbourTable::Range neighbouring_node_indices = mpPottsMesh->GetMooreNeighbours(node_index);
+            if (neighbouring_node_indices.empty())
+            {
+                continue;
+            }
+
+            // Find a random neighbouring node to overwrite the current site
+            unsigned chosen_neighbour = (unsigned)(GetCounterBasedRandomNumber(seed, 2*node_index)*neighbouring_node_indices.size());
+            unsigned neighbour_location_index = neighbouring_node_indices[chosen_neighbour];
+
+            // Only calculate Hamiltonian if the nodes are from different elements, or one is from the medium
+            const std::set<unsigned>& r_containing_elements = this->mrMesh.GetNode(node_index)->rGetContainingElementIndices();
+            const std::set<unsigned>& r_neighbour_containing_elements = this->mrMesh.GetNode(neighbour_location_index)->rGetContainingElementIndices();
+            if (r_containing_elements != r_neighbour_containing_elements)
+            {
+                double delta_H = EvaluateHamiltonianChange(neighbour_location_index, node_index);
+                if (delta_H <= 0 || GetCounterBasedRandomNumber(seed, 2*node_index + 1) < exp(-delta_H/mTemperature))
+                {
+                    accepted_neighbour_indices[local_index] = neighbour_location_index;
                 }
             }
         }
+
+        // Apply the accepted switches
+        for (unsigned local_index=0; local_index<r_sublattice.size(); local_index++)
+        {
+            if (accepted_neighbour_indices[local_index] != UNSIGNED_UNSET)
+            {
+                const std::set<unsigned>& r_neighbour_containing_elements = this->mrMesh.GetNode(accepted_neighbour_indices[local_index])->rGetContainingElementIndices();
+                unsigned new_element_index = r_neighbour_containing_elements.empty() ? UNSIGNED_UNSET : *r_neighbour_containing_elements.begin();
+                mpPottsMesh->MoveNodeToElement(r_sublattice[local_index], new_element_index);
+            }
+        }
     }
 }
 
+template<unsigned DIM>
+double PottsBasedCellPopulation<DIM>::GetCounterBasedRandomNumber(unsigned seed, unsigned counter)
+{
+    // Apply the SplitMix64 finaliser to the seed and counter, and use the top 53 bits
+    uint64_t z = ((uint64_t)seed << 32) + counter + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+
+    return (z >> 11)*(1.0/9007199254740992.0);
+}
+
 template<unsigned DIM>
 bool PottsBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPtr pCell)
 {
@@ -480,6 +622,7 @@ void PottsBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& r
 {
     *rParamsFile << "\t\t<Temperature>" << mTemperature << "</Temperature>\n";
     *rParamsFile << "\t\t<NumSweepsPerTimestep>" << mNumSweepsPerTimestep << "</NumSweepsPerTimestep>\n";
+    *rParamsFile << "\t\t<UseCheckerboardSweeps>" << mUseCheckerboardSweeps << "</UseCheckerboardSweeps>\n";
 
     // Call method on direct parent class
     AbstractOnLatticeCellPopulation<DIM>::OutputCellPopulationParameters(rParamsFile);
@@ -509,6 +652,18 @@ unsigned PottsBasedCellPopulation<DIM>::GetNumSweepsPerTimestep()
     return mNumSweepsPerTimestep;
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUseCheckerboardSweeps(bool useCheckerboardSweeps)
+{
+    mUseCheckerboardSweeps = useCheckerboardSweeps;
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::GetUseCheckerboardSweeps()
+{
+    return mUseCheckerboardSweeps;
+}
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirectory)
 {
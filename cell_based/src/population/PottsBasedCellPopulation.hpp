@@ -91,6 +91,19 @@ private:
      */
     unsigned mNumSweepsPerTimestep;
 
+    /**
+     * Whether to perform each Monte Carlo sweep as a sequence of sublattice (checkerboard) sweeps,
+     * in which the nodes of each sublattice are updated concurrently (see UpdateCellLocations()).
+     * Initialised to false in the constructor.
+     */
+    bool mUseCheckerboardSweeps;
+
+    /**
+     * The sublattices used when mUseCheckerboardSweeps is true, such that no two nodes of a
+     * sublattice are Moore neighbours. Computed on first use by ComputeSublattices().
+     */
+    std::vector<std::vector<unsigned> > mSublattices;
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -117,8 +130,44 @@ private:
 
         archive & mTemperature;
         archive & mNumSweepsPerTimestep;
+        archive & mUseCheckerboardSweeps;
     }
 
+    /**
+     * Compute mSublattices by greedily colouring the nodes of the mesh in index order so that no
+     * two Moore neighbours share a colour. On a regular lattice this gives the usual checkerboard
+     * decomposition into 2^DIM sublattices.
+     */
+    void ComputeSublattices();
+
+    /**
+     * Helper method for UpdateCellLocations() that sums the contributions to the change in the
+     * Hamiltonian from each update rule, were the target node to be added to the element
+     * containing the current node.
+     *
+     * @param currentNodeIndex the index of the current node
+     * @param targetNodeIndex the index of the target node
+     * @return the change in the Hamiltonian
+     */
+    double EvaluateHamiltonianChange(unsigned currentNodeIndex, unsigned targetNodeIndex);
+
+    /**
+     * Helper method for UpdateCellLocations() that performs a single Monte Carlo sweep of the
+     * mesh as a sequence of sublattice sweeps.
+     */
+    void PerformCheckerboardSweep();
+
+    /**
+     * Helper method for PerformCheckerboardSweep() that generates a reproducible uniform random
+     * number in [0,1) from a seed and a counter, so that the random numbers used for each node are
+     * independent of how the nodes are distributed over threads.
+     *
+     * @param seed the seed, drawn once per sublattice sweep
+     * @param counter the counter (for example, the node index)
+     * @return a uniform random number in [0,1)
+     */
+    static double GetCounterBasedRandomNumber(unsigned seed, unsigned counter);
+
     /**
      * Check the consistency of internal data structures.
      * Each PottsElement must have a CellPtr associated with it.
@@ -272,6 +321,16 @@ public:
     /**
      * Overridden UpdateCellLocations() method.
      *
+     * Performs mNumSweepsPerTimestep Monte Carlo sweeps of the mesh. By default each sweep
+     * consists of GetNumNodes() serial Metropolis updates. If mUseCheckerboardSweeps is true,
+     * each sweep instead visits every node once, one sublattice at a time, evaluating the updates
+     * of the nodes of each sublattice concurrently (when Chaste is built with OpenMP) and then
+     * applying those that are accepted. Since no two nodes of a sublattice are Moore neighbours,
+     * these updates do not interact locally, although the volumes and surface areas of the
+     * elements seen by each update are those at the start of the sublattice sweep. Update
+     * rules must therefore not modify the cell population when evaluating their contribution
+     * to the Hamiltonian.
+     *
      * @param dt time step
      */
     void UpdateCellLocations(double dt);
@@ -386,6 +445,19 @@ public:
      */
     unsigned GetNumSweepsPerTimestep();
 
+    /**
+     * Set mUseCheckerboardSweeps.
+     *
+     * @param useCheckerboardSweeps whether to perform each Monte Carlo sweep as a sequence of
+     *     sublattice sweeps, whose nodes may be updated concurrently
+     */
+    void SetUseCheckerboardSweeps(bool useCheckerboardSweeps);
+
+    /**
+     * @return mUseCheckerboardSweeps
+     */
+    bool GetUseCheckerboardSweeps();
+
     /**
      * Create a Element tessellation of the mesh for use in visualising the mesh.
      */
@@ -0,0 +1,120 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "PropensitySumTree.hpp"
+#include <cassert>
+
+PropensitySumTree::PropensitySumTree()
+    : mNumEvents(0),
+      mNumLeaves(1),
+      mSums(2, 0.0)
+{
+}
+
+void PropensitySumTree::Resize(unsigned numEvents)
+{
+    mNumEvents = numEvents;
+    mNumLeaves = 1;
+    while (mNumLeaves < numEvents)
+    {
+        mNumLeaves *= 2;
+    }
+    mSums.assign(2*mNumLeaves, 0.0);
+}
+
+void PropensitySumTree::Clear()
+{
+    mSums.assign(mSums.size(), 0.0);
+}
+
+unsigned PropensitySumTree::GetNumEvents() const
+{
+    return mNumEvents;
+}
+
+void PropensitySumTree::SetPropensity(unsigned eventIndex, double propensity)
+{
+    assert(eventIndex < mNumEvents);
+    assert(propensity >= 0.0);
+
+    unsigned position = mNumLeaves + eventIndex;
+    mSums[position] = propensity;
+
+    // Recompute the partial sums on the path to the root
+    for (position /= 2; position > 0; position /= 2)
+    {
+        mSums[position] = mSums[2*position] + mSums[2*position + 1];
+    }
+}
+
+double PropensitySumTree::GetPropensity(unsigned eventIndex) const
+{
+    assert(eventIndex < mNumEvents);
+    return mSums[mNumLeaves + eventIndex];
+}
+
+double PropensitySumTree::GetTotalPropensity() const
+{
+    return mSums[1];
+}
+
+unsigned PropensitySumTree::SampleEvent(double target) const
+{
+    assert(mSums[1] > 0.0);
+
+    unsigned position = 1;
+    while (position < mNumLeaves)
+    {
+        unsigned left_child = 2*position;
+
+        /*
+         * Descend to the right only if the target lies beyond the left subtree and
+         * the right subtree has a non-zero total; the second test guards against
+         * round-off placing the target just past the end of the last event.
+         */
+        if (target >= mSums[left_child] && mSums[left_child + 1] > 0.0)
+        {
+            target -= mSums[left_child];
+            position = left_child + 1;
+        }
+        else
+        {
+            position = left_child;
+        }
+    }
+
+    assert(position - mNumLeaves < mNumEvents);
+    return position - mNumLeaves;
+}
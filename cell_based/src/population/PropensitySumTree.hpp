@@ -0,0 +1,124 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef PROPENSITYSUMTREE_HPP_
+#define PROPENSITYSUMTREE_HPP_
+
+#include <vector>
+
+/**
+ * A binary sum tree over a fixed number of events, each with a non-negative
+ * propensity (rate). Used by kinetic Monte Carlo (Gillespie-type) update schemes
+ * to sample the next event with probability proportional to its propensity.
+ *
+ * Changing one propensity and sampling an event both cost O(log n) operations.
+ * Each internal node is recomputed from its two children rather than updated
+ * incrementally, so the partial sums do not accumulate round-off error however
+ * many updates are made.
+ */
+class PropensitySumTree
+{
+private:
+
+    /** The number of events. */
+    unsigned mNumEvents;
+
+    /** The number of leaves in the tree (the smallest power of two no less than mNumEvents). */
+    unsigned mNumLeaves;
+
+    /**
+     * The tree, stored as an implicit heap: entry 1 is the root, the children of
+     * entry i are entries 2i and 2i+1, and the propensity of event j is stored in
+     * entry mNumLeaves+j.
+     */
+    std::vector<double> mSums;
+
+public:
+
+    /**
+     * Default constructor. Creates an empty tree.
+     */
+    PropensitySumTree();
+
+    /**
+     * Resize the tree to hold a given number of events, and set all propensities to zero.
+     *
+     * @param numEvents the number of events
+     */
+    void Resize(unsigned numEvents);
+
+    /**
+     * Set all propensities to zero.
+     */
+    void Clear();
+
+    /**
+     * @return the number of events.
+     */
+    unsigned GetNumEvents() const;
+
+    /**
+     * Set the propensity of an event.
+     *
+     * @param eventIndex the index of the event
+     * @param propensity the new (non-negative) propensity
+     */
+    void SetPropensity(unsigned eventIndex, double propensity);
+
+    /**
+     * @param eventIndex the index of the event
+     * @return the propensity of this event.
+     */
+    double GetPropensity(unsigned eventIndex) const;
+
+    /**
+     * @return the sum of the propensities of all events.
+     */
+    double GetTotalPropensity() const;
+
+    /**
+     * Find the event whose interval contains a given point, when the interval
+     * [0, GetTotalPropensity()) is partitioned into consecutive sub-intervals of
+     * length equal to each propensity. Passing a uniform random number scaled by
+     * the total propensity therefore samples an event with probability proportional
+     * to its propensity. Events with zero propensity are never returned.
+     *
+     * @param target a point in [0, GetTotalPropensity())
+     * @return the index of the event.
+     */
+    unsigned SampleEvent(double target) const;
+};
+
+#endif /*PROPENSITYSUMTREE_HPP_*/
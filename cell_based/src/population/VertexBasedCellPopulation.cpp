@@ -48,6 +48,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexT3SwapLocationsWriter.hpp"
 #include "AbstractCellBasedSimulation.hpp"
 
+#include <algorithm>
+
 template<unsigned DIM>
 VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM, DIM>& rMesh,
                                           std::vector<CellPtr>& rCells,
@@ -75,6 +77,8 @@ VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM,
     {
         Validate();
     }
+
+    UpdateNodePartition();
 }
 
 template<unsigned DIM>
@@ -299,7 +303,8 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     {
         // Fix up the mappings between CellPtrs and VertexElements
         ///\todo We want to make these maps private, so we need a better way of doing the code below.
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_map;
+        old_map.swap(this->mCellLocationMap);
 
         this->mCellLocationMap.clear();
         this->mLocationCellMap.clear();
@@ -321,6 +326,9 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     }
 
     element_map.ResetToIdentity();
+
+    // Remeshing may have added or removed nodes, so share them out between processes again
+    UpdateNodePartition();
 }
 
 template<unsigned DIM>
@@ -393,6 +401,24 @@ double VertexBasedCellPopulation<DIM>::GetVolumeOfCell(CellPtr pCell)
     return cell_volume;
 }
 
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::WriteResultsToFiles(const std::string& rDirectory)
+{
+    bool cache_geometry = !mpMutableVertexMesh->IsElementGeometryCached();
+    if (cache_geometry)
+    {
+        mpMutableVertexMesh->CacheElementGeometry();
+    }
+
+    AbstractCellPopulation<DIM>::WriteResultsToFiles(rDirectory);
+
+    // Node positions may change before the next output, so do not keep the cache
+    if (cache_geometry)
+    {
+        mpMutableVertexMesh->ClearElementGeometryCache();
+    }
+}
+
 template<unsigned DIM>
 void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirectory)
 {
@@ -466,7 +492,11 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
     std::stringstream time;
     time << num_timesteps;
 
-    mesh_writer.WriteVtkUsingMesh(*mpMutableVertexMesh, time.str());
+    // The mesh is replicated on every process, so only the master process writes it
+    if (PetscTools::AmMaster())
+    {
+        mesh_writer.WriteVtkUsingMesh(*mpMutableVertexMesh, time.str());
+    }
 
     *(this->mpVtkMetaFile) << "        <DataSet timestep=\"";
     *(this->mpVtkMetaFile) << num_timesteps;
@@ -845,6 +875,126 @@ void VertexBasedCellPopulation<DIM>::SetRestrictVertexMovementBoolean(bool restr
     mRestrictVertexMovement = restrictMovement;
 }
 
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::UpdateNodePartition()
+{
+    mIsNodeOwned.clear();
+    mPartitionedNodeIndices.clear();
+    mPartitionOffsets.clear();
+    if (PetscTools::IsSequential())
+    {
+        return;
+    }
+
+    /*
+     * Sort the nodes along the first coordinate direction, breaking ties by index so that every
+     * process agrees. Any deleted nodes are included, so that every node index has an owner even
+     * if a deleted node is reused before the next call to this method.
+     */
+    std::vector<std::pair<double, unsigned> > sorted_nodes;
+    unsigned num_all_nodes = mpMutableVertexMesh->GetNumAllNodes();
+    sorted_nodes.reserve(num_all_nodes);
+    for (unsigned node_index=0; node_index<num_all_nodes; node_index++)
+    {
+        sorted_nodes.push_back(std::make_pair(mpMutableVertexMesh->GetNode(node_index)->rGetLocation()[0], node_index));
+    }
+    std::sort(sorted_nodes.begin(), sorted_nodes.end());
+
+    // Each process owns a contiguous slab of the sorted nodes
+    unsigned num_procs = PetscTools::GetNumProcs();
+    mPartitionOffsets.resize(num_procs + 1);
+    for (unsigned proc=0; proc<=num_procs; proc++)
+    {
+        mPartitionOffsets[proc] = (sorted_nodes.size()*proc)/num_procs;
+    }
+
+    mPartitionedNodeIndices.resize(sorted_nodes.size());
+    for (unsigned i=0; i<sorted_nodes.size(); i++)
+    {
+        mPartitionedNodeIndices[i] = sorted_nodes[i].second;
+    }
+
+    unsigned my_rank = PetscTools::GetMyRank();
+    mIsNodeOwned.assign(num_all_nodes, false);
+    for (unsigned i=mPartitionOffsets[my_rank]; i<mPartitionOffsets[my_rank + 1]; i++)
+    {
+        mIsNodeOwned[mPartitionedNodeIndices[i]] = true;
+    }
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::IsNodePartitionUpToDate() const
+{
+    return !mIsNodeOwned.empty() && (mIsNodeOwned.size() == mpMutableVertexMesh->GetNumAllNodes());
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::IsNodeOwnedByThisProcess(unsigned index) const
+{
+    if (!IsNodePartitionUpToDate())
+    {
+        return true;
+    }
+    assert(index < mIsNodeOwned.size());
+    return mIsNodeOwned[index];
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::ReduceAppliedForces()
+{
+    if (!IsNodePartitionUpToDate())
+    {
+        // Either running sequentially, or every process has computed the forces on every node
+        return;
+    }
+
+    // Pack the forces on the nodes owned by this process, in partition order
+    unsigned num_procs = PetscTools::GetNumProcs();
+    unsigned my_rank = PetscTools::GetMyRank();
+    unsigned num_owned_nodes = mPartitionOffsets[my_rank + 1] - mPartitionOffsets[my_rank];
+    std::vector<double> local_forces(num_owned_nodes*DIM);
+    for (unsigned i=0; i<num_owned_nodes; i++)
+    {
+        c_vector<double, DIM>& r_force = mpMutableVertexMesh->GetNode(mPartitionedNodeIndices[mPartitionOffsets[my_rank] + i])->rGetAppliedForce();
+        for (unsigned j=0; j<DIM; j++)
+        {
+            local_forces[i*DIM + j] = r_force[j];
+        }
+    }
+
+    // Every process receives each owner's forces, so only the owned nodes are communicated
+    std::vector<int> counts(num_procs);
+    std::vector<int> displacements(num_procs);
+    for (unsigned proc=0; proc<num_procs; proc++)
+    {
+        counts[proc] = (mPartitionOffsets[proc + 1] - mPartitionOffsets[proc])*DIM;
+        displacements[proc] = mPartitionOffsets[proc]*DIM;
+    }
+    std::vector<double> global_forces(mPartitionedNodeIndices.size()*DIM);
+    double* p_local_forces = local_forces.empty() ? nullptr : &local_forces[0];
+    double* p_global_forces = global_forces.empty() ? nullptr : &global_forces[0];
+    MPI_Allgatherv(p_local_forces, num_owned_nodes*DIM, MPI_DOUBLE,
+                   p_global_forces, &counts[0], &displacements[0], MPI_DOUBLE, PetscTools::GetWorld());
+
+    for (unsigned i=0; i<mPartitionedNodeIndices.size(); i++)
+    {
+        Node<DIM>* p_node = mpMutableVertexMesh->GetNode(mPartitionedNodeIndices[i]);
+        c_vector<double, DIM> force;
+        for (unsigned j=0; j<DIM; j++)
+        {
+            force[j] = global_forces[i*DIM + j];
+        }
+        p_node->ClearAppliedForce();
+        p_node->AddAppliedForceContribution(force);
+    }
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::IsReplicatedOnEveryProcess()
+{
+    return true;
+}
+
 // Explicit instantiation
 template class VertexBasedCellPopulation<1>;
 template class VertexBasedCellPopulation<2>;
@@ -53,6 +53,11 @@ class AbstractVertexBasedDivisionRule; // Forward declaration to prevent circula
  * Contains a group of cells and maintains the associations
  * between CellPtrs and elements in the MutableVertexMesh.
  *
+ * When running in parallel the population is replicated, not distributed: every
+ * process holds the whole mesh and all the cells, and carries out remeshing, T1, T2
+ * and T3 swaps, cell division and output identically. Only the computation of forces
+ * is shared between processes (see UpdateNodePartition()), so running in parallel
+ * shortens the force loop but does not reduce the memory used by each process.
  */
 template<unsigned DIM>
 class VertexBasedCellPopulation : public AbstractOffLatticeCellPopulation<DIM>
@@ -108,6 +113,30 @@ private:
      */
      bool mThrowStepSizeException = true;
 
+    /**
+     * When running in parallel, whether each node of the (replicated) mesh is owned by this
+     * process, indexed by node index. Empty when running sequentially. Ownership is assigned
+     * by UpdateNodePartition() and is not archived.
+     */
+    std::vector<bool> mIsNodeOwned;
+
+    /**
+     * When running in parallel, the indices of the nodes owned by each process in turn, so
+     * that process i owns the nodes mPartitionedNodeIndices[mPartitionOffsets[i]] up to (but
+     * not including) mPartitionedNodeIndices[mPartitionOffsets[i+1]].
+     */
+    std::vector<unsigned> mPartitionedNodeIndices;
+
+    /** The offset of the first node owned by each process in mPartitionedNodeIndices, plus the total number of nodes. */
+    std::vector<unsigned> mPartitionOffsets;
+
+    /**
+     * @return whether the node partition matches the current mesh. If nodes have been added
+     * since the last call to UpdateNodePartition(), every process computes the forces on
+     * every node until the population is next updated.
+     */
+    bool IsNodePartitionUpToDate() const;
+
     /**
      * Overridden WriteVtkResultsToFile() method.
      *
@@ -142,6 +171,13 @@ private:
      */
     void Validate();
 
+    /**
+     * Overridden IsReplicatedOnEveryProcess() method.
+     *
+     * @return true, since every process holds a complete copy of the mesh and cells.
+     */
+    bool IsReplicatedOnEveryProcess();
+
 public:
 
     /**
@@ -369,6 +405,17 @@ public:
      */
     unsigned GetRosetteRankOfCell(CellPtr pCell);
 
+    /**
+     * Overridden WriteResultsToFiles() method.
+     *
+     * The writers query the area and perimeter of every element, so unless the
+     * mesh already holds its element geometry this is computed once up front and
+     * discarded after writing.
+     *
+     * @param rDirectory  pathname of the output directory, relative to where Chaste output is stored
+     */
+    virtual void WriteResultsToFiles(const std::string& rDirectory);
+
     /**
      * Overridden GetVolumeOfCell() method.
      *
@@ -551,6 +598,37 @@ public:
      * @param restrictVertexMovement whether to restrict vertex movement in this simulation.
      */
     void SetRestrictVertexMovementBoolean(bool restrictVertexMovement);
+
+    /**
+     * Partition the nodes of the mesh between processes when running in parallel.
+     *
+     * Every process holds a complete copy of the mesh and cells, so that cell division and
+     * T1, T2 and T3 swaps are carried out identically on each process. The nodes are sorted
+     * along the first coordinate direction and divided into contiguous slabs of roughly equal
+     * size, one per process; each process then only computes forces on the nodes in its slab,
+     * and ReduceAppliedForces() combines the results. Does nothing when running sequentially.
+     *
+     * This is called by the constructor and by Update(), after any remeshing, so the nodes
+     * are partitioned once per time step rather than once per force evaluation.
+     */
+    void UpdateNodePartition();
+
+    /**
+     * @return whether forces on a given node should be computed by this process.
+     * Always true when running sequentially or when the partition is out of date.
+     *
+     * @param index the global index of the node
+     */
+    bool IsNodeOwnedByThisProcess(unsigned index) const;
+
+    /**
+     * Gather the forces applied to the nodes from all processes, so that every process
+     * holds the force computed by the owner of each node. The contributions of any forces
+     * that are not partition-aware, and so are computed on every node by every process,
+     * are only counted once. Does nothing when running sequentially, or when the partition
+     * is out of date and every process has computed the forces on every node.
+     */
+    void ReduceAppliedForces();
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -65,10 +65,14 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
     unsigned num_nodes = p_cell_population->GetNumNodes();
     unsigned num_elements = p_cell_population->GetNumElements();
 
-    // Begin by computing the area and perimeter of each element in the mesh, to avoid having to do this multiple times
+    /*
+     * Begin by computing the area and perimeter of each element in the mesh, to avoid having to do this multiple times.
+     * These are looked up from the mesh's geometry cache if it has been filled (see VertexMesh::CacheElementGeometry()).
+     */
     std::vector<double> element_areas(num_elements);
     std::vector<double> element_perimeters(num_elements);
     std::vector<double> target_areas(num_elements);
+    unsigned target_area_index = CellData::GetItemIndex("target area");
     for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = p_cell_population->rGetMesh().GetElementIteratorBegin();
          elem_iter != p_cell_population->rGetMesh().GetElementIteratorEnd();
          ++elem_iter)
@@ -82,7 +86,7 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
             // will throw an exception that it doesn't have "target area" entries.  We add this piece of code to give a more
             // understandable message. There is a slight chance that the exception is thrown although the error is not about the
             // target areas.
-            target_areas[elem_index] = p_cell_population->GetCellUsingLocationIndex(elem_index)->GetCellData()->GetItem("target area");
+            target_areas[elem_index] = p_cell_population->GetCellUsingLocationIndex(elem_index)->GetCellData()->GetItem(target_area_index);
         }
         catch (Exception&)
         {
@@ -90,9 +94,21 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
         }
     }
 
-    // Iterate over vertices in the cell population
-    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    /*
+     * Iterate over vertices in the cell population. The force on each vertex is computed
+     * independently of the others, so this loop is run in parallel if OpenMP is available.
+     */
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif // CHASTE_OPENMP
+    for (int node_index=0; node_index<static_cast<int>(num_nodes); node_index++)
     {
+        // When running in parallel, forces are only computed on the nodes owned by this process
+        if (!p_cell_population->IsNodeOwnedByThisProcess(node_index))
+        {
+            continue;
+        }
+
         Node<DIM>* p_this_node = p_cell_population->GetNode(node_index);
 
         /*
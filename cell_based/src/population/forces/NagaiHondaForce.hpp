@@ -133,6 +133,9 @@ public:
     /**
      * Get the adhesion parameter for the edge between two given nodes.
      *
+     * This method is called from within the (possibly OpenMP-parallel) loop over nodes in
+     * AddForceContribution(), so any overriding method must be safe to call concurrently.
+     *
      * @param pNodeA one node
      * @param pNodeB the other node
      * @param rVertexCellPopulation reference to the cell population
@@ -33,7 +33,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <climits>
 #include <cmath>
+#include <exception>
 #include <iostream>
 #include <fstream>
 #include <set>
@@ -43,6 +45,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LogFile.hpp"
 #include "ExecutableSupport.hpp"
 #include "AbstractPdeModifier.hpp"
+#include "CellCycleModelOdeHandler.hpp"
+#include "ThreadTools.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
@@ -61,6 +65,8 @@ AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(
       mNumDeaths(0),
       mOutputDivisionLocations(false),
       mOutputCellVelocities(false),
+      mUseParallelCellModelUpdates(false),
+      mSolveSrnModelOdesInBatches(false),
       mSamplingTimestepMultiple(1)
 {
     // Set a random seed of 0 if it wasn't specified earlier
@@ -97,68 +103,167 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellBirth()
 
     unsigned num_births_this_step = 0;
 
-    // Iterate over all cells, seeing if each one can be divided
+    // Only cells that already exist and have a positive age may divide this time step
+    std::vector<CellPtr> candidate_cells;
+    candidate_cells.reserve(mrCellPopulation.rGetCells().size());
     for (typename AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>::Iterator cell_iter = mrCellPopulation.Begin();
          cell_iter != mrCellPopulation.End();
          ++cell_iter)
     {
+        if (cell_iter->GetAge() > 0.0)
+        {
+            candidate_cells.push_back(*cell_iter);
+        }
+    }
+
+    // Bring the SRN models of these cells up to date together, before ReadyToDivide() is called on each
+    if (mSolveSrnModelOdesInBatches)
+    {
+        mSrnModelBatchSolver.SimulateToCurrentTime(candidate_cells);
+    }
+
+    std::vector<unsigned char> ready_to_divide;
+    if (mUseParallelCellModelUpdates)
+    {
+        UpdateCellModelsInParallel(candidate_cells, ready_to_divide);
+    }
+
+    // Iterate over these cells, seeing if each one can be divided
+    for (unsigned cell_index=0; cell_index<candidate_cells.size(); cell_index++)
+    {
+        CellPtr p_cell = candidate_cells[cell_index];
+        double cell_age = p_cell->GetAge();
+
         // Check if this cell is ready to divide
-        double cell_age = cell_iter->GetAge();
-        if (cell_age > 0.0)
+        bool is_ready = mUseParallelCellModelUpdates ? (ready_to_divide[cell_index] != 0) : p_cell->ReadyToDivide();
+        if (is_ready)
         {
-            if (cell_iter->ReadyToDivide())
+            // Check if there is room into which the cell may divide
+            if (mrCellPopulation.IsRoomToDivide(p_cell))
             {
-                // Check if there is room into which the cell may divide
-                if (mrCellPopulation.IsRoomToDivide(*cell_iter))
+                // Store parent ID for output if required
+                unsigned parent_cell_id = p_cell->GetCellId();
+
+                // Create a new cell
+                CellPtr p_new_cell = p_cell->Divide();
+
+                /**
+                 * If required, output this location to file
+                 *
+                 * \todo (#2578)
+                 *
+                 * For consistency with the rest of the output code, consider removing the
+                 * AbstractCellBasedSimulation member mOutputDivisionLocations, adding a new
+                 * member mAgesAndLocationsOfDividingCells to AbstractCellPopulation, adding
+                 * a new class CellDivisionLocationsWriter to the CellPopulationWriter hierarchy
+                 * to output the content of mAgesAndLocationsOfDividingCells to file (remembering
+                 * to clear mAgesAndLocationsOfDividingCells at each timestep), and replacing the
+                 * following conditional statement with something like
+                 *
+                 * if (mrCellPopulation.HasWriter<CellDivisionLocationsWriter>())
+                 * {
+                 *     mCellDivisionLocations.push_back(new_location);
+                 * }
+                 */
+                if (mOutputDivisionLocations)
                 {
-                    // Store parent ID for output if required
-                    unsigned parent_cell_id = cell_iter->GetCellId();
-
-                    // Create a new cell
-                    CellPtr p_new_cell = cell_iter->Divide();
-
-                    /**
-                     * If required, output this location to file
-                     *
-                     * \todo (#2578)
-                     *
-                     * For consistency with the rest of the output code, consider removing the
-                     * AbstractCellBasedSimulation member mOutputDivisionLocations, adding a new
-                     * member mAgesAndLocationsOfDividingCells to AbstractCellPopulation, adding
-                     * a new class CellDivisionLocationsWriter to the CellPopulationWriter hierarchy
-                     * to output the content of mAgesAndLocationsOfDividingCells to file (remembering
-                     * to clear mAgesAndLocationsOfDividingCells at each timestep), and replacing the
-                     * following conditional statement with something like
-                     *
-                     * if (mrCellPopulation.HasWriter<CellDivisionLocationsWriter>())
-                     * {
-                     *     mCellDivisionLocations.push_back(new_location);
-                     * }
-                     */
-                    if (mOutputDivisionLocations)
+                    c_vector<double, SPACE_DIM> cell_location = mrCellPopulation.GetLocationOfCellCentre(p_cell);
+
+                    *mpDivisionLocationFile << SimulationTime::Instance()->GetTime() << "\t";
+                    for (unsigned i=0; i<SPACE_DIM; i++)
                     {
-                        c_vector<double, SPACE_DIM> cell_location = mrCellPopulation.GetLocationOfCellCentre(*cell_iter);
-
-                        *mpDivisionLocationFile << SimulationTime::Instance()->GetTime() << "\t";
-                        for (unsigned i=0; i<SPACE_DIM; i++)
-                        {
-                            *mpDivisionLocationFile << cell_location[i] << "\t";
-                        }
-                        *mpDivisionLocationFile << "\t" << cell_age << "\t" << parent_cell_id << "\t" << cell_iter->GetCellId() << "\t" << p_new_cell->GetCellId() << "\n";
+                        *mpDivisionLocationFile << cell_location[i] << "\t";
                     }
+                    *mpDivisionLocationFile << "\t" << cell_age << "\t" << parent_cell_id << "\t" << p_cell->GetCellId() << "\t" << p_new_cell->GetCellId() << "\n";
+                }
 
-                    // Add the new cell to the cell population
-                    mrCellPopulation.AddCell(p_new_cell, *cell_iter);
+                // Add the new cell to the cell population
+                mrCellPopulation.AddCell(p_new_cell, p_cell);
 
-                    // Update counter
-                    num_births_this_step++;
-                }
+                // Update counter
+                num_births_this_step++;
             }
         }
     }
     return num_births_this_step;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellModelsInParallel(const std::vector<CellPtr>& rCells,
+                                                                                      std::vector<unsigned char>& rReadyToDivide)
+{
+    unsigned num_cells = rCells.size();
+    rReadyToDivide.assign(num_cells, 0);
+
+    // Give every ODE solver wrapper used by these cells one solver per thread
+    unsigned num_threads = ThreadTools::GetMaxNumThreads();
+    std::set<AbstractCellCycleModelOdeSolver*> ode_solvers;
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        CellCycleModelOdeHandler* p_cycle_handler = dynamic_cast<CellCycleModelOdeHandler*>(rCells[i]->GetCellCycleModel());
+        if (p_cycle_handler && p_cycle_handler->GetOdeSolver())
+        {
+            ode_solvers.insert(p_cycle_handler->GetOdeSolver().get());
+        }
+        CellCycleModelOdeHandler* p_srn_handler = dynamic_cast<CellCycleModelOdeHandler*>(rCells[i]->GetSrnModel());
+        if (p_srn_handler && p_srn_handler->GetOdeSolver())
+        {
+            ode_solvers.insert(p_srn_handler->GetOdeSolver().get());
+        }
+    }
+    for (std::set<AbstractCellCycleModelOdeSolver*>::iterator iter = ode_solvers.begin();
+         iter != ode_solvers.end();
+         ++iter)
+    {
+        if ((*iter)->IsSetUp())
+        {
+            (*iter)->SetUpThreadOdeSolvers(num_threads);
+        }
+    }
+
+    // A single draw from the shared generator makes each cell's stream depend on the simulation seed
+    unsigned step_seed = RandomNumberGenerator::Instance()->randMod(INT_MAX);
+
+    // Exceptions must not escape a parallel region, so remember the first one and rethrow it afterwards
+    std::exception_ptr p_error;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel
+#endif // CHASTE_OPENMP
+    {
+#ifdef CHASTE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif // CHASTE_OPENMP
+        for (int i=0; i<static_cast<int>(num_cells); i++)
+        {
+            RandomNumberGenerator::UseThreadLocalStream(RandomNumberGenerator::MixSeeds(step_seed, rCells[i]->GetCellId()));
+
+            try
+            {
+                rReadyToDivide[i] = rCells[i]->ReadyToDivide() ? 1 : 0;
+            }
+            catch (...)
+            {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCellBasedSimulationError)
+#endif // CHASTE_OPENMP
+                {
+                    if (!p_error)
+                    {
+                        p_error = std::current_exception();
+                    }
+                }
+            }
+        }
+        RandomNumberGenerator::UseGlobalStream();
+    }
+
+    if (p_error)
+    {
+        std::rethrow_exception(p_error);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellRemoval()
 {
@@ -627,6 +732,30 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetOutputCellVelocities
     mOutputCellVelocities = outputCellVelocities;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetUseParallelCellModelUpdates()
+{
+    return mUseParallelCellModelUpdates;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetUseParallelCellModelUpdates(bool useParallelCellModelUpdates)
+{
+    mUseParallelCellModelUpdates = useParallelCellModelUpdates;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetSolveSrnModelOdesInBatches()
+{
+    return mSolveSrnModelOdesInBatches;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetSolveSrnModelOdesInBatches(bool solveSrnModelOdesInBatches)
+{
+    mSolveSrnModelOdesInBatches = solveSrnModelOdesInBatches;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::OutputSimulationSetup()
 {
@@ -46,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCellBasedSimulationModifier.hpp"
 #include "AbstractForce.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "OdeSrnModelBatchSolver.hpp"
 
 // Forward declaration prevents circular include chain
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellPopulation;
@@ -159,6 +160,23 @@ protected:
     /** Results file for cell velocities. */
     out_stream mpCellVelocitiesFile;
 
+    /**
+     * Whether to update the cell-cycle and SRN models of all cells concurrently,
+     * using OpenMP threads, before processing divisions (defaults to false).
+     * This is a run-time performance setting and so is not archived.
+     */
+    bool mUseParallelCellModelUpdates;
+
+    /**
+     * Whether to solve the SRN model ODEs of all cells together in batches before
+     * processing divisions (defaults to false). Not archived, like
+     * mUseParallelCellModelUpdates.
+     */
+    bool mSolveSrnModelOdesInBatches;
+
+    /** Used to solve the SRN model ODEs in batches if mSolveSrnModelOdesInBatches is true. */
+    OdeSrnModelBatchSolver mSrnModelBatchSolver;
+
     /** List of cell killers. */
     std::vector<boost::shared_ptr<AbstractCellKiller<SPACE_DIM> > > mCellKillers;
 
@@ -195,6 +213,22 @@ protected:
      */
     virtual unsigned DoCellBirth();
 
+    /**
+     * Work out whether each of the given cells is ready to divide, calling
+     * ReadyToDivide() on the cells concurrently if Chaste was compiled with
+     * OpenMP.  Used by DoCellBirth() when mUseParallelCellModelUpdates is true.
+     *
+     * Each cell draws random numbers from its own stream, seeded from a single
+     * draw from the shared generator and the cell's ID, so results do not depend
+     * on the number of threads.  Cells sharing an ODE solver wrapper are given a
+     * separate solver per thread.
+     *
+     * @param rCells the cells to update
+     * @param rReadyToDivide filled with whether each cell is ready to divide
+     */
+    void UpdateCellModelsInParallel(const std::vector<CellPtr>& rCells,
+                                    std::vector<unsigned char>& rReadyToDivide);
+
     /**
      * During a simulation time step, process any cell sloughing or death
      *
@@ -469,6 +503,32 @@ public:
      */
     void SetOutputCellVelocities(bool outputCellVelocities);
 
+    /**
+     * @return mUseParallelCellModelUpdates
+     */
+    bool GetUseParallelCellModelUpdates();
+
+    /**
+     * Set mUseParallelCellModelUpdates.
+     *
+     * @param useParallelCellModelUpdates whether to update cell-cycle and SRN models concurrently
+     */
+    void SetUseParallelCellModelUpdates(bool useParallelCellModelUpdates);
+
+    /**
+     * @return mSolveSrnModelOdesInBatches
+     */
+    bool GetSolveSrnModelOdesInBatches();
+
+    /**
+     * Set mSolveSrnModelOdesInBatches.
+     *
+     * Only SRN models are batched; the ODEs of cell-cycle models are still solved cell by cell.
+     *
+     * @param solveSrnModelOdesInBatches whether to solve SRN model ODEs in batches (see OdeSrnModelBatchSolver)
+     */
+    void SetSolveSrnModelOdesInBatches(bool solveSrnModelOdesInBatches);
+
     /**
      * Outputs simulation parameters to file
      *
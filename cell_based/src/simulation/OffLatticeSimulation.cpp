@@ -104,6 +104,40 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
     double target_time_step  = this->mDt;
     double present_time_step = this->mDt;
 
+    /*
+     * A method whose adaptive time step may exceed mDt keeps its last accepted step from one
+     * simulation time step to the next. The node positions are left unchanged until waiting
+     * another simulation time step would take the time since they were last updated beyond
+     * that step, and are then advanced over all of that time. They are always brought up to
+     * date at output times and at the end of the simulation, and at every time step if cell
+     * velocities are written.
+     */
+    bool keep_time_step = mpNumericalMethod->HasAdaptiveTimestep() && mpNumericalMethod->CanExceedSimulationTimeStep();
+    double accepted_time_step = this->mDt;
+    if (keep_time_step)
+    {
+        if (mpNumericalMethod->GetLastAcceptedTimeStep() != DOUBLE_UNSET)
+        {
+            accepted_time_step = mpNumericalMethod->GetLastAcceptedTimeStep();
+        }
+        target_time_step = mpNumericalMethod->GetTimeSinceLastUpdate() + this->mDt;
+
+        SimulationTime* p_time = SimulationTime::Instance();
+        bool at_output_time = ((p_time->GetTimeStepsElapsed() + 1)%this->mSamplingTimestepMultiple == 0);
+        bool at_end_time = (p_time->GetTime() + 1.5*this->mDt > this->mEndTime);
+        if (!at_output_time && !at_end_time && !this->mOutputCellVelocities
+            && target_time_step + this->mDt <= accepted_time_step*(1.0 + 1e-8))
+        {
+            mpNumericalMethod->SetTimeSinceLastUpdate(target_time_step);
+            CellBasedEventHandler::EndEvent(CellBasedEventHandler::POSITION);
+            return;
+        }
+        mpNumericalMethod->SetTimeSinceLastUpdate(0.0);
+
+        // Allow for rounding, rather than leave a tiny remainder for a second step
+        present_time_step = (target_time_step <= accepted_time_step*(1.0 + 1e-8)) ? target_time_step : accepted_time_step;
+    }
+
     while (time_advanced_so_far < target_time_step)
     {
         // Store the initial node positions (these may be needed when applying boundary conditions)
@@ -125,14 +159,23 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
             // Successful time step! Update time_advanced_so_far
             time_advanced_so_far += present_time_step;
 
-            // If using adaptive timestep, then increase the present_time_step (by 1% for now)
+            // If using adaptive timestep, then increase the present_time_step as suggested by the numerical method
             if (mpNumericalMethod->HasAdaptiveTimestep())
             {
-                ///\todo #2087 Make this a settable member variable
-                double timestep_increase = 0.01;
-                present_time_step = std::min((1+timestep_increase)*present_time_step, target_time_step - time_advanced_so_far);
+                double suggested_time_step = mpNumericalMethod->GetSuggestedNextTimeStep(present_time_step);
+
+                /*
+                 * A step cut short by the end of the update only changes the kept step if it
+                 * suggests a step shorter than itself, or longer than the kept step.
+                 */
+                if (present_time_step >= accepted_time_step
+                    || suggested_time_step < present_time_step
+                    || suggested_time_step > accepted_time_step)
+                {
+                    accepted_time_step = suggested_time_step;
+                }
+                present_time_step = std::min(accepted_time_step, target_time_step - time_advanced_so_far);
             }
-
         }
         catch (StepSizeException& e)
         {
@@ -141,6 +184,7 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
             {
                 // If adaptivity is switched on, revert node locations and choose a suitably smaller time step
                 RevertToOldLocations(old_node_locations);
+                accepted_time_step = std::min(accepted_time_step, e.GetSuggestedNewStep());
                 present_time_step = std::min(e.GetSuggestedNewStep(), target_time_step - time_advanced_so_far);
             }
             else
@@ -151,6 +195,11 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
         }
     }
 
+    if (keep_time_step)
+    {
+        mpNumericalMethod->SetLastAcceptedTimeStep(accepted_time_step);
+    }
+
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::POSITION);
 }
 
@@ -69,6 +69,11 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
     // Make sure the cell population is updated
     rCellPopulation.Update();
 
+    // Look up the cell data item indices once, rather than by name for every cell
+    unsigned notch_index = CellData::GetItemIndex("notch");
+    unsigned delta_index = CellData::GetItemIndex("delta");
+    unsigned mean_delta_index = CellData::GetItemIndex("mean delta");
+
     // First recover each cell's Notch and Delta concentrations from the ODEs and store in CellData
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
@@ -79,8 +84,8 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
         double this_notch = p_model->GetNotch();
 
         // Note that the state variables must be in the same order as listed in DeltaNotchOdeSystem
-        cell_iter->GetCellData()->SetItem("notch", this_notch);
-        cell_iter->GetCellData()->SetItem("delta", this_delta);
+        cell_iter->GetCellData()->SetItem(notch_index, this_notch);
+        cell_iter->GetCellData()->SetItem(delta_index, this_delta);
     }
 
     // Next iterate over the population to compute and store each cell's neighbouring Delta concentration in CellData
@@ -100,15 +105,15 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
                  ++iter)
             {
                 CellPtr p_cell = rCellPopulation.GetCellUsingLocationIndex(*iter);
-                double this_delta = p_cell->GetCellData()->GetItem("delta");
+                double this_delta = p_cell->GetCellData()->GetItem(delta_index);
                 mean_delta += this_delta/neighbour_indices.size();
             }
-            cell_iter->GetCellData()->SetItem("mean delta", mean_delta);
+            cell_iter->GetCellData()->SetItem(mean_delta_index, mean_delta);
         }
         else
         {
             // If this cell has no neighbours, such as an isolated cell in a CaBasedCellPopulation, store 0.0 for the cell data
-            cell_iter->GetCellData()->SetItem("mean delta", 0.0);
+            cell_iter->GetCellData()->SetItem(mean_delta_index, 0.0);
         }
     }
 }
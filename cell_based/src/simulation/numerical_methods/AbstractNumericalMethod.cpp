@@ -39,7 +39,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCentreBasedCellPopulation.hpp"
 #include "NodeBasedCellPopulationWithBuskeUpdate.hpp"
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
+#include "VertexBasedCellPopulation.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "VertexMesh.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AbstractNumericalMethod()
@@ -47,7 +49,9 @@ AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AbstractNumericalMethod()
       mpForceCollection(nullptr),
       mUseAdaptiveTimestep(false),
       mUseUpdateNodeLocation(false),
-      mGhostNodeForcesEnabled(true)
+      mGhostNodeForcesEnabled(true),
+      mLastAcceptedTimeStep(DOUBLE_UNSET),
+      mTimeSinceLastUpdate(0.0)
 {
     // mpCellPopulation and mpForceCollection are initialized by the OffLatticeSimulation constructor
 }
@@ -97,6 +101,44 @@ bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::HasAdaptiveTimestep()
     return mUseAdaptiveTimestep;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetSuggestedNextTimeStep(double presentTimeStep)
+{
+    ///\todo #2087 Make this a settable member variable
+    double timestep_increase = 0.01;
+    return (1.0 + timestep_increase)*presentTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::CanExceedSimulationTimeStep()
+{
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetLastAcceptedTimeStep()
+{
+    return mLastAcceptedTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetLastAcceptedTimeStep(double lastAcceptedTimeStep)
+{
+    mLastAcceptedTimeStep = lastAcceptedTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTimeSinceLastUpdate()
+{
+    return mTimeSinceLastUpdate;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTimeSinceLastUpdate(double timeSinceLastUpdate)
+{
+    mTimeSinceLastUpdate = timeSinceLastUpdate;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesIncludingDamping()
 {
@@ -108,12 +150,31 @@ std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SP
         node_iter->ClearAppliedForce();
     }
 
+    // In parallel, vertex-based populations share the force computation between processes
+    VertexBasedCellPopulation<SPACE_DIM>* p_vertex_population = dynamic_cast<VertexBasedCellPopulation<SPACE_DIM>*>(mpCellPopulation);
+
+    // Vertex-based forces repeatedly query element areas, perimeters and edge lengths, so cache these for this step
+    VertexMesh<ELEMENT_DIM, SPACE_DIM>* p_vertex_mesh = dynamic_cast<VertexMesh<ELEMENT_DIM, SPACE_DIM>*>(&(mpCellPopulation->rGetMesh()));
+    if (p_vertex_mesh)
+    {
+        p_vertex_mesh->CacheElementGeometry();
+    }
+
     for (typename std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >::iterator iter = mpForceCollection->begin();
         iter != mpForceCollection->end(); ++iter)
     {
         (*iter)->AddForceContribution(*mpCellPopulation);
     }
 
+    if (p_vertex_mesh)
+    {
+        p_vertex_mesh->ClearElementGeometryCache();
+    }
+    if (p_vertex_population)
+    {
+        p_vertex_population->ReduceAppliedForces();
+    }
+
     /**
      * Here we deal with the special case forces on ghost nodes. Note that 'particles'
      * are dealt with like normal cells.
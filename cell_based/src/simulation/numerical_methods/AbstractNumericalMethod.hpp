@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include "ClassIsAbstract.hpp"
 #include "Identifiable.hpp"
 
@@ -73,6 +74,11 @@ private:
         archive & mUseAdaptiveTimestep;
         archive & mUseUpdateNodeLocation;
         archive & mGhostNodeForcesEnabled;
+        if (version >= 1)
+        {
+            archive & mLastAcceptedTimeStep;
+            archive & mTimeSinceLastUpdate;
+        }
     }
 
 protected:
@@ -106,6 +112,20 @@ protected:
      */
     bool mGhostNodeForcesEnabled;
 
+    /**
+     * The size of the time step to try first in the next update, for methods whose adaptive time
+     * step is kept from one simulation time step to the next (see CanExceedSimulationTimeStep()).
+     * Initialized to DOUBLE_UNSET in the AbstractNumericalMethod constructor, meaning the
+     * simulation time step.
+     */
+    double mLastAcceptedTimeStep;
+
+    /**
+     * The simulation time that has passed since the node positions were last updated.
+     * Initialized to 0 in the AbstractNumericalMethod constructor.
+     */
+    double mTimeSinceLastUpdate;
+
     /**
      * Computes and returns the force on each node, including the damping factor
      * @return A vector of applied forces
@@ -192,6 +212,55 @@ public:
      */
     bool HasAdaptiveTimestep();
 
+    /**
+     * Suggest the size of the next time step following a successful step. This is used
+     * by OffLatticeSimulation when the numerical method uses an adaptive time step.
+     *
+     * By default the time step is increased by 1%. Subclasses with some estimate of
+     * the local error or of the node displacements may override this method.
+     *
+     * @param presentTimeStep the size of the time step just taken
+     * @return the suggested size of the next time step
+     */
+    virtual double GetSuggestedNextTimeStep(double presentTimeStep);
+
+    /**
+     * Whether the adaptive time step of this method is kept from one simulation time step to the
+     * next, and may grow beyond the simulation time step. If so, OffLatticeSimulation leaves the
+     * node positions unchanged while less than one such step has passed since they were last
+     * updated, and then advances them over all of that time at once.
+     *
+     * By default this is false, since the default GetSuggestedNextTimeStep() has no control of
+     * the error or of the node displacements. Subclasses which have may override this method.
+     *
+     * @return whether the adaptive time step may exceed the simulation time step
+     */
+    virtual bool CanExceedSimulationTimeStep();
+
+    /**
+     * @return mLastAcceptedTimeStep
+     */
+    double GetLastAcceptedTimeStep();
+
+    /**
+     * Set mLastAcceptedTimeStep.
+     *
+     * @param lastAcceptedTimeStep the size of the time step to try first in the next update
+     */
+    void SetLastAcceptedTimeStep(double lastAcceptedTimeStep);
+
+    /**
+     * @return mTimeSinceLastUpdate
+     */
+    double GetTimeSinceLastUpdate();
+
+    /**
+     * Set mTimeSinceLastUpdate.
+     *
+     * @param timeSinceLastUpdate the simulation time that has passed since the node positions were last updated
+     */
+    void SetTimeSinceLastUpdate(double timeSinceLastUpdate);
+
     /**
      * Updates node positions according to Newton's 2nd law with overdamping.
      *
@@ -219,4 +288,23 @@ public:
 
 TEMPLATED_CLASS_IS_ABSTRACT_2_UNSIGNED(AbstractNumericalMethod)
 
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(AbstractNumericalMethod, 1)
+ * with a templated class.
+ */
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+struct version<AbstractNumericalMethod<ELEMENT_DIM, SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 #endif /*ABSTRACTNUMERICALMETHOD_HPP_*/
@@ -0,0 +1,173 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "AdaptiveForwardEulerNumericalMethod.hpp"
+#include "VertexBasedCellPopulation.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AdaptiveForwardEulerNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTargetDisplacementFraction(0.5),
+      mMaxTimeStepGrowthFactor(2.0),
+      mLastMaxDisplacement(0.0)
+{
+    this->mUseAdaptiveTimestep = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~AdaptiveForwardEulerNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaximumSafeDisplacement()
+{
+    VertexBasedCellPopulation<SPACE_DIM>* p_vertex_population = dynamic_cast<VertexBasedCellPopulation<SPACE_DIM>*>(this->mpCellPopulation);
+    if (p_vertex_population)
+    {
+        return 0.5*p_vertex_population->rGetMesh().GetCellRearrangementThreshold();
+    }
+    else
+    {
+        return this->mpCellPopulation->GetAbsoluteMovementThreshold();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        // Apply forces to each cell, and save a vector of net forces F
+        std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
+
+        double max_displacement = 0.0;
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            // Get the current node location and calculate the new location according to the forward Euler method
+            const c_vector<double, SPACE_DIM>& r_old_location = node_iter->rGetLocation();
+            c_vector<double, SPACE_DIM> displacement = dt * forces[index];
+            max_displacement = std::max(max_displacement, norm_2(displacement));
+
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
+
+            c_vector<double, SPACE_DIM> new_location = r_old_location + displacement;
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+        mLastMaxDisplacement = max_displacement;
+    }
+    else
+    {
+        /*
+         * If this type of cell population does not support the new numerical methods, delegate
+         * updating node positions to the population itself.
+         *
+         * This only applies to NodeBasedCellPopulationWithBuskeUpdates.
+         */
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+        mLastMaxDisplacement = 0.0;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::CanExceedSimulationTimeStep()
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetSuggestedNextTimeStep(double presentTimeStep)
+{
+    double target_displacement = mTargetDisplacementFraction*GetMaximumSafeDisplacement();
+
+    double factor = mMaxTimeStepGrowthFactor;
+    if (mLastMaxDisplacement*mMaxTimeStepGrowthFactor > target_displacement)
+    {
+        factor = target_displacement/mLastMaxDisplacement;
+    }
+    return factor*presentTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTargetDisplacementFraction()
+{
+    return mTargetDisplacementFraction;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTargetDisplacementFraction(double targetDisplacementFraction)
+{
+    assert(targetDisplacementFraction > 0.0 && targetDisplacementFraction <= 1.0);
+    mTargetDisplacementFraction = targetDisplacementFraction;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxTimeStepGrowthFactor()
+{
+    return mMaxTimeStepGrowthFactor;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxTimeStepGrowthFactor(double maxTimeStepGrowthFactor)
+{
+    assert(maxTimeStepGrowthFactor >= 1.0);
+    mMaxTimeStepGrowthFactor = maxTimeStepGrowthFactor;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveForwardEulerNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<TargetDisplacementFraction>" << mTargetDisplacementFraction << "</TargetDisplacementFraction>\n";
+    *rParamsFile << "\t\t\t<MaxTimeStepGrowthFactor>" << mMaxTimeStepGrowthFactor << "</MaxTimeStepGrowthFactor>\n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class AdaptiveForwardEulerNumericalMethod<1,1>;
+template class AdaptiveForwardEulerNumericalMethod<1,2>;
+template class AdaptiveForwardEulerNumericalMethod<2,2>;
+template class AdaptiveForwardEulerNumericalMethod<1,3>;
+template class AdaptiveForwardEulerNumericalMethod<2,3>;
+template class AdaptiveForwardEulerNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(AdaptiveForwardEulerNumericalMethod)
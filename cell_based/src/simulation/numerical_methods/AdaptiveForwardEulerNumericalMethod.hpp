@@ -0,0 +1,168 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ADAPTIVEFORWARDEULERNUMERICALMETHOD_HPP_
+#define ADAPTIVEFORWARDEULERNUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements forward Euler time stepping with a displacement-controlled adaptive time step.
+ *
+ * Each step is taken exactly as in ForwardEulerNumericalMethod. Adaptivity is switched on by
+ * default, and after each successful step the next time step is chosen so that the largest node
+ * displacement is expected to be a given fraction of the largest safe displacement: the
+ * AbsoluteMovementThreshold for centre-based populations, or half the cell rearrangement
+ * threshold for vertex-based populations. The time step thus grows quickly while nodes move
+ * slowly, and steps which move nodes too far are caught by the usual StepSizeException.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class AdaptiveForwardEulerNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mTargetDisplacementFraction;
+        archive & mMaxTimeStepGrowthFactor;
+        archive & mLastMaxDisplacement;
+    }
+
+    /**
+     * The fraction of the largest safe displacement that the largest node displacement
+     * should be in each step. Defaults to 0.5.
+     */
+    double mTargetDisplacementFraction;
+
+    /**
+     * The largest factor by which the time step may be increased after a successful step.
+     * Defaults to 2.
+     */
+    double mMaxTimeStepGrowthFactor;
+
+    /** The largest node displacement in the most recent step. */
+    double mLastMaxDisplacement;
+
+    /**
+     * @return the largest displacement a node may safely make in one step for the present
+     * cell population.
+     */
+    double GetMaximumSafeDisplacement();
+
+public:
+
+    /**
+     * Constructor.
+     */
+    AdaptiveForwardEulerNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~AdaptiveForwardEulerNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Overridden CanExceedSimulationTimeStep() method.
+     *
+     * @return true, since the time step of this method is controlled by the largest node displacement
+     */
+    bool CanExceedSimulationTimeStep();
+
+    /**
+     * Overridden GetSuggestedNextTimeStep() method.
+     *
+     * @param presentTimeStep the size of the time step just taken
+     * @return the suggested size of the next time step, based on the largest displacement in the last step
+     */
+    double GetSuggestedNextTimeStep(double presentTimeStep);
+
+    /**
+     * @return mTargetDisplacementFraction
+     */
+    double GetTargetDisplacementFraction();
+
+    /**
+     * Set mTargetDisplacementFraction.
+     *
+     * @param targetDisplacementFraction the new value of mTargetDisplacementFraction
+     */
+    void SetTargetDisplacementFraction(double targetDisplacementFraction);
+
+    /**
+     * @return mMaxTimeStepGrowthFactor
+     */
+    double GetMaxTimeStepGrowthFactor();
+
+    /**
+     * Set mMaxTimeStepGrowthFactor.
+     *
+     * @param maxTimeStepGrowthFactor the new value of mMaxTimeStepGrowthFactor
+     */
+    void SetMaxTimeStepGrowthFactor(double maxTimeStepGrowthFactor);
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(AdaptiveForwardEulerNumericalMethod)
+
+#endif /*ADAPTIVEFORWARDEULERNUMERICALMETHOD_HPP_*/
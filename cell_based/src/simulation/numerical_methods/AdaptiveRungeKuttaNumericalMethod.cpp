@@ -0,0 +1,215 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cmath>
+#include <sstream>
+#include "AdaptiveRungeKuttaNumericalMethod.hpp"
+#include "StepSizeException.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AdaptiveRungeKuttaNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTolerance(1e-4),
+      mMaxTimeStepGrowthFactor(5.0),
+      mLastErrorEstimate(0.0)
+{
+    this->mUseAdaptiveTimestep = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~AdaptiveRungeKuttaNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::MoveNodes(const std::vector<c_vector<double, SPACE_DIM> >& rOldLocations,
+                                                                         const std::vector<c_vector<double, SPACE_DIM> >& rDisplacements)
+{
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        this->SafeNodePositionUpdate(node_iter->GetIndex(), rOldLocations[index] + rDisplacements[index]);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTimeStepFactor(double errorEstimate)
+{
+    // Standard controller for a method with local error O(dt^3), with a safety factor
+    if (errorEstimate <= 0.0)
+    {
+        return mMaxTimeStepGrowthFactor;
+    }
+    double factor = 0.9*pow(mTolerance/errorEstimate, 1.0/3.0);
+    return std::max(0.2, std::min(mMaxTimeStepGrowthFactor, factor));
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > old_locations = this->SaveCurrentLocations();
+        unsigned num_nodes = old_locations.size();
+        std::vector<c_vector<double, SPACE_DIM> > displacements(num_nodes);
+
+        std::vector<c_vector<double, SPACE_DIM> > k1 = this->ComputeForcesIncludingDamping();
+
+        for (unsigned index=0; index<num_nodes; index++)
+        {
+            displacements[index] = 0.5*dt*k1[index];
+        }
+        MoveNodes(old_locations, displacements);
+        std::vector<c_vector<double, SPACE_DIM> > k2 = this->ComputeForcesIncludingDamping();
+
+        for (unsigned index=0; index<num_nodes; index++)
+        {
+            displacements[index] = 0.75*dt*k2[index];
+        }
+        MoveNodes(old_locations, displacements);
+        std::vector<c_vector<double, SPACE_DIM> > k3 = this->ComputeForcesIncludingDamping();
+
+        // Third-order solution
+        for (unsigned index=0; index<num_nodes; index++)
+        {
+            displacements[index] = dt*(2.0*k1[index] + 3.0*k2[index] + 4.0*k3[index])/9.0;
+        }
+        MoveNodes(old_locations, displacements);
+        std::vector<c_vector<double, SPACE_DIM> > k4 = this->ComputeForcesIncludingDamping();
+
+        // Estimate the error from the difference with the embedded second-order solution
+        double max_error = 0.0;
+        for (unsigned index=0; index<num_nodes; index++)
+        {
+            c_vector<double, SPACE_DIM> error = dt*(-5.0*k1[index]/72.0 + k2[index]/12.0 + k3[index]/9.0 - k4[index]/8.0);
+            max_error = std::max(max_error, norm_2(error));
+        }
+        mLastErrorEstimate = max_error;
+
+        if (this->mUseAdaptiveTimestep && (max_error > mTolerance))
+        {
+            std::ostringstream message;
+            message << "The estimated error in node positions is " << max_error;
+            message << ", which is more than the tolerance: use a smaller timestep to avoid this exception.";
+
+            MoveNodes(old_locations, std::vector<c_vector<double, SPACE_DIM> >(num_nodes, zero_vector<double>(SPACE_DIM)));
+            throw StepSizeException(GetTimeStepFactor(max_error)*dt, message.str(), false);
+        }
+
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacements[index], dt);
+
+            c_vector<double, SPACE_DIM> new_location = old_locations[index] + displacements[index];
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+    }
+    else
+    {
+        /*
+         * If this type of cell population does not support the new numerical methods, delegate
+         * updating node positions to the population itself.
+         *
+         * This only applies to NodeBasedCellPopulationWithBuskeUpdates.
+         */
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::CanExceedSimulationTimeStep()
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetSuggestedNextTimeStep(double presentTimeStep)
+{
+    return GetTimeStepFactor(mLastErrorEstimate)*presentTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTolerance()
+{
+    return mTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTolerance(double tolerance)
+{
+    assert(tolerance > 0.0);
+    mTolerance = tolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxTimeStepGrowthFactor()
+{
+    return mMaxTimeStepGrowthFactor;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxTimeStepGrowthFactor(double maxTimeStepGrowthFactor)
+{
+    assert(maxTimeStepGrowthFactor >= 1.0);
+    mMaxTimeStepGrowthFactor = maxTimeStepGrowthFactor;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AdaptiveRungeKuttaNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<Tolerance>" << mTolerance << "</Tolerance>\n";
+    *rParamsFile << "\t\t\t<MaxTimeStepGrowthFactor>" << mMaxTimeStepGrowthFactor << "</MaxTimeStepGrowthFactor>\n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class AdaptiveRungeKuttaNumericalMethod<1,1>;
+template class AdaptiveRungeKuttaNumericalMethod<1,2>;
+template class AdaptiveRungeKuttaNumericalMethod<2,2>;
+template class AdaptiveRungeKuttaNumericalMethod<1,3>;
+template class AdaptiveRungeKuttaNumericalMethod<2,3>;
+template class AdaptiveRungeKuttaNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(AdaptiveRungeKuttaNumericalMethod)
@@ -0,0 +1,187 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ADAPTIVERUNGEKUTTANUMERICALMETHOD_HPP_
+#define ADAPTIVERUNGEKUTTANUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements adaptive Runge-Kutta time stepping using the embedded third-order
+ * Bogacki-Shampine pair.
+ *
+ * Solves the equations of motion dr/dt = F
+ * Using the scheme
+ *
+ * k1 = F(r^t),
+ * k2 = F(r^t + dt k1/2),
+ * k3 = F(r^t + 3 dt k2/4),
+ * r^(t+1) = r^t + dt (2 k1 + 3 k2 + 4 k3)/9,
+ *
+ * with the local error estimated by comparison with the embedded second-order solution,
+ * which also uses k4 = F(r^(t+1)).
+ *
+ * Adaptivity is switched on by default. If the estimated error in any node's position
+ * exceeds the tolerance, a StepSizeException is thrown, so the simulation reverts the step
+ * and retries with the suggested smaller time step; otherwise the next time step is chosen
+ * from the error estimate, and may be considerably larger than the present one.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class AdaptiveRungeKuttaNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mTolerance;
+        archive & mMaxTimeStepGrowthFactor;
+        archive & mLastErrorEstimate;
+    }
+
+    /**
+     * Tolerance on the estimated local error in any node's position. Defaults to 1e-4.
+     */
+    double mTolerance;
+
+    /**
+     * The largest factor by which the time step may be increased after a successful step.
+     * Defaults to 5.
+     */
+    double mMaxTimeStepGrowthFactor;
+
+    /** The error estimate from the most recent step. */
+    double mLastErrorEstimate;
+
+    /**
+     * Move every node to a given displacement from its old location.
+     *
+     * @param rOldLocations the node locations at the start of the step
+     * @param rDisplacements the displacement of each node
+     */
+    void MoveNodes(const std::vector<c_vector<double, SPACE_DIM> >& rOldLocations,
+                   const std::vector<c_vector<double, SPACE_DIM> >& rDisplacements);
+
+    /**
+     * @return the factor by which to multiply the time step, given an error estimate.
+     *
+     * @param errorEstimate the estimated local error
+     */
+    double GetTimeStepFactor(double errorEstimate);
+
+public:
+
+    /**
+     * Constructor.
+     */
+    AdaptiveRungeKuttaNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~AdaptiveRungeKuttaNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Overridden CanExceedSimulationTimeStep() method.
+     *
+     * @return true, since the time step of this method is controlled by the local error estimate
+     */
+    bool CanExceedSimulationTimeStep();
+
+    /**
+     * Overridden GetSuggestedNextTimeStep() method.
+     *
+     * @param presentTimeStep the size of the time step just taken
+     * @return the suggested size of the next time step, based on the last error estimate
+     */
+    double GetSuggestedNextTimeStep(double presentTimeStep);
+
+    /**
+     * @return mTolerance
+     */
+    double GetTolerance();
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the new value of mTolerance
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * @return mMaxTimeStepGrowthFactor
+     */
+    double GetMaxTimeStepGrowthFactor();
+
+    /**
+     * Set mMaxTimeStepGrowthFactor.
+     *
+     * @param maxTimeStepGrowthFactor the new value of mMaxTimeStepGrowthFactor
+     */
+    void SetMaxTimeStepGrowthFactor(double maxTimeStepGrowthFactor);
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(AdaptiveRungeKuttaNumericalMethod)
+
+#endif /*ADAPTIVERUNGEKUTTANUMERICALMETHOD_HPP_*/
@@ -0,0 +1,201 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cfloat>
+#include <cmath>
+#include "BackwardEulerNumericalMethod.hpp"
+#include "StepSizeException.hpp"
+#include "Warnings.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::BackwardEulerNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTolerance(1e-6),
+      mMaxIterations(10)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~BackwardEulerNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > old_locations = this->SaveCurrentLocations();
+        unsigned num_nodes = old_locations.size();
+
+        // Forward Euler predictor; the previous iterate is taken to be the zero displacement
+        std::vector<c_vector<double, SPACE_DIM> > previous_forces = this->ComputeForcesIncludingDamping();
+        std::vector<c_vector<double, SPACE_DIM> > previous_displacements(num_nodes, zero_vector<double>(SPACE_DIM));
+        std::vector<c_vector<double, SPACE_DIM> > displacements(num_nodes);
+        for (unsigned index=0; index<num_nodes; index++)
+        {
+            displacements[index] = dt*previous_forces[index];
+        }
+
+        bool converged = false;
+        for (unsigned iteration=0; iteration<mMaxIterations; iteration++)
+        {
+            // Move the nodes to the present iterate and compute the forces there
+            unsigned index = 0;
+            for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+                 node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+                 ++node_iter, ++index)
+            {
+                this->SafeNodePositionUpdate(node_iter->GetIndex(), old_locations[index] + displacements[index]);
+            }
+            std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
+
+            double max_residual = 0.0;
+            for (index=0; index<num_nodes; index++)
+            {
+                c_vector<double, SPACE_DIM> residual = displacements[index] - dt*forces[index];
+                max_residual = std::max(max_residual, norm_2(residual));
+
+                // Quasi-Newton update using a secant estimate of the diagonal of the force Jacobian
+                for (unsigned i=0; i<SPACE_DIM; i++)
+                {
+                    double jacobian = 0.0;
+                    double change_in_displacement = displacements[index][i] - previous_displacements[index][i];
+                    if (fabs(change_in_displacement) > DBL_EPSILON)
+                    {
+                        jacobian = (forces[index][i] - previous_forces[index][i])/change_in_displacement;
+                    }
+
+                    // Fall back to a fixed-point update if the linearisation is not invertible
+                    double denominator = 1.0 - dt*jacobian;
+                    if (denominator <= 0.0)
+                    {
+                        denominator = 1.0;
+                    }
+
+                    previous_displacements[index][i] = displacements[index][i];
+                    displacements[index][i] -= residual[i]/denominator;
+                }
+            }
+            previous_forces = forces;
+
+            if (max_residual < mTolerance)
+            {
+                converged = true;
+                break;
+            }
+        }
+
+        if (!converged)
+        {
+            std::string message("Backward Euler iteration failed to converge: use a smaller timestep to avoid this.");
+            if (this->mUseAdaptiveTimestep)
+            {
+                throw StepSizeException(0.5*dt, message, false);
+            }
+            WARN_ONCE_ONLY(message);
+        }
+
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacements[index], dt);
+
+            c_vector<double, SPACE_DIM> new_location = old_locations[index] + displacements[index];
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+    }
+    else
+    {
+        /*
+         * If this type of cell population does not support the new numerical methods, delegate
+         * updating node positions to the population itself.
+         *
+         * This only applies to NodeBasedCellPopulationWithBuskeUpdates.
+         */
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTolerance()
+{
+    return mTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTolerance(double tolerance)
+{
+    assert(tolerance > 0.0);
+    mTolerance = tolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxIterations()
+{
+    return mMaxIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxIterations(unsigned maxIterations)
+{
+    assert(maxIterations > 0);
+    mMaxIterations = maxIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<Tolerance>" << mTolerance << "</Tolerance>\n";
+    *rParamsFile << "\t\t\t<MaxIterations>" << mMaxIterations << "</MaxIterations>\n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BackwardEulerNumericalMethod<1,1>;
+template class BackwardEulerNumericalMethod<1,2>;
+template class BackwardEulerNumericalMethod<2,2>;
+template class BackwardEulerNumericalMethod<1,3>;
+template class BackwardEulerNumericalMethod<2,3>;
+template class BackwardEulerNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
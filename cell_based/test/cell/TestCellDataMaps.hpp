@@ -51,6 +51,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellPropertyRegistry.hpp"
 #include "CellVecData.hpp"
 #include "CellData.hpp"
+#include "CellDataItemRegistry.hpp"
+#include "ThreadTools.hpp"
 #include "SmartPointers.hpp"
 
 #include "AbstractCellBasedTestSuite.hpp"
@@ -100,6 +102,52 @@ public:
         TS_ASSERT_EQUALS(p_daughtercell_data->GetItem("some other thing"), 2.0);
     }
 
+    void TestCellDataItemIndices()
+    {
+        CellData cell_data;
+        TS_ASSERT_EQUALS(cell_data.GetNumItems(), 0u);
+
+        // Items may be set and got either by name or by index
+        unsigned index = CellData::GetItemIndex("a new item");
+        TS_ASSERT_EQUALS(CellData::GetItemIndex("a new item"), index);
+        TS_ASSERT_EQUALS(CellDataItemRegistry::Instance()->GetName(index), "a new item");
+        TS_ASSERT_EQUALS(cell_data.HasItem("a new item"), false);
+        TS_ASSERT_THROWS_THIS(cell_data.GetItem(index), "The item a new item is not stored");
+
+        cell_data.SetItem(index, 1.5);
+        TS_ASSERT_EQUALS(cell_data.HasItem("a new item"), true);
+        TS_ASSERT_DELTA(cell_data.GetItem("a new item"), 1.5, 1e-12);
+        cell_data.SetItem("a new item", 2.5);
+        TS_ASSERT_DELTA(cell_data.GetItem(index), 2.5, 1e-12);
+        TS_ASSERT_EQUALS(cell_data.GetNumItems(), 1u);
+
+        // Looking up an unknown name does not register it
+        unsigned num_registered = CellDataItemRegistry::Instance()->GetNumItems();
+        TS_ASSERT_THROWS_THIS(cell_data.GetItem("never stored"), "The item never stored is not stored");
+        TS_ASSERT_EQUALS(cell_data.HasItem("never stored"), false);
+        TS_ASSERT_EQUALS(CellDataItemRegistry::Instance()->FindIndex("never stored"), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(CellDataItemRegistry::Instance()->GetNumItems(), num_registered);
+
+        // The registry is a single instance, which may only gain names outside parallel regions
+        TS_ASSERT_EQUALS(CellDataItemRegistry::Instance(), CellDataItemRegistry::Instance());
+        TS_ASSERT(!ThreadTools::IsInParallelRegion());
+
+        // Keys are returned in alphabetical order, whatever the order of registration
+        cell_data.SetItem("zebra", 3.0);
+        cell_data.SetItem("aardvark", 4.0);
+        std::vector<std::string> keys = cell_data.GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 3u);
+        TS_ASSERT_EQUALS(keys[0], "a new item");
+        TS_ASSERT_EQUALS(keys[1], "aardvark");
+        TS_ASSERT_EQUALS(keys[2], "zebra");
+
+        // Copies have their own values
+        CellData copied_cell_data(cell_data);
+        copied_cell_data.SetItem(index, 5.0);
+        TS_ASSERT_DELTA(cell_data.GetItem(index), 2.5, 1e-12);
+        TS_ASSERT_EQUALS(copied_cell_data.GetNumItems(), 3u);
+    }
+
     void TestCellVecData()
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellPropertyCollection.hpp"
 #include "AbstractCellProperty.hpp"
+#include "CellData.hpp"
 
 #include "AbstractCellMutationState.hpp"
 #include "WildTypeCellMutationState.hpp"
@@ -135,6 +136,18 @@ public:
         TS_ASSERT( *it == wild_types.GetProperty() );
         TS_ASSERT_THROWS_THIS(collection.GetProperty(),
                               "Can only call GetProperty on a collection of size 1.");
+
+        // Test the cached CellData property
+        TS_ASSERT(!collection.GetCellData());
+        boost::shared_ptr<CellData> p_cell_data(new CellData);
+        collection.AddProperty(p_cell_data);
+        TS_ASSERT_EQUALS(collection.GetCellData(), p_cell_data);
+        TS_ASSERT_EQUALS(collection.HasProperty<CellData>(), true);
+        TS_ASSERT_EQUALS(collection.GetPropertiesType<CellData>().GetCellData(), p_cell_data);
+        collection.RemoveProperty(p_cell_data);
+        TS_ASSERT(!collection.GetCellData());
+        TS_ASSERT_EQUALS(collection.HasProperty<CellData>(), false);
+        TS_ASSERT_EQUALS(collection.HasProperty<WildTypeCellMutationState>(), true);
     }
 
     void TestArchiveCellPropertyCollection()
@@ -47,6 +47,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NullSrnModel.hpp"
 #include "DeltaNotchSrnModel.hpp"
 #include "Goldbeter1991SrnModel.hpp"
+#include "OdeSrnModelBatchSolver.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
 #include "UniformG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
 #include "OutputFileHandler.hpp"
@@ -236,6 +239,95 @@ public:
         TS_ASSERT_DELTA(p_srn_model->GetX(), 2.1160, 1e-4);
     }
 
+    void TestSolvingSrnModelOdesInBatches()
+    {
+        MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        // Delta-Notch models are batched only if they use RK4
+        boost::shared_ptr<AbstractCellCycleModelOdeSolver> p_solver(CellCycleModelOdeSolver<DeltaNotchSrnModel, RungeKutta4IvpOdeSolver>::Instance());
+        p_solver->Initialise();
+
+        /*
+         * Create two identical sets of cells with Delta-Notch and Goldbeter SRN models, with
+         * different mean Delta in each cell. The first set is solved in batches.
+         */
+        unsigned num_cells = 6;
+        std::vector<CellPtr> batch_cells;
+        std::vector<CellPtr> single_cells;
+        for (unsigned set=0; set<2; set++)
+        {
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                AbstractOdeSrnModel* p_srn_model;
+                if (i < num_cells-1)
+                {
+                    DeltaNotchSrnModel* p_delta_notch_model = new DeltaNotchSrnModel(p_solver);
+                    p_delta_notch_model->SetDt(0.01);
+                    p_srn_model = p_delta_notch_model;
+                }
+                else
+                {
+                    p_srn_model = new Goldbeter1991SrnModel();
+                }
+
+                UniformG1GenerationalCellCycleModel* p_cc_model = new UniformG1GenerationalCellCycleModel();
+                CellPtr p_cell(new Cell(p_healthy_state, p_cc_model, p_srn_model, false, CellPropertyCollection()));
+                p_cell->SetCellProliferativeType(p_diff_type);
+                p_cell->GetCellData()->SetItem("mean delta", 0.1*i);
+                p_cell->InitialiseCellCycleModel();
+                p_cell->InitialiseSrnModel();
+
+                if (set == 0)
+                {
+                    batch_cells.push_back(p_cell);
+                }
+                else
+                {
+                    single_cells.push_back(p_cell);
+                }
+            }
+        }
+
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(2.0, 20);
+
+        OdeSrnModelBatchSolver batch_solver;
+        while (p_simulation_time->GetTime() < 2.0)
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            batch_solver.SimulateToCurrentTime(batch_cells);
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                // The batched models are already up to date, so this only does any custom behaviour
+                batch_cells[i]->GetSrnModel()->SimulateToCurrentTime();
+                single_cells[i]->GetSrnModel()->SimulateToCurrentTime();
+            }
+        }
+
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            AbstractOdeSrnModel* p_batch_model = static_cast<AbstractOdeSrnModel*>(batch_cells[i]->GetSrnModel());
+            AbstractOdeSrnModel* p_single_model = static_cast<AbstractOdeSrnModel*>(single_cells[i]->GetSrnModel());
+            TS_ASSERT_DELTA(p_batch_model->GetSimulatedToTime(), 2.0, 1e-12);
+
+            std::vector<double> batch_state = p_batch_model->GetProteinConcentrations();
+            std::vector<double> single_state = p_single_model->GetProteinConcentrations();
+            TS_ASSERT_EQUALS(batch_state.size(), single_state.size());
+            for (unsigned j=0; j<batch_state.size(); j++)
+            {
+                TS_ASSERT_DELTA(batch_state[j], single_state[j], 1e-12);
+            }
+        }
+
+        // Check the Delta-Notch models really were batched and evolved
+        DeltaNotchSrnModel* p_model = static_cast<DeltaNotchSrnModel*>(batch_cells[3]->GetSrnModel());
+        TS_ASSERT_DELTA(p_model->GetMeanNeighbouringDelta(), 0.3, 1e-12);
+        TS_ASSERT_DIFFERS(p_model->GetNotch(), 0.0);
+        TS_ASSERT_EQUALS(p_model->CanSolveOdesInBatch(), true);
+    }
+
     void TestGoldbeter1991SrnCreateCopy()
     {
         // Test with Goldbeter1991SrnModel
@@ -0,0 +1,217 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTBOXDOMAINMULTIGRIDSOLVER_HPP_
+#define TESTBOXDOMAINMULTIGRIDSOLVER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <pde/test/pdes/SimplePoissonEquation.hpp>
+
+#include "BoxDomainMultigridSolver.hpp"
+#include "ConstBoundaryCondition.hpp"
+#include "FunctionalBoundaryCondition.hpp"
+#include "ReplicatableVector.hpp"
+#include "Warnings.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * The solution of Laplacian(u) + 1 = 0 with these Dirichlet conditions, which is
+ * quadratic and is therefore reproduced exactly by the discrete problem.
+ *
+ * @param rX the point
+ * @return the value of the solution at rX
+ */
+double QuadraticSolution(const ChastePoint<2>& rX)
+{
+    return 1.0 - 0.25*(rX[0]*rX[0] + rX[1]*rX[1]);
+}
+
+class TestBoxDomainMultigridSolver : public CxxTest::TestSuite
+{
+public:
+
+    void TestEllipticPdeWithDirichletConditions()
+    {
+        // Create a mesh on [-1,1]x[-1,1] as AbstractBoxDomainPdeModifier would
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.125, 2.0, 2.0);
+        mesh.Translate(-1.0, -1.0);
+
+        SimplePoissonEquation<2,2> pde;
+
+        BoundaryConditionsContainer<2,2,1> bcc;
+        FunctionalBoundaryCondition<2>* p_boundary_condition = new FunctionalBoundaryCondition<2>(&QuadraticSolution);
+        for (TetrahedralMesh<2,2>::BoundaryNodeIterator node_iter = mesh.GetBoundaryNodeIteratorBegin();
+             node_iter != mesh.GetBoundaryNodeIteratorEnd();
+             ++node_iter)
+        {
+            bcc.AddDirichletBoundaryCondition(*node_iter, p_boundary_condition);
+        }
+
+        // There are 16 intervals in each direction, so the grid can be coarsened to 2 intervals
+        BoxDomainMultigridSolver<2> solver(&mesh, 0.125);
+        TS_ASSERT_EQUALS(solver.GetNumLevels(), 4u);
+
+        solver.SetUpEllipticPde(&pde);
+        solver.SetBoundaryConditions(&bcc);
+        Vec solution = solver.Solve();
+        TS_ASSERT_LESS_THAN(solver.GetNumCyclesInLastSolve(), 15u);
+
+        ReplicatableVector solution_repl(solution);
+        TS_ASSERT_EQUALS(solution_repl.GetSize(), mesh.GetNumNodes());
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(solution_repl[i], QuadraticSolution(mesh.GetNode(i)->GetPoint()), 1e-8);
+        }
+
+        // Starting from the solution, no further iterations are needed
+        Vec solution_again = solver.Solve(solution);
+        TS_ASSERT_EQUALS(solver.GetNumCyclesInLastSolve(), 0u);
+
+        PetscTools::Destroy(solution);
+        PetscTools::Destroy(solution_again);
+    }
+
+    void TestGridWithLargeCoarsestLevel()
+    {
+        // With 50 intervals in each direction the grid can only be coarsened once, leaving 26x26 coarse nodes
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.04, 2.0, 2.0);
+        mesh.Translate(-1.0, -1.0);
+
+        SimplePoissonEquation<2,2> pde;
+
+        BoundaryConditionsContainer<2,2,1> bcc;
+        FunctionalBoundaryCondition<2>* p_boundary_condition = new FunctionalBoundaryCondition<2>(&QuadraticSolution);
+        for (TetrahedralMesh<2,2>::BoundaryNodeIterator node_iter = mesh.GetBoundaryNodeIteratorBegin();
+             node_iter != mesh.GetBoundaryNodeIteratorEnd();
+             ++node_iter)
+        {
+            bcc.AddDirichletBoundaryCondition(*node_iter, p_boundary_condition);
+        }
+
+        BoxDomainMultigridSolver<2> solver(&mesh, 0.04);
+        TS_ASSERT_EQUALS(solver.GetNumLevels(), 2u);
+
+        // The coarsest level is solved directly, so the number of cycles stays small
+        solver.SetUpEllipticPde(&pde);
+        solver.SetBoundaryConditions(&bcc);
+        Vec solution = solver.Solve();
+        TS_ASSERT_LESS_THAN(solver.GetNumCyclesInLastSolve(), 15u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 0u);
+
+        ReplicatableVector solution_repl(solution);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(solution_repl[i], QuadraticSolution(mesh.GetNode(i)->GetPoint()), 1e-8);
+        }
+        PetscTools::Destroy(solution);
+
+        // A 3D grid with an odd number of intervals cannot be coarsened, and is too large to solve directly
+        TetrahedralMesh<3,3> mesh_3d;
+        mesh_3d.ConstructRegularSlabMesh(0.1, 1.5, 1.5, 1.5);
+        BoxDomainMultigridSolver<3> solver_3d(&mesh_3d, 0.1);
+        TS_ASSERT_EQUALS(solver_3d.GetNumLevels(), 1u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNextWarningMessage(),
+                         "The coarsest multigrid level has 4096 nodes, too many to solve directly, so it is solved by Gauss-Seidel"
+                         " iteration and the solver may be slow. Use a box with 2^k intervals in each direction for best performance.");
+        Warnings::QuietDestroy();
+    }
+
+    void TestEllipticPdeWithNeumannCondition()
+    {
+        // Solve u'' + 1 = 0 on [0,1] with u(0) = 0 and u'(1) = 0.5, so u = 1.5x - 0.5x^2
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0);
+
+        SimplePoissonEquation<1,1> pde;
+
+        BoundaryConditionsContainer<1,1,1> bcc;
+        ConstBoundaryCondition<1>* p_zero_condition = new ConstBoundaryCondition<1>(0.0);
+        bcc.AddDirichletBoundaryCondition(mesh.GetNode(0), p_zero_condition);
+        ConstBoundaryCondition<1>* p_flux_condition = new ConstBoundaryCondition<1>(0.5);
+        for (TetrahedralMesh<1,1>::BoundaryElementIterator elem_iter = mesh.GetBoundaryElementIteratorBegin();
+             elem_iter != mesh.GetBoundaryElementIteratorEnd();
+             ++elem_iter)
+        {
+            if ((*elem_iter)->GetNode(0)->rGetLocation()[0] > 0.5)
+            {
+                bcc.AddNeumannBoundaryCondition(*elem_iter, p_flux_condition);
+            }
+        }
+
+        // There are 10 intervals, so the grid can be coarsened once
+        BoxDomainMultigridSolver<1> solver(&mesh, 0.1);
+        TS_ASSERT_EQUALS(solver.GetNumLevels(), 2u);
+
+        solver.SetUpEllipticPde(&pde);
+        solver.SetBoundaryConditions(&bcc);
+        Vec solution = solver.Solve();
+
+        ReplicatableVector solution_repl(solution);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            double x = mesh.GetNode(i)->rGetLocation()[0];
+            TS_ASSERT_DELTA(solution_repl[i], 1.5*x - 0.5*x*x, 1e-8);
+        }
+
+        PetscTools::Destroy(solution);
+    }
+
+    void TestExceptions()
+    {
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.5, 2.0, 2.0);
+
+        // The step size must match that of the mesh
+        TS_ASSERT_THROWS_THIS(BoxDomainMultigridSolver<2> bad_solver(&mesh, 0.25),
+                              "The mesh is not a regular slab mesh with the given step size");
+
+        SimplePoissonEquation<2,2> pde;
+        BoundaryConditionsContainer<2,2,1> bcc;
+        bcc.DefineZeroDirichletOnMeshBoundary(&mesh);
+
+        BoxDomainMultigridSolver<2> solver(&mesh, 0.5);
+        solver.SetUpEllipticPde(&pde);
+        solver.SetBoundaryConditions(&bcc);
+        solver.SetTolerance(1e-12);
+        solver.SetMaxNumCycles(0);
+        TS_ASSERT_THROWS_THIS(solver.Solve(), "Multigrid solver did not converge in 0 V-cycles");
+    }
+};
+
+#endif /*TESTBOXDOMAINMULTIGRIDSOLVER_HPP_*/
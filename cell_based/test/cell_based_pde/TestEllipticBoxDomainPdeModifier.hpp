@@ -143,6 +143,7 @@ public:
             Vec vector = PetscTools::CreateVec(data);
             EllipticBoxDomainPdeModifier<2> modifier(p_pde, p_bc, false, p_cuboid, 2.0, vector);
             modifier.SetDependentVariableName("averaged quantity");
+            modifier.SetUseMultigridSolver(true);
 
             // Create an output archive
             std::ofstream ofs(archive_filename.c_str());
@@ -167,6 +168,7 @@ public:
             TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->rGetDependentVariableName(), "averaged quantity");
             TS_ASSERT_DELTA((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->GetStepSize(), 2.0, 1e-5);
             TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->AreBcsSetOnBoxBoundary(), true);
+            TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->GetUseMultigridSolver(), true);
 
             Vec solution = (static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->GetSolution();
             ReplicatableVector solution_repl(solution);
@@ -237,6 +239,78 @@ public:
         TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.0179, 1e-4);
     }
 
+    void TestMeshBasedSquareMonolayerWithMultigridSolver()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location;
+            cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0) < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (cell_population, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Solve the PDE using FE assembly
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_fe_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_fe_modifier->SetDependentVariableName("fe_variable");
+        p_fe_modifier->SetupSolve(cell_population,"TestAveragedBoxEllipticPdeWithMultigridSolver");
+
+        // Solve the PDE using the multigrid solver
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseMultigridSolver(), false);
+        p_pde_modifier->SetUseMultigridSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseMultigridSolver(), true);
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedBoxEllipticPdeWithMultigridSolver");
+
+        // The FE solver is not used, and the 20x20 grid is coarsened twice
+        TS_ASSERT(!p_pde_modifier->mpSolver);
+        TS_ASSERT(p_pde_modifier->mpMultigridSolver);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpMultigridSolver->GetNumLevels(), 3u);
+
+        // The two solutions agree to second order in the step size
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("variable"), cell_iter->GetCellData()->GetItem("fe_variable"), 1e-2);
+        }
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8605, 1e-2);
+
+        // The multigrid solver is reused on subsequent time steps
+        BoxDomainMultigridSolver<2>* p_solver = p_pde_modifier->mpMultigridSolver.get();
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpMultigridSolver.get(), p_solver);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8605, 1e-2);
+    }
+
     void TestNodeBasedSquareMonolayer()
     {
         HoneycombMeshGenerator generator(10,10,0);
@@ -518,6 +518,14 @@ public:
         TS_ASSERT_DELTA(cell_population.GetLocationOfCellCentre(p_cell_210)[0], 10, 1e-4);
         TS_ASSERT_DELTA(cell_population.GetLocationOfCellCentre(p_cell_210)[1], 5.0*sqrt(3.0), 1e-4);
         TS_ASSERT_DELTA(p_cell_210->GetCellData()->GetItem("variable"), 0.4542, 1e-4);
+
+        // The FE mesh is the population's own mesh and is unchanged, so solving again reuses the PDE solver
+        CellBasedEllipticPdeSolver<2>* p_solver = p_pde_modifier->mpSolver.get();
+        TS_ASSERT(p_solver != nullptr);
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        TS_ASSERT_EQUALS(p_pde_modifier->FeMeshTopologyIsUnchanged(), true);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpSolver.get(), p_solver);
+        TS_ASSERT_DELTA(p_cell_210->GetCellData()->GetItem("variable"), 0.4542, 1e-4);
     }
 
     void TestNodeBasedSquareMonolayer()
@@ -570,6 +578,11 @@ public:
         // Checking it doesn't change for this cell population
         TS_ASSERT_DELTA(p_cell_210->GetCellData()->GetItem("variable"), 0.4476, 1e-4);
 
+        // The FE mesh is regenerated at each time step, so is never treated as unchanged
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        TS_ASSERT_EQUALS(p_pde_modifier->FeMeshTopologyIsUnchanged(), false);
+        TS_ASSERT_DELTA(p_cell_210->GetCellData()->GetItem("variable"), 0.4476, 1e-4);
+
         // Clear memory
         delete p_mesh;
     }
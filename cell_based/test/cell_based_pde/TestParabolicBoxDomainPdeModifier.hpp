@@ -138,6 +138,7 @@ public:
             Vec vector = PetscTools::CreateVec(data);
             ParabolicBoxDomainPdeModifier<2> modifier(p_pde, p_bc, false, p_cuboid, 2.0, vector);
             modifier.SetDependentVariableName("averaged quantity");
+            modifier.rGetPdeTimeStepController().SetPdeTimeStep(0.25);
 
             // Create an output archive
             std::ofstream ofs(archive_filename.c_str());
@@ -162,6 +163,7 @@ public:
             TS_ASSERT_EQUALS((static_cast<ParabolicBoxDomainPdeModifier<2>*>(p_modifier2))->rGetDependentVariableName(), "averaged quantity");
             TS_ASSERT_DELTA((static_cast<ParabolicBoxDomainPdeModifier<2>*>(p_modifier2))->GetStepSize(), 2.0, 1e-5);
             TS_ASSERT_EQUALS((static_cast<ParabolicBoxDomainPdeModifier<2>*>(p_modifier2))->AreBcsSetOnBoxBoundary(), true);
+            TS_ASSERT_DELTA((static_cast<ParabolicBoxDomainPdeModifier<2>*>(p_modifier2))->rGetPdeTimeStepController().GetPdeTimeStep(), 0.25, 1e-12);
 
             Vec solution = (static_cast<ParabolicBoxDomainPdeModifier<2>*>(p_modifier2))->GetSolution();
             ReplicatableVector solution_repl(solution);
@@ -225,11 +227,20 @@ public:
         p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithMeshOnSquare");
 
         // Run for 10 time steps
+        SimpleLinearParabolicSolver<2,2>* p_solver = nullptr;
         for (unsigned i=0; i<10; i++)
         {
             SimulationTime::Instance()->IncrementTimeOneStep();
             p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
             p_pde_modifier->UpdateAtEndOfOutputTimeStep(cell_population);
+
+            // The box domain is fixed, so the PDE solver is created once and then reused
+            if (i == 0)
+            {
+                p_solver = p_pde_modifier->mpSolver.get();
+                TS_ASSERT(p_solver != nullptr);
+            }
+            TS_ASSERT_EQUALS(p_pde_modifier->mpSolver.get(), p_solver);
         }
 
         // Test the solution at some fixed points to compare with other cell populations
@@ -317,6 +328,160 @@ public:
         TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.2981, 1e-4);
     }
 
+    void TestMeshBasedSquareMonolayerWithNeumanBcsAndMultigridSolver()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+            cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location;
+            cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0) < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+
+            // Set initial condition for both PDEs
+            cells[i]->GetCellData()->SetItem("variable",1.0);
+            cells[i]->GetCellData()->SetItem("fe_variable",1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create PDE modifiers using FE assembly and the multigrid solver respectively
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_fe_modifier, (p_pde, p_bc, true, p_cuboid));
+        p_fe_modifier->SetDependentVariableName("fe_variable");
+        p_fe_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithMultigridSolver");
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, true, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetUseMultigridSolver(true);
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithMultigridSolver");
+
+        // Run for 10 time steps
+        for (unsigned i=0; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_fe_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+        TS_ASSERT(!p_pde_modifier->mpSolver);
+
+        // The two solutions agree to second order in the step size
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("variable"), cell_iter->GetCellData()->GetItem("fe_variable"), 2e-2);
+        }
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 2.0029, 2e-2);
+    }
+
+    void TestMeshBasedSquareMonolayerWithDecoupledPdeTimeStep()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+            cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location;
+            cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0) < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+
+            // Set initial condition for each PDE
+            cells[i]->GetCellData()->SetItem("variable",1.0);
+            cells[i]->GetCellData()->SetItem("subcycled_variable",1.0);
+            cells[i]->GetCellData()->SetItem("lagged_variable",1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create PDE modifiers advancing the PDE with the cell-based time step, with four PDE steps per
+        // cell-based time step, and once every two cell-based time steps respectively
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, true, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithDecoupledPdeTimeStep");
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_subcycled_modifier, (p_pde, p_bc, true, p_cuboid));
+        p_subcycled_modifier->SetDependentVariableName("subcycled_variable");
+        p_subcycled_modifier->rGetPdeTimeStepController().SetPdeTimeStep(0.025);
+        p_subcycled_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithDecoupledPdeTimeStep");
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_lagged_modifier, (p_pde, p_bc, true, p_cuboid));
+        p_lagged_modifier->SetDependentVariableName("lagged_variable");
+        p_lagged_modifier->rGetPdeTimeStepController().SetPdeTimeStep(0.2);
+        p_lagged_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithDecoupledPdeTimeStep");
+
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+
+        // Run for 10 time steps
+        for (unsigned i=0; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_subcycled_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_lagged_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+            // The lagged PDE is only advanced at every other time step
+            double expected_last_update_time = (i%2 == 0) ? 0.1*i : 0.1*(i+1);
+            TS_ASSERT_DELTA(p_lagged_modifier->rGetPdeTimeStepController().GetLastUpdateTime(), expected_last_update_time, 1e-10);
+            if (i == 0)
+            {
+                TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("lagged_variable"), 1.0, 1e-12);
+            }
+        }
+
+        // The subcycled solution matches the default solution to first order in the time step
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 2.0029, 1e-4);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("subcycled_variable"), 2.0029, 5e-2);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("lagged_variable"), 2.0029, 1e-1);
+    }
+
     void TestNodeBasedSquareMonolayer()
     {
         HoneycombMeshGenerator generator(10,10,0);
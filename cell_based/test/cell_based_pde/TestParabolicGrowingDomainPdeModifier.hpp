@@ -164,6 +164,7 @@ public:
             Vec vector = PetscTools::CreateVec(data);
             ParabolicGrowingDomainPdeModifier<2> modifier(p_pde, p_bc, false, vector);
             modifier.SetDependentVariableName("averaged quantity");
+            modifier.rGetPdeTimeStepController().SetAdaptivePdeTimeStep(1e-2, 0.01, 0.5);
 
             // Create an output archive
             std::ofstream ofs(archive_filename.c_str());
@@ -188,6 +189,10 @@ public:
             std::string variable_name = (static_cast<ParabolicGrowingDomainPdeModifier<2>*>(p_modifier2))->rGetDependentVariableName();
             TS_ASSERT_EQUALS(variable_name, "averaged quantity");
 
+            ParabolicPdeTimeStepController& r_controller = (static_cast<ParabolicGrowingDomainPdeModifier<2>*>(p_modifier2))->rGetPdeTimeStepController();
+            TS_ASSERT_EQUALS(r_controller.IsAdaptive(), true);
+            TS_ASSERT_DELTA(r_controller.GetPdeTimeStep(), 0.01, 1e-12);
+
             Vec solution = (static_cast<ParabolicGrowingDomainPdeModifier<2>*>(p_modifier2))->GetSolution();
             ReplicatableVector solution_repl(solution);
 
@@ -0,0 +1,149 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTPARABOLICPDETIMESTEPCONTROLLER_HPP_
+#define TESTPARABOLICPDETIMESTEPCONTROLLER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "ParabolicPdeTimeStepController.hpp"
+#include "PetscTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestParabolicPdeTimeStepController : public CxxTest::TestSuite
+{
+public:
+
+    void TestDefaultBehaviour()
+    {
+        ParabolicPdeTimeStepController controller;
+        TS_ASSERT_EQUALS(controller.GetPdeTimeStep(), DOUBLE_UNSET);
+        TS_ASSERT_EQUALS(controller.IsAdaptive(), false);
+        TS_ASSERT_EQUALS(controller.IsQuasiSteady(), false);
+
+        // By default the PDE is advanced by a single step at every cell-based time step
+        controller.Reset(1.0);
+        TS_ASSERT_DELTA(controller.GetLastUpdateTime(), 1.0, 1e-12);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(1.1, 0.1), true);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.1), 1u);
+
+        TS_ASSERT_THROWS_THIS(controller.SetPdeTimeStep(0.0), "The PDE time step must be positive");
+        TS_ASSERT_THROWS_THIS(controller.SetAdaptivePdeTimeStep(0.1, 0.2, 0.1),
+            "The tolerance and PDE time step bounds must be positive, with the minimum no larger than the maximum");
+        TS_ASSERT_THROWS_THIS(controller.SetQuasiSteadyTolerance(-1.0), "The quasi-steady tolerance must be positive");
+    }
+
+    void TestFixedPdeTimeStep()
+    {
+        ParabolicPdeTimeStepController controller;
+        controller.Reset(0.0);
+
+        // A PDE time step shorter than the cell-based time step is subcycled
+        controller.SetPdeTimeStep(0.03);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(0.1, 0.1), true);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.1), 4u);
+        controller.SetPdeTimeStep(0.025);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.1), 4u);
+
+        // A PDE time step longer than the cell-based time step delays updates
+        controller.SetPdeTimeStep(0.3);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(0.1, 0.1), false);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(0.2, 0.1), false);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(0.1+0.1+0.1, 0.1), true);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.3), 1u);
+
+        Vec previous_solution = PetscTools::CreateAndSetVec(5, 1.0);
+        Vec solution = PetscTools::CreateAndSetVec(5, 2.0);
+        controller.RecordUpdate(0.3, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetLastUpdateTime(), 0.3, 1e-12);
+        TS_ASSERT_EQUALS(controller.IsUpdateDue(0.4, 0.1), false);
+
+        // The PDE time step is unchanged as it is not adaptive
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.3, 1e-12);
+
+        PetscTools::Destroy(previous_solution);
+        PetscTools::Destroy(solution);
+    }
+
+    void TestAdaptivePdeTimeStepAndQuasiSteadyState()
+    {
+        ParabolicPdeTimeStepController controller;
+        controller.SetAdaptivePdeTimeStep(0.01, 0.01, 0.08);
+        controller.SetQuasiSteadyTolerance(1e-3);
+        TS_ASSERT_EQUALS(controller.IsAdaptive(), true);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.01, 1e-12);
+        controller.Reset(0.0);
+
+        Vec previous_solution = PetscTools::CreateAndSetVec(5, 1.0);
+
+        // A relative change of 0.5 over 0.1 time units requires the shortest PDE time step
+        Vec solution = PetscTools::CreateAndSetVec(5, 2.0);
+        controller.RecordUpdate(0.1, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.01, 1e-12);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.1), 10u);
+        TS_ASSERT_EQUALS(controller.IsQuasiSteady(), false);
+        PetscTools::Destroy(solution);
+
+        // A relative change of 0.01 over 0.1 time units allows a PDE time step of 0.1, but this
+        // may at most double at each update and is bounded above
+        solution = PetscTools::CreateAndSetVec(5, 1.0/0.99);
+        controller.RecordUpdate(0.2, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.02, 1e-12);
+        controller.RecordUpdate(0.3, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.04, 1e-12);
+        controller.RecordUpdate(0.4, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.08, 1e-12);
+        controller.RecordUpdate(0.5, previous_solution, solution);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.08, 1e-12);
+        TS_ASSERT_EQUALS(controller.IsQuasiSteady(), false);
+        PetscTools::Destroy(solution);
+
+        // Once the solution is barely changing it is taken to be quasi-steady, so no longer subcycled
+        solution = PetscTools::CreateAndSetVec(5, 1.0 + 1e-6);
+        controller.RecordUpdate(0.6, previous_solution, solution);
+        TS_ASSERT_EQUALS(controller.IsQuasiSteady(), true);
+        TS_ASSERT_EQUALS(controller.GetNumSubSteps(0.1), 1u);
+
+        // Resetting the controller restores the shortest PDE time step
+        controller.Reset(0.0);
+        TS_ASSERT_DELTA(controller.GetPdeTimeStep(), 0.01, 1e-12);
+        TS_ASSERT_EQUALS(controller.IsQuasiSteady(), false);
+
+        PetscTools::Destroy(previous_solution);
+        PetscTools::Destroy(solution);
+    }
+};
+
+#endif /*TESTPARABOLICPDETIMESTEPCONTROLLER_HPP_*/
@@ -1394,6 +1394,97 @@ public:
         TS_ASSERT_EQUALS(mesh.GetNumElements(), 2u);
     }
 
+    void TestNeighbourTables()
+    {
+        // The neighbour views agree with the neighbour sets in a periodic 3D mesh
+        PottsMeshGenerator<3> generator(3, 1, 3, 3, 1, 3, 3, 1, 3, false, true, true, true);
+        PottsMesh<3>* p_mesh = generator.GetMesh();
+
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            PottsNeighbourTable::Range moore_neighbours = p_mesh->GetMooreNeighbours(node_index);
+            std::set<unsigned> moore_neighbour_set = p_mesh->GetMooreNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(moore_neighbours.size(), 26u);
+            TS_ASSERT(std::equal(moore_neighbours.begin(), moore_neighbours.end(), moore_neighbour_set.begin()));
+
+            PottsNeighbourTable::Range von_neumann_neighbours = p_mesh->GetVonNeumannNeighbours(node_index);
+            std::set<unsigned> von_neumann_neighbour_set = p_mesh->GetVonNeumannNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(von_neumann_neighbours.size(), 6u);
+            TS_ASSERT(std::equal(von_neumann_neighbours.begin(), von_neumann_neighbours.end(), von_neumann_neighbour_set.begin()));
+        }
+
+        // Test removing a node from a table
+        std::vector<std::set<unsigned> > neighbours(4);
+        neighbours[0].insert(1);
+        neighbours[0].insert(3);
+        neighbours[1].insert(0);
+        neighbours[1].insert(2);
+        neighbours[2].insert(1);
+        neighbours[2].insert(3);
+        neighbours[3].insert(0);
+        neighbours[3].insert(2);
+
+        PottsNeighbourTable table;
+        TS_ASSERT_EQUALS(table.GetNumNodes(), 0u);
+        table.SetNeighbours(neighbours);
+        TS_ASSERT_EQUALS(table.GetNumNodes(), 4u);
+        TS_ASSERT(table.GetNeighbourSets() == neighbours);
+
+        table.RemoveNode(1);
+        TS_ASSERT_EQUALS(table.GetNumNodes(), 3u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(0).size(), 1u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(0)[0], 2u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(1).size(), 1u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(1)[0], 2u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(2).size(), 2u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(2)[0], 0u);
+        TS_ASSERT_EQUALS(table.GetNeighbours(2)[1], 1u);
+    }
+
+    void TestMoveNodeToElementWithCachedSurfaceAreas()
+    {
+        // Create a mesh with four 2 by 2 elements surrounded by medium
+        PottsMeshGenerator<2> generator(6, 2, 2, 6, 2, 2);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), 4u);
+        TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(0), 8.0, 1e-12);
+
+        p_mesh->CacheElementSurfaceAreas();
+        TS_ASSERT_EQUALS(p_mesh->mElementSurfaceAreas.size(), 4u);
+
+        // Move nodes between elements, from an element to the medium and from the medium to an element
+        unsigned element_0_node = p_mesh->GetElement(0)->GetNodeGlobalIndex(0);
+        unsigned element_1_node = p_mesh->GetElement(1)->GetNodeGlobalIndex(0);
+        p_mesh->MoveNodeToElement(element_1_node, 0);
+        p_mesh->MoveNodeToElement(element_0_node, UNSIGNED_UNSET);
+        p_mesh->MoveNodeToElement(element_0_node, 2);
+        p_mesh->MoveNodeToElement(element_0_node, 2); // Does nothing
+
+        TS_ASSERT_EQUALS(p_mesh->GetElement(0)->GetNumNodes(), 4u);
+        TS_ASSERT_EQUALS(p_mesh->GetElement(1)->GetNumNodes(), 3u);
+        TS_ASSERT_EQUALS(p_mesh->GetElement(2)->GetNumNodes(), 5u);
+        TS_ASSERT_EQUALS(p_mesh->GetNode(element_0_node)->GetNumContainingElements(), 1u);
+        TS_ASSERT_EQUALS(*(p_mesh->GetNode(element_0_node)->rGetContainingElementIndices().begin()), 2u);
+
+        // The incrementally updated surface areas match those computed from scratch
+        std::vector<double> cached_surface_areas;
+        for (unsigned elem_index=0; elem_index<4; elem_index++)
+        {
+            cached_surface_areas.push_back(p_mesh->GetSurfaceAreaOfElement(elem_index));
+        }
+        p_mesh->ClearElementSurfaceAreaCache();
+        TS_ASSERT_EQUALS(p_mesh->mElementSurfaceAreas.size(), 0u);
+        for (unsigned elem_index=0; elem_index<4; elem_index++)
+        {
+            TS_ASSERT_DELTA(cached_surface_areas[elem_index], p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+        }
+
+        // Any other change to the elements clears the cache
+        p_mesh->CacheElementSurfaceAreas();
+        p_mesh->DeleteElement(3);
+        TS_ASSERT_EQUALS(p_mesh->mElementSurfaceAreas.size(), 0u);
+    }
+
     void TestDividePottsElementIn2d()
     {
         {
@@ -50,6 +50,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "DiffusionCaUpdateRule.hpp"
+#include "RandomCaSwitchingUpdateRule.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
 #include "ArchiveOpener.hpp"
 #include "WildTypeCellMutationState.hpp"
@@ -259,6 +260,14 @@ public:
         TS_ASSERT_THROWS_THIS(cell_population.RemoveCellUsingLocationIndex(0,cells[0]),
             "Tried to remove a cell which is not attached to the given location index");
 
+        // Location indices beyond any that have had a cell attached are empty
+        TS_ASSERT(!cell_population.IsCellAttachedToLocationIndex(100));
+        TS_ASSERT_EQUALS(cell_population.GetCellsUsingLocationIndex(100).size(), 0u);
+        TS_ASSERT_THROWS_THIS(cell_population.GetCellUsingLocationIndex(100),
+            "Location index input argument does not correspond to a Cell");
+        TS_ASSERT_THROWS_THIS(cell_population.RemoveCellUsingLocationIndex(100,cells[0]),
+            "Tried to remove a cell which is not attached to the given location index");
+
         // Check cells are in the correct locations
         TS_ASSERT(!cell_population.IsCellAttachedToLocationIndex(0));
         TS_ASSERT(cell_population.IsCellAttachedToLocationIndex(1));
@@ -770,6 +779,161 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 1u);
     }
 
+    void TestUpdateCellLocationsUsingKineticMonteCarlo()
+    {
+        // Create a simple 2D PottsMesh with one cell
+        PottsMeshGenerator<2> generator(5, 0, 0, 5, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 1);
+
+        std::vector<unsigned> location_indices;
+        location_indices.push_back(12);
+
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+        TS_ASSERT_EQUALS(cell_population.GetUseKineticMonteCarlo(), false);
+        cell_population.SetUseKineticMonteCarlo(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseKineticMonteCarlo(), true);
+
+        // With no update rules nothing happens
+        TS_ASSERT_THROWS_NOTHING(cell_population.UpdateCellLocations(1.0));
+        TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(*(cell_population.Begin())), 12u);
+
+        MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+        p_diffusion_update_rule->SetDiffusionParameter(1.0);
+        cell_population.AddUpdateRule(p_diffusion_update_rule);
+
+        // The total rate of moving is 3, so over a very short time step the cell is very unlikely to move
+        cell_population.UpdateCellLocations(1e-6);
+        TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(*(cell_population.Begin())), 12u);
+
+        // Unlike the lattice sweep, time steps for which a move is probable are allowed
+        for (unsigned i=0; i<10; i++)
+        {
+            TS_ASSERT_THROWS_NOTHING(cell_population.UpdateCellLocations(5.0));
+
+            unsigned location_index = cell_population.GetLocationIndexUsingCell(*(cell_population.Begin()));
+            TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[location_index], 0u);
+            unsigned num_available_spaces = 0;
+            for (unsigned node_index=0; node_index<25; node_index++)
+            {
+                num_available_spaces += cell_population.rGetAvailableSpaces()[node_index];
+            }
+            TS_ASSERT_EQUALS(num_available_spaces, 24u);
+        }
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 1u);
+    }
+
+    void TestUpdateCellLocationsUsingKineticMonteCarloWithSwitching()
+    {
+        // Create a simple 2D PottsMesh with four cells along one edge
+        PottsMeshGenerator<2> generator(4, 0, 0, 4, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 4);
+
+        std::vector<unsigned> location_indices;
+        for (unsigned i=0; i<4; i++)
+        {
+            location_indices.push_back(i);
+        }
+
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+        cell_population.SetUseKineticMonteCarlo(true);
+
+        MAKE_PTR(RandomCaSwitchingUpdateRule<2u>, p_switching_update_rule);
+        p_switching_update_rule->SetSwitchingParameter(1.0);
+        cell_population.AddUpdateRule(p_switching_update_rule);
+
+        for (unsigned i=0; i<10; i++)
+        {
+            cell_population.UpdateCellLocations(1.0);
+
+            // Each cell remains on its own site
+            std::set<unsigned> occupied_sites;
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                unsigned location_index = cell_population.GetLocationIndexUsingCell(*cell_iter);
+                TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[location_index], 0u);
+                occupied_sites.insert(location_index);
+            }
+            TS_ASSERT_EQUALS(occupied_sites.size(), 4u);
+        }
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 4u);
+    }
+
+    void TestKineticMonteCarloPropensitiesAfterCellDeath()
+    {
+        // Create a simple 2D PottsMesh with four cells
+        PottsMeshGenerator<2> generator(5, 0, 0, 5, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 4);
+
+        std::vector<unsigned> location_indices;
+        location_indices.push_back(6);
+        location_indices.push_back(7);
+        location_indices.push_back(12);
+        location_indices.push_back(18);
+
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+        cell_population.SetUseKineticMonteCarlo(true);
+
+        MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+        p_diffusion_update_rule->SetDiffusionParameter(1.0);
+        cell_population.AddUpdateRule(p_diffusion_update_rule);
+        MAKE_PTR(RandomCaSwitchingUpdateRule<2u>, p_switching_update_rule);
+        p_switching_update_rule->SetSwitchingParameter(0.5);
+        cell_population.AddUpdateRule(p_switching_update_rule);
+
+        for (unsigned i=0; i<3; i++)
+        {
+            cell_population.UpdateCellLocations(0.1);
+        }
+        TS_ASSERT_EQUALS(cell_population.mEventPropensitiesOutOfDate, false);
+
+        // Between time steps only the propensities near the dead cell's node are recomputed
+        (*cell_population.Begin())->Kill();
+        TS_ASSERT_EQUALS(cell_population.RemoveDeadCells(), 1u);
+        TS_ASSERT_EQUALS(cell_population.mNodesWithChangedOccupancy.size(), 1u);
+        cell_population.UpdateCellLocations(0.1);
+        TS_ASSERT_EQUALS(cell_population.mNodesWithChangedOccupancy.empty(), true);
+
+        // The propensities agree with recomputing those of every node
+        unsigned num_events = cell_population.mEventPropensities.GetNumEvents();
+        std::vector<double> propensities(num_events);
+        for (unsigned event_index=0; event_index<num_events; event_index++)
+        {
+            propensities[event_index] = cell_population.mEventPropensities.GetPropensity(event_index);
+        }
+        for (unsigned node_index=0; node_index<25; node_index++)
+        {
+            cell_population.UpdateEventPropensitiesAtNode(node_index, 0.1);
+        }
+        for (unsigned event_index=0; event_index<num_events; event_index++)
+        {
+            TS_ASSERT_DELTA(cell_population.mEventPropensities.GetPropensity(event_index), propensities[event_index], 1e-12);
+        }
+
+        // Changing the time step or update rules recomputes all propensities
+        cell_population.MarkEventPropensitiesOutOfDate();
+        TS_ASSERT_EQUALS(cell_population.mEventPropensitiesOutOfDate, true);
+        cell_population.UpdateCellLocations(0.2);
+        TS_ASSERT_EQUALS(cell_population.mEventPropensitiesOutOfDate, false);
+        TS_ASSERT_DELTA(cell_population.mEventPropensitiesTimeStep, 0.2, 1e-12);
+        cell_population.RemoveAllUpdateRules();
+        TS_ASSERT_EQUALS(cell_population.mEventPropensitiesOutOfDate, true);
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 3u);
+    }
+
     void TestArchiving()
     {
         FileFinder archive_dir("archive", RelativeTo::ChasteTestOutput);
@@ -823,6 +987,7 @@ public:
             // Set member variables in order to test that they are archived correctly
             static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetUpdateNodesInRandomOrder(false);
             static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetIterateRandomlyOverUpdateRuleCollection(true);
+            static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetUseKineticMonteCarlo(true);
 
             // Create output archive
             ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
@@ -877,6 +1042,7 @@ public:
 
             TS_ASSERT_EQUALS(p_static_population->GetUpdateNodesInRandomOrder(), false);
             TS_ASSERT_EQUALS(p_static_population->GetIterateRandomlyOverUpdateRuleCollection(), true);
+            TS_ASSERT_EQUALS(p_static_population->GetUseKineticMonteCarlo(), true);
 
             // Test that the update rule has been archived correctly
             std::vector<boost::shared_ptr<AbstractUpdateRule<2> > > update_rule_collection = p_static_population->GetUpdateRuleCollection();
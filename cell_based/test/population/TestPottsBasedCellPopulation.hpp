@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellsGenerator.hpp"
 #include "PottsBasedCellPopulation.hpp"
 #include "VolumeConstraintPottsUpdateRule.hpp"
+#include "SurfaceAreaConstraintPottsUpdateRule.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
@@ -421,6 +422,78 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetMesh().GetElement(1)->GetNumNodes(), 4u);
     }
 
+    void TestUpdateCellLocationsWithCheckerboardSweeps()
+    {
+        // Create a 2D PottsMesh with four cells surrounded by medium
+        PottsMeshGenerator<2> generator(10, 2, 3, 10, 2, 3);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        // Create cell population
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweeps(), false);
+        cell_population.SetUseCheckerboardSweeps(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweeps(), true);
+        cell_population.SetNumSweepsPerTimestep(3);
+        cell_population.SetTemperature(10.0);
+
+        // Create volume and surface area update rules and pass to the population
+        MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+        cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+        MAKE_PTR(SurfaceAreaConstraintPottsUpdateRule<2>, p_surface_area_constraint_update_rule);
+        cell_population.AddUpdateRule(p_surface_area_constraint_update_rule);
+
+        unsigned num_nodes_in_elements = 0;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            num_nodes_in_elements += p_mesh->GetElement(elem_index)->GetNumNodes();
+        }
+        TS_ASSERT_EQUALS(num_nodes_in_elements, 36u);
+
+        cell_population.UpdateCellLocations(1.0);
+
+        // On a regular lattice the nodes are split into a checkerboard of four sublattices
+        TS_ASSERT_EQUALS(cell_population.mSublattices.size(), 4u);
+        for (unsigned i=0; i<cell_population.mSublattices.size(); i++)
+        {
+            TS_ASSERT_EQUALS(cell_population.mSublattices[i].size(), 25u);
+            std::set<unsigned> sublattice(cell_population.mSublattices[i].begin(), cell_population.mSublattices[i].end());
+            for (unsigned j=0; j<cell_population.mSublattices[i].size(); j++)
+            {
+                std::set<unsigned> neighbours = p_mesh->GetMooreNeighbouringNodeIndices(cell_population.mSublattices[i][j]);
+                for (std::set<unsigned>::iterator iter = neighbours.begin(); iter != neighbours.end(); ++iter)
+                {
+                    TS_ASSERT_EQUALS(sublattice.count(*iter), 0u);
+                }
+            }
+        }
+
+        // The mesh remains consistent: each node is in at most one element, which contains it
+        num_nodes_in_elements = 0;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            PottsElement<2>* p_element = p_mesh->GetElement(elem_index);
+            num_nodes_in_elements += p_element->GetNumNodes();
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                std::set<unsigned> containing_elements = p_element->GetNode(local_index)->rGetContainingElementIndices();
+                TS_ASSERT_EQUALS(containing_elements.size(), 1u);
+                TS_ASSERT_EQUALS(*(containing_elements.begin()), elem_index);
+            }
+        }
+        unsigned num_contained_nodes = 0;
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            TS_ASSERT_LESS_THAN_EQUALS(p_mesh->GetNode(node_index)->GetNumContainingElements(), 1u);
+            num_contained_nodes += p_mesh->GetNode(node_index)->GetNumContainingElements();
+        }
+        TS_ASSERT_EQUALS(num_nodes_in_elements, num_contained_nodes);
+    }
+
     ///\todo implement this test (#1666)
 //    void TestVoronoiMethods()
 //    {
@@ -679,6 +752,7 @@ public:
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetNumSweepsPerTimestep(3);
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetUpdateNodesInRandomOrder(false);
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetIterateRandomlyOverUpdateRuleCollection(true);
+            static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetUseCheckerboardSweeps(true);
 
             // Archive the cell population
             (*p_arch) << static_cast<const SimulationTime&>(*p_simulation_time);
@@ -714,6 +788,7 @@ public:
             TS_ASSERT_EQUALS(p_static_population->GetNumSweepsPerTimestep(), 3u);
             TS_ASSERT_EQUALS(p_static_population->GetUpdateNodesInRandomOrder(), false);
             TS_ASSERT_EQUALS(p_static_population->GetIterateRandomlyOverUpdateRuleCollection(), true);
+            TS_ASSERT_EQUALS(p_static_population->GetUseCheckerboardSweeps(), true);
 
             // Test that the update rule has been archived correctly
             std::vector<boost::shared_ptr<AbstractUpdateRule<2> > > update_rule_collection = p_static_population->GetUpdateRuleCollection();
@@ -0,0 +1,84 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTPROPENSITYSUMTREE_HPP_
+#define TESTPROPENSITYSUMTREE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "PropensitySumTree.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestPropensitySumTree : public CxxTest::TestSuite
+{
+public:
+
+    void TestSetPropensitiesAndSampleEvents()
+    {
+        PropensitySumTree tree;
+        TS_ASSERT_EQUALS(tree.GetNumEvents(), 0u);
+        TS_ASSERT_DELTA(tree.GetTotalPropensity(), 0.0, 1e-12);
+
+        tree.Resize(5);
+        TS_ASSERT_EQUALS(tree.GetNumEvents(), 5u);
+        tree.SetPropensity(0, 1.0);
+        tree.SetPropensity(2, 2.0);
+        tree.SetPropensity(4, 0.5);
+        TS_ASSERT_DELTA(tree.GetPropensity(2), 2.0, 1e-12);
+        TS_ASSERT_DELTA(tree.GetTotalPropensity(), 3.5, 1e-12);
+
+        // Events are sampled from consecutive intervals of length equal to their propensities
+        TS_ASSERT_EQUALS(tree.SampleEvent(0.0), 0u);
+        TS_ASSERT_EQUALS(tree.SampleEvent(0.99), 0u);
+        TS_ASSERT_EQUALS(tree.SampleEvent(1.0), 2u);
+        TS_ASSERT_EQUALS(tree.SampleEvent(2.99), 2u);
+        TS_ASSERT_EQUALS(tree.SampleEvent(3.2), 4u);
+
+        // Events with zero propensity are never returned, even if the target is too large
+        TS_ASSERT_EQUALS(tree.SampleEvent(3.5), 4u);
+
+        tree.SetPropensity(2, 0.0);
+        TS_ASSERT_DELTA(tree.GetTotalPropensity(), 1.5, 1e-12);
+        TS_ASSERT_EQUALS(tree.SampleEvent(1.0), 4u);
+
+        tree.Clear();
+        TS_ASSERT_EQUALS(tree.GetNumEvents(), 5u);
+        TS_ASSERT_DELTA(tree.GetTotalPropensity(), 0.0, 1e-12);
+    }
+};
+
+#endif /*TESTPROPENSITYSUMTREE_HPP_*/
@@ -390,6 +390,46 @@ public:
         TS_ASSERT_THROWS_NOTHING(cell_population.Update());
     }
 
+    void TestNodePartitionAndReduceAppliedForces()
+    {
+        // Create a simple vertex-based mesh
+        HoneycombVertexMeshGenerator generator(4, 6);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        // Create cell population
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Apply a different force to each node
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2> force;
+            force[0] = node_index;
+            force[1] = -2.0*node_index;
+            p_mesh->GetNode(node_index)->ClearAppliedForce();
+            p_mesh->GetNode(node_index)->AddAppliedForceContribution(force);
+        }
+
+        // Sequentially, this process owns every node and reducing the forces leaves them unchanged
+        cell_population.UpdateNodePartition();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            TS_ASSERT(cell_population.IsNodeOwnedByThisProcess(node_index));
+        }
+
+        cell_population.ReduceAppliedForces();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2>& r_force = p_mesh->GetNode(node_index)->rGetAppliedForce();
+            TS_ASSERT_DELTA(r_force[0], node_index, 1e-12);
+            TS_ASSERT_DELTA(r_force[1], -2.0*node_index, 1e-12);
+        }
+    }
+
     void TestAddNode()
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -975,6 +1015,9 @@ public:
         cell_population.OpenWritersFiles(output_file_handler);
         cell_population.WriteResultsToFiles(output_directory);
 
+        // The element geometry is only cached while the results are written
+        TS_ASSERT_EQUALS(p_mesh->IsElementGeometryCached(), false);
+
         SimulationTime::Instance()->IncrementTimeOneStep();
         cell_population.Update();
         cell_population.WriteResultsToFiles(output_directory);
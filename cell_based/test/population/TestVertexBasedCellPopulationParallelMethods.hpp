@@ -0,0 +1,236 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_
+#define TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+
+#include "VertexBasedCellPopulation.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "CellMutationStatesCountWriter.hpp"
+#include "SmartPointers.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestVertexBasedCellPopulationParallelMethods : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestNodePartitionCoversEachNodeOnce()
+    {
+        // Create a simple vertex-based mesh
+        HoneycombVertexMeshGenerator generator(4, 6);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        // Create cell population, which partitions the nodes between processes
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Each node should be owned by exactly one process
+        unsigned num_nodes = p_mesh->GetNumNodes();
+        std::vector<unsigned> local_owned(num_nodes, 0u);
+        unsigned num_local_owned = 0;
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            if (cell_population.IsNodeOwnedByThisProcess(node_index))
+            {
+                local_owned[node_index] = 1u;
+                num_local_owned++;
+            }
+        }
+        std::vector<unsigned> global_owned(num_nodes);
+        MPI_Allreduce(&local_owned[0], &global_owned[0], num_nodes, MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            TS_ASSERT_EQUALS(global_owned[node_index], 1u);
+        }
+
+        // The nodes are shared out evenly
+        TS_ASSERT_LESS_THAN_EQUALS(num_local_owned, num_nodes/PetscTools::GetNumProcs() + 1);
+        TS_ASSERT_LESS_THAN_EQUALS(num_nodes/PetscTools::GetNumProcs(), num_local_owned);
+
+        // Apply the correct force to owned nodes and a wrong one to all others
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            c_vector<double, 2> force;
+            force[0] = node_index;
+            force[1] = -2.0*node_index;
+            if (!cell_population.IsNodeOwnedByThisProcess(node_index))
+            {
+                force[0] += 1000.0;
+            }
+            p_mesh->GetNode(node_index)->ClearAppliedForce();
+            p_mesh->GetNode(node_index)->AddAppliedForceContribution(force);
+        }
+
+        // After reducing the forces, every process holds the owner's force on each node
+        cell_population.ReduceAppliedForces();
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            c_vector<double, 2>& r_force = p_mesh->GetNode(node_index)->rGetAppliedForce();
+            TS_ASSERT_DELTA(r_force[0], node_index, 1e-12);
+            TS_ASSERT_DELTA(r_force[1], -2.0*node_index, 1e-12);
+        }
+    }
+
+    void TestPartitionedForcesMatchUnpartitionedForces()
+    {
+        // Create two identical vertex-based meshes
+        HoneycombVertexMeshGenerator generator(5, 5);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        HoneycombVertexMeshGenerator reference_generator(5, 5);
+        MutableVertexMesh<2,2>* p_reference_mesh = reference_generator.GetMesh();
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        std::vector<CellPtr> reference_cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+        cells_generator.GenerateBasic(reference_cells, p_reference_mesh->GetNumElements());
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            cells[i]->GetCellData()->SetItem("target area", 0.5);
+            reference_cells[i]->GetCellData()->SetItem("target area", 0.5);
+        }
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        VertexBasedCellPopulation<2> reference_cell_population(*p_reference_mesh, reference_cells);
+
+        // Adding an isolated node makes the reference partition out of date, so every process computes every force
+        unsigned num_nodes = p_mesh->GetNumNodes();
+        p_reference_mesh->AddNode(new Node<2>(num_nodes, false, 100.0, 100.0));
+
+        NagaiHondaForce<2> force;
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            p_mesh->GetNode(node_index)->ClearAppliedForce();
+            p_reference_mesh->GetNode(node_index)->ClearAppliedForce();
+        }
+        p_reference_mesh->GetNode(num_nodes)->ClearAppliedForce();
+
+        force.AddForceContribution(cell_population);
+        cell_population.ReduceAppliedForces();
+        force.AddForceContribution(reference_cell_population);
+        reference_cell_population.ReduceAppliedForces();
+
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            TS_ASSERT(reference_cell_population.IsNodeOwnedByThisProcess(node_index));
+            c_vector<double, 2>& r_force = p_mesh->GetNode(node_index)->rGetAppliedForce();
+            c_vector<double, 2>& r_reference_force = p_reference_mesh->GetNode(node_index)->rGetAppliedForce();
+            TS_ASSERT_DELTA(r_force[0], r_reference_force[0], 1e-12);
+            TS_ASSERT_DELTA(r_force[1], r_reference_force[1], 1e-12);
+        }
+
+        // Updating the population after remeshing partitions the nodes again
+        cell_population.Update();
+        unsigned num_local_owned = 0;
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            if (cell_population.IsNodeOwnedByThisProcess(node_index))
+            {
+                num_local_owned++;
+            }
+        }
+        unsigned num_global_owned;
+        MPI_Allreduce(&num_local_owned, &num_global_owned, 1, MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
+        TS_ASSERT_EQUALS(num_global_owned, p_mesh->GetNumNodes());
+    }
+
+    void TestSimulationAgreesAcrossProcesses()
+    {
+        // Create a simple vertex-based mesh
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Create differentiated cells, so that no cells divide
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements(), std::vector<unsigned>(), p_diff_type);
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.AddCellPopulationCountWriter<CellMutationStatesCountWriter>();
+
+        // Set up cell-based simulation
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestVertexBasedSimulationAgreesAcrossProcesses");
+        simulator.SetEndTime(0.1);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_nagai_honda_force);
+        simulator.AddForce(p_nagai_honda_force);
+        MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+        simulator.AddSimulationModifier(p_growth_modifier);
+
+        simulator.Solve();
+
+        // Every process holds the same copy of the mesh
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            for (unsigned i=0; i<2; i++)
+            {
+                double local_location = p_mesh->GetNode(node_index)->rGetLocation()[i];
+                double min_location;
+                double max_location;
+                MPI_Allreduce(&local_location, &min_location, 1, MPI_DOUBLE, MPI_MIN, PetscTools::GetWorld());
+                MPI_Allreduce(&local_location, &max_location, 1, MPI_DOUBLE, MPI_MAX, PetscTools::GetWorld());
+                TS_ASSERT_DELTA(min_location, max_location, 1e-12);
+            }
+        }
+
+        // Cells are counted once, not once per process
+        std::vector<unsigned> mutation_state_count = cell_population.GetCellMutationStateCount();
+        unsigned num_cells = 0;
+        for (unsigned i=0; i<mutation_state_count.size(); i++)
+        {
+            num_cells += mutation_state_count[i];
+        }
+        TS_ASSERT_EQUALS(num_cells, cell_population.GetNumRealCells());
+    }
+};
+
+#endif /*TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_*/
@@ -65,6 +65,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "PopulationTestingForce.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "BackwardEulerNumericalMethod.hpp"
+#include "AdaptiveRungeKuttaNumericalMethod.hpp"
+#include "AdaptiveForwardEulerNumericalMethod.hpp"
+#include "StepSizeException.hpp"
 #include "Warnings.hpp"
 
 
@@ -475,6 +479,218 @@ public:
         }
     }
 
+    void TestBackwardEulerWithMeshBased()
+    {
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create a cell population, with no ghost nodes at the moment
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Create numerical method for testing
+        MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+        TS_ASSERT_DELTA(p_be_method->GetTolerance(), 1e-6, 1e-12);
+        TS_ASSERT_EQUALS(p_be_method->GetMaxIterations(), 10u);
+        TS_ASSERT(!(p_be_method->HasAdaptiveTimestep()));
+
+        double dt = 0.01;
+
+        p_be_method->SetCellPopulation(&cell_population);
+        p_be_method->SetForceCollection(&force_collection);
+
+        // Save starting positions
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j][0] = cell_population.GetNode(j)->rGetLocation()[0];
+            old_posns[j][1] = cell_population.GetNode(j)->rGetLocation()[1];
+        }
+
+        // Update positions and check the answer
+        p_be_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            expectedLocation = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], dt);
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-6);
+        }
+
+        // With no iterations allowed to converge, a StepSizeException is thrown if adaptivity is switched on
+        p_be_method->SetMaxIterations(1);
+        p_be_method->SetTolerance(1e-16);
+        p_be_method->SetUseAdaptiveTimestep(true);
+        TS_ASSERT_THROWS_ANYTHING(p_be_method->UpdateAllNodePositions(dt));
+
+        // ...and otherwise just a warning
+        p_be_method->SetUseAdaptiveTimestep(false);
+        p_be_method->UpdateAllNodePositions(dt);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNextWarningMessage(), "Backward Euler iteration failed to converge: use a smaller timestep to avoid this.");
+        Warnings::QuietDestroy();
+    }
+
+    void TestAdaptiveRungeKuttaWithMeshBased()
+    {
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create a cell population, with no ghost nodes at the moment
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Create numerical method for testing
+        MAKE_PTR(AdaptiveRungeKuttaNumericalMethod<2>, p_rk_method);
+        TS_ASSERT(p_rk_method->HasAdaptiveTimestep());
+        TS_ASSERT_DELTA(p_rk_method->GetTolerance(), 1e-4, 1e-12);
+        TS_ASSERT_DELTA(p_rk_method->GetMaxTimeStepGrowthFactor(), 5.0, 1e-12);
+
+        double dt = 0.01;
+
+        p_rk_method->SetCellPopulation(&cell_population);
+        p_rk_method->SetForceCollection(&force_collection);
+
+        // Save starting positions
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j][0] = cell_population.GetNode(j)->rGetLocation()[0];
+            old_posns[j][1] = cell_population.GetNode(j)->rGetLocation()[1];
+        }
+
+        // Update positions and check the answer agrees with classical RK4 to within the local error
+        p_rk_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            expectedLocation = p_test_force->GetExpectedOneStepLocationRK4(j, damping, old_posns[j], dt);
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-9);
+        }
+
+        // The error is tiny, so the time step may grow by the maximum factor
+        TS_ASSERT_DELTA(p_rk_method->GetSuggestedNextTimeStep(dt), 5.0*dt, 1e-12);
+
+        // With a tiny tolerance the step is rejected, the nodes are not moved and a smaller step is suggested
+        p_rk_method->SetTolerance(1e-16);
+        std::vector<c_vector<double, 2> > posns_before_rejected_step = p_rk_method->SaveCurrentLocations();
+        try
+        {
+            p_rk_method->UpdateAllNodePositions(dt);
+            TS_FAIL("A StepSizeException should have been thrown");
+        }
+        catch (StepSizeException& e)
+        {
+            TS_ASSERT(!(e.IsTerminal()));
+            TS_ASSERT_LESS_THAN(e.GetSuggestedNewStep(), dt);
+        }
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - posns_before_rejected_step[j]), 0, 1e-12);
+        }
+    }
+
+    void TestAdaptiveForwardEulerWithMeshBased()
+    {
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create a cell population, with no ghost nodes at the moment
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Create numerical method for testing
+        MAKE_PTR(AdaptiveForwardEulerNumericalMethod<2>, p_afe_method);
+        TS_ASSERT(p_afe_method->HasAdaptiveTimestep());
+        TS_ASSERT_DELTA(p_afe_method->GetTargetDisplacementFraction(), 0.5, 1e-12);
+        TS_ASSERT_DELTA(p_afe_method->GetMaxTimeStepGrowthFactor(), 2.0, 1e-12);
+
+        double dt = 0.01;
+
+        p_afe_method->SetCellPopulation(&cell_population);
+        p_afe_method->SetForceCollection(&force_collection);
+
+        // Save starting positions
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j][0] = cell_population.GetNode(j)->rGetLocation()[0];
+            old_posns[j][1] = cell_population.GetNode(j)->rGetLocation()[1];
+        }
+
+        // Each step is a forward Euler step
+        p_afe_method->UpdateAllNodePositions(dt);
+
+        double max_displacement = 0.0;
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            expectedLocation = p_test_force->GetExpectedOneStepLocationFE(j, damping, old_posns[j], dt);
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-12);
+            max_displacement = std::max(max_displacement, norm_2(actualLocation - old_posns[j]));
+        }
+
+        // The nodes moved much less than the AbsoluteMovementThreshold, so the time step may grow by the maximum factor
+        TS_ASSERT_DELTA(p_afe_method->GetSuggestedNextTimeStep(dt), 2.0*dt, 1e-12);
+
+        // If the threshold is smaller then the time step is chosen to give the target displacement
+        cell_population.SetAbsoluteMovementThreshold(max_displacement);
+        TS_ASSERT_DELTA(p_afe_method->GetSuggestedNextTimeStep(dt), 0.5*dt, 1e-12);
+
+        p_afe_method->SetTargetDisplacementFraction(0.25);
+        p_afe_method->SetMaxTimeStepGrowthFactor(3.0);
+        TS_ASSERT_DELTA(p_afe_method->GetSuggestedNextTimeStep(dt), 0.25*dt, 1e-12);
+    }
+
     void TestSettingAndGettingFlags()
     {
         // Create numerical methods for testing
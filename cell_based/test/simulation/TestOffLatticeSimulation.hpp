@@ -49,6 +49,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "UniformCellCycleModel.hpp"
 #include "NoCellCycleModel.hpp"
+#include "TysonNovakCellCycleModel.hpp"
+#include "BernoulliTrialCellCycleModel.hpp"
 #include "GeneralisedLinearSpringForce.hpp"
 #include "ChemotacticForce.hpp"
 #include "RandomCellKiller.hpp"
@@ -1269,6 +1271,129 @@ public:
         TS_ASSERT_DELTA(simulator.rGetCellPopulation().rGetMesh().GetNode(0)->rGetLocation()[0], 0.3906,1e-4);
         TS_ASSERT_DELTA(simulator.rGetCellPopulation().rGetMesh().GetNode(0)->rGetLocation()[1], -0.1782,1e-4);
     }
+
+    /**
+     * Run a small simulation with serial or parallel cell model updates and record,
+     * for each cell ID, the cell's age, its location and (for Tyson-Novak cells)
+     * the state of its cell-cycle ODEs.
+     */
+    std::map<unsigned, std::vector<double> > RunSimulationWithCellModelUpdates(bool useParallelUpdates,
+                                                                               bool useBernoulliTrials)
+    {
+        HoneycombMeshGenerator generator(3, 3, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // Tyson-Novak cells share an ODE solver, which must be duplicated for each thread
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        if (useBernoulliTrials)
+        {
+            // These cells draw from the random number generator each time they are asked whether to divide
+            CellsGenerator<BernoulliTrialCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_transit_type);
+            for (unsigned i=0; i<cells.size(); i++)
+            {
+                static_cast<BernoulliTrialCellCycleModel*>(cells[i]->GetCellCycleModel())->SetDivisionProbability(0.5);
+                static_cast<BernoulliTrialCellCycleModel*>(cells[i]->GetCellCycleModel())->SetMinimumDivisionAge(0.0);
+            }
+        }
+        else
+        {
+            CellsGenerator<TysonNovakCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_transit_type);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestOffLatticeSimulationWithParallelCellModelUpdates");
+        simulator.SetEndTime(1.5);
+
+        TS_ASSERT_EQUALS(simulator.GetUseParallelCellModelUpdates(), false);
+        simulator.SetUseParallelCellModelUpdates(useParallelUpdates);
+        TS_ASSERT_EQUALS(simulator.GetUseParallelCellModelUpdates(), useParallelUpdates);
+
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        simulator.AddForce(p_force);
+
+        simulator.Solve();
+
+        std::map<unsigned, std::vector<double> > cell_states;
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            std::vector<double> state;
+            state.push_back(cell_iter->GetAge());
+            c_vector<double, 2> location = cell_population.GetLocationOfCellCentre(*cell_iter);
+            state.push_back(location[0]);
+            state.push_back(location[1]);
+            if (!useBernoulliTrials)
+            {
+                std::vector<double> concentrations = static_cast<TysonNovakCellCycleModel*>(cell_iter->GetCellCycleModel())->GetProteinConcentrations();
+                state.insert(state.end(), concentrations.begin(), concentrations.end());
+            }
+            cell_states[cell_iter->GetCellId()] = state;
+        }
+
+        // Leave the singletons as the next run expects to find them
+        tearDown();
+        setUp();
+
+        return cell_states;
+    }
+
+    void TestOffLatticeSimulationWithParallelCellModelUpdates()
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator does not work in parallel
+
+        /*
+         * The deterministic Tyson-Novak model gives the same cells, ages and ODE states
+         * with serial and parallel updates. Node locations differ, as the parallel updates
+         * draw from the random number generator to seed each cell's stream.
+         */
+        std::map<unsigned, std::vector<double> > serial_states = RunSimulationWithCellModelUpdates(false, false);
+        std::map<unsigned, std::vector<double> > parallel_states = RunSimulationWithCellModelUpdates(true, false);
+
+        TS_ASSERT_LESS_THAN(9u, serial_states.size());
+        TS_ASSERT_EQUALS(parallel_states.size(), serial_states.size());
+        for (std::map<unsigned, std::vector<double> >::iterator iter = serial_states.begin();
+             iter != serial_states.end();
+             ++iter)
+        {
+            TS_ASSERT_EQUALS(parallel_states.count(iter->first), 1u);
+            std::vector<double>& r_parallel_state = parallel_states[iter->first];
+            TS_ASSERT_EQUALS(r_parallel_state.size(), iter->second.size());
+            TS_ASSERT_DELTA(r_parallel_state[0], iter->second[0], 1e-12);
+            for (unsigned i=3; i<iter->second.size(); i++)
+            {
+                TS_ASSERT_DELTA(r_parallel_state[i], iter->second[i], 1e-10);
+            }
+        }
+
+        /*
+         * Cells that draw random numbers while being updated in parallel get their own
+         * stream, seeded from the simulation seed and the cell ID, so two runs with the
+         * same seed give the same cells in the same places whatever the thread schedule.
+         */
+        std::map<unsigned, std::vector<double> > first_states = RunSimulationWithCellModelUpdates(true, true);
+        std::map<unsigned, std::vector<double> > second_states = RunSimulationWithCellModelUpdates(true, true);
+
+        TS_ASSERT_LESS_THAN(9u, first_states.size());
+        TS_ASSERT_EQUALS(second_states.size(), first_states.size());
+        for (std::map<unsigned, std::vector<double> >::iterator iter = first_states.begin();
+             iter != first_states.end();
+             ++iter)
+        {
+            TS_ASSERT_EQUALS(second_states.count(iter->first), 1u);
+            std::vector<double>& r_second_state = second_states[iter->first];
+            TS_ASSERT_EQUALS(r_second_state.size(), iter->second.size());
+            for (unsigned i=0; i<iter->second.size(); i++)
+            {
+                TS_ASSERT_DELTA(r_second_state[i], iter->second[i], 1e-12);
+            }
+        }
+    }
 };
 
 #endif /*TESTOFFLATTICESIMULATION_HPP_*/
@@ -58,6 +58,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellVolumesWriter.hpp"
 #include "FileComparison.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "AdaptiveForwardEulerNumericalMethod.hpp"
+#include "NoCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
 
 // Cell population writers
 #include "CellMutationStatesCountWriter.hpp"
@@ -68,6 +71,64 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PetscSetupAndFinalize.hpp"
 
+/**
+ * A linear spring force which counts how many times it is evaluated.
+ */
+class ForceEvaluationCountingForce : public GeneralisedLinearSpringForce<2>
+{
+private:
+
+    /** The number of calls to AddForceContribution(). */
+    unsigned mNumEvaluations;
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Archive the force.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<GeneralisedLinearSpringForce<2> >(*this);
+        archive & mNumEvaluations;
+    }
+
+public:
+
+    /** Constructor. */
+    ForceEvaluationCountingForce()
+        : GeneralisedLinearSpringForce<2>(),
+          mNumEvaluations(0)
+    {
+    }
+
+    /**
+     * Overridden AddForceContribution() method.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    void AddForceContribution(AbstractCellPopulation<2>& rCellPopulation)
+    {
+        mNumEvaluations++;
+        GeneralisedLinearSpringForce<2>::AddForceContribution(rCellPopulation);
+    }
+
+    /** @return the number of calls to AddForceContribution() */
+    unsigned GetNumEvaluations()
+    {
+        return mNumEvaluations;
+    }
+};
+
+#include "SerializationExportWrapper.hpp"
+CHASTE_CLASS_EXPORT(ForceEvaluationCountingForce)
+#include "SerializationExportWrapperForCpp.hpp"
+CHASTE_CLASS_EXPORT(ForceEvaluationCountingForce)
+
 class TestOffLatticeSimulationWithNodeBasedCellPopulation : public AbstractCellBasedWithTimingsTestSuite
 {
 public:
@@ -736,6 +797,86 @@ public:
         delete nodes[1];
     }
 
+    /**
+     * Relax two overlapping cells with fixed and with adaptive forward Euler steps. The adaptive
+     * step is kept between simulation time steps and grows beyond the simulation time step, so
+     * far fewer force evaluations are needed.
+     */
+    void TestAdaptiveTimeStepExceedsSimulationTimeStep()
+    {
+        EXIT_IF_PARALLEL;    // Only one process would hold the cells
+
+        std::vector<unsigned> num_evaluations(2);
+        std::vector<double> separations(2);
+        for (unsigned run=0; run<2; run++)
+        {
+            bool use_adaptive_method = (run == 1);
+            if (use_adaptive_method)
+            {
+                tearDown();
+                setUp();
+            }
+
+            std::vector<Node<2>*> nodes;
+            nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+            nodes.push_back(new Node<2>(1, false, 0.5, 0.0));
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+            CellsGenerator<NoCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_diff_type);
+
+            NodeBasedCellPopulation<2> cell_population(mesh, cells);
+            cell_population.SetAbsoluteMovementThreshold(0.1);
+
+            OffLatticeSimulation<2> simulator(cell_population);
+            simulator.SetOutputDirectory("TestOffLatticeSimulationWithNodeBasedCellPopulationAdaptive");
+            simulator.SetDt(1.0/120.0);
+            simulator.SetSamplingTimestepMultiple(120);
+            simulator.SetEndTime(2.0);
+
+            MAKE_PTR(ForceEvaluationCountingForce, p_force);
+            p_force->SetCutOffLength(1.5);
+            simulator.AddForce(p_force);
+
+            if (use_adaptive_method)
+            {
+                MAKE_PTR(AdaptiveForwardEulerNumericalMethod<2>, p_method);
+                simulator.SetNumericalMethod(p_method);
+            }
+
+            simulator.Solve();
+
+            num_evaluations[run] = p_force->GetNumEvaluations();
+            separations[run] = norm_2(simulator.rGetCellPopulation().GetNode(1)->rGetLocation()
+                                      - simulator.rGetCellPopulation().GetNode(0)->rGetLocation());
+
+            if (use_adaptive_method)
+            {
+                // The kept step has grown beyond the simulation time step
+                TS_ASSERT_LESS_THAN(simulator.GetDt(), simulator.GetNumericalMethod()->GetLastAcceptedTimeStep());
+
+                // The node positions are up to date at the end of the simulation
+                TS_ASSERT_DELTA(simulator.GetNumericalMethod()->GetTimeSinceLastUpdate(), 0.0, 1e-12);
+            }
+
+            for (unsigned i=0; i<nodes.size(); i++)
+            {
+                delete nodes[i];
+            }
+        }
+
+        // The fixed step evaluates the forces once per simulation time step
+        TS_ASSERT_EQUALS(num_evaluations[0], 240u);
+        TS_ASSERT_LESS_THAN(num_evaluations[1], num_evaluations[0]/2);
+
+        // Both methods relax the cells to the spring rest length
+        TS_ASSERT_DELTA(separations[0], 1.0, 1e-3);
+        TS_ASSERT_DELTA(separations[1], 1.0, 0.1);
+    }
+
     void TestUpdateCellLocationsAndTopologyWithNoForce()
     {
         // Creates nodes and mesh
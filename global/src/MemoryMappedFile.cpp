@@ -0,0 +1,154 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "MemoryMappedFile.hpp"
+#include "Exception.hpp"
+
+#ifdef _MSC_VER
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _MSC_VER
+
+MemoryMappedFile::MemoryMappedFile()
+    : mpData(nullptr),
+      mSize(0),
+      mIsOpen(false)
+{
+}
+
+MemoryMappedFile::MemoryMappedFile(const std::string& rFileName)
+    : mpData(nullptr),
+      mSize(0),
+      mIsOpen(false)
+{
+    Open(rFileName);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+void MemoryMappedFile::Open(const std::string& rFileName)
+{
+    Close();
+
+#ifdef _MSC_VER
+    std::ifstream file(rFileName.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open file " + rFileName);
+    }
+    mSize = static_cast<std::size_t>(file.tellg());
+    mContents.resize(mSize);
+    file.seekg(0, std::ios::beg);
+    if (mSize > 0)
+    {
+        file.read(&mContents[0], mSize);
+        mpData = &mContents[0];
+    }
+#else
+    int file_descriptor = open(rFileName.c_str(), O_RDONLY);
+    if (file_descriptor == -1)
+    {
+        EXCEPTION("Could not open file " + rFileName);
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == -1)
+    {
+        // LCOV_EXCL_START
+        close(file_descriptor);
+        EXCEPTION("Could not determine the size of file " + rFileName);
+        // LCOV_EXCL_STOP
+    }
+    mSize = static_cast<std::size_t>(file_status.st_size);
+
+    // An empty file cannot be mapped, but there is nothing to read anyway
+    if (mSize > 0)
+    {
+        void* p_map = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (p_map == MAP_FAILED)
+        {
+            // LCOV_EXCL_START
+            close(file_descriptor);
+            mSize = 0;
+            EXCEPTION("Could not map file " + rFileName + " into memory");
+            // LCOV_EXCL_STOP
+        }
+        mpData = static_cast<const char*>(p_map);
+    }
+
+    // The mapping remains valid after the file descriptor is closed
+    close(file_descriptor);
+#endif // _MSC_VER
+
+    mIsOpen = true;
+}
+
+void MemoryMappedFile::Close()
+{
+#ifdef _MSC_VER
+    std::vector<char>().swap(mContents);
+#else
+    if (mpData != nullptr)
+    {
+        munmap(const_cast<char*>(mpData), mSize);
+    }
+#endif // _MSC_VER
+
+    mpData = nullptr;
+    mSize = 0;
+    mIsOpen = false;
+}
+
+bool MemoryMappedFile::IsOpen() const
+{
+    return mIsOpen;
+}
+
+const char* MemoryMappedFile::GetData() const
+{
+    return mpData;
+}
+
+std::size_t MemoryMappedFile::GetSize() const
+{
+    return mSize;
+}
@@ -0,0 +1,118 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef MEMORYMAPPEDFILE_HPP_
+#define MEMORYMAPPEDFILE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <boost/utility.hpp>
+
+/**
+ * Read-only access to the contents of a file through a single contiguous block of memory.
+ *
+ * On POSIX systems the file is mapped into memory with mmap(), so that pages are only read
+ * from disk when they are first touched and any part of a large file may be accessed in
+ * constant time without seeking. On Windows the whole file is instead read into memory when
+ * it is opened.
+ */
+class MemoryMappedFile : private boost::noncopyable
+{
+private:
+
+    /** Pointer to the start of the file contents, or NULL if no file is open or the file is empty. */
+    const char* mpData;
+
+    /** The size of the file in bytes. */
+    std::size_t mSize;
+
+    /** Whether a file is currently open. */
+    bool mIsOpen;
+
+#ifdef _MSC_VER
+    /** The file contents, on platforms where files are read into memory rather than mapped. */
+    std::vector<char> mContents;
+#endif // _MSC_VER
+
+public:
+
+    /**
+     * Default constructor. No file is opened until Open() is called.
+     */
+    MemoryMappedFile();
+
+    /**
+     * Constructor which opens the given file.
+     *
+     * @param rFileName  the absolute path of the file to open
+     */
+    explicit MemoryMappedFile(const std::string& rFileName);
+
+    /**
+     * Destructor, which closes any open file.
+     */
+    ~MemoryMappedFile();
+
+    /**
+     * Open a file, closing any file that is already open. Throws an exception if the file
+     * cannot be opened or mapped.
+     *
+     * @param rFileName  the absolute path of the file to open
+     */
+    void Open(const std::string& rFileName);
+
+    /**
+     * Close the file, if one is open.
+     */
+    void Close();
+
+    /**
+     * @return whether a file is currently open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @return a pointer to the start of the file contents (NULL if the file is empty).
+     */
+    const char* GetData() const;
+
+    /**
+     * @return the size of the file in bytes.
+     */
+    std::size_t GetSize() const;
+};
+
+#endif // MEMORYMAPPEDFILE_HPP_
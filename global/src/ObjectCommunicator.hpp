@@ -40,7 +40,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 
-#include <boost/scoped_array.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include "PetscTools.hpp" // For MPI methods
@@ -52,30 +54,41 @@ const unsigned MAX_BUFFER_SIZE = 1000000;
  * This is a helper class to enable classes that can be serialized to be sent using
  * PetSc MPI communication. The object is serialized in to a string of characters, and then
  * de-serialized on the receive process.
+ *
+ * Archives are written without the usual boost archive header (both ends of a message
+ * are always the same executable) and serialised straight into, or read straight out of,
+ * buffers which are owned by the communicator and reused between calls. This keeps the
+ * per-message overhead low when many small messages are exchanged every timestep, as
+ * in NodeBasedCellPopulation.
  */
 template<typename CLASS>
 class ObjectCommunicator
 {
 private:
 
-    /** A buffer for use in asynchronous communication */
-    char* mRecvBuffer;
+    /** Flags used when creating the boost archives. */
+    static const unsigned ARCHIVE_FLAGS = boost::archive::no_header;
 
-    /** A group of buffers for use in asynchronous communication.  There's one for each process so that
-     * a non-blocking send request won't accidentally overwrite a message which is actively being communicated
-     * to another remote process */
-    std::vector<char* > mSendBuffer;
+    /**
+     * A buffer for use in asynchronous communication.  This is allocated on the first call
+     * to IRecvObject() and reused thereafter.
+     */
+    std::vector<char> mRecvBuffer;
+
+    /**
+     * A buffer for use in blocking receives.  This grows to the largest message received so far
+     * and is reused thereafter.
+     */
+    std::vector<char> mBlockingRecvBuffer;
 
     /** A group of strings for use in asynchronous communication.  There's one for each process so that
      * a non-blocking send request won't accidentally overwrite a message which is actively being communicated
-     * to another remote process */
+     * to another remote process.  The strings are reused between sends, so their capacity is only grown
+     * when a larger message is sent. */
     std::vector<std::string> mSendString;
 
-    /** The size of a string we are waiting for in an asynchronous receive */
-    unsigned mRecvBufferLength;
-
-    /** The size of a string we are sending */
-    unsigned mSendBufferLength;
+    /** One MPI_Request per process, for the most recent non-blocking send to that process. */
+    std::vector<MPI_Request> mSendRequests;
 
     /** An MPI_Request used in MPI_Irecv */
     MPI_Request mMpiRequest;
@@ -83,6 +96,32 @@ private:
     /** A flag, used as a lock to ensure that we don't accidentally start overwriting the above buffer, #mRecvBuffer */
     bool mIsWriting;
 
+    /**
+     * Serialize an object into a string, reusing the string's storage.
+     *
+     * @param pObject A pointer to the object to be serialized
+     * @param rString the string to write to (any previous contents are discarded)
+     */
+    void SerializeToString(boost::shared_ptr<CLASS> const pObject, std::string& rString);
+
+    /**
+     * De-serialize an object from a buffer of characters.
+     *
+     * @param pBuffer the start of the buffer
+     * @param length the number of characters in the buffer
+     *
+     * @return A pointer to the new object.
+     */
+    boost::shared_ptr<CLASS> DeserializeFromBuffer(const char* pBuffer, unsigned length);
+
+    /**
+     * Wait for the most recent non-blocking send to a given process to complete, so that
+     * its buffer may be safely reused.
+     *
+     * @param destinationProcess the rank of the process
+     */
+    void WaitForSend(unsigned destinationProcess);
+
 public:
 
     /**
@@ -90,6 +129,11 @@ public:
      */
     ObjectCommunicator();
 
+    /**
+     * Destructor.  Waits for any outstanding non-blocking sends, since they reference our buffers.
+     */
+    ~ObjectCommunicator();
+
     /**
      * Send an object.
      *
@@ -102,6 +146,9 @@ public:
     /**
      * Send an object.
      *
+     * If a previous non-blocking send to the same process is still in progress, this waits
+     * for it to complete before its buffer is reused.
+     *
      * @param pObject A pointer to the object to be sent
      * @param destinationProcess the index of the process to send the data to
      * @param tag a unique identifier tag for this communication
@@ -149,62 +196,98 @@ public:
     boost::shared_ptr<CLASS> SendRecvObject(boost::shared_ptr<CLASS> const pSendObject, unsigned destinationProcess, unsigned sendTag, unsigned sourceProcess, unsigned sourceTag, MPI_Status& status);
 };
 
-#include <sstream>
+#include <algorithm>
 #include <string>
-#include <cstring>
 
 // Implementation needs to be here, as CLASS could be anything
 template<typename CLASS>
 ObjectCommunicator<CLASS>::ObjectCommunicator()
     : mIsWriting(false)
 {
-    mSendBuffer.resize(PetscTools::GetNumProcs());
     mSendString.resize(PetscTools::GetNumProcs());
+    mSendRequests.resize(PetscTools::GetNumProcs(), MPI_REQUEST_NULL);
 }
 
 template<typename CLASS>
-void ObjectCommunicator<CLASS>::SendObject(boost::shared_ptr<CLASS> const pObject, unsigned destinationProcess, unsigned tag)
+ObjectCommunicator<CLASS>::~ObjectCommunicator()
+{
+    for (unsigned process=0; process<mSendRequests.size(); process++)
+    {
+        WaitForSend(process);
+    }
+}
+
+template<typename CLASS>
+void ObjectCommunicator<CLASS>::SerializeToString(boost::shared_ptr<CLASS> const pObject, std::string& rString)
 {
-    // Create an output archive
-    std::ostringstream ss(std::ios::binary);
-    boost::archive::binary_oarchive output_arch(ss);
+    rString.clear();
+    {
+        boost::iostreams::stream<boost::iostreams::back_insert_device<std::string> > ss(rString);
+        boost::archive::binary_oarchive output_arch(ss, ARCHIVE_FLAGS);
+
+        output_arch << pObject;
+    } // Archive and stream go out of scope here, flushing everything into rString
+}
+
+template<typename CLASS>
+boost::shared_ptr<CLASS> ObjectCommunicator<CLASS>::DeserializeFromBuffer(const char* pBuffer, unsigned length)
+{
+    boost::iostreams::stream<boost::iostreams::array_source> ss(pBuffer, length);
 
-    output_arch << pObject;
+    boost::shared_ptr<CLASS> p_recv_object(new CLASS);
+    boost::archive::binary_iarchive input_arch(ss, ARCHIVE_FLAGS);
 
-    const std::string send_msg = ss.str();
+    input_arch >> p_recv_object;
+
+    return p_recv_object;
+}
+
+template<typename CLASS>
+void ObjectCommunicator<CLASS>::WaitForSend(unsigned destinationProcess)
+{
+    if (mSendRequests[destinationProcess] != MPI_REQUEST_NULL)
+    {
+        MPI_Status status;
+        MPI_Wait(&mSendRequests[destinationProcess], &status);
+    }
+}
+
+template<typename CLASS>
+void ObjectCommunicator<CLASS>::SendObject(boost::shared_ptr<CLASS> const pObject, unsigned destinationProcess, unsigned tag)
+{
+    // Make sure the buffer for this process is not in use by a previous non-blocking send
+    WaitForSend(destinationProcess);
+
+    std::string& r_send_msg = mSendString[destinationProcess];
+    SerializeToString(pObject, r_send_msg);
 
     // Get + send string length
-    unsigned string_length = send_msg.size();
+    unsigned string_length = r_send_msg.size();
     MPI_Send(&string_length, 1, MPI_UNSIGNED, destinationProcess, tag, PetscTools::GetWorld());
 
     // Send archive data
     // The buffer is treated as const, but not specified as such by MPI_Send's signature
-    char* send_buf = const_cast<char*>(send_msg.data());
+    char* send_buf = const_cast<char*>(r_send_msg.data());
     MPI_Send(send_buf, string_length, MPI_BYTE, destinationProcess, tag, PetscTools::GetWorld());
 }
 
 template<typename CLASS>
 void ObjectCommunicator<CLASS>::ISendObject(boost::shared_ptr<CLASS> const pObject, unsigned destinationProcess, unsigned tag)
 {
-    MPI_Request request;
-
-     // Create an output archive
-    std::ostringstream ss(std::ios::binary);
-    boost::archive::binary_oarchive output_arch(ss);
+    // Don't overwrite a message which is still being communicated to this process
+    WaitForSend(destinationProcess);
 
-    output_arch << pObject;
-
-    mSendString[destinationProcess] = ss.str();
-    mSendBufferLength = mSendString[destinationProcess].size();
+    std::string& r_send_msg = mSendString[destinationProcess];
+    SerializeToString(pObject, r_send_msg);
+    unsigned send_buffer_length = r_send_msg.size();
 
     // Make sure we are not going to overrun the asynchronous buffer size.
-    assert(mSendBufferLength < MAX_BUFFER_SIZE);
+    assert(send_buffer_length < MAX_BUFFER_SIZE);
 
     // Send archive data
     // The buffer is treated as const, but not specified as such by MPI_Send's signature
-    mSendBuffer[destinationProcess] = const_cast<char*>(mSendString[destinationProcess].data());
-    MPI_Isend(mSendBuffer[destinationProcess], mSendBufferLength, MPI_BYTE, destinationProcess, tag, PetscTools::GetWorld(), &request);
-    MPI_Request_free(&request); //This is evil because it allows for another non-blocking send to overwrite the buffer
+    char* send_buf = const_cast<char*>(r_send_msg.data());
+    MPI_Isend(send_buf, send_buffer_length, MPI_BYTE, destinationProcess, tag, PetscTools::GetWorld(), &mSendRequests[destinationProcess]);
 }
 
 template<typename CLASS>
@@ -213,20 +296,15 @@ boost::shared_ptr<CLASS> ObjectCommunicator<CLASS>::RecvObject(unsigned sourcePr
     unsigned string_length = 0;
     MPI_Recv(&string_length, 1, MPI_UNSIGNED, sourceProcess, tag, PetscTools::GetWorld(), &status);
 
-    char* recv_array = new char[string_length];
-    MPI_Recv(recv_array, string_length, MPI_BYTE, sourceProcess , tag, PetscTools::GetWorld(), &status);
+    // The receive buffer must be non-empty for us to take its address
+    if (mBlockingRecvBuffer.size() < std::max(string_length, 1u))
+    {
+        mBlockingRecvBuffer.resize(std::max(string_length, 1u));
+    }
+    MPI_Recv(&mBlockingRecvBuffer[0], string_length, MPI_BYTE, sourceProcess , tag, PetscTools::GetWorld(), &status);
 
     // Extract a proper object from the buffer
-    std::string recv_string(recv_array, string_length);
-    delete[] recv_array;
-    std::istringstream ss(recv_string, std::ios::binary);
-
-    boost::shared_ptr<CLASS> p_recv_object(new CLASS);
-    boost::archive::binary_iarchive input_arch(ss);
-
-    input_arch >> p_recv_object;
-
-    return p_recv_object;
+    return DeserializeFromBuffer(&mBlockingRecvBuffer[0], string_length);
 }
 
 template<typename CLASS>
@@ -236,8 +314,9 @@ void ObjectCommunicator<CLASS>::IRecvObject(unsigned sourceProcess, unsigned tag
 
     mIsWriting = true;
 
-    mRecvBuffer = new char[MAX_BUFFER_SIZE];
-    MPI_Irecv(mRecvBuffer, MAX_BUFFER_SIZE, MPI_BYTE, sourceProcess, tag, PetscTools::GetWorld(), &mMpiRequest);
+    // The buffer is only allocated once, and reused by subsequent receives
+    mRecvBuffer.resize(MAX_BUFFER_SIZE);
+    MPI_Irecv(&mRecvBuffer[0], MAX_BUFFER_SIZE, MPI_BYTE, sourceProcess, tag, PetscTools::GetWorld(), &mMpiRequest);
 }
 
 template<typename CLASS>
@@ -255,56 +334,39 @@ boost::shared_ptr<CLASS> ObjectCommunicator<CLASS>::GetRecvObject()
     int recv_size;
     MPI_Get_count(&return_status, MPI_BYTE, &recv_size);
 
-    // Extract a proper object from the buffer
-    std::string recv_string(mRecvBuffer, recv_size);
-    std::istringstream ss(recv_string, std::ios::binary);
-
-    boost::shared_ptr<CLASS> p_recv_object(new CLASS);
-    boost::archive::binary_iarchive input_arch(ss);
-
-    input_arch >> p_recv_object;
-
-    // Tidy up
-    delete[] mRecvBuffer;
-
     mIsWriting = false;
 
-    return p_recv_object;
+    // Extract a proper object from the buffer
+    return DeserializeFromBuffer(&mRecvBuffer[0], recv_size);
 }
 
 template<typename CLASS>
 boost::shared_ptr<CLASS> ObjectCommunicator<CLASS>::SendRecvObject(boost::shared_ptr<CLASS> const pSendObject, unsigned destinationProcess, unsigned sendTag, unsigned sourceProcess, unsigned sourceTag, MPI_Status& status)
 {
-    // Create an output archive
-    std::ostringstream oss(std::ios::binary);
-    boost::archive::binary_oarchive output_arch(oss);
-
-    output_arch << pSendObject;
+    // Make sure the buffer for this process is not in use by a previous non-blocking send
+    WaitForSend(destinationProcess);
 
-    std::string send_msg = oss.str();
+    std::string& r_send_msg = mSendString[destinationProcess];
+    SerializeToString(pSendObject, r_send_msg);
 
     // Get + send string length
-    unsigned send_string_length = send_msg.size();
+    unsigned send_string_length = r_send_msg.size();
     unsigned recv_string_length;
 
     MPI_Sendrecv(&send_string_length, 1, MPI_UNSIGNED, destinationProcess, sendTag, &recv_string_length, 1, MPI_UNSIGNED, sourceProcess, sourceTag, PetscTools::GetWorld(), &status);
 
-    boost::scoped_array<char> recv_array(new char[recv_string_length]);
+    // The receive buffer must be non-empty for us to take its address
+    if (mBlockingRecvBuffer.size() < std::max(recv_string_length, 1u))
+    {
+        mBlockingRecvBuffer.resize(std::max(recv_string_length, 1u));
+    }
 
     // Send archive data
-    char* send_buf = const_cast<char*>(send_msg.data());
-    MPI_Sendrecv(send_buf, send_string_length, MPI_BYTE, destinationProcess, sendTag, recv_array.get(), recv_string_length, MPI_BYTE, sourceProcess, sourceTag, PetscTools::GetWorld(), &status);
+    char* send_buf = const_cast<char*>(r_send_msg.data());
+    MPI_Sendrecv(send_buf, send_string_length, MPI_BYTE, destinationProcess, sendTag, &mBlockingRecvBuffer[0], recv_string_length, MPI_BYTE, sourceProcess, sourceTag, PetscTools::GetWorld(), &status);
 
     // Extract received object
-    std::string recv_string(recv_array.get(), recv_string_length);
-    std::istringstream iss(recv_string, std::ios::binary);
-
-    boost::shared_ptr<CLASS> p_recv_object(new CLASS);
-    boost::archive::binary_iarchive input_arch(iss);
-
-    input_arch >> p_recv_object;
-
-    return p_recv_object;
+    return DeserializeFromBuffer(&mBlockingRecvBuffer[0], recv_string_length);
 }
 
 #endif // _OBJECTCOMMUNICATOR_HPP_
@@ -33,6 +33,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <cstdint>
+
 #include "RandomNumberGenerator.hpp"
 #include "Exception.hpp"
 
@@ -43,6 +45,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 RandomNumberGenerator* RandomNumberGenerator::mpInstance = nullptr;
+thread_local std::unique_ptr<RandomNumberGenerator> RandomNumberGenerator::mpThreadLocalStream;
+thread_local bool RandomNumberGenerator::mUsingThreadLocalStream = false;
 
 RandomNumberGenerator::RandomNumberGenerator()
         : mMersenneTwisterGenerator(0u),
@@ -56,8 +60,23 @@ RandomNumberGenerator::RandomNumberGenerator()
     assert(mpInstance == nullptr); // Ensure correct serialization
 }
 
+RandomNumberGenerator::RandomNumberGenerator(unsigned seed)
+        : mMersenneTwisterGenerator(seed),
+          mGenerateUnitReal(mMersenneTwisterGenerator, boost::uniform_real<>()),
+#if BOOST_VERSION < 106400 // #2585 and #2893
+          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::random::normal_distribution_v165<>(0.0, 1.0))
+#else
+          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::normal_distribution<>(0.0, 1.0))
+#endif
+{
+}
+
 RandomNumberGenerator* RandomNumberGenerator::Instance()
 {
+    if (mUsingThreadLocalStream)
+    {
+        return mpThreadLocalStream.get();
+    }
     if (mpInstance == nullptr)
     {
         mpInstance = new RandomNumberGenerator();
@@ -74,6 +93,34 @@ void RandomNumberGenerator::Destroy()
     }
 }
 
+void RandomNumberGenerator::UseThreadLocalStream(unsigned seed)
+{
+    if (!mpThreadLocalStream)
+    {
+        mpThreadLocalStream.reset(new RandomNumberGenerator(seed));
+    }
+    else
+    {
+        mpThreadLocalStream->Reseed(seed);
+    }
+    mUsingThreadLocalStream = true;
+}
+
+unsigned RandomNumberGenerator::MixSeeds(unsigned seed, unsigned streamId)
+{
+    uint64_t z = (static_cast<uint64_t>(seed) << 32) | static_cast<uint64_t>(streamId);
+    z += UINT64_C(0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    z ^= z >> 31;
+    return static_cast<unsigned>(z >> 32);
+}
+
+void RandomNumberGenerator::UseGlobalStream()
+{
+    mUsingThreadLocalStream = false;
+}
+
 unsigned RandomNumberGenerator::randMod(unsigned base)
 {
     assert(base > 0u);
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include <boost/version.hpp>
+#include <memory>
 #include <sstream>
 
 #if BOOST_VERSION < 106400
@@ -98,6 +99,15 @@ private:
     /** Pointer to the single instance. */
     static RandomNumberGenerator* mpInstance;
 
+    /**
+     * This thread's private random number stream, if one has been created
+     * by UseThreadLocalStream().  Never archived.
+     */
+    static thread_local std::unique_ptr<RandomNumberGenerator> mpThreadLocalStream;
+
+    /** Whether Instance() currently returns this thread's private stream rather than the shared generator. */
+    static thread_local bool mUsingThreadLocalStream;
+
     friend class boost::serialization::access;
     /**
      * Save the RandomNumberGenerator and its member variables.
@@ -158,6 +168,15 @@ protected:
      */
     RandomNumberGenerator();
 
+private:
+    /**
+     * Constructor used for thread-local streams, which exist alongside the
+     * shared instance and so skip its uniqueness check.
+     *
+     * @param seed the seed for the new stream
+     */
+    explicit RandomNumberGenerator(unsigned seed);
+
 public:
     /**
      *
@@ -253,6 +272,34 @@ public:
      */
     static void Destroy();
 
+    /**
+     * Make Instance() on the calling thread return a private random number
+     * stream, reseeded with the given seed, until UseGlobalStream() is called.
+     * This lets work be farmed out across threads while each thread draws
+     * a reproducible sequence; the shared generator is left untouched.
+     *
+     * @param seed the seed for this thread's stream
+     */
+    static void UseThreadLocalStream(unsigned seed);
+
+    /**
+     * Derive the seed of one sub-stream from a base seed, so that each
+     * stream (e.g. one per cell) gets a well-separated seed.  The two values
+     * are packed into 64 bits and passed through the SplitMix64 finaliser, so
+     * the result depends only on the arguments and not on the platform, the
+     * width of std::size_t or the Boost version.
+     *
+     * @param seed the base seed
+     * @param streamId the identifier of the sub-stream
+     * @return the seed for that sub-stream
+     */
+    static unsigned MixSeeds(unsigned seed, unsigned streamId);
+
+    /**
+     * Make Instance() on the calling thread return the shared generator again.
+     */
+    static void UseGlobalStream();
+
     /**
      * Reseed the random number generator.
      *
@@ -0,0 +1,75 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef THREADTOOLS_HPP_
+#define THREADTOOLS_HPP_
+
+/**
+ * A helper class of static methods for shared-memory (OpenMP) parallelism
+ * within a single process.
+ *
+ * Chaste is only built with OpenMP support if the CMake option
+ * Chaste_USE_OPENMP is switched on, in which case CHASTE_OPENMP is defined.
+ * Otherwise these methods report a single thread, so callers can be written
+ * once and still behave correctly in a serial build.
+ */
+class ThreadTools
+{
+public:
+    /**
+     * @return whether Chaste was compiled with OpenMP support.
+     */
+    static bool IsThreadingEnabled();
+
+    /**
+     * @return the maximum number of threads that a parallel region may use
+     * (1 if Chaste was compiled without OpenMP).
+     */
+    static unsigned GetMaxNumThreads();
+
+    /**
+     * @return the index of the calling thread within the current parallel
+     * region (always 0 outside a parallel region or without OpenMP).
+     */
+    static unsigned GetThreadNum();
+
+    /**
+     * @return whether the caller is inside an active parallel region
+     * (always false without OpenMP).
+     */
+    static bool IsInParallelRegion();
+};
+
+#endif // THREADTOOLS_HPP_
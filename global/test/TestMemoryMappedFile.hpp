@@ -0,0 +1,105 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTMEMORYMAPPEDFILE_HPP_
+#define TESTMEMORYMAPPEDFILE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <cstring>
+#include <string>
+
+#include "MemoryMappedFile.hpp"
+#include "OutputFileHandler.hpp"
+#include "FileFinder.hpp"
+#include "PetscTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestMemoryMappedFile : public CxxTest::TestSuite
+{
+public:
+
+    void TestMapFile()
+    {
+        // Write a small file containing text and binary data
+        OutputFileHandler handler("TestMemoryMappedFile");
+        std::string contents = "Some text\n";
+        double values[3] = {1.5, -2.25, 1e10};
+        if (PetscTools::AmMaster())
+        {
+            out_stream p_file = handler.OpenOutputFile("mapped.dat", std::ios::out | std::ios::binary);
+            *p_file << contents;
+            p_file->write((char*)values, 3*sizeof(double));
+            p_file->close();
+
+            p_file = handler.OpenOutputFile("empty.dat");
+            p_file->close();
+        }
+        PetscTools::Barrier("TestMapFile");
+
+        // Map the file and check its contents
+        MemoryMappedFile mapped_file(handler.FindFile("mapped.dat").GetAbsolutePath());
+        TS_ASSERT(mapped_file.IsOpen());
+        TS_ASSERT_EQUALS(mapped_file.GetSize(), contents.size() + 3*sizeof(double));
+        TS_ASSERT_EQUALS(std::string(mapped_file.GetData(), contents.size()), contents);
+
+        double mapped_values[3];
+        memcpy(mapped_values, mapped_file.GetData() + contents.size(), 3*sizeof(double));
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(mapped_values[i], values[i]);
+        }
+
+        mapped_file.Close();
+        TS_ASSERT(!mapped_file.IsOpen());
+        TS_ASSERT_EQUALS(mapped_file.GetSize(), 0u);
+        TS_ASSERT(mapped_file.GetData() == nullptr);
+
+        // An empty file may be opened but has no data
+        MemoryMappedFile empty_file;
+        TS_ASSERT(!empty_file.IsOpen());
+        empty_file.Open(handler.FindFile("empty.dat").GetAbsolutePath());
+        TS_ASSERT(empty_file.IsOpen());
+        TS_ASSERT_EQUALS(empty_file.GetSize(), 0u);
+        TS_ASSERT(empty_file.GetData() == nullptr);
+
+        // Opening a missing file throws
+        std::string missing_file = handler.GetOutputDirectoryFullPath() + "missing.dat";
+        TS_ASSERT_THROWS_THIS(empty_file.Open(missing_file), "Could not open file " + missing_file);
+        TS_ASSERT(!empty_file.IsOpen());
+    }
+};
+
+#endif // TESTMEMORYMAPPEDFILE_HPP_
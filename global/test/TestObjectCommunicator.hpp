@@ -215,6 +215,50 @@ public:
         PetscTools::Barrier("Make sure that no ISendObject buffers are in use before proceeding");
     }
 
+    /* Buffers are reused, so several messages in flight to the same process must not overwrite each other */
+    void TestRepeatedNonBlockingSendsToSameProcess()
+    {
+        ObjectCommunicator<ClassOfSimpleVariables> communicator;
+        const unsigned num_messages = 3;
+
+        if (PetscTools::AmMaster())
+        {
+            std::vector<double> doubles(3);
+            doubles[0] = 1.1;
+            doubles[1] = 1.2;
+            doubles[2] = 1.3;
+
+            std::vector<bool> bools(2);
+            bools[0] = true;
+            bools[1] = false;
+
+            for (unsigned message=0; message<num_messages; message++)
+            {
+                boost::shared_ptr<ClassOfSimpleVariables> p_new_class(new ClassOfSimpleVariables(message,"hello",doubles,bools));
+                for (unsigned p=1; p < PetscTools::GetNumProcs(); p++)
+                {
+                    communicator.ISendObject(p_new_class, p, 123 + message);
+                }
+            }
+        }
+        else
+        {
+            for (unsigned message=0; message<num_messages; message++)
+            {
+                communicator.IRecvObject(0, 123 + message);
+                boost::shared_ptr<ClassOfSimpleVariables> p_recv_class = communicator.GetRecvObject();
+
+                TS_ASSERT_EQUALS(p_recv_class->GetNumber(), (int) message);
+                TS_ASSERT_EQUALS(p_recv_class->GetString(),"hello");
+                TS_ASSERT_EQUALS(p_recv_class->GetVectorOfDoubles().size(),3u);
+                TS_ASSERT_DELTA(p_recv_class->GetVectorOfDoubles()[2],1.3,1e-12);
+                TS_ASSERT(p_recv_class->GetVectorOfBools()[0]);
+                TS_ASSERT(!p_recv_class->GetVectorOfBools()[1]);
+            }
+        }
+        PetscTools::Barrier("Make sure that no ISendObject buffers are in use before proceeding");
+    }
+
     void TestSendRecv()
     {
         if (PetscTools::GetNumProcs() == 2)
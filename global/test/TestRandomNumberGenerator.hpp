@@ -485,6 +485,48 @@ public:
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(3.0), 0.2967, 1e-4);
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(4.0), 0.2715, 1e-4);
     }
+
+    void TestThreadLocalStream()
+    {
+        RandomNumberGenerator::Destroy();
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+
+        // Record what a generator seeded with 7 produces
+        p_gen->Reseed(7);
+        double first_with_seed_7 = p_gen->ranf();
+        double second_with_seed_7 = p_gen->ranf();
+
+        // Leave the shared generator part-way through its sequence for seed 3
+        p_gen->Reseed(3);
+        p_gen->ranf();
+        double second_with_seed_3 = p_gen->ranf();
+        p_gen->Reseed(3);
+        p_gen->ranf();
+
+        // A thread-local stream gives the sequence for its own seed
+        RandomNumberGenerator::UseThreadLocalStream(7);
+        TS_ASSERT_DIFFERS(RandomNumberGenerator::Instance(), p_gen);
+        TS_ASSERT_DELTA(RandomNumberGenerator::Instance()->ranf(), first_with_seed_7, 1e-12);
+
+        // Reseeding the stream restarts it
+        RandomNumberGenerator::UseThreadLocalStream(7);
+        TS_ASSERT_DELTA(RandomNumberGenerator::Instance()->ranf(), first_with_seed_7, 1e-12);
+        TS_ASSERT_DELTA(RandomNumberGenerator::Instance()->ranf(), second_with_seed_7, 1e-12);
+
+        // Returning to the shared generator carries on where it left off
+        RandomNumberGenerator::UseGlobalStream();
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance(), p_gen);
+        TS_ASSERT_DELTA(p_gen->ranf(), second_with_seed_3, 1e-12);
+    }
+
+    void TestMixSeeds()
+    {
+        // Reference values of the SplitMix64 finaliser, which must not change between platforms
+        TS_ASSERT_EQUALS(RandomNumberGenerator::MixSeeds(0u, 0u), 3793791033u);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::MixSeeds(1u, 0u), 3291240986u);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::MixSeeds(0u, 1u), 2433363436u);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::MixSeeds(12345u, 7u), 1157863096u);
+    }
 };
 
 #endif /*TESTRANDOMNUMBERGENERATOR_HPP_*/
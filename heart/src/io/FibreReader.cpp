@@ -35,13 +35,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FibreReader.hpp"
 
+#include <cstring>
 #include <sstream>
 #include "Exception.hpp"
 
 template<unsigned DIM>
 FibreReader<DIM>::FibreReader(const FileFinder& rFileFinder, FibreFileType fibreFileType)
    : mFileIsBinary(false), // overwritten by ReadNumLinesOfDataFromFile() if applicable.
-     mNextIndex(0u)
+     mNextIndex(0u),
+     mBinaryDataOffset(0u)
 {
     if (fibreFileType == AXISYM)
     {
@@ -130,22 +132,17 @@ void FibreReader<DIM>::GetFibreSheetAndNormalMatrix(unsigned fibreIndex,
     {
         EXCEPTION("Use GetFibreVector when reading axisymmetric fibres");
     }
-    if (fibreIndex < mNextIndex)
-    {
-        EXCEPTION("Fibre reads must be monotonically increasing; " << fibreIndex
-                << " is before expected next index " << mNextIndex);
-    }
     if (mFileIsBinary)
     {
-
-        // Skip to the desired index
-        mDataFile.seekg((fibreIndex-mNextIndex)*mNumItemsPerLine*sizeof(double), std::ios::cur);
-        // Take mNumItemsPerLine from the ifstream
-        mDataFile.read((char*)&(rFibreMatrix(0,0)), mNumItemsPerLine*sizeof(double));
-        mNextIndex = fibreIndex+1;
+        ReadBinaryRecord(fibreIndex, &(rFibreMatrix(0,0)));
     }
     else
     {
+        if (fibreIndex < mNextIndex)
+        {
+            EXCEPTION("Fibre reads must be monotonically increasing; " << fibreIndex
+                    << " is before expected next index " << mNextIndex);
+        }
         unsigned num_entries = 0u;
         while (fibreIndex >= mNextIndex)
         {
@@ -201,22 +198,17 @@ void FibreReader<DIM>::GetFibreVector(unsigned fibreIndex,
     {
         EXCEPTION("Use GetFibreSheetAndNormalMatrix when reading orthotropic fibres");
     }
-    if (fibreIndex < mNextIndex)
-    {
-        EXCEPTION("Fibre reads must be monotonically increasing; " << fibreIndex
-                  << " is before expected next index " << mNextIndex);
-    }
-
     if (mFileIsBinary)
     {
-        // Skip to the desired index
-        mDataFile.seekg((fibreIndex-mNextIndex)*mNumItemsPerLine*sizeof(double), std::ios::cur);
-        // Take mNumItemsPerLine from the ifstream
-        mDataFile.read((char*)&rFibreVector[0], mNumItemsPerLine*sizeof(double));
-        mNextIndex = fibreIndex+1;
+        ReadBinaryRecord(fibreIndex, &rFibreVector[0]);
     }
     else
     {
+        if (fibreIndex < mNextIndex)
+        {
+            EXCEPTION("Fibre reads must be monotonically increasing; " << fibreIndex
+                      << " is before expected next index " << mNextIndex);
+        }
         unsigned num_entries = 0u;
         while (fibreIndex >= mNextIndex)
         {
@@ -242,6 +234,21 @@ void FibreReader<DIM>::GetFibreVector(unsigned fibreIndex,
     }
 }
 
+template<unsigned DIM>
+void FibreReader<DIM>::ReadBinaryRecord(unsigned fibreIndex, double* pData)
+{
+    assert(mMappedFile.IsOpen());
+    if (fibreIndex >= mNumLinesOfData)
+    {
+        EXCEPTION("Fibre " << fibreIndex << " requested from " << mFilePath
+                  << " which only contains " << mNumLinesOfData << " definitions");
+    }
+    const std::size_t record_size = mNumItemsPerLine*sizeof(double);
+    // The records need not be aligned for doubles within the mapping, so copy them out bytewise
+    memcpy(pData, mMappedFile.GetData() + mBinaryDataOffset + fibreIndex*record_size, record_size);
+    mNextIndex = fibreIndex+1;
+}
+
 template<unsigned DIM>
 unsigned FibreReader<DIM>::GetTokensAtNextLine()
 {
@@ -323,6 +330,18 @@ void FibreReader<DIM>::ReadNumLinesOfDataFromFile()
     if (extras == "BIN")
     {
         mFileIsBinary = true;
+
+        // Map the binary records into memory, so that each process only touches the pages
+        // holding the fibres it needs rather than reading through the whole file.
+        mBinaryDataOffset = static_cast<std::size_t>(mDataFile.tellg());
+        mDataFile.close();
+        mMappedFile.Open(mFilePath);
+        if (mMappedFile.GetSize() < mBinaryDataOffset + mNumLinesOfData*mNumItemsPerLine*sizeof(double))
+        {
+            mMappedFile.Close();
+            EXCEPTION("Binary fibre file " << mFilePath << " is too short to contain the "
+                      << mNumLinesOfData << " definitions given in its header");
+        }
     }
     else if (extras!="")
     {
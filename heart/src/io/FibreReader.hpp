@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "UblasIncludes.hpp"
 #include "FileFinder.hpp"
+#include "MemoryMappedFile.hpp"
 
 /**
  * Simple enumeration for use in FibreReader constructor
@@ -81,6 +82,23 @@ private:
     /** Vector which entries read from a line in a file is put into. */
     std::vector<double> mTokens;
 
+    /**
+     * The contents of a binary fibre file, mapped into memory so that any record can be
+     * read directly without scanning the records before it.  Not used for ascii files.
+     */
+    MemoryMappedFile mMappedFile;
+
+    /** Offset in bytes of the first binary record within #mMappedFile (i.e. the length of the header). */
+    std::size_t mBinaryDataOffset;
+
+    /**
+     * Copy one record from a binary fibre file.
+     *
+     * @param fibreIndex  which record to read
+     * @param pData  where to put the #mNumItemsPerLine entries of the record
+     */
+    void ReadBinaryRecord(unsigned fibreIndex, double* pData);
+
     /**
      *  Read a line of numbers from #mDataFile.
      *  Sets up the member variable #mTokens with the data in the next line.
@@ -126,6 +144,7 @@ public:
      * @param fibreIndex  which fibre vector to read.  Note that vectors must be read
      *     in monotonically increasing order, so subsequent calls to this method must
      *     always pass a strictly greater index.  They may skip vectors, however.
+     *     Binary files are memory-mapped and may be read in any order.
      * @param rFibreMatrix  matrix to be filled in
      * @param checkOrthogonality  if true, checks if the matrix is orthogonal
      *    and throws an exception if not
@@ -142,6 +161,7 @@ public:
      * @param fibreIndex  which fibre vector to read.  Note that vectors must be read
      *     in monotonically increasing order, so subsequent calls to this method must
      *     always pass a strictly greater index.  They may skip vectors, however.
+     *     Binary files are memory-mapped and may be read in any order.
      * @param rFibreVector  vector to be filled in
      * @param checkNormalised  if true, checks if the read vector is normalised
      *   and throws an exception if not
@@ -64,7 +64,9 @@ AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::AbstractCardiacProb
           mpTimeAdaptivityController(NULL),
           mpWriter(NULL),
           mUseHdf5DataWriterCache(false),
-          mHdf5DataWriterChunkSizeAndAlignment(0)
+          mHdf5DataWriterChunkSizeAndAlignment(0),
+          mWriteXdmfDuringSolve(false),
+          mpXdmfWriter(NULL)
 {
     assert(mNodesToOutput.empty());
     if (!mpCellFactory)
@@ -94,7 +96,9 @@ AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::AbstractCardiacProb
           mpTimeAdaptivityController(NULL),
           mpWriter(NULL),
           mUseHdf5DataWriterCache(false),
-          mHdf5DataWriterChunkSizeAndAlignment(0)
+          mHdf5DataWriterChunkSizeAndAlignment(0),
+          mWriteXdmfDuringSolve(false),
+          mpXdmfWriter(NULL)
 {
 }
 
@@ -418,11 +422,14 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::Solve()
         try
         {
             extending_file = InitialiseWriter();
+            InitialiseXdmfWriter();
         }
         catch (Exception& e)
         {
             delete mpWriter;
             mpWriter = NULL;
+            delete mpXdmfWriter;
+            mpXdmfWriter = NULL;
             delete mpSolver;
             if (mSolution != initial_condition)
             {
@@ -447,6 +454,7 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::Solve()
         if (!(mSolution && extending_file))
         {
             WriteOneStep(stepper.GetTime(), initial_condition);
+            WriteXdmfOneStep(stepper.GetTime());
             mpWriter->AdvanceAlongUnlimitedDimension();
         }
         HeartEventHandler::EndEvent(HeartEventHandler::WRITE_OUTPUT);
@@ -558,6 +566,7 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::Solve()
             // Writing data out to the file <FilenamePrefix>.dat
             HeartEventHandler::BeginEvent(HeartEventHandler::WRITE_OUTPUT);
             WriteOneStep(stepper.GetTime(), mSolution);
+            WriteXdmfOneStep(stepper.GetTime());
             // Just flags that we've finished a time-step; won't actually 'extend' unless new data is written.
             mpWriter->AdvanceAlongUnlimitedDimension();
 
@@ -596,6 +605,8 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::CloseFilesAndP
     // If write caching is on, the next line might actually take a significant amount of time.
     delete mpWriter;
     mpWriter = NULL;
+    delete mpXdmfWriter;
+    mpXdmfWriter = NULL;
     HeartEventHandler::EndEvent(HeartEventHandler::WRITE_OUTPUT);
 
     FileFinder test_output(HeartConfig::Instance()->GetOutputDirectory(), RelativeTo::ChasteTestOutput);
@@ -889,6 +900,48 @@ bool AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseWrit
     return extend_file;
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseXdmfWriter()
+{
+    assert(!mpXdmfWriter);
+    if (!mWriteXdmfDuringSolve)
+    {
+        return;
+    }
+    if (!mNodesToOutput.empty() || HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering())
+    {
+        WARNING("XDMF output is only written during the solve when all nodes are output in the mesh's own ordering.");
+        return;
+    }
+
+    const std::string prefix = HeartConfig::Instance()->GetOutputFilenamePrefix();
+    mpXdmfWriter = new XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>(HeartConfig::Instance()->GetOutputDirectory() + "/xdmf_output",
+                                                                     prefix,
+                                                                     "../" + prefix + ".h5:/Data",
+                                                                     mpWriter->GetVariableNames());
+    mpXdmfWriter->WriteFilesUsingMesh(*mpMesh);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::WriteXdmfOneStep(double time)
+{
+    if (mpXdmfWriter)
+    {
+        mpWriter->Flush();
+        mpXdmfWriter->AddTimeStep(time, mpWriter->GetCurrentTimeStep(), mpWriter->GetUnlimitedDimensionLength());
+    }
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::SetWriteXdmfDuringSolve(bool writeXdmf)
+{
+    if (writeXdmf && ELEMENT_DIM == 1)
+    {
+        EXCEPTION("XDMF output is only available for 2D and 3D meshes.");
+    }
+    mWriteXdmfDuringSolve = writeXdmf;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
 void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::SetUseHdf5DataWriterCache(bool useCache)
 {
@@ -60,6 +60,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DistributedVectorFactory.hpp"
 #include "Hdf5DataReader.hpp"
 #include "Hdf5DataWriter.hpp"
+#include "XdmfTimeSeriesWriter.hpp"
 #include "Warnings.hpp"
 #include "AbstractOutputModifier.hpp"
 /*
@@ -212,6 +213,11 @@ private:
             archive & mUseHdf5DataWriterCache;
             archive & mHdf5DataWriterChunkSizeAndAlignment;
         }
+
+        if (version >= 5)
+        {
+            archive & mWriteXdmfDuringSolve;
+        }
     }
 
     /**
@@ -337,6 +343,11 @@ private:
             archive & mUseHdf5DataWriterCache;
             archive & mHdf5DataWriterChunkSizeAndAlignment;
         }
+
+        if (version >= 5)
+        {
+            archive & mWriteXdmfDuringSolve;
+        }
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -481,6 +492,16 @@ protected:
      */
     hsize_t mHdf5DataWriterChunkSizeAndAlignment;
 
+    /**
+     * Whether to write an XDMF index for the results file as the simulation runs.
+     */
+    bool mWriteXdmfDuringSolve;
+
+    /**
+     * The object to use to write the XDMF index of the results (only created if #mWriteXdmfDuringSolve).
+     */
+    XdmfTimeSeriesWriter<ELEMENT_DIM,SPACE_DIM>* mpXdmfWriter;
+
     /**
      * A vector of user-defined output modifiers which may be used to produce lightweight on the fly output
      */
@@ -671,6 +692,20 @@ public:
      */
     bool InitialiseWriter();
 
+    /**
+     * Create the XDMF writer and write the mesh for it, if XDMF output during the solve was requested
+     * and is possible.  Called by Solve() after InitialiseWriter().
+     */
+    void InitialiseXdmfWriter();
+
+    /**
+     * Flush the results file and add the time step which has just been written to it to the XDMF index
+     * (if there is one).  Must be called before the writer advances along its unlimited dimension.
+     *
+     * @param time  the simulation time of the step
+     */
+    void WriteXdmfOneStep(double time);
+
     /**
      * Set whether to use caching in the Hdf5DataWriter. This tells the
      * Hdf5DataWriter to write only whole chunks to disk, rather than every
@@ -700,6 +735,22 @@ public:
      */
     void SetHdf5DataWriterTargetChunkSizeAndAlignment(hsize_t size);
 
+    /**
+     * Set whether to write an XDMF index (<prefix>.xdmf in the xdmf_output sub-folder) for the
+     * results as they are written, so that they can be visualized (e.g. in ParaView) while the
+     * simulation runs, without converting the HDF5 file afterwards.  The mesh is written once
+     * and each time step refers to its row of the HDF5 dataset, which is flushed every printing
+     * time step.  (With #SetUseHdf5DataWriterCache the latest steps only become readable when
+     * the cache is written.)
+     *
+     * This is not possible when only some nodes are output, or when the output uses the original
+     * node ordering of a permuted mesh: a warning is given and no XDMF index is written.  When a
+     * checkpointed simulation is resumed, the index only lists the time steps of the resumed run.
+     *
+     * @param writeXdmf  whether to write the XDMF index
+     */
+    void SetWriteXdmfDuringSolve(bool writeXdmf=true);
+
     /**
      * Specifies which nodes in the mesh to output. This method must be called before InitialiseWriter,
      * otherwise all nodes will still be output. If this method is called when extending an existing
@@ -889,7 +940,7 @@ template <unsigned ELEMENT_DIM, unsigned SPACE_DIM,  unsigned PROBLEM_DIM>
 struct version<AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM> >
 {
     ///Macro to set the version number of templated archive in known versions of Boost
-    CHASTE_VERSION_CONTENT(4);
+    CHASTE_VERSION_CONTENT(5);
 };
 } // namespace serialization
 } // namespace boost
@@ -36,7 +36,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HeartGeometryInformation.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 #include "OutputFileHandler.hpp"
 #include "Exception.hpp"
@@ -73,7 +75,8 @@ HeartGeometryInformation<SPACE_DIM>::HeartGeometryInformation (AbstractTetrahedr
                                                                const std::string& rEpiFile,
                                                                const std::string& rLVFile,
                                                                const std::string& rRVFile,
-                                                               bool indexFromZero)
+                                                               bool indexFromZero,
+                                                               const FileFinder& rDistanceMapCacheFile)
     : mpMesh(&rMesh)
 {
     DistanceMapCalculator<SPACE_DIM, SPACE_DIM> distance_calculator(*mpMesh);
@@ -97,13 +100,147 @@ HeartGeometryInformation<SPACE_DIM>::HeartGeometryInformation (AbstractTetrahedr
     {
         GetNodesAtSurface(rRVFile, mRVSurface, indexFromZero);
     }
+
+    // The distance maps are the expensive part, so may be kept between runs
+    std::string cache_key;
+    if (rDistanceMapCacheFile.IsPathSet())
+    {
+        cache_key = CalculateDistanceMapCacheKey();
+        if (ReadDistanceMapCache(rDistanceMapCacheFile, cache_key))
+        {
+            mNumberOfSurfacesProvided = 3;
+            return;
+        }
+    }
+
     distance_calculator.ComputeDistanceMap(mEpiSurface, mDistMapEpicardium);
     distance_calculator.ComputeDistanceMap(mLVSurface, mDistMapLeftVentricle);
     distance_calculator.ComputeDistanceMap(mRVSurface, mDistMapRightVentricle);
 
+    if (rDistanceMapCacheFile.IsPathSet())
+    {
+        WriteDistanceMapCache(rDistanceMapCacheFile, cache_key);
+    }
+
     mNumberOfSurfacesProvided = 3;
 }
 
+/**
+ * Fold some bytes into a 64-bit FNV-1a hash.
+ *
+ * @param hash  the hash so far
+ * @param pBytes  the bytes
+ * @param numBytes  the number of bytes
+ * @return the updated hash
+ */
+static uint64_t HashBytes(uint64_t hash, const void* pBytes, std::size_t numBytes)
+{
+    const unsigned char* p_bytes = static_cast<const unsigned char*>(pBytes);
+    for (std::size_t i=0; i<numBytes; i++)
+    {
+        hash ^= p_bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template<unsigned SPACE_DIM>
+std::string HeartGeometryInformation<SPACE_DIM>::CalculateDistanceMapCacheKey() const
+{
+    const uint64_t fnv_offset = 14695981039346656037ull;
+
+    /*
+     * Each node contributes its own hash, combined by exclusive or, so that the key does not
+     * depend on how the nodes are distributed (only on how they are numbered).
+     */
+    uint64_t node_hash = 0u;
+    for (typename AbstractMesh<SPACE_DIM,SPACE_DIM>::NodeIterator iter = mpMesh->GetNodeIteratorBegin();
+         iter != mpMesh->GetNodeIteratorEnd();
+         ++iter)
+    {
+        unsigned node_index = iter->GetIndex();
+        if (mpMesh->GetDistributedVectorFactory()->IsGlobalIndexLocal(node_index))
+        {
+            uint64_t hash = HashBytes(fnv_offset, &node_index, sizeof(unsigned));
+            node_hash ^= HashBytes(hash, &(iter->rGetLocation()[0]), SPACE_DIM*sizeof(double));
+        }
+    }
+    unsigned local_words[2] = {(unsigned)(node_hash >> 32), (unsigned)(node_hash & 0xffffffffu)};
+    unsigned global_words[2];
+    MPI_Allreduce(local_words, global_words, 2, MPI_UNSIGNED, MPI_BXOR, PETSC_COMM_WORLD);
+
+    // The surfaces are known to every process
+    uint64_t surface_hash = fnv_offset;
+    const std::vector<unsigned>* surfaces[3] = {&mEpiSurface, &mLVSurface, &mRVSurface};
+    for (unsigned i=0; i<3; i++)
+    {
+        unsigned size = surfaces[i]->size();
+        surface_hash = HashBytes(surface_hash, &size, sizeof(unsigned));
+        if (size > 0)
+        {
+            surface_hash = HashBytes(surface_hash, &(*surfaces[i])[0], size*sizeof(unsigned));
+        }
+    }
+
+    std::stringstream key;
+    key << mpMesh->GetNumNodes() << "-" << std::hex << std::setfill('0')
+        << std::setw(8) << global_words[0] << std::setw(8) << global_words[1] << "-" << std::setw(16) << surface_hash;
+    return key.str();
+}
+
+template<unsigned SPACE_DIM>
+bool HeartGeometryInformation<SPACE_DIM>::ReadDistanceMapCache(const FileFinder& rCacheFile, const std::string& rKey)
+{
+    bool read_ok = false;
+    if (rCacheFile.IsFile())
+    {
+        std::ifstream cache_file(rCacheFile.GetAbsolutePath().c_str(), std::ios::binary);
+        std::string header;
+        getline(cache_file, header);
+        if (header == "Chaste distance map cache " + rKey)
+        {
+            unsigned num_nodes = mpMesh->GetNumNodes();
+            std::vector<double>* maps[3] = {&mDistMapEpicardium, &mDistMapLeftVentricle, &mDistMapRightVentricle};
+            for (unsigned i=0; i<3; i++)
+            {
+                maps[i]->resize(num_nodes);
+                cache_file.read((char*)&(*maps[i])[0], num_nodes*sizeof(double));
+            }
+            read_ok = cache_file.good();
+        }
+    }
+
+    // Every process must agree, since otherwise the maps are computed collectively
+    return !PetscTools::ReplicateBool(!read_ok);
+}
+
+template<unsigned SPACE_DIM>
+void HeartGeometryInformation<SPACE_DIM>::WriteDistanceMapCache(const FileFinder& rCacheFile, const std::string& rKey) const
+{
+    if (PetscTools::AmMaster())
+    {
+        try
+        {
+            std::ofstream cache_file(rCacheFile.GetAbsolutePath().c_str(), std::ios::binary | std::ios::trunc);
+            if (!cache_file.is_open())
+            {
+                EXCEPTION("Could not write distance map cache file " << rCacheFile.GetAbsolutePath());
+            }
+            cache_file << "Chaste distance map cache " << rKey << "\n";
+            unsigned num_nodes = mpMesh->GetNumNodes();
+            cache_file.write((const char*)&mDistMapEpicardium[0], num_nodes*sizeof(double));
+            cache_file.write((const char*)&mDistMapLeftVentricle[0], num_nodes*sizeof(double));
+            cache_file.write((const char*)&mDistMapRightVentricle[0], num_nodes*sizeof(double));
+        }
+        catch (Exception& e)
+        {
+            PetscTools::ReplicateException(true);
+            throw e;
+        }
+    }
+    PetscTools::ReplicateException(false);
+}
+
 template<unsigned SPACE_DIM>
 HeartGeometryInformation<SPACE_DIM>::HeartGeometryInformation (std::string nodeHeterogeneityFileName)
 {
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DistanceMapCalculator.hpp"
 #include "AbstractTetrahedralMesh.hpp"
 #include "ChasteCuboid.hpp"
+#include "FileFinder.hpp"
 
 /** Names for layers in the heart wall */
 typedef enum HeartLayerType_
@@ -152,6 +153,32 @@ private:
      */
     ChasteCuboid<SPACE_DIM> CalculateBoundingBoxOfSurface(const std::vector<unsigned>& rSurfaceNodes);
 
+    /**
+     * @return a key identifying the three surface distance maps: a hash of the node indices and locations
+     * of the mesh (as permuted in memory) and of the surface node lists.
+     * MUST BE CALLED IN PARALLEL, since each process hashes the nodes it owns.
+     */
+    std::string CalculateDistanceMapCacheKey() const;
+
+    /**
+     * Read the three surface distance maps from a cache file written by WriteDistanceMapCache().
+     * MUST BE CALLED IN PARALLEL.
+     *
+     * @param rCacheFile  the cache file
+     * @param rKey  the key of the distance maps wanted (see CalculateDistanceMapCacheKey())
+     * @return whether every process read the maps (false if the file is missing, for other maps, or incomplete)
+     */
+    bool ReadDistanceMapCache(const FileFinder& rCacheFile, const std::string& rKey);
+
+    /**
+     * Write the three surface distance maps to a cache file (from the master process).
+     * MUST BE CALLED IN PARALLEL.
+     *
+     * @param rCacheFile  the cache file
+     * @param rKey  the key of the distance maps (see CalculateDistanceMapCacheKey())
+     */
+    void WriteDistanceMapCache(const FileFinder& rCacheFile, const std::string& rKey) const;
+
 public:
 /// \todo #1703 Perhaps add these constants to HeartConfig...
     /** Left ventricular wall */
@@ -197,12 +224,17 @@ public:
      * If either rRVFile or rLVfile are the empty string, then it is assumed that this is a
      * wedge preparation for left or right ventricle, respectively.  That is, the ventricle with a non-empty string.
      * If both are empty strings then throws exception.
+     *
+     * @param rDistanceMapCacheFile  optionally, a file in which to cache the distance maps.  If it holds the maps for
+     *     this mesh and these surfaces they are read from it, rather than computed; otherwise they are computed
+     *     and written to it.
      */
     HeartGeometryInformation (AbstractTetrahedralMesh<SPACE_DIM,SPACE_DIM>& rMesh,
                               const std::string& rEpiFile,
                               const std::string& rLVFile,
                               const std::string& rRVFile,
-                              bool indexFromZero);
+                              bool indexFromZero,
+                              const FileFinder& rDistanceMapCacheFile=FileFinder());
 
     /**
      * Alternative constructor that takes in the file containing a list of numbers (as many as the number of nodes).
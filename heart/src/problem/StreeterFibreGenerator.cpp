@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "StreeterFibreGenerator.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <sstream>
@@ -70,11 +71,11 @@ double StreeterFibreGenerator<SPACE_DIM>::GetAveragedThicknessLocalNode(
 
     // Initialise the average with the value corresponding to the current node
     double average = wallThickness[nodeIndex];
-    unsigned nodes_visited = 1;
 
-    // Use a set to store visited nodes
-    std::set<unsigned> visited_nodes;
-    visited_nodes.insert(nodeIndex);
+    // The forward star is small, so a vector is cheaper than a set for the visited nodes
+    std::vector<unsigned> visited_nodes;
+    visited_nodes.reserve(32);
+    visited_nodes.push_back(nodeIndex);
 
     Node<SPACE_DIM>* p_current_node = this->mpMesh->GetNode(nodeIndex);
 
@@ -95,16 +96,15 @@ double StreeterFibreGenerator<SPACE_DIM>::GetAveragedThicknessLocalNode(
             unsigned neighbour_node_index = p_neighbour_node->GetIndex();
 
             // Check if the neighbour node has already been visited
-            if (visited_nodes.find(neighbour_node_index) == visited_nodes.end())
+            if (std::find(visited_nodes.begin(), visited_nodes.end(), neighbour_node_index) == visited_nodes.end())
             {
                 average += wallThickness[neighbour_node_index];
-                visited_nodes.insert(neighbour_node_index);
-                nodes_visited++;
+                visited_nodes.push_back(neighbour_node_index);
             }
        }
     }
 
-    return average/nodes_visited;
+    return average/visited_nodes.size();
 }
 
 template<unsigned SPACE_DIM>
@@ -157,6 +157,7 @@ StreeterFibreGenerator<SPACE_DIM>::StreeterFibreGenerator(AbstractTetrahedralMes
 
     mWallThickness.resize(rMesh.GetNumNodes());
     mAveragedWallThickness.resize(rMesh.GetNumNodes());
+    mNodeRegions.resize(rMesh.GetNumNodes());
 }
 
 template<unsigned SPACE_DIM>
@@ -170,10 +171,14 @@ void StreeterFibreGenerator<SPACE_DIM>::SetSurfaceFiles(
             const std::string& rEpicardiumFile,
             const std::string& rRightVentricleFile,
             const std::string& rLeftVentricleFile,
-            bool indexFromZero)
+            bool indexFromZero,
+            const FileFinder& rDistanceMapCacheFile)
 {
-    // Compute the distance map of each surface
-     mpGeometryInfo = new HeartGeometryInformation<SPACE_DIM>(*(this->mpMesh), rEpicardiumFile, rLeftVentricleFile, rRightVentricleFile, indexFromZero);
+    // Compute (or read from the cache) the distance map of each surface
+    delete mpGeometryInfo;
+    mpGeometryInfo = NULL;
+    mpGeometryInfo = new HeartGeometryInformation<SPACE_DIM>(*(this->mpMesh), rEpicardiumFile, rLeftVentricleFile, rRightVentricleFile,
+                                                             indexFromZero, rDistanceMapCacheFile);
 }
 
 template<unsigned SPACE_DIM>
@@ -218,6 +223,7 @@ void StreeterFibreGenerator<SPACE_DIM>::PreWriteCalculations(OutputFileHandler&
         double dist_epi, dist_endo;
 
         HeartRegionType node_region = mpGeometryInfo->GetHeartRegion(node_index);
+        mNodeRegions[node_index] = node_region;
 
         switch(node_region)
         {
@@ -282,10 +288,15 @@ void StreeterFibreGenerator<SPACE_DIM>::PreWriteCalculations(OutputFileHandler&
     }
 
     /*
-     *  For each node, average its value of e with the values of all the neighbours
+     *  For each local node, average its value of e with the values of all the neighbours
      */
-    std::vector<double> my_averaged_wall_thickness(num_nodes);
-    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    std::vector<double> my_averaged_wall_thickness(num_nodes, 0.0);
+    const int lo = this->mpMesh->GetDistributedVectorFactory()->GetLow();
+    const int hi = this->mpMesh->GetDistributedVectorFactory()->GetHigh();
+#ifdef CHASTE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 256)
+#endif // CHASTE_OPENMP
+    for (int node_index=lo; node_index<hi; node_index++)
     {
         my_averaged_wall_thickness[node_index] = GetAveragedThicknessLocalNode(node_index, mWallThickness);
     }
@@ -340,7 +351,7 @@ void StreeterFibreGenerator<SPACE_DIM>::Visit(Element<SPACE_DIM, SPACE_DIM>* pEl
         unsigned global_node_index = pElement->GetNode(local_node_index)->GetIndex();
 
         elem_nodes_ave_thickness[local_node_index] = mAveragedWallThickness[global_node_index];
-        elem_nodes_region[local_node_index] = mpGeometryInfo->GetHeartRegion(global_node_index);
+        elem_nodes_region[local_node_index] = mNodeRegions[global_node_index];
 
         // Calculate wall thickness averaged value for the element
         element_averaged_thickness +=  mWallThickness[global_node_index];
@@ -92,6 +92,9 @@ private:
    /** Wall thickness at each node, smoothed by averaging over local nodes by #GetAveragedThicknessLocalNode().*/
    std::vector<double> mAveragedWallThickness;
 
+   /** The heart region of each node in the mesh, as given by HeartGeometryInformation::GetHeartRegion(). */
+   std::vector<HeartRegionType> mNodeRegions;
+
    /** Whether to write Streeter generation log files for regions and wall thicknesses */
    bool mLogInfo;
 
@@ -117,7 +120,8 @@ protected:
 
    /**
     * Does calculations to generate an orthotropic fibre orientation model of the ventricular mesh provided.
-    * In particular - populates the member variables #mWallThickness and #mAveragedWallThickness.
+    * In particular - populates the member variables #mWallThickness, #mAveragedWallThickness and #mNodeRegions.
+    * The averaging is shared between threads if OpenMP is available.
     *
     * Also writes these to file if SetLogInfo() has been called.
     *
@@ -152,11 +156,15 @@ public:
      * If either rRightVentricleFile or rLeftVentricleFile are the empty string, then it is assumed that this is a
      * wedge preparation for left or right ventricle, respectively.  That is, the ventricle with a non-empty string.
      * If both are empty strings then throws exception in HeartGeometryInformation.
+     *
+     * @param rDistanceMapCacheFile  optionally, a file in which to keep the surface distance maps, which are the
+     *     expensive part of fibre generation, between runs on the same mesh and surfaces (see HeartGeometryInformation).
      */
     void SetSurfaceFiles(const std::string& rEpicardiumFile,
                          const std::string& rRightVentricleFile,
                          const std::string& rLeftVentricleFile,
-                         bool indexFromZero);
+                         bool indexFromZero,
+                         const FileFinder& rDistanceMapCacheFile=FileFinder());
 
     /**
      * Set the direction from apex to base
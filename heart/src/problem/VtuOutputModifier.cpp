@@ -0,0 +1,106 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "VtuOutputModifier.hpp"
+#include "HeartConfig.hpp"
+#include "Exception.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuOutputModifier<ELEMENT_DIM, SPACE_DIM>::InitialiseAtStart(DistributedVectorFactory* pVectorFactory, const std::vector<unsigned>& rNodePermutation)
+{
+    assert(mpMesh != NULL);
+    assert(pVectorFactory == mpMesh->GetDistributedVectorFactory());
+    mpWriter.reset(new VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>(HeartConfig::Instance()->GetOutputDirectory() + "/vtu_output",
+                                                                     mFilename, *mpMesh));
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuOutputModifier<ELEMENT_DIM, SPACE_DIM>::FinaliseAtEnd()
+{
+    // All the files are complete after each time step, so there is nothing left to write
+    mpWriter.reset();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuOutputModifier<ELEMENT_DIM, SPACE_DIM>::ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim)
+{
+    assert(mpWriter);
+    if (mVariableNames.empty())
+    {
+        mVariableNames.push_back("V");
+        if (problemDim == 3)
+        {
+            mVariableNames.push_back("V_2");
+        }
+        if (problemDim > 1)
+        {
+            mVariableNames.push_back("Phi_e");
+        }
+    }
+    if (mVariableNames.size() != problemDim)
+    {
+        EXCEPTION("VtuOutputModifier was given " << mVariableNames.size() << " variable names for a problem with "
+                  << problemDim << " variables.");
+    }
+
+    const unsigned local_size = mpMesh->GetDistributedVectorFactory()->GetLocalOwnership();
+    std::vector<double> stripe(local_size);
+
+    double* p_solution;
+    VecGetArray(solution, &p_solution);
+    for (unsigned variable=0; variable<problemDim; variable++)
+    {
+        for (unsigned local_index=0; local_index<local_size; local_index++)
+        {
+            stripe[local_index] = p_solution[local_index*problemDim + variable];
+        }
+        mpWriter->AddPointData(mVariableNames[variable], stripe);
+    }
+    VecRestoreArray(solution, &p_solution);
+
+    mpWriter->WriteTimeStep(time);
+}
+
+// Explicit instantiation
+template class VtuOutputModifier<1,1>;
+template class VtuOutputModifier<1,2>;
+template class VtuOutputModifier<1,3>;
+template class VtuOutputModifier<2,2>;
+template class VtuOutputModifier<2,3>;
+template class VtuOutputModifier<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(VtuOutputModifier)
@@ -0,0 +1,145 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VTUOUTPUTMODIFIER_HPP_
+#define VTUOUTPUTMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractOutputModifier.hpp"
+#include "AbstractTetrahedralMesh.hpp"
+#include "VtuTimeSeriesWriter.hpp"
+
+/**
+ * Stream the solution of a cardiac problem to a VTK time series as the simulation runs, using a
+ * VtuTimeSeriesWriter.  This avoids the post-processing step which converts the HDF5 results file
+ * to VTK, and it writes from every process without gathering the solution onto the master.
+ *
+ * The files (and the <mFilename>.pvd collection which can be opened in ParaView) are written to the
+ * "vtu_output" sub-folder of the simulation's output directory.  The nodes are in the order held in
+ * memory at solve time, which is fine for visualisation since the geometry is written with them.
+ *
+ * WARNING:  If you checkpoint this class then the files written so far are not saved in the checkpoint.
+ *           A resumed simulation starts a new time series, overwriting the files of the original run.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VtuOutputModifier : public AbstractOutputModifier
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /** The mesh on which the problem is solved. */
+    AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* mpMesh;
+
+    /**
+     * The names of the variables in the solution, one per stripe.  If empty they are chosen
+     * from the problem dimension ("V", then "Phi_e" or "V_2" and "Phi_e").
+     */
+    std::vector<std::string> mVariableNames;
+
+    /** The writer (created in #InitialiseAtStart and destroyed in #FinaliseAtEnd). */
+    boost::shared_ptr<VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM> > mpWriter;
+
+    /**
+     * Archive the output modifier, never used directly - boost uses this.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        // This calls serialize on the base class.
+        archive & boost::serialization::base_object<AbstractOutputModifier>(*this);
+        // The problem archives the mesh before its output modifiers, so this is resolved to the same object
+        archive & mpMesh;
+        archive & mVariableNames;
+        // The writer is re-created in InitialiseAtStart
+    }
+
+    /** Private constructor that does nothing, for archiving */
+    VtuOutputModifier()
+        : mpMesh(NULL)
+    {}
+
+public:
+    /**
+     * Constructor
+     *
+     * @param rFilename  The base name of the files produced by this modifier
+     * @param pMesh  The mesh on which the problem is solved
+     * @param rVariableNames  The names of the variables in the solution (defaults to the names used in the
+     *     HDF5 results: "V" for monodomain, "V" and "Phi_e" for bidomain, and "V", "V_2" and "Phi_e" for
+     *     extended bidomain problems)
+     */
+    VtuOutputModifier(const std::string& rFilename,
+                      AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* pMesh,
+                      const std::vector<std::string>& rVariableNames=std::vector<std::string>())
+        : AbstractOutputModifier(rFilename),
+          mpMesh(pMesh),
+          mVariableNames(rVariableNames)
+    {
+    }
+
+    /**
+     * Initialise the modifier (create the writer, which encodes the mesh) when the solve loop is starting
+     *
+     * @param pVectorFactory  The vector factory which is associated with the calling problem's mesh
+     * @param rNodePermutation The permutation associated with the calling problem's mesh (when running with parallel partitioning)
+     */
+    virtual void InitialiseAtStart(DistributedVectorFactory* pVectorFactory, const std::vector<unsigned>& rNodePermutation);
+
+    /**
+     * Finalise the modifier (release the writer)
+     */
+    virtual void FinaliseAtEnd();
+
+    /**
+     * Process a solution time-step (write each variable to a new step of the time series)
+     * @param time  The current simulation time
+     * @param solution  A working copy of the solution at the current time-step.  This is the PETSc vector which is distributed across the processes.
+     * @param problemDim  The calling problem dimension. Used here to avoid probing the size of the solution vector
+     */
+    virtual void ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(VtuOutputModifier)
+
+#endif /* VTUOUTPUTMODIFIER_HPP_ */
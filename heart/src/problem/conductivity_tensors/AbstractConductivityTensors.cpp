@@ -107,6 +107,20 @@ void AbstractConductivityTensors<ELEMENT_DIM,SPACE_DIM>::SetNonConstantConductiv
     mpNonConstantConductivities = pNonConstantConductivities;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractConductivityTensors<ELEMENT_DIM,SPACE_DIM>::AddSharedTensor(const c_matrix<double,SPACE_DIM,SPACE_DIM>& rTensor,
+                                                                        std::map<std::vector<double>, unsigned>& rTensorLookup)
+{
+    std::vector<double> key(rTensor.data(), rTensor.data() + SPACE_DIM*SPACE_DIM);
+    std::pair<std::map<std::vector<double>, unsigned>::iterator, bool> result
+        = rTensorLookup.insert(std::make_pair(key, (unsigned)mTensors.size()));
+    if (result.second)
+    {
+        mTensors.push_back(rTensor);
+    }
+    mTensorIndices.push_back(result.first->second);
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 c_matrix<double,SPACE_DIM,SPACE_DIM>& AbstractConductivityTensors<ELEMENT_DIM,SPACE_DIM>::operator[](const unsigned global_index)
 {
@@ -123,6 +137,10 @@ c_matrix<double,SPACE_DIM,SPACE_DIM>& AbstractConductivityTensors<ELEMENT_DIM,SP
     else
     {
         unsigned local_index = mpMesh->SolveElementMapping(global_index); //This will throw if we don't own the element
+        if (!mTensorIndices.empty())
+        {
+            return mTensors[mTensorIndices[local_index]];
+        }
         return mTensors[local_index];
     }
 }
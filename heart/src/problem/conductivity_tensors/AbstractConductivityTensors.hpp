@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 #include <string>
+#include <map>
 #include <memory>
 #include "UblasIncludes.hpp"
 #include "AbstractTetrahedralMesh.hpp"
@@ -65,9 +66,17 @@ protected:
     std::vector<c_vector<double, SPACE_DIM> >* mpNonConstantConductivities; // mS/cm
 
     /** Container for conductivity tensors
-     * (single, size=1 [one for all space] or multiple, size=num local elements [one for each local element]) */
+     * (single, size=1 [one for all space], one for each distinct tensor when #mTensorIndices is in use,
+     *  or multiple, size=num local elements [one for each local element]) */
     std::vector< c_matrix<double,SPACE_DIM,SPACE_DIM> > mTensors;
 
+    /**
+     * When non-empty, the entry of #mTensors used by each local element.  This is used when
+     * conductivities vary but there is no fibre orientation, so that the (typically few)
+     * distinct tensors, e.g. one per tissue region, are only stored once.
+     */
+    std::vector<unsigned> mTensorIndices;
+
     /** Set by Init() in the base classes*/
     bool mInitialised;
 
@@ -77,6 +86,17 @@ protected:
     /** Fibre file reader */
     std::shared_ptr<FibreReader<SPACE_DIM> > mFileReader;
 
+    /**
+     * Set the tensor for the next local element, sharing storage with any identical tensor
+     * already added in this way.  For use by Init() when there is no fibre orientation.
+     *
+     * @param rTensor  the conductivity tensor for the element
+     * @param rTensorLookup  map from the entries of each tensor added so far to its index in
+     *     #mTensors (should be empty for the first element)
+     */
+    void AddSharedTensor(const c_matrix<double,SPACE_DIM,SPACE_DIM>& rTensor,
+                         std::map<std::vector<double>, unsigned>& rTensorLookup);
+
 public:
 
     AbstractConductivityTensors();
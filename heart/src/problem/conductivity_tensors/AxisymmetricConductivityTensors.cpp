@@ -101,9 +101,20 @@ void AxisymmetricConductivityTensors<ELEMENT_DIM, SPACE_DIM>::Init(AbstractTetra
             }
         }
 
+        // Without fibres the tensors only vary with the conductivities, so elements with the same
+        // conductivities (e.g. in the same region) share one tensor, looked up through this map.
+        std::map<std::vector<double>, unsigned> tensor_lookup;
+
         // reserve() allocates all the memory at once, more efficient than relying
         // on the automatic reallocation scheme.
-        this->mTensors.reserve(this->mpMesh->GetNumLocalElements());
+        if (this->mUseFibreOrientation)
+        {
+            this->mTensors.reserve(this->mpMesh->GetNumLocalElements());
+        }
+        else
+        {
+            this->mTensorIndices.reserve(this->mpMesh->GetNumLocalElements());
+        }
 
         c_matrix<double, SPACE_DIM, SPACE_DIM> conductivity_matrix(zero_matrix<double>(SPACE_DIM,SPACE_DIM));
 
@@ -160,14 +171,22 @@ void AxisymmetricConductivityTensors<ELEMENT_DIM, SPACE_DIM>::Init(AbstractTetra
                 this->mFileReader->GetFibreVector(current_fibre_global_index, fibre_vector);
             }
 
-            this->mTensors.push_back( conductivity_matrix(1,1) * identity_matrix<double>(SPACE_DIM) +
-                                      (conductivity_matrix(0,0) - conductivity_matrix(1,1)) * outer_prod(fibre_vector,fibre_vector));
+            c_matrix<double,SPACE_DIM,SPACE_DIM> tensor = conductivity_matrix(1,1) * identity_matrix<double>(SPACE_DIM) +
+                (conductivity_matrix(0,0) - conductivity_matrix(1,1)) * outer_prod(fibre_vector,fibre_vector);
+            if (this->mUseFibreOrientation)
+            {
+                this->mTensors.push_back(tensor);
+            }
+            else
+            {
+                this->AddSharedTensor(tensor, tensor_lookup);
+            }
 
             local_element_index++;
         }
 
-        assert(this->mTensors.size() == this->mpMesh->GetNumLocalElements());
-        assert(this->mTensors.size() == local_element_index);
+        assert((this->mUseFibreOrientation ? this->mTensors.size() : this->mTensorIndices.size()) == this->mpMesh->GetNumLocalElements());
+        assert(this->mpMesh->GetNumLocalElements() == local_element_index);
 
         if (this->mUseFibreOrientation)
         {
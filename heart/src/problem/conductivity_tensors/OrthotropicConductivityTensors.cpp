@@ -76,9 +76,20 @@ void OrthotropicConductivityTensors<ELEMENT_DIM, SPACE_DIM>::Init(AbstractTetrah
             }
         }
 
+        // Without fibres the tensors only vary with the conductivities, so elements with the same
+        // conductivities (e.g. in the same region) share one tensor, looked up through this map.
+        std::map<std::vector<double>, unsigned> tensor_lookup;
+
         // reserve() allocates all the memory at once, more efficient than relying
         // on the automatic reallocation scheme.
-        this->mTensors.reserve(this->mpMesh->GetNumLocalElements());
+        if (this->mUseFibreOrientation)
+        {
+            this->mTensors.reserve(this->mpMesh->GetNumLocalElements());
+        }
+        else
+        {
+            this->mTensorIndices.reserve(this->mpMesh->GetNumLocalElements());
+        }
 
         c_matrix<double, SPACE_DIM, SPACE_DIM> conductivity_matrix(zero_matrix<double>(SPACE_DIM,SPACE_DIM));
 
@@ -129,14 +140,22 @@ void OrthotropicConductivityTensors<ELEMENT_DIM, SPACE_DIM>::Init(AbstractTetrah
                 this->mFileReader->GetFibreSheetAndNormalMatrix(current_fibre_global_index, orientation_matrix);
             }
 
-            c_matrix<double,SPACE_DIM,SPACE_DIM> temp;
-            noalias(temp) = prod(orientation_matrix, conductivity_matrix);
-            this->mTensors.push_back( prod(temp, trans(orientation_matrix) ) );
+            if (this->mUseFibreOrientation)
+            {
+                c_matrix<double,SPACE_DIM,SPACE_DIM> temp;
+                noalias(temp) = prod(orientation_matrix, conductivity_matrix);
+                this->mTensors.push_back( prod(temp, trans(orientation_matrix) ) );
+            }
+            else
+            {
+                // The orientation matrix is the identity
+                this->AddSharedTensor(conductivity_matrix, tensor_lookup);
+            }
 
             local_element_index++;
         }
-        assert(this->mTensors.size() == this->mpMesh->GetNumLocalElements());
-        assert(this->mTensors.size() == local_element_index);
+        assert((this->mUseFibreOrientation ? this->mTensors.size() : this->mTensorIndices.size()) == this->mpMesh->GetNumLocalElements());
+        assert(this->mpMesh->GetNumLocalElements() == local_element_index);
 
         if (this->mUseFibreOrientation)
         {
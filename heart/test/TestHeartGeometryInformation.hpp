@@ -35,6 +35,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef TESTHEARTGEOMETRYINFORMATION_HPP_
 #define TESTHEARTGEOMETRYINFORMATION_HPP_
 
+#include <fstream>
+
 #include "TrianglesMeshReader.hpp"
 #include "HeartGeometryInformation.hpp"
 #include "PetscTools.hpp"
@@ -538,6 +540,110 @@ public:
              TS_ASSERT_EQUALS(info.GetHeartRegion(node_index), HeartGeometryInformation<3>::LEFT_VENTRICLE_WALL);
          }
     }
+
+    void TestDistanceMapCache()
+    {
+        std::string epi_surface = "heart/test/data/box_shaped_heart/epi.tri";
+        std::string lv_surface = "heart/test/data/box_shaped_heart/lv.tri";
+        std::string rv_surface = "heart/test/data/box_shaped_heart/rv.tri";
+
+        TrianglesMeshReader<3,3> mesh_reader("heart/test/data/box_shaped_heart/box_heart");
+        DistributedTetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        unsigned num_nodes = mesh.GetNumNodes();
+
+        OutputFileHandler handler("HeartGeometryDistanceMapCache");
+        FileFinder cache_file = handler.FindFile("box_heart.distances");
+
+        HeartGeometryInformation<3> reference(mesh, epi_surface, lv_surface, rv_surface, false);
+
+        // The first run computes the maps and fills the cache
+        {
+            HeartGeometryInformation<3> info(mesh, epi_surface, lv_surface, rv_surface, false, cache_file);
+            PetscTools::Barrier("TestDistanceMapCache");
+            TS_ASSERT(cache_file.IsFile());
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                TS_ASSERT_EQUALS(info.rGetDistanceMapEpicardium()[i], reference.rGetDistanceMapEpicardium()[i]);
+                TS_ASSERT_EQUALS(info.rGetDistanceMapLeftVentricle()[i], reference.rGetDistanceMapLeftVentricle()[i]);
+                TS_ASSERT_EQUALS(info.rGetDistanceMapRightVentricle()[i], reference.rGetDistanceMapRightVentricle()[i]);
+            }
+        }
+
+        // Replace the cached maps (keeping the header) to show that they are read rather than computed
+        std::string header;
+        {
+            std::ifstream file(cache_file.GetAbsolutePath().c_str(), std::ios::binary);
+            getline(file, header);
+        }
+        PetscTools::Barrier("TestDistanceMapCache");
+        if (PetscTools::AmMaster())
+        {
+            std::ofstream file(cache_file.GetAbsolutePath().c_str(), std::ios::binary | std::ios::trunc);
+            file << header << "\n";
+            for (unsigned map=1; map<=3; map++)
+            {
+                std::vector<double> values(num_nodes, (double)map);
+                file.write((const char*)&values[0], num_nodes*sizeof(double));
+            }
+        }
+        PetscTools::Barrier("TestDistanceMapCache");
+        {
+            HeartGeometryInformation<3> info(mesh, epi_surface, lv_surface, rv_surface, false, cache_file);
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                TS_ASSERT_EQUALS(info.rGetDistanceMapEpicardium()[i], 1.0);
+                TS_ASSERT_EQUALS(info.rGetDistanceMapLeftVentricle()[i], 2.0);
+                TS_ASSERT_EQUALS(info.rGetDistanceMapRightVentricle()[i], 3.0);
+            }
+        }
+
+        // Different surfaces do not match the cache, so the maps are computed (and the cache replaced)
+        {
+            HeartGeometryInformation<3> info(mesh, epi_surface, rv_surface, lv_surface, false, cache_file);
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                TS_ASSERT_EQUALS(info.rGetDistanceMapLeftVentricle()[i], reference.rGetDistanceMapRightVentricle()[i]);
+                TS_ASSERT_EQUALS(info.rGetDistanceMapRightVentricle()[i], reference.rGetDistanceMapLeftVentricle()[i]);
+            }
+        }
+        PetscTools::Barrier("TestDistanceMapCache");
+        {
+            std::ifstream file(cache_file.GetAbsolutePath().c_str(), std::ios::binary);
+            std::string new_header;
+            getline(file, new_header);
+            TS_ASSERT_DIFFERS(new_header, header);
+        }
+
+        // A truncated cache is ignored
+        PetscTools::Barrier("TestDistanceMapCache");
+        if (PetscTools::AmMaster())
+        {
+            std::ofstream file(cache_file.GetAbsolutePath().c_str(), std::ios::binary | std::ios::trunc);
+            file << header << "\n";
+        }
+        PetscTools::Barrier("TestDistanceMapCache");
+        {
+            HeartGeometryInformation<3> info(mesh, epi_surface, lv_surface, rv_surface, false, cache_file);
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                TS_ASSERT_EQUALS(info.rGetDistanceMapEpicardium()[i], reference.rGetDistanceMapEpicardium()[i]);
+            }
+        }
+
+        // The cache must be writable
+        FileFinder bad_cache_file = handler.FindFile("no_such_folder/box_heart.distances");
+        if (PetscTools::AmMaster())
+        {
+            TS_ASSERT_THROWS_CONTAINS(HeartGeometryInformation<3> info(mesh, epi_surface, lv_surface, rv_surface, false, bad_cache_file),
+                                      "Could not write distance map cache file");
+        }
+        else
+        {
+            TS_ASSERT_THROWS_THIS(HeartGeometryInformation<3> info(mesh, epi_surface, lv_surface, rv_surface, false, bad_cache_file),
+                                  "Another process threw an exception; bailing out.");
+        }
+    }
 };
 
 #endif /*TESTHEARTGEOMETRYINFORMATION_HPP_*/
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FibreReader.hpp"
 #include "HeartFileFinder.hpp"
+#include "OutputFileHandler.hpp"
 #include "TetrahedralMesh.hpp"
 #include "VtkMeshWriter.hpp"
 
@@ -441,6 +442,53 @@ public:
             }
         }
     }
+
+    void TestBinaryFileRandomAccess()
+    {
+        // Read in the equivalent ascii fibres file.
+        FileFinder file_finder("heart/test/data/fibre_tests/Orthotropic3D.ortho", RelativeTo::ChasteSourceRoot);
+        FibreReader<3> fibre_reader(file_finder, ORTHO);
+        std::vector< c_vector<double, 3> > fibre_vector;
+        std::vector< c_vector<double, 3> > second_vector;
+        std::vector< c_vector<double, 3> > third_vector;
+        fibre_reader.GetAllOrtho(fibre_vector, second_vector, third_vector);
+
+        // Binary files are memory-mapped, so can be read in any order (e.g. that of the locally owned elements)
+        FileFinder file_finder_bin("heart/test/data/fibre_tests/Orthotropic3DBin.ortho", RelativeTo::ChasteSourceRoot);
+        FibreReader<3> fibre_reader_bin(file_finder_bin, ORTHO);
+        TS_ASSERT_EQUALS(fibre_reader_bin.GetNumLinesOfData(), fibre_vector.size());
+        c_matrix<double, 3, 3> fibre_matrix;
+        for (unsigned i=fibre_vector.size(); i-- > 0; )
+        {
+            fibre_reader_bin.GetFibreSheetAndNormalMatrix(i, fibre_matrix);
+            for (unsigned j=0; j<3; j++)
+            {
+                TS_ASSERT_DELTA(fibre_matrix(j,0), fibre_vector[i][j], 1e-9);
+                TS_ASSERT_DELTA(fibre_matrix(j,1), second_vector[i][j], 1e-9);
+                TS_ASSERT_DELTA(fibre_matrix(j,2), third_vector[i][j], 1e-9);
+            }
+        }
+        fibre_reader_bin.GetFibreSheetAndNormalMatrix(1u, fibre_matrix);
+        TS_ASSERT_DELTA(fibre_matrix(0,0), fibre_vector[1][0], 1e-9);
+
+        TS_ASSERT_THROWS_CONTAINS(fibre_reader_bin.GetFibreSheetAndNormalMatrix(6u, fibre_matrix),
+                                  "which only contains 6 definitions");
+
+        // A binary file with fewer records than its header claims
+        OutputFileHandler handler("TestBinaryFileRandomAccess");
+        if (PetscTools::AmMaster())
+        {
+            out_stream p_file = handler.OpenOutputFile("truncated.axi");
+            *p_file << "3\tBIN\n";
+            double data[3] = {1.0, 0.0, 0.0};
+            p_file->write((char*)data, 3*sizeof(double));
+            p_file->close();
+        }
+        PetscTools::Barrier("TestBinaryFileRandomAccess");
+        FileFinder truncated_file = handler.FindFile("truncated.axi");
+        TS_ASSERT_THROWS_CONTAINS(FibreReader<3> truncated_reader(truncated_file, AXISYM),
+                                  "is too short to contain the 3 definitions given in its header");
+    }
 };
 
 #endif /*TESTFIBREREADER_HPP_*/
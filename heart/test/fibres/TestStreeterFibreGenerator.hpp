@@ -163,6 +163,35 @@ public:
         CompareGeneratedWithReferenceFile(fibre_file1, ORTHO, fibre_file2, ORTHO);
     }
 
+    void TestCachedDistanceMaps()
+    {
+        TrianglesMeshReader<3,3> mesh_reader("heart/test/data/box_shaped_heart/box_heart");
+        std::string epi_face_file = "heart/test/data/box_shaped_heart/epi.tri";
+        std::string rv_face_file = "heart/test/data/box_shaped_heart/rv.tri";
+        std::string lv_face_file = "heart/test/data/box_shaped_heart/lv.tri";
+
+        DistributedTetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        OutputFileHandler handler("cached_streeter");
+        FileFinder cache_file = handler.FindFile("box_heart.distances");
+        FileFinder fibre_file_reference("heart/test/data/box_shaped_heart/box_heart.ortho", RelativeTo::ChasteSourceRoot);
+
+        // The first generator fills the cache and the second reads it; both give the same fibres
+        for (unsigned run=0; run<2; run++)
+        {
+            StreeterFibreGenerator<3> fibre_generator(mesh);
+            fibre_generator.SetSurfaceFiles(epi_face_file, rv_face_file, lv_face_file, false, cache_file);
+            fibre_generator.SetApexToBase(0);
+            fibre_generator.SetWriteFileAsBinary();
+            fibre_generator.WriteData(handler, "box_heart.ortho");
+
+            TS_ASSERT(cache_file.IsFile());
+            FileFinder fibre_file = handler.FindFile("box_heart.ortho");
+            CompareGeneratedWithReferenceFile(fibre_file, ORTHO, fibre_file_reference, ORTHO);
+        }
+    }
+
     void TestExceptions()
     {
         TrianglesMeshReader<3,3> mesh_reader("heart/test/data/box_shaped_heart/box_heart");
@@ -63,6 +63,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SingleTraceOutputModifier.hpp"
 #include "TetrahedralMesh.hpp"
 #include "VtkMeshReader.hpp"
+#include "VtuOutputModifier.hpp"
 #include "Warnings.hpp"
 #include "PetscSetupAndFinalize.hpp"
 
@@ -1560,6 +1561,87 @@ public:
             delete p_abstract_class_2;
         }
     }
+
+    void TestVtuOutputModifier()
+    {
+        HeartConfig::Instance()->SetIntracellularConductivities(Create_c_vector(0.0005));
+        HeartConfig::Instance()->SetSimulationDuration(0.5); //ms
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.1);
+        HeartConfig::Instance()->SetMeshFileName("mesh/test/data/1D_0_to_1mm_10_elements");
+        HeartConfig::Instance()->SetOutputDirectory("MonoProblem1dVtuOutputModifier");
+        HeartConfig::Instance()->SetOutputFilenamePrefix("MonodomainLR91_1d");
+
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory;
+        MonodomainProblem<1> monodomain_problem(&cell_factory);
+        monodomain_problem.Initialise();
+
+        boost::shared_ptr<VtuOutputModifier<1, 1> > p_vtu(new VtuOutputModifier<1, 1>("voltage", &(monodomain_problem.rGetMesh())));
+        monodomain_problem.AddOutputModifier(p_vtu);
+        monodomain_problem.Solve();
+
+        // The initial condition and five printing steps are written, one piece per process
+        OutputFileHandler handler("MonoProblem1dVtuOutputModifier/vtu_output", false);
+        for (unsigned step = 0; step < 6; step++)
+        {
+            std::stringstream piece;
+            piece << "voltage_00000" << step << "_" << PetscTools::GetMyRank() << ".vtu";
+            TS_ASSERT(handler.FindFile(piece.str()).Exists());
+        }
+
+        // The collection (written by the master) lists every step
+        PetscTools::Barrier("TestVtuOutputModifier");
+        std::ifstream pvd(handler.FindFile("voltage.pvd").GetAbsolutePath().c_str());
+        std::string contents((std::istreambuf_iterator<char>(pvd)), std::istreambuf_iterator<char>());
+        TS_ASSERT_DIFFERS(contents.find("file=\"voltage_000000.pvtu\""), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("file=\"voltage_000005.pvtu\""), std::string::npos);
+        TS_ASSERT_EQUALS(contents.find("file=\"voltage_000006.pvtu\""), std::string::npos);
+
+        // A 2-variable problem needs 2 names
+        std::vector<std::string> names(1, "V");
+        VtuOutputModifier<1, 1> wrong_names("wrong", &(monodomain_problem.rGetMesh()), names);
+        wrong_names.InitialiseAtStart(monodomain_problem.rGetMesh().GetDistributedVectorFactory(), std::vector<unsigned>());
+        Vec two_variables = monodomain_problem.rGetMesh().GetDistributedVectorFactory()->CreateVec(2);
+        TS_ASSERT_THROWS_THIS(wrong_names.ProcessSolutionAtTimeStep(0.0, two_variables, 2),
+                              "VtuOutputModifier was given 1 variable names for a problem with 2 variables.");
+        PetscTools::Destroy(two_variables);
+    }
+
+    void TestWriteXdmfDuringSolve()
+    {
+        HeartConfig::Instance()->SetIntracellularConductivities(Create_c_vector(0.0005, 0.0005));
+        HeartConfig::Instance()->SetSimulationDuration(0.3); //ms
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.1);
+        HeartConfig::Instance()->SetMeshFileName("mesh/test/data/2D_0_to_1mm_400_elements");
+        HeartConfig::Instance()->SetOutputDirectory("MonoProblem2dXdmfDuringSolve");
+        HeartConfig::Instance()->SetOutputFilenamePrefix("monodomain2d");
+
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 2> cell_factory;
+        MonodomainProblem<2> monodomain_problem(&cell_factory);
+        monodomain_problem.Initialise();
+        monodomain_problem.SetWriteXdmfDuringSolve();
+        monodomain_problem.Solve();
+
+        // The mesh is written once, and each of the 4 printing steps refers to its row of the results file
+        OutputFileHandler handler("MonoProblem2dXdmfDuringSolve/xdmf_output", false);
+        TS_ASSERT(handler.FindFile("monodomain2d_geometry_0.xml").Exists());
+        TS_ASSERT(handler.FindFile("monodomain2d_topology_0.xml").Exists());
+        std::ifstream xdmf(handler.FindFile("monodomain2d.xdmf").GetAbsolutePath().c_str());
+        std::string contents((std::istreambuf_iterator<char>(xdmf)), std::istreambuf_iterator<char>());
+        TS_ASSERT_DIFFERS(contents.find("<DataItem Dimensions=\"3 3\" Format=\"XML\">3 0 0 1 1 1 1 221 1</DataItem>"), std::string::npos);
+        TS_ASSERT_EQUALS(contents.find("<DataItem Dimensions=\"3 3\" Format=\"XML\">4 0 0"), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("../monodomain2d.h5:/Data"), std::string::npos);
+
+        // Every step, including the first, declares the whole dataset as it is in the file
+        TS_ASSERT_EQUALS(contents.find("<DataItem Dimensions=\"1 221 1\" Format=\"HDF\""), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("<DataItem Dimensions=\"4 221 1\" Format=\"HDF\""), std::string::npos);
+
+        // Not available in 1D
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory_1d;
+        MonodomainProblem<1> monodomain_problem_1d(&cell_factory_1d);
+        TS_ASSERT_THROWS_THIS(monodomain_problem_1d.SetWriteXdmfDuringSolve(),
+                              "XDMF output is only available for 2D and 3D meshes.");
+    }
+
     void TestMonodomainProblem2DWithArchiving()
     {
 
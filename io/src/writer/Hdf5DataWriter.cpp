@@ -1193,6 +1193,35 @@ int Hdf5DataWriter::GetVariableByName(const std::string& rVariableName)
     return id;
 }
 
+std::vector<std::string> Hdf5DataWriter::GetVariableNames() const
+{
+    std::vector<std::string> names;
+    for (unsigned index = 0; index < mVariables.size(); index++)
+    {
+        names.push_back(mVariables[index].mVariableName);
+    }
+    return names;
+}
+
+unsigned Hdf5DataWriter::GetCurrentTimeStep() const
+{
+    return mCurrentTimeStep;
+}
+
+unsigned Hdf5DataWriter::GetUnlimitedDimensionLength() const
+{
+    return mDatasetDims[0];
+}
+
+void Hdf5DataWriter::Flush()
+{
+    if (mIsInDefineMode)
+    {
+        return; // Nothing has been written yet
+    }
+    H5Fflush(mFileId, H5F_SCOPE_GLOBAL);
+}
+
 bool Hdf5DataWriter::ApplyPermutation(const std::vector<unsigned>& rPermutation, bool unsafeExtendingMode)
 {
     if (unsafeExtendingMode == false && !mIsInDefineMode)
@@ -288,6 +288,29 @@ public:
      */
     int GetVariableByName(const std::string& rVariableName);
 
+    /**
+     * @return the names of the variables, in the order in which they are stored in the dataset
+     */
+    std::vector<std::string> GetVariableNames() const;
+
+    /**
+     * @return the index along the unlimited dimension (e.g. time step) at which data is being written
+     */
+    unsigned GetCurrentTimeStep() const;
+
+    /**
+     * @return the length of the unlimited dimension of the dataset in the file.  This is the estimated
+     * length given to SetEstimatedUnlimitedLength() until more steps than that have been written.
+     */
+    unsigned GetUnlimitedDimensionLength() const;
+
+    /**
+     * Flush the data written so far to disk, so that the file can be read (e.g. by a visualizer)
+     * while it is still being written.  Data held in the cache is not written until the cache is.
+     * This method is collective.
+     */
+    void Flush();
+
 
     /**
      * Apply a permutation to all occurences of PutVector
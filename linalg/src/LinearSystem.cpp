@@ -975,9 +975,13 @@ Vec LinearSystem::Solve(Vec lhsGuess)
     if (lhsGuess)
     {
         VecCopy(lhsGuess, lhs_vector);
-        // If this wasn't done at construction time then it may be too late for this:
-        // KSPSetInitialGuessNonzero(mKspSolver, PETSC_TRUE);
-        // Is it possible to warn the user?
+
+        /*
+         * The KSP solver is told to use a non-zero initial guess when it is set up, if a guess
+         * is supplied to the first solve. Do this here too so that a guess supplied to a later
+         * solve (e.g. when a linear system is reused by cell-based PDE modifiers) is not ignored.
+         */
+        KSPSetInitialGuessNonzero(mKspSolver, PETSC_TRUE);
     }
 
     // Check if the right hand side is small (but non-zero), PETSc can diverge immediately
@@ -150,7 +150,9 @@ private:
             std::shared_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > p_original_mesh_reader
                 = GenericMeshReader<ELEMENT_DIM, SPACE_DIM>(original_file, order_of_element, order_of_boundary_element);
 
-            if (p_original_mesh_reader->IsFileFormatBinary())
+            // Archives are reloaded with a TrianglesMeshReader, so only binary Triangles files can be copied as they are
+            if (p_original_mesh_reader->IsFileFormatBinary()
+                && dynamic_cast<TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>*>(p_original_mesh_reader.get()) != nullptr)
             {
                 // Mesh is in binary format, we can just copy the files across ignoring the mesh reader
                 if (PetscTools::AmMaster())
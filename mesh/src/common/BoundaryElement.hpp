@@ -65,8 +65,9 @@ public:
      *
      * @param index  the index of the element in the mesh
      * @param rNodes  the nodes owned by the element
+     * @param registerWithNodes  whether to tell the nodes that they are contained in this element
      */
-    BoundaryElement(unsigned index, const std::vector<Node<SPACE_DIM>*>& rNodes);
+    BoundaryElement(unsigned index, const std::vector<Node<SPACE_DIM>*>& rNodes, bool registerWithNodes=true);
 
     /**
      * Create a new boundary element from a Node.
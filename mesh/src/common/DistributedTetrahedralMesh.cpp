@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DistributedTetrahedralMesh.hpp"
 
 #include <cassert>
+#include <climits>
 #include <sstream>
 #include <string>
 #include <iterator>
@@ -54,6 +55,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "RandomNumberGenerator.hpp"
 
 #include "Timer.hpp"
+#include "MeshSetupEventHandler.hpp"
 #include "TetrahedralMesh.hpp"
 #include "Warnings.hpp"
 
@@ -187,31 +189,54 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ComputeMeshPartitioning
         }
         else
         {
+            /*
+             * Flag owned and halo nodes in flat arrays indexed by global node index, so that
+             * testing element ownership is a constant-time look-up rather than a set search,
+             * and the halo set can be built in a single ordered pass at the end.
+             */
+            std::vector<bool> node_is_owned(mTotalNumNodes, false);
+            std::vector<bool> node_is_halo(mTotalNumNodes, false);
+            for (std::set<unsigned>::const_iterator iter = rNodesOwned.begin();
+                 iter != rNodesOwned.end();
+                 ++iter)
+            {
+                node_is_owned[*iter] = true;
+            }
+
             for (unsigned element_number = 0; element_number < mTotalNumElements; element_number++)
             {
                 ElementData element_data = rMeshReader.GetNextElementData();
+                const std::vector<unsigned>& r_node_indices = element_data.NodeIndices;
 
                 bool element_owned = false;
-                std::set<unsigned> temp_halo_nodes;
-
-                for (std::vector<unsigned>::const_iterator it = element_data.NodeIndices.begin();
-                     it != element_data.NodeIndices.end();
-                     ++it)
+                for (unsigned i=0; i<r_node_indices.size(); i++)
                 {
-                    if (rNodesOwned.find(*it) != rNodesOwned.end())
+                    if (node_is_owned[r_node_indices[i]])
                     {
                         element_owned = true;
-                        rElementsOwned.insert(element_number);
+                        break;
                     }
-                    else
+                }
+
+                if (element_owned)
+                {
+                    // Elements are visited in increasing order, so insert at the end of the set
+                    rElementsOwned.insert(rElementsOwned.end(), element_number);
+                    for (unsigned i=0; i<r_node_indices.size(); i++)
                     {
-                        temp_halo_nodes.insert(*it);
+                        if (!node_is_owned[r_node_indices[i]])
+                        {
+                            node_is_halo[r_node_indices[i]] = true;
+                        }
                     }
                 }
+            }
 
-                if (element_owned)
+            for (unsigned node_index=0; node_index<mTotalNumNodes; node_index++)
+            {
+                if (node_is_halo[node_index])
                 {
-                    rHaloNodesOwned.insert(temp_halo_nodes.begin(), temp_halo_nodes.end());
+                    rHaloNodesOwned.insert(rHaloNodesOwned.end(), node_index);
                 }
             }
         }
@@ -245,14 +270,36 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
 
     PetscTools::Barrier();
     Timer::Reset();
-    ComputeMeshPartitioning(rMeshReader, nodes_owned, halo_nodes_owned, elements_owned, proc_offsets);
+    MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::PARTITION);
+    try
+    {
+        ComputeMeshPartitioning(rMeshReader, nodes_owned, halo_nodes_owned, elements_owned, proc_offsets);
+    }
+    catch (Exception&)
+    {
+        MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::PARTITION);
+        throw;
+    }
     PetscTools::Barrier();
-    //Timer::Print("partitioning");
+    MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::PARTITION);
+
+    // Flag owned and halo nodes by global index, for constant-time ownership tests below
+    std::vector<bool> node_is_owned(mTotalNumNodes, false);
+    std::vector<bool> node_is_halo(mTotalNumNodes, false);
+    for (std::set<unsigned>::const_iterator iter = nodes_owned.begin(); iter != nodes_owned.end(); ++iter)
+    {
+        node_is_owned[*iter] = true;
+    }
+    for (std::set<unsigned>::const_iterator iter = halo_nodes_owned.begin(); iter != halo_nodes_owned.end(); ++iter)
+    {
+        node_is_halo[*iter] = true;
+    }
 
     // Reserve memory
     this->mElements.reserve(elements_owned.size());
     this->mNodes.reserve(nodes_owned.size());
 
+    MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::NODES);
     if (rMeshReader.IsFileFormatBinary())
     {
         ///\todo #1930 We should use a reader set iterator for this bit now.
@@ -300,7 +347,7 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
             coords = rMeshReader.GetNextNode();
 
             // The node is owned by the processor
-            if (nodes_owned.find(node_index) != nodes_owned.end())
+            if (node_is_owned[node_index])
             {
                 RegisterNode(node_index);
                 Node<SPACE_DIM>* p_node =  new Node<SPACE_DIM>(node_index, coords, false);
@@ -315,13 +362,29 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
             }
 
             // The node is a halo node in this processor
-            if (halo_nodes_owned.find(node_index) != halo_nodes_owned.end())
+            if (node_is_halo[node_index])
             {
                 RegisterHaloNode(node_index);
                 mHaloNodes.push_back(new Node<SPACE_DIM>(node_index, coords, false));
             }
         }
     }
+    MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::NODES);
+
+    /*
+     * Elements are built in three passes.  The mesh reader is sequential, so the first pass just
+     * copies the owned element data into flat arrays.  The second pass creates the element objects:
+     * it only reads the node maps and each element checks its own Jacobian, so it runs in parallel
+     * if OpenMP is available.  The last pass registers the elements with the mesh and with their
+     * nodes, which modifies shared containers and so is serial.
+     */
+    MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::ELEMENTS);
+    const bool has_element_attributes = (rMeshReader.GetNumElementAttributes() > 0);
+    std::vector<unsigned> element_indices;
+    std::vector<unsigned> element_node_indices;
+    std::vector<double> element_attributes;
+    element_indices.reserve(elements_owned.size());
+    element_node_indices.reserve(elements_owned.size()*(ELEMENT_DIM+1));
 
     for (typename AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>::ElementIterator elem_it
              = rMeshReader.GetElementIteratorBegin(elements_owned);
@@ -329,41 +392,99 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
          ++elem_it)
     {
         ElementData element_data = *elem_it;
-        unsigned global_element_index = elem_it.GetIndex();
-
-        std::vector<Node<SPACE_DIM>*> nodes;
-        for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+        element_indices.push_back(elem_it.GetIndex());
+        element_node_indices.insert(element_node_indices.end(),
+                                    element_data.NodeIndices.begin(),
+                                    element_data.NodeIndices.begin() + ELEMENT_DIM+1);
+        if (has_element_attributes)
         {
-            // Because we have populated mNodes and mHaloNodes above, we can now use this method, which should never throw
-            nodes.push_back(this->GetNodeOrHaloNode(element_data.NodeIndices[j]));
+            assert(rMeshReader.GetNumElementAttributes() == 1);
+            element_attributes.push_back(element_data.AttributeValue);
         }
+    }
 
-        RegisterElement(global_element_index);
-        Element<ELEMENT_DIM,SPACE_DIM>* p_element = new Element<ELEMENT_DIM,SPACE_DIM>(global_element_index, nodes);
-        this->mElements.push_back(p_element);
+    const unsigned num_local_elements = element_indices.size();
+    std::vector<Element<ELEMENT_DIM,SPACE_DIM>*> new_elements(num_local_elements, nullptr);
+    unsigned first_bad_element = UINT_MAX;
+    std::string bad_element_message;
 
-        if (rMeshReader.GetNumElementAttributes() > 0)
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int local_index=0; local_index<static_cast<int>(num_local_elements); local_index++)
+    {
+        try
         {
-            assert(rMeshReader.GetNumElementAttributes() == 1);
-            double attribute_value = element_data.AttributeValue;
-            p_element->SetAttribute(attribute_value);
+            std::vector<Node<SPACE_DIM>*> nodes(ELEMENT_DIM+1);
+            for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+            {
+                // Because we have populated mNodes and mHaloNodes above, we can now use this method, which should never throw
+                nodes[j] = this->GetNodeOrHaloNode(element_node_indices[local_index*(ELEMENT_DIM+1) + j]);
+            }
+
+            Element<ELEMENT_DIM,SPACE_DIM>* p_element = new Element<ELEMENT_DIM,SPACE_DIM>(element_indices[local_index], nodes, false);
+            new_elements[local_index] = p_element;
+
+            if (has_element_attributes)
+            {
+                p_element->SetAttribute(element_attributes[local_index]);
+            }
+        }
+        catch (Exception& e)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(DistributedTetrahedralMeshBadElement)
+#endif // CHASTE_OPENMP
+            {
+                // Keep the lowest-numbered failure, so the error doesn't depend on thread scheduling
+                if (static_cast<unsigned>(local_index) < first_bad_element)
+                {
+                    first_bad_element = local_index;
+                    bad_element_message = e.GetShortMessage();
+                }
+            }
+        }
+    }
+
+    if (first_bad_element != UINT_MAX)
+    {
+        // None of the new elements have been registered with their nodes, so they can simply be deleted
+        for (unsigned local_index=0; local_index<num_local_elements; local_index++)
+        {
+            delete new_elements[local_index];
         }
+        MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::ELEMENTS);
+        EXCEPTION(bad_element_message);
     }
 
-    // Boundary nodes and elements
+    for (unsigned local_index=0; local_index<num_local_elements; local_index++)
+    {
+        RegisterElement(element_indices[local_index]);
+        this->mElements.push_back(new_elements[local_index]);
+        new_elements[local_index]->RegisterWithNodes();
+    }
+    MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::ELEMENTS);
+
+    // Boundary nodes and elements, built in the same three passes as the elements
+    MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::BOUNDARY_ELEMENTS);
     try
     {
+        const bool has_face_attributes = (rMeshReader.GetNumFaceAttributes() > 0);
+        std::vector<unsigned> face_indices;
+        std::vector<unsigned> face_node_offsets(1, 0u);
+        std::vector<unsigned> face_node_indices;
+        std::vector<double> face_attributes;
+
         for (unsigned face_index=0; face_index<mTotalNumBoundaryElements; face_index++)
         {
             ElementData face_data = rMeshReader.GetNextFaceData();
-            std::vector<unsigned> node_indices = face_data.NodeIndices;
+            const std::vector<unsigned>& r_node_indices = face_data.NodeIndices;
 
+            // The face is ours if I own any of its nodes
             bool own = false;
-
-            for (unsigned node_index=0; node_index<node_indices.size(); node_index++)
+            for (unsigned node_index=0; node_index<r_node_indices.size(); node_index++)
             {
-                // if I own this node
-                if (mNodesMapping.find(node_indices[node_index]) != mNodesMapping.end())
+                if (node_is_owned[r_node_indices[node_index]])
                 {
                     own = true;
                     break;
@@ -375,53 +496,107 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
                 continue;
             }
 
-            // Determine if this is a boundary face
-            //std::set<unsigned> containing_element_indices; // Elements that contain this face
-            std::vector<Node<SPACE_DIM>*> nodes;
+            face_indices.push_back(face_index);
+            face_node_indices.insert(face_node_indices.end(), r_node_indices.begin(), r_node_indices.end());
+            face_node_offsets.push_back(face_node_indices.size());
+            if (has_face_attributes)
+            {
+                assert(rMeshReader.GetNumFaceAttributes() == 1);
+                face_attributes.push_back(face_data.AttributeValue);
+            }
+        }
 
-            for (unsigned node_index=0; node_index<node_indices.size(); node_index++)
+        const unsigned num_local_faces = face_indices.size();
+        std::vector<BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>*> new_faces(num_local_faces, nullptr);
+        unsigned first_bad_face = UINT_MAX;
+        std::string bad_face_message;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+        for (int local_index=0; local_index<static_cast<int>(num_local_faces); local_index++)
+        {
+            try
             {
-                //because we have populated mNodes and mHaloNodes above, we can now use this method,
-                //which SHOULD never throw (but it does).
-                try
+                std::vector<Node<SPACE_DIM>*> nodes;
+                for (unsigned i=face_node_offsets[local_index]; i<face_node_offsets[local_index+1]; i++)
+                {
+                    //because we have populated mNodes and mHaloNodes above, we can now use this method,
+                    //which SHOULD never throw (but it does).
+                    try
+                    {
+                        nodes.push_back(this->GetNodeOrHaloNode(face_node_indices[i]));
+                    }
+                    catch (Exception &)
+                    {
+                        EXCEPTION("Face does not appear in element file (Face " << face_indices[local_index] << " in "<<this->mMeshFileBaseName<< ")");
+                    }
+                }
+
+                BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>* p_boundary_element =
+                    new BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>(face_indices[local_index], nodes, false);
+                new_faces[local_index] = p_boundary_element;
+
+                if (has_face_attributes)
                 {
-                    nodes.push_back(this->GetNodeOrHaloNode(node_indices[node_index]));
+                    p_boundary_element->SetAttribute(face_attributes[local_index]);
                 }
-                catch (Exception &)
+            }
+            catch (Exception& e)
+            {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(DistributedTetrahedralMeshBadFace)
+#endif // CHASTE_OPENMP
                 {
-                    EXCEPTION("Face does not appear in element file (Face " << face_index << " in "<<this->mMeshFileBaseName<< ")");
+                    // Keep the lowest-numbered failure, so the error doesn't depend on thread scheduling
+                    if (static_cast<unsigned>(local_index) < first_bad_face)
+                    {
+                        first_bad_face = local_index;
+                        bad_face_message = e.GetShortMessage();
+                    }
                 }
             }
+        }
+
+        if (first_bad_face != UINT_MAX)
+        {
+            for (unsigned local_index=0; local_index<num_local_faces; local_index++)
+            {
+                delete new_faces[local_index];
+            }
+            EXCEPTION(bad_face_message);
+        }
+
+        for (unsigned local_index=0; local_index<num_local_faces; local_index++)
+        {
+            BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>* p_boundary_element = new_faces[local_index];
+            unsigned face_index = face_indices[local_index];
 
             // This is a boundary face
             // Ensure all its nodes are marked as boundary nodes
-            for (unsigned j=0; j<nodes.size(); j++)
+            for (unsigned j=0; j<p_boundary_element->GetNumNodes(); j++)
             {
-                if (!nodes[j]->IsBoundaryNode())
+                Node<SPACE_DIM>* p_node = p_boundary_element->GetNode(j);
+                if (!p_node->IsBoundaryNode())
                 {
-                    nodes[j]->SetAsBoundaryNode();
-                    this->mBoundaryNodes.push_back(nodes[j]);
+                    p_node->SetAsBoundaryNode();
+                    this->mBoundaryNodes.push_back(p_node);
                 }
                 // Register the index that this boundary element will have with the node
-                nodes[j]->AddBoundaryElement(face_index);
+                p_node->AddBoundaryElement(face_index);
             }
 
             RegisterBoundaryElement(face_index);
-            BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>* p_boundary_element = new BoundaryElement<ELEMENT_DIM-1,SPACE_DIM>(face_index, nodes);
             this->mBoundaryElements.push_back(p_boundary_element);
-
-            if (rMeshReader.GetNumFaceAttributes() > 0)
-            {
-                assert(rMeshReader.GetNumFaceAttributes() == 1);
-                p_boundary_element->SetAttribute(face_data.AttributeValue);
-            }
         }
     }
     catch (Exception &e)
     {
+        MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::BOUNDARY_ELEMENTS);
         PetscTools::ReplicateException(true); //Bad face exception
         throw e;
     }
+    MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::BOUNDARY_ELEMENTS);
     PetscTools::ReplicateException(false);
 
     if (mPartitioning != DistributedTetrahedralMeshPartitionType::DUMB && PetscTools::IsParallel())
@@ -431,7 +606,9 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
         assert(rMeshReader.HasNodePermutation() == false);
 
         // We reorder so that each process owns a contiguous set of the indices and we can then build a distributed vector factory.
+        MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::REORDER);
         ReorderNodes();
+        MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::REORDER);
 
         unsigned num_owned;
         unsigned rank = PetscTools::GetMyRank();
@@ -579,25 +756,26 @@ bool DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::CalculateDesignatedOwne
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RegisterNode(unsigned index)
 {
-    mNodesMapping[index] = this->mNodes.size();
+    // Indices are normally registered in increasing order, so hint the insertion at the end of the map
+    mNodesMapping.insert(mNodesMapping.end(), std::make_pair(index, 0u))->second = this->mNodes.size();
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RegisterHaloNode(unsigned index)
 {
-    mHaloNodesMapping[index] = mHaloNodes.size();
+    mHaloNodesMapping.insert(mHaloNodesMapping.end(), std::make_pair(index, 0u))->second = mHaloNodes.size();
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RegisterElement(unsigned index)
 {
-    mElementsMapping[index] = this->mElements.size();
+    mElementsMapping.insert(mElementsMapping.end(), std::make_pair(index, 0u))->second = this->mElements.size();
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RegisterBoundaryElement(unsigned index)
 {
-    mBoundaryElementsMapping[index] = this->mBoundaryElements.size();
+    mBoundaryElementsMapping.insert(mBoundaryElementsMapping.end(), std::make_pair(index, 0u))->second = this->mBoundaryElements.size();
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -669,28 +847,38 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ReorderNodes()
 {
     assert(PetscTools::IsParallel());
 
-    // Need to rebuild global-local maps
-    mNodesMapping.clear();
-    mHaloNodesMapping.clear();
-
-    // Update indices
-    for (unsigned index=0; index<this->mNodes.size(); index++)
+    /*
+     * Each node is renumbered independently, so this runs in parallel if OpenMP is available.
+     * The global-local maps are then rebuilt from sorted (global, local) pairs, which std::map
+     * can insert in linear time.
+     */
+    std::vector<std::pair<unsigned, unsigned> > node_pairs(this->mNodes.size());
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int index=0; index<static_cast<int>(this->mNodes.size()); index++)
     {
-        unsigned old_index = this->mNodes[index]->GetIndex();
-        unsigned new_index = this->mNodePermutation[old_index];
-
+        unsigned new_index = this->mNodePermutation[this->mNodes[index]->GetIndex()];
         this->mNodes[index]->SetIndex(new_index);
-        mNodesMapping[new_index] = index;
+        node_pairs[index] = std::make_pair(new_index, static_cast<unsigned>(index));
     }
+    std::sort(node_pairs.begin(), node_pairs.end());
+    mNodesMapping.clear();
+    mNodesMapping.insert(node_pairs.begin(), node_pairs.end());
 
-    for (unsigned index=0; index<mHaloNodes.size(); index++)
+    std::vector<std::pair<unsigned, unsigned> > halo_node_pairs(mHaloNodes.size());
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int index=0; index<static_cast<int>(mHaloNodes.size()); index++)
     {
-        unsigned old_index = mHaloNodes[index]->GetIndex();
-        unsigned new_index = this->mNodePermutation[old_index];
-
+        unsigned new_index = this->mNodePermutation[mHaloNodes[index]->GetIndex()];
         mHaloNodes[index]->SetIndex(new_index);
-        mHaloNodesMapping[new_index] = index;
+        halo_node_pairs[index] = std::make_pair(new_index, static_cast<unsigned>(index));
     }
+    std::sort(halo_node_pairs.begin(), halo_node_pairs.end());
+    mHaloNodesMapping.clear();
+    mHaloNodesMapping.insert(halo_node_pairs.begin(), halo_node_pairs.end());
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TetrahedralMesh.hpp"
 
 #include <cassert>
+#include <climits>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -44,6 +45,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BoundaryElement.hpp"
 #include "Element.hpp"
 #include "Exception.hpp"
+#include "MeshSetupEventHandler.hpp"
 #include "Node.hpp"
 #include "OutputFileHandler.hpp"
 #include "PetscTools.hpp"
@@ -685,32 +687,86 @@ void TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefreshJacobianCachedData()
     this->mElementJacobianDeterminants.resize(num_elements);
     this->mBoundaryElementJacobianDeterminants.resize(num_boundary_elements);
 
-    // Update caches
-    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = this->GetElementIteratorBegin();
-         iter != this->GetElementIteratorEnd();
-         ++iter)
+    /*
+     * Update caches.  Each element only writes its own entries, so the loops run in parallel
+     * if OpenMP is available.  Exceptions must not escape an OpenMP region, so the first
+     * failure (by position) is recorded and re-thrown once the loop has finished.
+     */
+    MeshSetupEventHandler::BeginEvent(MeshSetupEventHandler::JACOBIANS);
+    const int num_local_elements = static_cast<int>(this->mElements.size());
+    unsigned first_bad_element = UINT_MAX;
+    std::string bad_element_message;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int local_index = 0; local_index < num_local_elements; local_index++)
     {
-        unsigned index = iter->GetIndex();
-        iter->CalculateInverseJacobian(this->mElementJacobians[index], this->mElementJacobianDeterminants[index], this->mElementInverseJacobians[index]);
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[local_index];
+        if (p_element->IsDeleted())
+        {
+            continue;
+        }
+
+        try
+        {
+            unsigned index = p_element->GetIndex();
+            p_element->CalculateInverseJacobian(this->mElementJacobians[index], this->mElementJacobianDeterminants[index], this->mElementInverseJacobians[index]);
+
+            if (ELEMENT_DIM < SPACE_DIM)
+            {
+                p_element->CalculateWeightedDirection(this->mElementWeightedDirections[index], this->mElementJacobianDeterminants[index]);
+            }
+        }
+        catch (Exception& e)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(TetrahedralMeshBadJacobian)
+#endif // CHASTE_OPENMP
+            {
+                if (static_cast<unsigned>(local_index) < first_bad_element)
+                {
+                    first_bad_element = local_index;
+                    bad_element_message = e.GetShortMessage();
+                }
+            }
+        }
     }
 
-    if (ELEMENT_DIM < SPACE_DIM)
+    const int num_local_boundary_elements = static_cast<int>(this->mBoundaryElements.size());
+    if (first_bad_element == UINT_MAX)
     {
-        for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = this->GetElementIteratorBegin();
-             iter != this->GetElementIteratorEnd();
-             ++iter)
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+        for (int local_index = 0; local_index < num_local_boundary_elements; local_index++)
         {
-            unsigned index = iter->GetIndex();
-            iter->CalculateWeightedDirection(this->mElementWeightedDirections[index], this->mElementJacobianDeterminants[index]);
+            BoundaryElement<ELEMENT_DIM - 1, SPACE_DIM>* p_boundary_element = this->mBoundaryElements[local_index];
+            try
+            {
+                unsigned index = p_boundary_element->GetIndex();
+                p_boundary_element->CalculateWeightedDirection(this->mBoundaryElementWeightedDirections[index], this->mBoundaryElementJacobianDeterminants[index]);
+            }
+            catch (Exception& e)
+            {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(TetrahedralMeshBadJacobian)
+#endif // CHASTE_OPENMP
+                {
+                    if (static_cast<unsigned>(num_local_elements + local_index) < first_bad_element)
+                    {
+                        first_bad_element = num_local_elements + local_index;
+                        bad_element_message = e.GetShortMessage();
+                    }
+                }
+            }
         }
     }
+    MeshSetupEventHandler::EndEvent(MeshSetupEventHandler::JACOBIANS);
 
-    for (typename TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::BoundaryElementIterator itb = this->GetBoundaryElementIteratorBegin();
-         itb != this->GetBoundaryElementIteratorEnd();
-         itb++)
+    if (first_bad_element != UINT_MAX)
     {
-        unsigned index = (*itb)->GetIndex();
-        (*itb)->CalculateWeightedDirection(this->mBoundaryElementWeightedDirections[index], this->mBoundaryElementJacobianDeterminants[index]);
+        EXCEPTION(bad_element_message);
     }
 }
 
@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Possible mesh reader classes to create
 #include "TrianglesMeshReader.hpp"
 #include "MemfemMeshReader.hpp"
+#include "Hdf5MeshReader.hpp"
 #include "VtkMeshReader.hpp"
 
 /**
@@ -51,6 +52,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * It can use any of the following readers:
  *  - TrianglesMeshReader
  *  - MemfemMeshReader
+ *  - Hdf5MeshReader
  *  - VtkMeshReader
  *
  * The created mesh reader is returned as a std::shared_ptr to ease memory management.
@@ -91,25 +93,33 @@ std::shared_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > GenericMeshReader(c
         }
         catch (const Exception& r_memfem_exception)
         {
-#ifdef CHASTE_VTK
             try
             {
-                p_reader.reset(new VtkMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+                p_reader.reset(new Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
             }
-            catch (const Exception& r_vtk_exception)
+            catch (const Exception& r_hdf5_exception)
             {
+#ifdef CHASTE_VTK
+                try
+                {
+                    p_reader.reset(new VtkMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+                }
+                catch (const Exception& r_vtk_exception)
+                {
 #endif // CHASTE_VTK
-                std::string eol("\n");
-                std::string combined_message = "Could not open appropriate mesh files for " + rPathBaseName + eol;
-                combined_message += "Triangle format: " + r_triangles_exception.GetShortMessage() + eol;
-                combined_message += "Memfem format: " + r_memfem_exception.GetShortMessage() + eol;
+                    std::string eol("\n");
+                    std::string combined_message = "Could not open appropriate mesh files for " + rPathBaseName + eol;
+                    combined_message += "Triangle format: " + r_triangles_exception.GetShortMessage() + eol;
+                    combined_message += "Memfem format: " + r_memfem_exception.GetShortMessage() + eol;
+                    combined_message += "Hdf5 format: " + r_hdf5_exception.GetShortMessage() + eol;
 #ifdef CHASTE_VTK
-                combined_message += "Vtk format: " + r_vtk_exception.GetShortMessage() + eol;
+                    combined_message += "Vtk format: " + r_vtk_exception.GetShortMessage() + eol;
 #endif // CHASTE_VTK
-                EXCEPTION(combined_message);
+                    EXCEPTION(combined_message);
 #ifdef CHASTE_VTK
-            }
+                }
 #endif // CHASTE_VTK
+            }
         }
     }
     return p_reader;
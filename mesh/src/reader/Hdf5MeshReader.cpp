@@ -0,0 +1,383 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+
+#include "Hdf5MeshReader.hpp"
+#include "FileFinder.hpp"
+
+/** Number of rows of a dataset read from the file at a time. */
+const unsigned HDF5_MESH_READER_BLOCK_ROWS = 4096u;
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::Hdf5MeshReader(const std::string& rPathBaseName, bool useStoredNodePermutation)
+    : mFilesBaseName(rPathBaseName),
+      mFileId(-1),
+      mNodesRead(0),
+      mElementsRead(0),
+      mFacesRead(0),
+      mOrderOfElements(1),
+      mOrderOfBoundaryElements(1),
+      mNodePermutationDefined(false)
+{
+    mNodes.DatasetId = -1;
+    mElements.DatasetId = -1;
+    mElementAttributes.DatasetId = -1;
+    mFaces.DatasetId = -1;
+    mFaceAttributes.DatasetId = -1;
+
+    FileFinder h5_file(rPathBaseName + ".h5", RelativeTo::AbsoluteOrCwd);
+    if (!h5_file.IsFile())
+    {
+        EXCEPTION("Could not open data file: " + rPathBaseName + ".h5");
+    }
+
+    mFileId = H5Fopen(h5_file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (mFileId < 0)
+    {
+        EXCEPTION("Could not open data file: " << rPathBaseName << ".h5, H5Fopen error code = " << mFileId);
+    }
+
+    try
+    {
+        OpenDataset("Nodes", mNodes, true);
+        OpenDataset("Elements", mElements, true);
+        OpenDataset("ElementAttributes", mElementAttributes, false);
+        OpenDataset("Faces", mFaces, true);
+        OpenDataset("FaceAttributes", mFaceAttributes, false);
+
+        if (mNodes.NumColumns != SPACE_DIM)
+        {
+            EXCEPTION("Space dimension of mesh file " << rPathBaseName << ".h5 is " << mNodes.NumColumns
+                      << ", expected " << SPACE_DIM);
+        }
+
+        if (mElements.NumColumns == (ELEMENT_DIM+1)*(ELEMENT_DIM+2)/2)
+        {
+            mOrderOfElements = 2;
+        }
+        else if (mElements.NumColumns != ELEMENT_DIM+1)
+        {
+            EXCEPTION("Elements in mesh file " << rPathBaseName << ".h5 have " << mElements.NumColumns
+                      << " nodes, which does not match the element dimension " << ELEMENT_DIM);
+        }
+
+        if (mFaces.NumColumns == ELEMENT_DIM*(ELEMENT_DIM+1)/2 && ELEMENT_DIM > 1)
+        {
+            mOrderOfBoundaryElements = 2;
+        }
+        else if (mFaces.NumColumns != ELEMENT_DIM)
+        {
+            EXCEPTION("Faces in mesh file " << rPathBaseName << ".h5 have " << mFaces.NumColumns
+                      << " nodes, which does not match the element dimension " << ELEMENT_DIM);
+        }
+
+        if (H5Lexists(mFileId, "NodePermutation", H5P_DEFAULT) > 0)
+        {
+            CachedDataset<unsigned> permutation;
+            OpenDataset("NodePermutation", permutation, true);
+            mPermutationVector.resize(permutation.NumRows);
+            if (permutation.NumRows > 0)
+            {
+                H5Dread(permutation.DatasetId, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &mPermutationVector[0]);
+            }
+            CloseDataset(permutation);
+            mNodePermutationDefined = useStoredNodePermutation;
+        }
+    }
+    catch (const Exception&)
+    {
+        CloseFile();
+        throw;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::~Hdf5MeshReader()
+{
+    CloseFile();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+template<typename DATA_TYPE>
+void Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::OpenDataset(const std::string& rName, CachedDataset<DATA_TYPE>& rDataset, bool required)
+{
+    rDataset.Name = rName;
+    rDataset.DatasetId = -1;
+    rDataset.NumRows = 0;
+    rDataset.NumColumns = 0;
+    rDataset.FirstCachedRow = 0;
+    rDataset.NumCachedRows = 0;
+    rDataset.Data.clear();
+
+    if (H5Lexists(mFileId, rName.c_str(), H5P_DEFAULT) <= 0)
+    {
+        if (required)
+        {
+            EXCEPTION("Mesh file " << mFilesBaseName << ".h5 does not contain the dataset '" << rName << "'");
+        }
+        return;
+    }
+
+    rDataset.DatasetId = H5Dopen(mFileId, rName.c_str(), H5P_DEFAULT);
+    hid_t data_space = H5Dget_space(rDataset.DatasetId);
+    int rank = H5Sget_simple_extent_ndims(data_space);
+    hsize_t dims[2] = {0, 0};
+    if (rank == 2)
+    {
+        H5Sget_simple_extent_dims(data_space, dims, nullptr);
+    }
+    H5Sclose(data_space);
+    if (rank != 2)
+    {
+        EXCEPTION("Dataset '" << rName << "' in mesh file " << mFilesBaseName << ".h5 is not two-dimensional");
+    }
+    rDataset.NumRows = dims[0];
+    rDataset.NumColumns = dims[1];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+template<typename DATA_TYPE>
+void Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::CloseDataset(CachedDataset<DATA_TYPE>& rDataset)
+{
+    if (rDataset.DatasetId >= 0)
+    {
+        H5Dclose(rDataset.DatasetId);
+        rDataset.DatasetId = -1;
+    }
+    rDataset.NumCachedRows = 0;
+    rDataset.Data.clear();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::CloseFile()
+{
+    CloseDataset(mNodes);
+    CloseDataset(mElements);
+    CloseDataset(mElementAttributes);
+    CloseDataset(mFaces);
+    CloseDataset(mFaceAttributes);
+    if (mFileId >= 0)
+    {
+        H5Fclose(mFileId);
+        mFileId = -1;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+template<typename DATA_TYPE>
+const DATA_TYPE* Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetRow(CachedDataset<DATA_TYPE>& rDataset, hid_t dataType, unsigned row)
+{
+    if (row >= rDataset.NumRows)
+    {
+        EXCEPTION("Row " << row << " is beyond the end of dataset '" << rDataset.Name
+                  << "' in mesh file " << mFilesBaseName << ".h5");
+    }
+
+    if (row < rDataset.FirstCachedRow || row >= rDataset.FirstCachedRow + rDataset.NumCachedRows)
+    {
+        // Read the block of rows starting at this one through a hyperslab selection
+        hsize_t num_rows = std::min(HDF5_MESH_READER_BLOCK_ROWS, rDataset.NumRows - row);
+        hsize_t offset[2] = {row, 0};
+        hsize_t count[2] = {num_rows, rDataset.NumColumns};
+
+        hid_t file_space = H5Dget_space(rDataset.DatasetId);
+        H5Sselect_hyperslab(file_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+        hsize_t mem_dims[1] = {num_rows*rDataset.NumColumns};
+        hid_t mem_space = H5Screate_simple(1, mem_dims, nullptr);
+
+        rDataset.Data.resize(num_rows*rDataset.NumColumns);
+        herr_t err = H5Dread(rDataset.DatasetId, dataType, mem_space, file_space, H5P_DEFAULT, &rDataset.Data[0]);
+
+        H5Sclose(mem_space);
+        H5Sclose(file_space);
+
+        if (err < 0)
+        {
+            rDataset.NumCachedRows = 0;
+            EXCEPTION("Could not read dataset '" << rDataset.Name << "' in mesh file " << mFilesBaseName << ".h5");
+        }
+        rDataset.FirstCachedRow = row;
+        rDataset.NumCachedRows = num_rows;
+    }
+
+    return &rDataset.Data[(row - rDataset.FirstCachedRow)*rDataset.NumColumns];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetItemData(CachedDataset<unsigned>& rIndices,
+                                                               CachedDataset<double>& rAttributes,
+                                                               unsigned index)
+{
+    ElementData data;
+    const unsigned* p_indices = GetRow(rIndices, H5T_NATIVE_UINT, index);
+    data.NodeIndices.assign(p_indices, p_indices + rIndices.NumColumns);
+    if (rAttributes.DatasetId >= 0)
+    {
+        data.AttributeValue = *GetRow(rAttributes, H5T_NATIVE_DOUBLE, index);
+    }
+    else
+    {
+        data.AttributeValue = 0.0;
+    }
+    return data;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElements() const
+{
+    return mElements.NumRows;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumNodes() const
+{
+    return mNodes.NumRows;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaces() const
+{
+    return mFaces.NumRows;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElementAttributes() const
+{
+    return (mElementAttributes.DatasetId >= 0) ? 1u : 0u;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaceAttributes() const
+{
+    return (mFaceAttributes.DatasetId >= 0) ? 1u : 0u;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextNode()
+{
+    const double* p_coords = GetRow(mNodes, H5T_NATIVE_DOUBLE, mNodesRead);
+    mNodesRead++;
+    return std::vector<double>(p_coords, p_coords + SPACE_DIM);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::Reset()
+{
+    mNodesRead = 0;
+    mElementsRead = 0;
+    mFacesRead = 0;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextElementData()
+{
+    ElementData data = GetItemData(mElements, mElementAttributes, mElementsRead);
+    mElementsRead++;
+    return data;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextFaceData()
+{
+    ElementData data = GetItemData(mFaces, mFaceAttributes, mFacesRead);
+    mFacesRead++;
+    return data;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetNode(unsigned index)
+{
+    mNodesRead = index;
+    return GetNextNode();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetElementData(unsigned index)
+{
+    mElementsRead = index;
+    return GetNextElementData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetFaceData(unsigned index)
+{
+    mFacesRead = index;
+    return GetNextFaceData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetMeshFileBaseName()
+{
+    return mFilesBaseName;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetOrderOfElements()
+{
+    return mOrderOfElements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::GetOrderOfBoundaryElements()
+{
+    return mOrderOfBoundaryElements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::IsFileFormatBinary()
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::HasNodePermutation()
+{
+    return mNodePermutationDefined;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<unsigned>& Hdf5MeshReader<ELEMENT_DIM, SPACE_DIM>::rGetNodePermutation()
+{
+    return mPermutationVector;
+}
+
+// Explicit instantiation
+template class Hdf5MeshReader<1,1>;
+template class Hdf5MeshReader<1,2>;
+template class Hdf5MeshReader<1,3>;
+template class Hdf5MeshReader<2,2>;
+template class Hdf5MeshReader<2,3>;
+template class Hdf5MeshReader<3,3>;
@@ -0,0 +1,223 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef HDF5MESHREADER_HPP_
+#define HDF5MESHREADER_HPP_
+
+#include <string>
+#include <vector>
+#include <hdf5.h>
+
+#include "AbstractMeshReader.hpp"
+
+/**
+ * A reader for meshes stored in a single HDF5 file (with extension .h5) by Hdf5MeshWriter.
+ *
+ * Rows are read from the file in blocks through hyperslab selections, so that sequential
+ * access costs one read per block, while any node, element or face can also be read
+ * directly by index.  This reader therefore reports itself as a binary format, allowing
+ * each process of a DistributedTetrahedralMesh to read only the items it needs.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class Hdf5MeshReader : public AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+
+    /**
+     * An open dataset in the mesh file, together with the block of rows most recently read from it.
+     */
+    template<typename DATA_TYPE>
+    struct CachedDataset
+    {
+        std::string Name;            /**< The name of the dataset in the file. */
+        hid_t DatasetId;             /**< The open dataset (or -1 if it is not present). */
+        unsigned NumRows;            /**< Number of rows in the dataset. */
+        unsigned NumColumns;         /**< Number of columns in the dataset. */
+        unsigned FirstCachedRow;     /**< Index of the first row held in Data. */
+        unsigned NumCachedRows;      /**< Number of rows held in Data. */
+        std::vector<DATA_TYPE> Data; /**< The cached rows, packed contiguously. */
+    };
+
+    std::string mFilesBaseName; /**< The base name of the mesh file (without the .h5 extension). */
+
+    hid_t mFileId; /**< The open HDF5 file. */
+
+    CachedDataset<double> mNodes;               /**< The "Nodes" dataset. */
+    CachedDataset<unsigned> mElements;          /**< The "Elements" dataset. */
+    CachedDataset<double> mElementAttributes;   /**< The "ElementAttributes" dataset. */
+    CachedDataset<unsigned> mFaces;             /**< The "Faces" dataset. */
+    CachedDataset<double> mFaceAttributes;      /**< The "FaceAttributes" dataset. */
+
+    unsigned mNodesRead;    /**< Index of the next node to be returned by GetNextNode(). */
+    unsigned mElementsRead; /**< Index of the next element to be returned by GetNextElementData(). */
+    unsigned mFacesRead;    /**< Index of the next face to be returned by GetNextFaceData(). */
+
+    unsigned mOrderOfElements;         /**< The order of each element (1 for linear, 2 for quadratic). */
+    unsigned mOrderOfBoundaryElements; /**< The order of each boundary element (1 for linear, 2 for quadratic). */
+
+    bool mNodePermutationDefined;              /**< Whether the node permutation stored in the file is reported to callers. */
+    std::vector<unsigned> mPermutationVector;  /**< The node permutation stored in the file, if any. */
+
+    /**
+     * Open a dataset in the file, if it is present.
+     *
+     * @param rName  the name of the dataset
+     * @param rDataset  filled in with the open dataset
+     * @param required  whether to throw if the dataset is not present
+     */
+    template<typename DATA_TYPE>
+    void OpenDataset(const std::string& rName, CachedDataset<DATA_TYPE>& rDataset, bool required);
+
+    /**
+     * Close a dataset, if it is open.
+     *
+     * @param rDataset  the dataset
+     */
+    template<typename DATA_TYPE>
+    void CloseDataset(CachedDataset<DATA_TYPE>& rDataset);
+
+    /**
+     * Get a pointer to one row of a dataset, reading the block containing it if necessary.
+     *
+     * @param rDataset  the dataset
+     * @param dataType  the native type of DATA_TYPE, H5T_NATIVE_DOUBLE or H5T_NATIVE_UINT
+     * @param row  the row index
+     * @return a pointer to the NumColumns entries of the row (valid until the next read of this dataset)
+     */
+    template<typename DATA_TYPE>
+    const DATA_TYPE* GetRow(CachedDataset<DATA_TYPE>& rDataset, hid_t dataType, unsigned row);
+
+    /**
+     * Read the element or face with the given index from the given datasets.
+     *
+     * @param rIndices  the "Elements" or "Faces" dataset
+     * @param rAttributes  the matching attribute dataset
+     * @param index  the item index
+     * @return the item's data
+     */
+    ElementData GetItemData(CachedDataset<unsigned>& rIndices, CachedDataset<double>& rAttributes, unsigned index);
+
+    /** Close all datasets and the file. */
+    void CloseFile();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rPathBaseName  the base name of the mesh file (without the .h5 extension),
+     *    either absolute or relative to the current directory
+     * @param useStoredNodePermutation  whether to report the node permutation stored in the file
+     *    (if any) through HasNodePermutation(), so that a mesh built from this reader records it.
+     *    Leave false unless reloading a mesh which will not be repartitioned.
+     */
+    Hdf5MeshReader(const std::string& rPathBaseName, bool useStoredNodePermutation=false);
+
+    /**
+     * Destructor.
+     */
+    virtual ~Hdf5MeshReader();
+
+    /** @return the number of elements in the mesh */
+    unsigned GetNumElements() const;
+
+    /** @return the number of nodes in the mesh */
+    unsigned GetNumNodes() const;
+
+    /** @return the number of faces in the mesh (synonym of GetNumEdges()) */
+    unsigned GetNumFaces() const;
+
+    /** @return the number of element attributes in the mesh */
+    unsigned GetNumElementAttributes() const;
+
+    /** @return the number of face attributes in the mesh */
+    unsigned GetNumFaceAttributes() const;
+
+    /** @return a vector of the coordinates of each node in turn */
+    std::vector<double> GetNextNode();
+
+    /** Resets pointers to beginning */
+    void Reset();
+
+    /** @return a vector of the node indices of each element (and any attribute information, if there is any) in turn */
+    ElementData GetNextElementData();
+
+    /** @return a vector of the node indices of each face (and any attribute information, if there is any) in turn */
+    ElementData GetNextFaceData();
+
+    /**
+     * Read a node, and move the sequential read position to just after it.
+     *
+     * @param index  The global node index
+     * @return a vector of the coordinates of the node
+     */
+    std::vector<double> GetNode(unsigned index);
+
+    /**
+     * Read an element, and move the sequential read position to just after it.
+     *
+     * @param index  The global element index
+     * @return a vector of the node indices of the element (and any attribute information, if there is any)
+     */
+    ElementData GetElementData(unsigned index);
+
+    /**
+     * Read a face, and move the sequential read position to just after it.
+     *
+     * @param index  The global face index
+     * @return a vector of the node indices of the face (and any attribute information, if there is any)
+     */
+    ElementData GetFaceData(unsigned index);
+
+    /** @return the base name (less the .h5 extension) of the mesh file */
+    std::string GetMeshFileBaseName();
+
+    /** @return the order of the elements (1=linear, 2=quadratic) */
+    unsigned GetOrderOfElements();
+
+    /** @return the order of the boundary elements (1=linear, 2=quadratic) */
+    unsigned GetOrderOfBoundaryElements();
+
+    /** @return true, since items can be read directly by index */
+    bool IsFileFormatBinary();
+
+    /** @return true if the file has a node permutation and the reader was asked to report it */
+    bool HasNodePermutation();
+
+    /** @return the node permutation stored in the file */
+    const std::vector<unsigned>& rGetNodePermutation();
+};
+
+#endif // HDF5MESHREADER_HPP_
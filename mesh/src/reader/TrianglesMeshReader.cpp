@@ -39,6 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshReader.hpp"
 #include "Exception.hpp"
 
+#include <cstring>
+
 static const char* NODES_FILE_EXTENSION = ".node";
 static const char* ELEMENTS_FILE_EXTENSION = ".ele";
 static const char* FACES_FILE_EXTENSION = ".face";
@@ -189,7 +191,14 @@ std::vector<double> TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextNode()
     std::vector<double> ret_coords(SPACE_DIM);
 
     mNodeAttributes.clear(); // clear attributes for this node
-    GetNextItemFromStream(mNodesFile, mNodesRead, ret_coords, mNumNodeAttributes, mNodeAttributes);
+    if (mNodesFileMapping.IsOpen())
+    {
+        GetItemFromMappedFile(mNodesFileMapping, mNodeFileDataStart, mNodeItemWidth, mNodesRead, ret_coords, mNumNodeAttributes, mNodeAttributes);
+    }
+    else
+    {
+        GetNextItemFromStream(mNodesFile, mNodesRead, ret_coords, mNumNodeAttributes, mNodeAttributes);
+    }
 
     mNodesRead++;
     return ret_coords;
@@ -203,7 +212,14 @@ ElementData TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextElementData()
     element_data.AttributeValue = 0.0; // If an attribute is not read this stays as zero, otherwise overwritten.
 
     std::vector<double> element_attributes;
-    GetNextItemFromStream(mElementsFile, mElementsRead, element_data.NodeIndices, mNumElementAttributes, element_attributes);
+    if (mElementsFileMapping.IsOpen())
+    {
+        GetItemFromMappedFile(mElementsFileMapping, mElementFileDataStart, mElementItemWidth, mElementsRead, element_data.NodeIndices, mNumElementAttributes, element_attributes);
+    }
+    else
+    {
+        GetNextItemFromStream(mElementsFile, mElementsRead, element_data.NodeIndices, mNumElementAttributes, element_attributes);
+    }
 
     if (mNumElementAttributes > 0)
     {
@@ -347,16 +363,19 @@ std::vector<double> TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNode(unsigne
         index = mInversePermutationVector[index];
     }
 
-    // Put the file stream pointer to the right location
-    if (index > mNodesRead)
+    // Put the file stream pointer to the right location (no seek is needed if the file is mapped into memory)
+    if (!mNodesFileMapping.IsOpen())
     {
-        // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
-        // to seek from the current position rather than from the start of the file
-        mNodesFile.seekg( mNodeItemWidth*(index-mNodesRead), std::ios_base::cur);
-    }
-    else if (mNodesRead != index)
-    {
-        mNodesFile.seekg(mNodeFileDataStart + mNodeItemWidth*index, std::ios_base::beg);
+        if (index > mNodesRead)
+        {
+            // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
+            // to seek from the current position rather than from the start of the file
+            mNodesFile.seekg( mNodeItemWidth*(index-mNodesRead), std::ios_base::cur);
+        }
+        else if (mNodesRead != index)
+        {
+            mNodesFile.seekg(mNodeFileDataStart + mNodeItemWidth*index, std::ios_base::beg);
+        }
     }
 
     mNodesRead = index; // Allow GetNextNode() to note the position of the item after this one
@@ -376,16 +395,19 @@ ElementData TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetElementData(unsigned
         EXCEPTION("Element " << index << " does not exist - not enough elements (only " << mNumElements << ").");
     }
 
-    // Put the file stream pointer to the right location
-    if (index > mElementsRead)
+    // Put the file stream pointer to the right location (no seek is needed if the file is mapped into memory)
+    if (!mElementsFileMapping.IsOpen())
     {
-        // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
-        // to seek from the current position rather than from the start of the file
-        mElementsFile.seekg( mElementItemWidth*(index-mElementsRead), std::ios_base::cur);
-    }
-    else if (mElementsRead != index)
-    {
-        mElementsFile.seekg(mElementFileDataStart + mElementItemWidth*index, std::ios_base::beg);
+        if (index > mElementsRead)
+        {
+            // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
+            // to seek from the current position rather than from the start of the file
+            mElementsFile.seekg( mElementItemWidth*(index-mElementsRead), std::ios_base::cur);
+        }
+        else if (mElementsRead != index)
+        {
+            mElementsFile.seekg(mElementFileDataStart + mElementItemWidth*index, std::ios_base::beg);
+        }
     }
 
     mElementsRead = index; // Allow GetNextElementData() to note the position of the item after this one
@@ -449,24 +471,30 @@ std::vector<unsigned> TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetContaining
         index = mInversePermutationVector[index];
     }
 
-    // Put the file stream pointer to the right location
-    if (index > mNclItemsRead)
+    // Read the item, putting the file stream pointer to the right location if the file is not mapped into memory
+    std::vector<unsigned> containing_element_indices;
+    containing_element_indices.resize(mMaxContainingElements);
+    std::vector<double> dummy; // unused here
+
+    if (mNclFileMapping.IsOpen())
     {
-        // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
-        // to seek from the current position rather than from the start of the file
-        mNclFile.seekg( mNclItemWidth*(index-mNclItemsRead), std::ios_base::cur);
+        GetItemFromMappedFile(mNclFileMapping, mNclFileDataStart, mNclItemWidth, index, containing_element_indices, 0, dummy);
     }
-    else if  ( mNclItemsRead != index )
+    else
     {
-        mNclFile.seekg(mNclFileDataStart + mNclItemWidth*index, std::ios_base::beg);
-    }
-
-    // Read the next item
-    std::vector<unsigned> containing_element_indices;
-    containing_element_indices.resize(mMaxContainingElements);
+        if (index > mNclItemsRead)
+        {
+            // This is a monotonic (but non-contiguous) read.  Let's assume that it's more efficient
+            // to seek from the current position rather than from the start of the file
+            mNclFile.seekg( mNclItemWidth*(index-mNclItemsRead), std::ios_base::cur);
+        }
+        else if  ( mNclItemsRead != index )
+        {
+            mNclFile.seekg(mNclFileDataStart + mNclItemWidth*index, std::ios_base::beg);
+        }
 
-    std::vector<double> dummy; // unused here
-    GetNextItemFromStream(mNclFile, index, containing_element_indices, 0, dummy);
+        GetNextItemFromStream(mNclFile, index, containing_element_indices, 0, dummy);
+    }
     mNclItemsRead = index + 1; //Ready for the next call
 
     EnsureIndexingFromZero(containing_element_indices);
@@ -825,6 +853,11 @@ void TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::ReadHeaders()
         assert(num_nodes_per_cable_element == 2u);
         mCableElementsRead = 0u;
     }
+
+    if (mFilesAreBinary)
+    {
+        MapBinaryFiles();
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -835,6 +868,65 @@ void TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::CloseFiles()
     mFacesFile.close();
     mNclFile.close();
     mCableElementsFile.close();
+
+    mNodesFileMapping.Close();
+    mElementsFileMapping.Close();
+    mNclFileMapping.Close();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::MapBinaryFiles()
+{
+    assert(mFilesAreBinary);
+
+    mNodesFileMapping.Open(mFilesBaseName + NODES_FILE_EXTENSION);
+
+    // The elements file has the same name as in OpenElementsFile()
+    if (ELEMENT_DIM == SPACE_DIM)
+    {
+        mElementsFileMapping.Open(mFilesBaseName + ELEMENTS_FILE_EXTENSION);
+    }
+    else if (ELEMENT_DIM == 1)
+    {
+        mElementsFileMapping.Open(mFilesBaseName + EDGES_FILE_EXTENSION);
+    }
+    else
+    {
+        mElementsFileMapping.Open(mFilesBaseName + FACES_FILE_EXTENSION);
+    }
+
+    if (mNclFileAvailable)
+    {
+        mNclFileMapping.Open(mFilesBaseName + NCL_FILE_EXTENSION);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+template<class T_DATA>
+void TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>::GetItemFromMappedFile(const MemoryMappedFile& rMappedFile, std::streampos dataStart,
+                                                                        std::streamoff itemWidth, unsigned itemIndex,
+                                                                        std::vector<T_DATA>& rDataPacket, const unsigned& rNumAttributes,
+                                                                        std::vector<double>& rAttributes)
+{
+    std::size_t offset = static_cast<std::size_t>(dataStart) + static_cast<std::size_t>(itemWidth)*itemIndex;
+    std::size_t packet_size = rDataPacket.size()*sizeof(T_DATA);
+    if (offset + packet_size + rNumAttributes*sizeof(double) > rMappedFile.GetSize())
+    {
+        mEofException = true;
+        EXCEPTION("File contains incomplete data: unexpected end of file.");
+    }
+
+    const char* p_item = rMappedFile.GetData() + offset;
+    if (!rDataPacket.empty()) // Avoid MSVC 10 assertion
+    {
+        memcpy(&rDataPacket[0], p_item, packet_size);
+    }
+    for (unsigned i = 0; i < rNumAttributes; i++)
+    {
+        double attribute;
+        memcpy(&attribute, p_item + packet_size + i*sizeof(double), sizeof(double));
+        rAttributes.push_back(attribute);
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
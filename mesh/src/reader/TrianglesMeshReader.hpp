@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <fstream>
 #include "AbstractMeshReader.hpp"
+#include "MemoryMappedFile.hpp"
 
 /**
  * Concrete version of the AbstractCachedMeshReader class.
@@ -66,6 +67,10 @@ private:
     std::ifstream mNclFile;         /**< The node connectivity list file for the mesh. */
     std::ifstream mCableElementsFile; /**< The elements file for the mesh. */
 
+    MemoryMappedFile mNodesFileMapping;    /**< The nodes file mapped into memory, for random access to binary data. */
+    MemoryMappedFile mElementsFileMapping; /**< The elements file mapped into memory, for random access to binary data. */
+    MemoryMappedFile mNclFileMapping;      /**< The node connectivity list file mapped into memory, for random access to binary data. */
+
     std::streampos mNodeFileDataStart; /**< The start of the binary data*/
     std::streamoff mNodeItemWidth;  /**< The number of bytes in a line of the node file*/
     std::streampos mElementFileDataStart; /**< The start of the binary element data*/
@@ -311,6 +316,31 @@ private:
     /** Close mesh files. */
     void CloseFiles();
 
+    /**
+     * Map the binary node, element and node connectivity list files into memory. Once mapped,
+     * every item is read directly from memory at its known offset, so random access with
+     * GetNode(), GetElementData() and GetContainingElementIndices() does not need to seek.
+     * Called at the end of ReadHeaders() if the files are binary.
+     */
+    void MapBinaryFiles();
+
+    /**
+     * Read an item from a binary mesh file that has been mapped into memory.
+     *
+     * @param rMappedFile  The mapped file to read from
+     * @param dataStart  The offset of the first item after the file header
+     * @param itemWidth  The number of bytes in each item
+     * @param itemIndex  The index of the item to read
+     * @param rDataPacket  Assumed to be of the right size but is allowed to contain dirty data on entry.
+     * @param rNumAttributes  The number of attributes per item that we expect to read.
+     * @param rAttributes  Will be filled with the attribute values if rNumAttributes > 0, otherwise empty.
+     */
+    template<class T_DATA>
+    void GetItemFromMappedFile(const MemoryMappedFile& rMappedFile, std::streampos dataStart,
+                               std::streamoff itemWidth, unsigned itemIndex,
+                               std::vector<T_DATA>& rDataPacket, const unsigned& rNumAttributes,
+                               std::vector<double>& rAttributes);
+
     /**
      * Read in the next line.
      *
@@ -35,6 +35,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTPERELEMENTWRITER_HPP_
 #define ABSTRACTPERELEMENTWRITER_HPP_
 
+#include <algorithm>
+#include <vector>
+
 #include "AbstractTetrahedralMesh.hpp"
 #include "UblasCustomFunctions.hpp"
 #include "OutputFileHandler.hpp"
@@ -141,6 +144,10 @@ public:
      * Writing is done by the master process using the WriteElement() method.
      * Any element not owned by the master is communicated by the unique designated owner.
      *
+     * The elements are dealt with in blocks of consecutive global indices: each process visits the
+     * elements of the block it is the designated owner of, and the data are gathered onto the master
+     * in one collective operation per block, which bounds the memory needed on the master.
+     *
      * MUST BE CALLED IN PARALLEL.
      *
      * @param rHandler  specify the directory in which to place the output file
@@ -150,12 +157,10 @@ public:
     {
         PreWriteCalculations(rHandler);
 
-        c_vector<double, DATA_SIZE> data;
-        if (PetscTools::AmMaster())
+        const bool am_master = PetscTools::AmMaster();
+        if (am_master)
         {
             mpMasterFile = rHandler.OpenOutputFile(rFileName);
-            MPI_Status status;
-            status.MPI_ERROR = MPI_SUCCESS; //For MPICH2
             WriteHeaderOnMaster();
             // say whether the fibres are binary in the header line (not ended yet!)
             if (mFileIsBinary)
@@ -166,45 +171,35 @@ public:
             {
                 *mpMasterFile << "\n";
             }
-            // The master process needs to keep track of both the global element list
-            // (so that all elements are concentrated) and the local element list (so that
-            // a local element index can be applied
-            unsigned local_element_index=0u; //Data invariant associates iter with local_element_index
-            typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
-
-            for (unsigned global_element_index=0; global_element_index<mpMesh->GetNumElements(); global_element_index++)
-            {
-                if (mpMesh->CalculateDesignatedOwnershipOfElement(global_element_index))
-                {
-                    Element<ELEMENT_DIM,SPACE_DIM>* p_elem = mpMesh->GetElement(global_element_index);
-                    //Spool forward in the local vector of elements
-                    while (&(*iter) != p_elem)
-                    {
-                        ++iter;
-                        local_element_index++;
-                        assert(iter != mpMesh->GetElementIteratorEnd());
-                    }
-                    //Master owns this process and can write it directly
-                    Visit(p_elem, local_element_index, data);
-                }
-                else
-                {
-                    //Data must come from a remote process
-                    MPI_Recv(&data[0], DATA_SIZE, MPI_DOUBLE, MPI_ANY_SOURCE, global_element_index, PETSC_COMM_WORLD, &status);
-                }
-                WriteElementOnMaster(data);
-            }
-            *mpMasterFile << "# "<<ChasteBuildInfo::GetProvenanceString();
-            mpMasterFile->close();
         }
-        else
+
+        const unsigned block_size = 4096u;
+        const unsigned num_elements = mpMesh->GetNumElements();
+        const unsigned num_procs = PetscTools::GetNumProcs();
+
+        std::vector<unsigned> my_indices;
+        std::vector<double> my_data;
+        std::vector<int> index_counts(num_procs);
+        std::vector<int> index_displacements(num_procs);
+        std::vector<int> data_counts(num_procs);
+        std::vector<int> data_displacements(num_procs);
+        std::vector<unsigned> gathered_indices;
+        std::vector<double> gathered_data;
+        std::vector<double> block_data;
+
+        c_vector<double, DATA_SIZE> data;
+        unsigned local_index = 0u; //Data invariant associates iter with local_index
+        unsigned previous_index = 0u; //Used to check that the indices are monotone
+        typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
+
+        for (unsigned block_start=0; block_start<num_elements; block_start+=block_size)
         {
-            //Not master process
-            unsigned previous_index = 0u; //Used to check that the indices are monotone
-            unsigned local_index = 0u;
-            for (typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
-                          iter != mpMesh->GetElementIteratorEnd();
-                          ++iter, local_index++)
+            const unsigned block_end = std::min(block_start + block_size, num_elements);
+
+            // Visit the local elements in this block which this process is responsible for
+            my_indices.clear();
+            my_data.clear();
+            while (iter != mpMesh->GetElementIteratorEnd() && iter->GetIndex() < block_end)
             {
                 unsigned element_index = iter->GetIndex();
                 //Check monotonicity
@@ -215,13 +210,55 @@ public:
                 previous_index = element_index;
                 if (mpMesh->CalculateDesignatedOwnershipOfElement(element_index))
                 {
-                    // The master needs to know about this one.
                     Visit(&(*iter), local_index, data);
-                    /// \todo See if this can be speeded up with #2351.
-                    MPI_Ssend(&data[0], DATA_SIZE, MPI_DOUBLE, 0, element_index, PETSC_COMM_WORLD);//Tag with element_index
+                    my_indices.push_back(element_index);
+                    my_data.insert(my_data.end(), data.begin(), data.end());
                 }
+                ++iter;
+                local_index++;
             }
 
+            // Concentrate them on the master
+            int my_count = my_indices.size();
+            MPI_Gather(&my_count, 1, MPI_INT, &index_counts[0], 1, MPI_INT, 0, PETSC_COMM_WORLD);
+            if (am_master)
+            {
+                for (unsigned process=0; process<num_procs; process++)
+                {
+                    index_displacements[process] = (process == 0) ? 0 : index_displacements[process-1] + index_counts[process-1];
+                    data_counts[process] = index_counts[process]*DATA_SIZE;
+                    data_displacements[process] = index_displacements[process]*DATA_SIZE;
+                }
+                assert(index_displacements[num_procs-1] + index_counts[num_procs-1] == (int)(block_end - block_start));
+                gathered_indices.resize(block_end - block_start);
+                gathered_data.resize((block_end - block_start)*DATA_SIZE);
+            }
+            MPI_Gatherv(my_indices.data(), my_count, MPI_UNSIGNED,
+                        gathered_indices.data(), &index_counts[0], &index_displacements[0], MPI_UNSIGNED, 0, PETSC_COMM_WORLD);
+            MPI_Gatherv(my_data.data(), my_count*DATA_SIZE, MPI_DOUBLE,
+                        gathered_data.data(), &data_counts[0], &data_displacements[0], MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+
+            if (am_master)
+            {
+                // Put the block into global order and write it
+                block_data.resize(gathered_data.size());
+                for (unsigned i=0; i<gathered_indices.size(); i++)
+                {
+                    std::copy(gathered_data.begin() + i*DATA_SIZE, gathered_data.begin() + (i+1)*DATA_SIZE,
+                              block_data.begin() + (gathered_indices[i] - block_start)*DATA_SIZE);
+                }
+                for (unsigned i=0; i<block_end-block_start; i++)
+                {
+                    std::copy(block_data.begin() + i*DATA_SIZE, block_data.begin() + (i+1)*DATA_SIZE, data.begin());
+                    WriteElementOnMaster(data);
+                }
+            }
+        }
+
+        if (am_master)
+        {
+            *mpMasterFile << "# "<<ChasteBuildInfo::GetProvenanceString();
+            mpMasterFile->close();
         }
     }
 
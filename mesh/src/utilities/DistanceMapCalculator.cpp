@@ -34,6 +34,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "DistanceMapCalculator.hpp"
+
+#include <algorithm>
+
 #include "DistributedTetrahedralMesh.hpp" // For dynamic cast
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -41,11 +44,11 @@ DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::DistanceMapCalculator(
             AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>& rMesh)
     : mrMesh(rMesh),
       mWorkOnEntireMesh(true),
-      mNumHalosPerProcess(nullptr),
       mRoundCounter(0u),
       mPopCounter(0u),
       mTargetNodeIndex(UINT_MAX),
-      mSingleTarget(false)
+      mSingleTarget(false),
+      mUseGeodesicDistances(false)
 {
     mNumNodes = mrMesh.GetNumNodes();
 
@@ -65,11 +68,75 @@ DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::DistanceMapCalculator(
 
         // Get local halo information
         p_distributed_mesh->GetHaloNodeIndices(mHaloNodeIndices);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::SetUseGeodesicDistances(bool useGeodesicDistances)
+{
+    mUseGeodesicDistances = useGeodesicDistances;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::SetUpNeighbourLists()
+{
+    const unsigned num_local_nodes = mHi - mLo;
+
+    // Gather the distinct neighbours of each node from its containing elements (each node independently)
+    std::vector<std::vector<Node<SPACE_DIM>*> > neighbours(num_local_nodes);
+#ifdef CHASTE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 256)
+#endif // CHASTE_OPENMP
+    for (int local_index=0; local_index<(int)num_local_nodes; local_index++)
+    {
+        Node<SPACE_DIM>* p_node = mrMesh.GetNode(mLo + local_index);
+        std::vector<std::pair<unsigned, Node<SPACE_DIM>*> > indexed_neighbours;
+        for (typename Node<SPACE_DIM>::ContainingElementIterator element_iterator = p_node->ContainingElementsBegin();
+             element_iterator != p_node->ContainingElementsEnd();
+             ++element_iterator)
+        {
+            Element<ELEMENT_DIM, SPACE_DIM>* p_containing_element = mrMesh.GetElement(*element_iterator);
+            for (unsigned node_local_index=0; node_local_index<p_containing_element->GetNumNodes(); node_local_index++)
+            {
+                Node<SPACE_DIM>* p_neighbour_node = p_containing_element->GetNode(node_local_index);
+                if (p_neighbour_node != p_node)
+                {
+                    indexed_neighbours.push_back(std::make_pair(p_neighbour_node->GetIndex(), p_neighbour_node));
+                }
+            }
+        }
+        std::sort(indexed_neighbours.begin(), indexed_neighbours.end());
 
-        // Share information on the number of halo nodes
-        unsigned my_size = mHaloNodeIndices.size();
-        mNumHalosPerProcess = new unsigned[PetscTools::GetNumProcs()];
-        MPI_Allgather(&my_size, 1, MPI_UNSIGNED, mNumHalosPerProcess, 1, MPI_UNSIGNED, PETSC_COMM_WORLD);
+        for (unsigned i=0; i<indexed_neighbours.size(); i++)
+        {
+            if (i == 0 || indexed_neighbours[i].first != indexed_neighbours[i-1].first)
+            {
+                neighbours[local_index].push_back(indexed_neighbours[i].second);
+            }
+        }
+    }
+
+    // Flatten into compressed rows
+    mNeighbourOffsets.resize(num_local_nodes + 1);
+    mNeighbourOffsets[0] = 0;
+    for (unsigned local_index=0; local_index<num_local_nodes; local_index++)
+    {
+        mNeighbourOffsets[local_index + 1] = mNeighbourOffsets[local_index] + neighbours[local_index].size();
+    }
+    mNeighbourNodes.resize(mNeighbourOffsets[num_local_nodes]);
+    mNeighbourDistances.resize(mNeighbourOffsets[num_local_nodes]);
+
+#ifdef CHASTE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int local_index=0; local_index<(int)num_local_nodes; local_index++)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = mrMesh.GetNode(mLo + local_index)->rGetLocation();
+        for (unsigned i=0; i<neighbours[local_index].size(); i++)
+        {
+            mNeighbourNodes[mNeighbourOffsets[local_index] + i] = neighbours[local_index][i];
+            mNeighbourDistances[mNeighbourOffsets[local_index] + i] = norm_2(neighbours[local_index][i]->rGetLocation() - r_location);
+        }
     }
 }
 
@@ -85,6 +152,15 @@ void DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::ComputeDistanceMap(
     }
     assert(mActivePriorityNodeIndexQueue.empty());
 
+    if (mNeighbourOffsets.empty())
+    {
+        SetUpNeighbourLists();
+    }
+    if (mWorkOnEntireMesh == false)
+    {
+        mLastSentHaloDistances.assign(mHaloNodeIndices.size(), DBL_MAX);
+    }
+
     if (mSingleTarget)
     {
         assert(rSourceNodeIndices.size() == 1);
@@ -148,47 +224,64 @@ bool DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::UpdateQueueFromRemote(std::v
         // This update does nowt
         return !mActivePriorityNodeIndexQueue.empty();
     }
-    for (unsigned bcast_process=0; bcast_process<PetscTools::GetNumProcs(); bcast_process++)
+    /*
+     * Share the halo distances which have improved since they were last sent. A single gather
+     * of everyone's changes replaces a broadcast of every halo from each process in turn.
+     */
+    std::vector<double> send_distances;
+    std::vector<unsigned> send_indices;
+    for (unsigned index=0; index<mHaloNodeIndices.size(); index++)
     {
-        // Process packs cart0/cart1/...euclid/index into a 1-d array
-        double* dist_exchange = new double[ mNumHalosPerProcess[bcast_process] ];
-        unsigned* index_exchange = new unsigned[ mNumHalosPerProcess[bcast_process] ];
-        if (PetscTools::GetMyRank() == bcast_process)
+        double distance = rNodeDistances[mHaloNodeIndices[index]];
+        if (distance < mLastSentHaloDistances[index])
         {
-            // Broadcaster fills the array
-            for (unsigned index=0; index<mHaloNodeIndices.size();index++)
-            {
-                dist_exchange[index] = rNodeDistances[mHaloNodeIndices[index]];
-                index_exchange[index] = mHaloNodeIndices[index];
-            }
+            send_distances.push_back(distance);
+            send_indices.push_back(mHaloNodeIndices[index]);
+            mLastSentHaloDistances[index] = distance;
         }
+    }
+
+    const unsigned num_procs = PetscTools::GetNumProcs();
+    int my_count = send_distances.size();
+    std::vector<int> counts(num_procs);
+    MPI_Allgather(&my_count, 1, MPI_INT, &counts[0], 1, MPI_INT, PETSC_COMM_WORLD);
 
-        /*
-         * Broadcast - this is can be done by casting indices to double and
-         * packing everything into a single array. That would be better for
-         * latency, but this is probably more readable.
-         */
-        MPI_Bcast(dist_exchange, mNumHalosPerProcess[bcast_process], MPI_DOUBLE,
-                  bcast_process, PETSC_COMM_WORLD);
-        MPI_Bcast(index_exchange, mNumHalosPerProcess[bcast_process], MPI_UNSIGNED,
-                  bcast_process, PETSC_COMM_WORLD);
-        if (PetscTools::GetMyRank() != bcast_process)
+    std::vector<int> displacements(num_procs, 0);
+    for (unsigned process=1; process<num_procs; process++)
+    {
+        displacements[process] = displacements[process-1] + counts[process-1];
+    }
+    unsigned total_count = displacements[num_procs-1] + counts[num_procs-1];
+
+    // Pad the buffers so that they always have storage
+    send_distances.push_back(0.0);
+    send_indices.push_back(0u);
+    std::vector<double> dist_exchange(total_count + 1);
+    std::vector<unsigned> index_exchange(total_count + 1);
+    MPI_Allgatherv(&send_distances[0], my_count, MPI_DOUBLE,
+                   &dist_exchange[0], &counts[0], &displacements[0], MPI_DOUBLE, PETSC_COMM_WORLD);
+    MPI_Allgatherv(&send_indices[0], my_count, MPI_UNSIGNED,
+                   &index_exchange[0], &counts[0], &displacements[0], MPI_UNSIGNED, PETSC_COMM_WORLD);
+
+    const unsigned my_rank = PetscTools::GetMyRank();
+    for (unsigned process=0; process<num_procs; process++)
+    {
+        if (process == my_rank)
+        {
+            continue;
+        }
+        // Receiving process take updates
+        for (int index=displacements[process]; index<displacements[process]+counts[process]; index++)
         {
-            // Receiving process take updates
-            for (unsigned index=0; index<mNumHalosPerProcess[bcast_process];index++)
+            unsigned global_index = index_exchange[index];
+            // Is it a better answer?
+            if (dist_exchange[index] < rNodeDistances[global_index]*(1.0-2*DBL_EPSILON) )
             {
-                unsigned global_index=index_exchange[index];
-                // Is it a better answer?
-                if (dist_exchange[index] < rNodeDistances[global_index]*(1.0-2*DBL_EPSILON) )
-                {
-                    // Copy across - this may be unnecessary when PushLocal isn't going to push because it's not local
-                    rNodeDistances[global_index] = dist_exchange[index];
-                    PushLocal(rNodeDistances[global_index], global_index);
-                }
+                // Copy across - this may be unnecessary when PushLocal isn't going to push because it's not local
+                rNodeDistances[global_index] = dist_exchange[index];
+                PushLocal(rNodeDistances[global_index], global_index);
             }
         }
-        delete [] dist_exchange;
-        delete [] index_exchange;
     }
     // Is any queue non-empty?
     bool non_empty_queue = PetscTools::ReplicateBool(!mActivePriorityNodeIndexQueue.empty());
@@ -218,43 +311,62 @@ bool DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::WorkOnLocalQueue(std::vector
                  current_heuristic=norm_2(p_current_node->rGetLocation()-mTargetNodePoint);
             }
 
-            // Loop over the elements containing the given node
-            for (typename Node<SPACE_DIM>::ContainingElementIterator element_iterator = p_current_node->ContainingElementsBegin();
-                element_iterator != p_current_node->ContainingElementsEnd();
-                ++element_iterator)
+            if (mUseGeodesicDistances && !mSingleTarget)
             {
-                // Get a pointer to the container element
-                Element<ELEMENT_DIM, SPACE_DIM>* p_containing_element = mrMesh.GetElement(*element_iterator);
-
-                // Loop over the nodes of the element
-                for (unsigned node_local_index=0;
-                   node_local_index<p_containing_element->GetNumNodes();
-                   node_local_index++)
+                // Loop over the elements containing the given node, updating its neighbours across each element
+                for (typename Node<SPACE_DIM>::ContainingElementIterator element_iterator = p_current_node->ContainingElementsBegin();
+                    element_iterator != p_current_node->ContainingElementsEnd();
+                    ++element_iterator)
                 {
-                    Node<SPACE_DIM>* p_neighbour_node = p_containing_element->GetNode(node_local_index);
-                    unsigned neighbour_node_index = p_neighbour_node->GetIndex();
-
-                    // Avoid revisiting the active node
-                    if (neighbour_node_index != current_node_index)
+                    Element<ELEMENT_DIM, SPACE_DIM>* p_containing_element = mrMesh.GetElement(*element_iterator);
+                    unsigned current_local_index = 0;
+                    while (p_containing_element->GetNodeGlobalIndex(current_local_index) != current_node_index)
                     {
+                        current_local_index++;
+                    }
 
-                        double neighbour_heuristic=0.0;
-                        if (mSingleTarget)
-                        {
-                             neighbour_heuristic=norm_2(p_neighbour_node->rGetLocation()-mTargetNodePoint);
-                        }
-                        // Test if we have found a shorter path from the source to the neighbour through current node
-                        double updated_distance = rNodeDistances[current_node_index] +
-                                                  norm_2(p_neighbour_node->rGetLocation() - p_current_node->rGetLocation())
-                                                  - current_heuristic + neighbour_heuristic;
-                        if (updated_distance < rNodeDistances[neighbour_node_index] * (1.0-2*DBL_EPSILON))
+                    for (unsigned node_local_index=0;
+                       node_local_index<p_containing_element->GetNumNodes();
+                       node_local_index++)
+                    {
+                        if (node_local_index != current_local_index)
                         {
-                            rNodeDistances[neighbour_node_index] = updated_distance;
-                            PushLocal(updated_distance, neighbour_node_index);
+                            unsigned neighbour_node_index = p_containing_element->GetNodeGlobalIndex(node_local_index);
+                            double updated_distance = CalculateGeodesicUpdate(p_containing_element, node_local_index,
+                                                                              current_local_index, rNodeDistances);
+                            if (updated_distance < rNodeDistances[neighbour_node_index] * (1.0-2*DBL_EPSILON))
+                            {
+                                rNodeDistances[neighbour_node_index] = updated_distance;
+                                PushLocal(updated_distance, neighbour_node_index);
+                            }
                         }
                     }
                 }
             }
+            else
+            {
+                // Loop over the neighbours of the given node
+                unsigned local_index = current_node_index - mLo;
+                for (unsigned i=mNeighbourOffsets[local_index]; i<mNeighbourOffsets[local_index+1]; i++)
+                {
+                    Node<SPACE_DIM>* p_neighbour_node = mNeighbourNodes[i];
+                    unsigned neighbour_node_index = p_neighbour_node->GetIndex();
+
+                    double neighbour_heuristic=0.0;
+                    if (mSingleTarget)
+                    {
+                         neighbour_heuristic=norm_2(p_neighbour_node->rGetLocation()-mTargetNodePoint);
+                    }
+                    // Test if we have found a shorter path from the source to the neighbour through current node
+                    double updated_distance = rNodeDistances[current_node_index] + mNeighbourDistances[i]
+                                              - current_heuristic + neighbour_heuristic;
+                    if (updated_distance < rNodeDistances[neighbour_node_index] * (1.0-2*DBL_EPSILON))
+                    {
+                        rNodeDistances[neighbour_node_index] = updated_distance;
+                        PushLocal(updated_distance, neighbour_node_index);
+                    }
+                }
+            }
             if (mSingleTarget)
             {
                 if (current_node_index == mTargetNodeIndex)
@@ -273,6 +385,150 @@ bool DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::WorkOnLocalQueue(std::vector
      return false;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::CalculateGeodesicUpdate(Element<ELEMENT_DIM, SPACE_DIM>* pElement,
+                                                                              unsigned targetLocalIndex,
+                                                                              unsigned sourceLocalIndex,
+                                                                              const std::vector<double>& rNodeDistances)
+{
+    // The other nodes of the element with known distances, the source node first
+    unsigned known[ELEMENT_DIM];
+    unsigned num_known = 0;
+    known[num_known++] = sourceLocalIndex;
+    for (unsigned local_index=0; local_index<pElement->GetNumNodes(); local_index++)
+    {
+        if (local_index != targetLocalIndex && local_index != sourceLocalIndex
+            && rNodeDistances[pElement->GetNodeGlobalIndex(local_index)] < DBL_MAX)
+        {
+            known[num_known++] = local_index;
+        }
+    }
+
+    // Try every vertex, edge and face of the known nodes which includes the source node
+    const c_vector<double, SPACE_DIM>& r_target = pElement->GetNode(targetLocalIndex)->rGetLocation();
+    double best_distance = DBL_MAX;
+    for (unsigned subset=1; subset<(1u<<num_known); subset+=2)
+    {
+        const c_vector<double, SPACE_DIM>* vertices[3];
+        double distances[3];
+        unsigned num_vertices = 0;
+        for (unsigned i=0; i<num_known; i++)
+        {
+            if (subset & (1u<<i))
+            {
+                vertices[num_vertices] = &(pElement->GetNode(known[i])->rGetLocation());
+                distances[num_vertices] = rNodeDistances[pElement->GetNodeGlobalIndex(known[i])];
+                num_vertices++;
+            }
+        }
+        best_distance = std::min(best_distance, MinimiseOverSimplex(r_target, vertices, distances, num_vertices));
+    }
+    return best_distance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::MinimiseOverSimplex(const c_vector<double, SPACE_DIM>& rTarget,
+                                                                          const c_vector<double, SPACE_DIM>* pVertices[],
+                                                                          const double pDistances[],
+                                                                          unsigned numVertices)
+{
+    assert(numVertices >= 1 && numVertices <= 3);
+    c_vector<double, SPACE_DIM> to_target = rTarget - *pVertices[0];
+    if (numVertices == 1)
+    {
+        return pDistances[0] + norm_2(to_target);
+    }
+
+    /*
+     * Points of the simplex are p = x0 + E lambda, where the columns of E are the edges from
+     * vertex 0, and the distance there is d0 + delta.lambda.  Setting the gradient of
+     * d0 + delta.lambda + |x - p| to zero gives, with G = E^T E and r = x - p,
+     *   |r|^2 (1 - delta^T G^-1 delta) = |component of x - x0 normal to the simplex|^2
+     *   lambda = G^-1 (E^T (x - x0) - |r| delta).
+     */
+    const unsigned num_edges = numVertices - 1;
+    c_vector<double, SPACE_DIM> edges[2];
+    double gram[2][2];
+    double projections[2];
+    double increments[2];
+    for (unsigned i=0; i<num_edges; i++)
+    {
+        edges[i] = *pVertices[i+1] - *pVertices[0];
+        projections[i] = inner_prod(edges[i], to_target);
+        increments[i] = pDistances[i+1] - pDistances[0];
+    }
+    for (unsigned i=0; i<num_edges; i++)
+    {
+        for (unsigned j=0; j<num_edges; j++)
+        {
+            gram[i][j] = inner_prod(edges[i], edges[j]);
+        }
+    }
+
+    double inverse_gram[2][2];
+    if (num_edges == 1)
+    {
+        inverse_gram[0][0] = 1.0/gram[0][0];
+    }
+    else
+    {
+        double determinant = gram[0][0]*gram[1][1] - gram[0][1]*gram[1][0];
+        if (determinant <= 1e-12*gram[0][0]*gram[1][1])
+        {
+            // Degenerate face: the edges will do instead
+            return DBL_MAX;
+        }
+        inverse_gram[0][0] = gram[1][1]/determinant;
+        inverse_gram[1][1] = gram[0][0]/determinant;
+        inverse_gram[0][1] = -gram[0][1]/determinant;
+        inverse_gram[1][0] = -gram[1][0]/determinant;
+    }
+
+    double coefficients[2] = {0.0, 0.0}; // G^-1 E^T (x - x0)
+    double directions[2] = {0.0, 0.0}; // G^-1 delta
+    for (unsigned i=0; i<num_edges; i++)
+    {
+        for (unsigned j=0; j<num_edges; j++)
+        {
+            coefficients[i] += inverse_gram[i][j]*projections[j];
+            directions[i] += inverse_gram[i][j]*increments[j];
+        }
+    }
+    double gradient_squared = 0.0;
+    double in_plane_squared = 0.0;
+    for (unsigned i=0; i<num_edges; i++)
+    {
+        gradient_squared += increments[i]*directions[i];
+        in_plane_squared += projections[i]*coefficients[i];
+    }
+    if (gradient_squared >= 1.0)
+    {
+        // The distances across the simplex vary faster than distance itself, so the minimum is on its boundary
+        return DBL_MAX;
+    }
+
+    double normal_squared = std::max(inner_prod(to_target, to_target) - in_plane_squared, 0.0);
+    double distance_to_simplex = sqrt(normal_squared/(1.0 - gradient_squared));
+
+    double distance = pDistances[0] + distance_to_simplex;
+    double lambda_sum = 0.0;
+    for (unsigned i=0; i<num_edges; i++)
+    {
+        double lambda = coefficients[i] - distance_to_simplex*directions[i];
+        if (lambda < 0.0)
+        {
+            return DBL_MAX;
+        }
+        lambda_sum += lambda;
+        distance += increments[i]*lambda;
+    }
+    if (lambda_sum > 1.0)
+    {
+        return DBL_MAX;
+    }
+    return distance;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM>::SingleDistance(unsigned sourceNodeIndex, unsigned targetNodeIndex)
 {
@@ -64,8 +64,6 @@ private:
     unsigned mHi;
     /** Whether we should work on the entire mesh.  True if sequential.  True is the mesh is a plain TetrahedralMesh.*/
     bool mWorkOnEntireMesh;
-    /** (Only used when mWorkOnEntrireMesh == false).  This forms an array of with the number of halo nodes known by each process.*/
-    unsigned *mNumHalosPerProcess;
     /** (Only used when mWorkOnEntrireMesh == false).  This is a local cache of halo node indices.*/
     std::vector<unsigned> mHaloNodeIndices;
     /** Used to check parallel implementation*/
@@ -78,6 +76,21 @@ private:
     bool mSingleTarget;
     /** Also used in the calculation of point-to-point distances with A* heuristic -- this requires a parallel communication*/
     c_vector<double, SPACE_DIM> mTargetNodePoint;
+    /** Whether ComputeDistanceMap updates distances across elements (geodesic) rather than along edges.  Defaults to false.*/
+    bool mUseGeodesicDistances;
+
+    /**
+     * Neighbour lists of the locally-owned nodes, in compressed row form: the neighbours of
+     * node mLo+i are mNeighbourNodes[mNeighbourOffsets[i]] to mNeighbourNodes[mNeighbourOffsets[i+1]-1].
+     * Set up on the first call to ComputeDistanceMap and reused thereafter.
+     */
+    std::vector<unsigned> mNeighbourOffsets;
+    /** The neighbours of each locally-owned node (see mNeighbourOffsets), which may include halo nodes.*/
+    std::vector<Node<SPACE_DIM>*> mNeighbourNodes;
+    /** The length of the edge to each neighbour in mNeighbourNodes.*/
+    std::vector<double> mNeighbourDistances;
+    /** (Only used when mWorkOnEntrireMesh == false).  The halo node distances last sent to the other processes.*/
+    std::vector<double> mLastSentHaloDistances;
 
     /**
      * Queue of nodes to be processed (initialised with the nodes defining the surface)
@@ -108,6 +121,47 @@ private:
      */
     bool UpdateQueueFromRemote(std::vector<double>& rNodeDistances);
 
+    /**
+     * Set up the neighbour lists of the locally-owned nodes (mNeighbourOffsets etc.), in parallel
+     * if OpenMP is available.  Each edge is then visited once per pop, rather than once for every
+     * element which shares it.
+     */
+    void SetUpNeighbourLists();
+
+    /**
+     * Compute the geodesic distance to one node of an element from those of its other nodes whose
+     * distances are known, assuming the distance varies linearly over the element (the local
+     * update of the fast marching method).  The smallest value given by any vertex, edge or face
+     * of the element opposite the node, which includes the node just popped from the queue, is returned
+     * (the others were tried when their own nodes were popped).
+     *
+     * @param pElement  the element
+     * @param targetLocalIndex  the local index in the element of the node to update
+     * @param sourceLocalIndex  the local index in the element of the node just popped from the queue
+     * @param rNodeDistances  the current distance map
+     * @return the updated distance (DBL_MAX if no other node of the element has a known distance)
+     */
+    double CalculateGeodesicUpdate(Element<ELEMENT_DIM, SPACE_DIM>* pElement,
+                                   unsigned targetLocalIndex,
+                                   unsigned sourceLocalIndex,
+                                   const std::vector<double>& rNodeDistances);
+
+    /**
+     * Minimise, over the simplex spanned by some points, the linearly interpolated distance at a
+     * point of the simplex plus the straight-line distance from there to a target.  Only interior
+     * minima are found; minima on the boundary are found by calling this method for the sub-simplices.
+     *
+     * @param rTarget  the location of the target
+     * @param pVertices  the locations of the (up to three) vertices of the simplex
+     * @param pDistances  the distances at the vertices
+     * @param numVertices  the number of vertices
+     * @return the minimum, or DBL_MAX if it does not lie in the interior of the simplex
+     */
+    static double MinimiseOverSimplex(const c_vector<double, SPACE_DIM>& rTarget,
+                                      const c_vector<double, SPACE_DIM>* pVertices[],
+                                      const double pDistances[],
+                                      unsigned numVertices);
+
     /**
      * Push a node index onto the queue.  In the parallel case this will only push a
      * locally-owned (not halo) node.  Halo nodes will be updated, but never pushed to the local queue
@@ -133,14 +187,6 @@ public:
      */
     DistanceMapCalculator(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
 
-     /**
-     * Destructor - cleans up mNumHalosPerProcess (which is normally set to NULL anyway).
-     */
-    ~DistanceMapCalculator()
-    {
-        delete [] mNumHalosPerProcess;
-    }
-
     /**
      *  Generates a distance map of all the nodes of the mesh to the given source
      *
@@ -153,6 +199,19 @@ public:
     void ComputeDistanceMap(const std::vector<unsigned>& rSourceNodeIndices,
                             std::vector<double>& rNodeDistances);
 
+    /**
+     * Choose how ComputeDistanceMap measures distance.  By default the distance to a node is the length of
+     * the shortest path along mesh edges, which overestimates the true distance by up to ~40% (in 3D)
+     * when the path runs across the grain of the mesh.  With geodesic distances the distance is instead
+     * propagated across elements, as in the fast marching method, which gives close to the straight-line
+     * distance in a convex domain and the distance within the mesh around holes and cavities.
+     *
+     * Point-to-point distances (SingleDistance) are always measured along edges.
+     *
+     * @param useGeodesicDistances  whether to compute geodesic distances
+     */
+    void SetUseGeodesicDistances(bool useGeodesicDistances=true);
+
     /**
      *  @return calculated single point-to-point distance
      *
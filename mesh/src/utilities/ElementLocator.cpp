@@ -0,0 +1,446 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "ElementLocator.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "Exception.hpp"
+
+/**
+ * Orders element positions by one coordinate of their centroids, for the median split in BuildTree.
+ */
+template<unsigned DIM>
+class CentroidComponentLess
+{
+private:
+    /** The centroids. */
+    const std::vector<c_vector<double, DIM> >& mrCentroids;
+
+    /** The coordinate to compare. */
+    unsigned mAxis;
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param rCentroids  the centroids
+     * @param axis  the coordinate to compare
+     */
+    CentroidComponentLess(const std::vector<c_vector<double, DIM> >& rCentroids, unsigned axis)
+        : mrCentroids(rCentroids),
+          mAxis(axis)
+    {
+    }
+
+    /**
+     * @return whether the first centroid is before the second along the axis
+     *
+     * @param first  the position of the first centroid
+     * @param second  the position of the second centroid
+     */
+    bool operator()(unsigned first, unsigned second) const
+    {
+        return mrCentroids[first][mAxis] < mrCentroids[second][mAxis];
+    }
+};
+
+template<unsigned DIM>
+ElementLocator<DIM>::ElementLocator(AbstractTetrahedralMesh<DIM, DIM>& rMesh, unsigned maxElementsPerLeaf)
+    : mrMesh(rMesh),
+      mMaxElementsPerLeaf(std::max(maxElementsPerLeaf, 1u))
+{
+    for (typename AbstractTetrahedralMesh<DIM, DIM>::ElementIterator iter = mrMesh.GetElementIteratorBegin();
+         iter != mrMesh.GetElementIteratorEnd();
+         ++iter)
+    {
+        mElements.push_back(&(*iter));
+    }
+
+    const unsigned num_elements = mElements.size();
+    if (num_elements == 0)
+    {
+        return;
+    }
+
+    // The element boxes and centroids are independent of one another, so are computed in parallel
+    std::vector<c_vector<double, DIM> > centroids(num_elements);
+    mElementLower.resize(num_elements);
+    mElementUpper.resize(num_elements);
+    mElementDiameters.resize(num_elements);
+
+#ifdef CHASTE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int i=0; i<(int)num_elements; i++)
+    {
+        Element<DIM, DIM>* p_element = mElements[i];
+        c_vector<double, DIM> lower = p_element->GetNode(0)->rGetLocation();
+        c_vector<double, DIM> upper = lower;
+        c_vector<double, DIM> centroid = lower;
+        for (unsigned local_index=1; local_index<=DIM; local_index++)
+        {
+            const c_vector<double, DIM>& r_location = p_element->GetNode(local_index)->rGetLocation();
+            for (unsigned j=0; j<DIM; j++)
+            {
+                lower[j] = std::min(lower[j], r_location[j]);
+                upper[j] = std::max(upper[j], r_location[j]);
+            }
+            centroid += r_location;
+        }
+
+        double diameter_squared = 0.0;
+        for (unsigned local_index=0; local_index<=DIM; local_index++)
+        {
+            for (unsigned other_index=local_index+1; other_index<=DIM; other_index++)
+            {
+                diameter_squared = std::max(diameter_squared, norm_2_square(p_element->GetNode(local_index)->rGetLocation()
+                                                                             - p_element->GetNode(other_index)->rGetLocation()));
+            }
+        }
+
+        /*
+         * Element::IncludesPoint accepts points a little way outside the element, so the
+         * boxes are swollen slightly to make sure that no such point is missed.
+         */
+        double width = 0.0;
+        for (unsigned j=0; j<DIM; j++)
+        {
+            width = std::max(width, upper[j] - lower[j]);
+        }
+        const double margin = 1e-10*width;
+        for (unsigned j=0; j<DIM; j++)
+        {
+            lower[j] -= margin;
+            upper[j] += margin;
+        }
+
+        mElementLower[i] = lower;
+        mElementUpper[i] = upper;
+        mElementDiameters[i] = sqrt(diameter_squared);
+        centroids[i] = centroid/(DIM + 1.0);
+    }
+
+    mTreeNodes.reserve(2*(num_elements/mMaxElementsPerLeaf + 1));
+    BuildTree(0, num_elements, centroids);
+}
+
+template<unsigned DIM>
+unsigned ElementLocator<DIM>::BuildTree(unsigned first, unsigned count, std::vector<c_vector<double, DIM> >& rCentroids)
+{
+    const unsigned node_index = mTreeNodes.size();
+    mTreeNodes.push_back(TreeNode());
+
+    c_vector<double, DIM> lower = mElementLower[first];
+    c_vector<double, DIM> upper = mElementUpper[first];
+    c_vector<double, DIM> centroid_lower = rCentroids[first];
+    c_vector<double, DIM> centroid_upper = rCentroids[first];
+    double max_diameter = mElementDiameters[first];
+    for (unsigned i=first+1; i<first+count; i++)
+    {
+        max_diameter = std::max(max_diameter, mElementDiameters[i]);
+        for (unsigned j=0; j<DIM; j++)
+        {
+            lower[j] = std::min(lower[j], mElementLower[i][j]);
+            upper[j] = std::max(upper[j], mElementUpper[i][j]);
+            centroid_lower[j] = std::min(centroid_lower[j], rCentroids[i][j]);
+            centroid_upper[j] = std::max(centroid_upper[j], rCentroids[i][j]);
+        }
+    }
+    mTreeNodes[node_index].Lower = lower;
+    mTreeNodes[node_index].Upper = upper;
+    mTreeNodes[node_index].First = first;
+    mTreeNodes[node_index].Count = count;
+    mTreeNodes[node_index].Right = UINT_MAX;
+    mTreeNodes[node_index].MaxDiameter = max_diameter;
+
+    if (count <= mMaxElementsPerLeaf)
+    {
+        return node_index;
+    }
+
+    // Split at the median centroid along the axis in which the centroids are most spread out
+    unsigned axis = 0;
+    for (unsigned j=1; j<DIM; j++)
+    {
+        if (centroid_upper[j] - centroid_lower[j] > centroid_upper[axis] - centroid_lower[axis])
+        {
+            axis = j;
+        }
+    }
+
+    std::vector<unsigned> order(count);
+    for (unsigned i=0; i<count; i++)
+    {
+        order[i] = first + i;
+    }
+    const unsigned half = count/2;
+    std::nth_element(order.begin(), order.begin() + half, order.end(), CentroidComponentLess<DIM>(rCentroids, axis));
+
+    // Apply the permutation to the element range
+    std::vector<Element<DIM, DIM>*> elements(count);
+    std::vector<c_vector<double, DIM> > element_lower(count);
+    std::vector<c_vector<double, DIM> > element_upper(count);
+    std::vector<double> element_diameters(count);
+    std::vector<c_vector<double, DIM> > centroids(count);
+    for (unsigned i=0; i<count; i++)
+    {
+        elements[i] = mElements[order[i]];
+        element_lower[i] = mElementLower[order[i]];
+        element_upper[i] = mElementUpper[order[i]];
+        element_diameters[i] = mElementDiameters[order[i]];
+        centroids[i] = rCentroids[order[i]];
+    }
+    std::copy(elements.begin(), elements.end(), mElements.begin() + first);
+    std::copy(element_lower.begin(), element_lower.end(), mElementLower.begin() + first);
+    std::copy(element_upper.begin(), element_upper.end(), mElementUpper.begin() + first);
+    std::copy(element_diameters.begin(), element_diameters.end(), mElementDiameters.begin() + first);
+    std::copy(centroids.begin(), centroids.end(), rCentroids.begin() + first);
+
+    mTreeNodes[node_index].Count = 0;
+    BuildTree(first, half, rCentroids); // The left child is always node_index+1
+    unsigned right = BuildTree(first + half, count - half, rCentroids);
+    mTreeNodes[node_index].Right = right;
+
+    return node_index;
+}
+
+template<unsigned DIM>
+double ElementLocator<DIM>::SquaredDistanceToBox(const c_vector<double, DIM>& rPoint,
+                                                 const c_vector<double, DIM>& rLower,
+                                                 const c_vector<double, DIM>& rUpper)
+{
+    double distance_squared = 0.0;
+    for (unsigned j=0; j<DIM; j++)
+    {
+        double gap = 0.0;
+        if (rPoint[j] < rLower[j])
+        {
+            gap = rLower[j] - rPoint[j];
+        }
+        else if (rPoint[j] > rUpper[j])
+        {
+            gap = rPoint[j] - rUpper[j];
+        }
+        distance_squared += gap*gap;
+    }
+    return distance_squared;
+}
+
+template<unsigned DIM>
+void ElementLocator<DIM>::ThrowNotInMesh(const ChastePoint<DIM>& rTestPoint) const
+{
+    std::stringstream ss;
+    ss << "Point [";
+    for (unsigned j=0; (int)j<(int)DIM-1; j++)
+    {
+        ss << rTestPoint[j] << ",";
+    }
+    ss << rTestPoint[DIM-1] << "] is not in mesh - all elements tested";
+    EXCEPTION(ss.str());
+}
+
+template<unsigned DIM>
+unsigned ElementLocator<DIM>::GetContainingElementIndex(const ChastePoint<DIM>& rTestPoint, bool strict) const
+{
+    const c_vector<double, DIM>& r_point = rTestPoint.rGetLocation();
+
+    /*
+     * Boxes overlap, so every box containing the point must be visited in order to
+     * return the lowest-numbered containing element, as the linear search would.
+     */
+    unsigned containing_index = UINT_MAX;
+    std::vector<unsigned> stack;
+    if (!mTreeNodes.empty())
+    {
+        stack.push_back(0);
+    }
+    while (!stack.empty())
+    {
+        const TreeNode& r_node = mTreeNodes[stack.back()];
+        const unsigned node_index = stack.back();
+        stack.pop_back();
+
+        if (SquaredDistanceToBox(r_point, r_node.Lower, r_node.Upper) > 0.0)
+        {
+            continue;
+        }
+        if (r_node.Count == 0)
+        {
+            stack.push_back(r_node.Right);
+            stack.push_back(node_index + 1);
+            continue;
+        }
+        for (unsigned i=r_node.First; i<r_node.First+r_node.Count; i++)
+        {
+            const unsigned element_index = mElements[i]->GetIndex();
+            if (element_index < containing_index
+                && SquaredDistanceToBox(r_point, mElementLower[i], mElementUpper[i]) == 0.0
+                && mElements[i]->IncludesPoint(rTestPoint, strict))
+            {
+                containing_index = element_index;
+            }
+        }
+    }
+
+    if (containing_index == UINT_MAX)
+    {
+        ThrowNotInMesh(rTestPoint);
+    }
+    return containing_index;
+}
+
+template<unsigned DIM>
+unsigned ElementLocator<DIM>::GetNearestElementIndex(const ChastePoint<DIM>& rTestPoint) const
+{
+    if (mTreeNodes.empty())
+    {
+        ThrowNotInMesh(rTestPoint);
+    }
+
+    try
+    {
+        return GetContainingElementIndex(rTestPoint, false);
+    }
+    catch (Exception&) // not_in_mesh
+    {
+    }
+
+    const c_vector<double, DIM>& r_point = rTestPoint.rGetLocation();
+
+    /*
+     * Search for the element maximising the same measure as TetrahedralMesh::GetNearestElementIndex,
+     * ties going to the lowest index, visiting the nearer child of each node first.
+     *
+     * If the point is at distance d from an element of diameter L, then writing it as a combination
+     * of the element's vertices, with weights summing to 1, gives d <= -L*neg_weight_sum.  A box at
+     * distance d from the point therefore contains no element with neg_weight_sum above
+     * -d/MaxDiameter, and is skipped when that is below the best value found so far.  The bound is
+     * slackened slightly so that rounding in the interpolation weights cannot skip a tie.
+     */
+    double max_min_weight = -std::numeric_limits<double>::infinity();
+    unsigned closest_index = UINT_MAX;
+    std::vector<unsigned> stack(1, 0u);
+    while (!stack.empty())
+    {
+        const unsigned node_index = stack.back();
+        const TreeNode& r_node = mTreeNodes[node_index];
+        stack.pop_back();
+
+        double distance = sqrt(SquaredDistanceToBox(r_point, r_node.Lower, r_node.Upper));
+        if (distance > -max_min_weight*r_node.MaxDiameter*(1.0 + 1e-8))
+        {
+            continue;
+        }
+        if (r_node.Count == 0)
+        {
+            const TreeNode& r_left = mTreeNodes[node_index + 1];
+            const TreeNode& r_right = mTreeNodes[r_node.Right];
+            if (SquaredDistanceToBox(r_point, r_left.Lower, r_left.Upper)
+                < SquaredDistanceToBox(r_point, r_right.Lower, r_right.Upper))
+            {
+                stack.push_back(r_node.Right);
+                stack.push_back(node_index + 1);
+            }
+            else
+            {
+                stack.push_back(node_index + 1);
+                stack.push_back(r_node.Right);
+            }
+            continue;
+        }
+        for (unsigned i=r_node.First; i<r_node.First+r_node.Count; i++)
+        {
+            c_vector<double, DIM+1> weight = mElements[i]->CalculateInterpolationWeights(rTestPoint);
+            double neg_weight_sum = 0.0;
+            for (unsigned j=0; j<=DIM; j++)
+            {
+                if (weight[j] < 0.0)
+                {
+                    neg_weight_sum += weight[j];
+                }
+            }
+            const unsigned element_index = mElements[i]->GetIndex();
+            if (neg_weight_sum > max_min_weight
+                || (neg_weight_sum == max_min_weight && element_index < closest_index))
+            {
+                max_min_weight = neg_weight_sum;
+                closest_index = element_index;
+            }
+        }
+    }
+    return closest_index;
+}
+
+template<unsigned DIM>
+unsigned ElementLocator<DIM>::GetNumElements() const
+{
+    return mElements.size();
+}
+
+template<unsigned DIM>
+unsigned ElementLocator<DIM>::GetDepth() const
+{
+    if (mTreeNodes.empty())
+    {
+        return 0;
+    }
+
+    unsigned depth = 0;
+    std::vector<std::pair<unsigned, unsigned> > stack(1, std::make_pair(0u, 1u));
+    while (!stack.empty())
+    {
+        std::pair<unsigned, unsigned> node_and_depth = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, node_and_depth.second);
+
+        const TreeNode& r_node = mTreeNodes[node_and_depth.first];
+        if (r_node.Count == 0)
+        {
+            stack.push_back(std::make_pair(node_and_depth.first + 1, node_and_depth.second + 1));
+            stack.push_back(std::make_pair(r_node.Right, node_and_depth.second + 1));
+        }
+    }
+    return depth;
+}
+
+// Explicit instantiation
+template class ElementLocator<1>;
+template class ElementLocator<2>;
+template class ElementLocator<3>;
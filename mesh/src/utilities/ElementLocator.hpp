@@ -0,0 +1,181 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ELEMENTLOCATOR_HPP_
+#define ELEMENTLOCATOR_HPP_
+
+#include <vector>
+
+#include "UblasVectorInclude.hpp"
+#include "AbstractTetrahedralMesh.hpp"
+#include "ChastePoint.hpp"
+
+/**
+ * A bounding volume hierarchy over the (local) elements of a mesh, for fast point location.
+ *
+ * The hierarchy is a binary tree of axis-aligned boxes, built once by recursively splitting
+ * the elements at the median of their centroids along the longest axis, so that locating a
+ * point costs O(log N) box tests plus a handful of element tests, rather than the O(N) scan
+ * of AbstractTetrahedralMesh::GetContainingElementIndex.
+ *
+ * The locator stores pointers to the mesh's elements, so the mesh must not be changed
+ * (nodes moved, elements added or deleted) while the locator is in use.  All query methods
+ * are const and may be called concurrently from several threads.
+ */
+template<unsigned DIM>
+class ElementLocator
+{
+private:
+
+    /**
+     * A node of the tree: a box, and either two children or a range of elements.
+     * Nodes are stored depth first, so the left child of an internal node immediately follows it.
+     */
+    struct TreeNode
+    {
+        /** The lower corner of the box bounding everything below this node. */
+        c_vector<double, DIM> Lower;
+
+        /** The upper corner of the box bounding everything below this node. */
+        c_vector<double, DIM> Upper;
+
+        /** For a leaf, the position of its first element in mElements. */
+        unsigned First;
+
+        /** For a leaf, the number of elements; zero for an internal node. */
+        unsigned Count;
+
+        /** For an internal node, the index of its right child. */
+        unsigned Right;
+
+        /** The largest diameter (longest edge) of the elements below this node. */
+        double MaxDiameter;
+    };
+
+    /** The mesh whose elements are indexed. */
+    AbstractTetrahedralMesh<DIM, DIM>& mrMesh;
+
+    /** The maximum number of elements in a leaf of the tree. */
+    unsigned mMaxElementsPerLeaf;
+
+    /** The tree, with the root at position 0. */
+    std::vector<TreeNode> mTreeNodes;
+
+    /** The elements, ordered so that each leaf owns a contiguous range. */
+    std::vector<Element<DIM, DIM>*> mElements;
+
+    /** The lower corners of the (slightly inflated) element bounding boxes, in the order of mElements. */
+    std::vector<c_vector<double, DIM> > mElementLower;
+
+    /** The upper corners of the (slightly inflated) element bounding boxes, in the order of mElements. */
+    std::vector<c_vector<double, DIM> > mElementUpper;
+
+    /** The diameters (longest edges) of the elements, in the order of mElements. */
+    std::vector<double> mElementDiameters;
+
+    /**
+     * Recursively build the tree over a range of mElements.
+     *
+     * @param first  the position in mElements of the first element in the range
+     * @param count  the number of elements in the range
+     * @param rCentroids  the element centroids, in the order of mElements (reordered along with them)
+     * @return the index in mTreeNodes of the node created for the range
+     */
+    unsigned BuildTree(unsigned first, unsigned count, std::vector<c_vector<double, DIM> >& rCentroids);
+
+    /**
+     * @return the squared distance from a point to a box (zero if the point is inside).
+     *
+     * @param rPoint  the point
+     * @param rLower  the lower corner of the box
+     * @param rUpper  the upper corner of the box
+     */
+    static double SquaredDistanceToBox(const c_vector<double, DIM>& rPoint,
+                                       const c_vector<double, DIM>& rLower,
+                                       const c_vector<double, DIM>& rUpper);
+
+    /**
+     * Throw the same exception as AbstractTetrahedralMesh::GetContainingElementIndex for a point outside the mesh.
+     *
+     * @param rTestPoint  the point
+     */
+    void ThrowNotInMesh(const ChastePoint<DIM>& rTestPoint) const;
+
+public:
+
+    /**
+     * Constructor.  Builds the tree over the local, non-deleted elements of the mesh.
+     * The element bounding boxes are computed in parallel if OpenMP is available.
+     *
+     * @param rMesh  the mesh
+     * @param maxElementsPerLeaf  the maximum number of elements in a leaf of the tree (defaults to 8)
+     */
+    ElementLocator(AbstractTetrahedralMesh<DIM, DIM>& rMesh, unsigned maxElementsPerLeaf=8);
+
+    /**
+     * @return the global index of the lowest-numbered element containing a point, which is what
+     * AbstractTetrahedralMesh::GetContainingElementIndex would return.  Throws if no local element
+     * contains the point.
+     *
+     * @param rTestPoint  the point
+     * @param strict  whether the point must be strictly inside the element, rather than on its boundary
+     */
+    unsigned GetContainingElementIndex(const ChastePoint<DIM>& rTestPoint, bool strict=false) const;
+
+    /**
+     * @return the global index of the element containing a point or, if the point is outside the mesh,
+     * of the element nearest to it, which is what TetrahedralMesh::GetNearestElementIndex would return.
+     * The nearest element maximises the sum of the negative interpolation weights of the point.  A point
+     * at distance d from an element of diameter L has negative weights summing to at most -d/L, so a
+     * subtree is skipped only when this bound shows that none of its elements can do better than (or
+     * tie with) the best element found so far; the result is the same as the linear search on any mesh,
+     * however graded.
+     *
+     * @param rTestPoint  the point
+     */
+    unsigned GetNearestElementIndex(const ChastePoint<DIM>& rTestPoint) const;
+
+    /**
+     * @return the number of elements indexed.
+     */
+    unsigned GetNumElements() const;
+
+    /**
+     * @return the depth of the tree (1 for a tree consisting of a single leaf).
+     */
+    unsigned GetDepth() const;
+};
+
+#endif /*ELEMENTLOCATOR_HPP_*/
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LogFile.hpp"
 #include "UblasCustomFunctions.hpp"
 #include "Warnings.hpp"
+#include "VertexElementBoundingBoxGrid.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh(std::vector<Node<SPACE_DIM>*> nodes,
@@ -327,6 +328,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ClearLocationsOfT3Swaps()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNewNode)
 {
+    this->ClearElementGeometryCache();
+
     if (mDeletedNodeIndices.empty())
     {
         pNewNode->SetIndex(this->mNodes.size());
@@ -346,6 +349,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNe
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddElement(VertexElement<ELEMENT_DIM,SPACE_DIM>* pNewElement)
 {
+    this->ClearElementGeometryCache();
+
     unsigned new_element_index = pNewElement->GetIndex();
 
     if (new_element_index == this->mElements.size())
@@ -363,6 +368,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddElement(VertexElement<ELE
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetNode(unsigned nodeIndex, ChastePoint<SPACE_DIM> point)
 {
+    this->ClearElementGeometryCache();
+
     this->mNodes[nodeIndex]->SetPoint(point);
 }
 
@@ -571,6 +578,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideElement(VertexElement<
                                                                   unsigned nodeBIndex,
                                                                   bool placeOriginalElementBelow)
 {
+    this->ClearElementGeometryCache();
+
     assert(SPACE_DIM == 2);                // LCOV_EXCL_LINE
     assert(ELEMENT_DIM == SPACE_DIM);    // LCOV_EXCL_LINE
 
@@ -694,6 +703,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideElement(VertexElement<
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteElementPriorToReMesh(unsigned index)
 {
+    this->ClearElementGeometryCache();
+
     assert(SPACE_DIM == 2); // LCOV_EXCL_LINE
 
     // Mark any nodes that are contained only in this element as deleted
@@ -718,6 +729,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteElementPriorToReMesh(unsig
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteNodePriorToReMesh(unsigned index)
 {
+    this->ClearElementGeometryCache();
+
     this->mNodes[index]->MarkAsDeleted();
     mDeletedNodeIndices.push_back(index);
 }
@@ -725,6 +738,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteNodePriorToReMesh(unsigned
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideEdge(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
+    this->ClearElementGeometryCache();
+
     // Find the indices of the elements owned by each node
     std::set<unsigned> elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
     std::set<unsigned> elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
@@ -801,6 +816,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideEdge(Node<SPACE_DIM>* pNod
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveDeletedNodesAndElements(VertexElementMap& rElementMap)
 {
+    this->ClearElementGeometryCache();
+
     // Make sure the map is big enough.  Each entry will be set in the loop below.
     rElementMap.Resize(this->GetNumAllElements());
 
@@ -840,6 +857,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveDeletedNodesAndElements(Ve
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveDeletedNodes()
 {
+    this->ClearElementGeometryCache();
+
     // Remove any nodes that have been marked for deletion and store all other nodes in a temporary structure
     std::vector<Node<SPACE_DIM>*> live_nodes;
     for (unsigned i=0; i<this->mNodes.size(); i++)
@@ -871,6 +890,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveDeletedNodes()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElementMap)
 {
+    this->ClearElementGeometryCache();
+
     // Make sure that we are in the correct dimension - this code will be eliminated at compile time
     assert(SPACE_DIM==2 || SPACE_DIM==3);     // LCOV_EXCL_LINE
     assert(ELEMENT_DIM == SPACE_DIM);         // LCOV_EXCL_LINE
@@ -1015,21 +1036,45 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
 {
+    /*
+     * A node can only lie inside an element if it lies inside the element's bounding box,
+     * so we bin the elements on a grid and only test each node against the elements whose
+     * bounding box contains it. Candidates are visited in ascending order of element index,
+     * so the first intersection found is the same as for an exhaustive search. If the grid
+     * cannot be used (see VertexElementBoundingBoxGrid::Build()), every element is tested.
+     */
+    VertexElementBoundingBoxGrid<ELEMENT_DIM, SPACE_DIM> grid;
+    std::vector<unsigned> candidate_element_indices;
+
     // If checking for internal intersections as well as on the boundary, then check that no nodes have overlapped any elements...
     if (mCheckForInternalIntersections)
     {
-        ///\todo Change to only loop over neighbouring elements (see #2401)
+        std::vector<unsigned> element_indices;
+        for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+             elem_iter != this->GetElementIteratorEnd();
+             ++elem_iter)
+        {
+            element_indices.push_back(elem_iter->GetIndex());
+        }
+        bool use_grid = grid.Build(*this, element_indices);
+
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
              ++node_iter)
         {
             assert(!(node_iter->IsDeleted()));
 
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
+            if (use_grid)
+            {
+                grid.GetCandidateElements(node_iter->rGetLocation(), candidate_element_indices);
+            }
+            const std::vector<unsigned>& r_elements_to_check = use_grid ? candidate_element_indices : element_indices;
+
+            for (std::vector<unsigned>::const_iterator elem_iter = r_elements_to_check.begin();
+                 elem_iter != r_elements_to_check.end();
                  ++elem_iter)
             {
-                unsigned elem_index = elem_iter->GetIndex();
+                unsigned elem_index = *elem_iter;
 
                 // Check that the node is not part of this element
                 if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
@@ -1048,7 +1093,7 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
         // ...otherwise, just check that no boundary nodes have overlapped any boundary elements
         // First: find all boundary element and calculate their centroid only once
         std::vector<unsigned> boundary_element_indices;
-        std::vector< c_vector<double, SPACE_DIM> > boundary_element_centroids;
+        std::vector< c_vector<double, SPACE_DIM> > boundary_element_centroids(this->GetNumAllElements());
         for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
                 elem_iter != this->GetElementIteratorEnd();
                 ++elem_iter)
@@ -1057,10 +1102,10 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
             {
                 unsigned element_index = elem_iter->GetIndex();
                 boundary_element_indices.push_back(element_index);
-                // should be a map but I am too lazy to look up the syntax
-                boundary_element_centroids.push_back(this->GetCentroidOfElement(element_index));
+                boundary_element_centroids[element_index] = this->GetCentroidOfElement(element_index);
             }
         }
+        bool use_grid = grid.Build(*this, boundary_element_indices);
 
         // Second: Check intersections only for those nodes and elements within
         // mDistanceForT3SwapChecking within each other (node<-->element centroid)
@@ -1072,17 +1117,21 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
             {
                 assert(!(node_iter->IsDeleted()));
 
-                // index in boundary_element_centroids and boundary_element_indices
-                unsigned boundary_element_index = 0;
-                for (std::vector<unsigned>::iterator elem_iter = boundary_element_indices.begin();
-                        elem_iter != boundary_element_indices.end();
+                if (use_grid)
+                {
+                    grid.GetCandidateElements(node_iter->rGetLocation(), candidate_element_indices);
+                }
+                const std::vector<unsigned>& r_elements_to_check = use_grid ? candidate_element_indices : boundary_element_indices;
+
+                for (std::vector<unsigned>::const_iterator elem_iter = r_elements_to_check.begin();
+                        elem_iter != r_elements_to_check.end();
                         ++elem_iter)
                 {
                     // Check that the node is not part of this element
                     if (node_iter->rGetContainingElementIndices().count(*elem_iter) == 0)
                     {
                         c_vector<double, SPACE_DIM> node_location = node_iter->rGetLocation();
-                        c_vector<double, SPACE_DIM> element_centroid = boundary_element_centroids[boundary_element_index];
+                        c_vector<double, SPACE_DIM> element_centroid = boundary_element_centroids[*elem_iter];
                         double node_element_distance = norm_2(this->GetVectorFromAtoB(node_location, element_centroid));
 
                         if ( node_element_distance < mDistanceForT3SwapChecking )
@@ -1094,12 +1143,9 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
                             }
                         }
                     }
-                    // increment the boundary element index
-                    boundary_element_index +=1u;
                 }
             }
         }
-
     }
     return false;
 }
@@ -1437,6 +1483,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformNodeMerge(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
+    this->ClearElementGeometryCache();
+
     // Find the sets of elements containing each of the nodes, sorted by index
     std::set<unsigned> nodeA_elem_indices = pNodeA->rGetContainingElementIndices();
     std::set<unsigned> nodeB_elem_indices = pNodeB->rGetContainingElementIndices();
@@ -1477,6 +1525,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
                                                               Node<SPACE_DIM>* pNodeB,
                                                               std::set<unsigned>& rElementsContainingNodes)
 {
+    this->ClearElementGeometryCache();
+
     // First compute and store the location of the T1 swap, which is at the midpoint of nodes A and B
     double distance_between_nodes_CD = mCellRearrangementRatio*mCellRearrangementThreshold;
 
@@ -1616,6 +1666,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformIntersectionSwap(Node<SPACE_DIM>* pNode, unsigned elementIndex)
 {
+    this->ClearElementGeometryCache();
+
     assert(SPACE_DIM == 2);                    // LCOV_EXCL_LINE
     assert(ELEMENT_DIM == SPACE_DIM);        // LCOV_EXCL_LINE
 
@@ -1783,6 +1835,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformIntersectionSwap(Node<SPA
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT2Swap(VertexElement<ELEMENT_DIM,SPACE_DIM>& rElement)
 {
+    this->ClearElementGeometryCache();
+
     // The given element must be triangular for us to be able to perform a T2 swap on it
     assert(rElement.GetNumNodes() == 3);
 
@@ -1851,6 +1905,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT2Swap(VertexElement<ELEM
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT3Swap(Node<SPACE_DIM>* pNode, unsigned elementIndex)
 {
+    this->ClearElementGeometryCache();
+
     assert(SPACE_DIM == 2);                 // LCOV_EXCL_LINE - code will be removed at compile time
     assert(ELEMENT_DIM == SPACE_DIM);    // LCOV_EXCL_LINE - code will be removed at compile time
 
@@ -2559,6 +2615,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT3Swap(Node<SPACE_DIM>* p
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformVoidRemoval(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB, Node<SPACE_DIM>* pNodeC)
 {
+    this->ClearElementGeometryCache();
+
     // Calculate void centroid
     c_vector<double, SPACE_DIM> nodes_midpoint = pNodeA->rGetLocation()
             + this->GetVectorFromAtoB(pNodeA->rGetLocation(), pNodeB->rGetLocation()) / 3.0
@@ -2616,6 +2674,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::HandleHighOrderJunctions(Node<SP
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformRosetteRankIncrease(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
+    this->ClearElementGeometryCache();
+
     /*
      * One of the nodes will have 3 containing element indices, the other
      * will have at least four. We first identify which node is which.
@@ -2703,6 +2763,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformRosetteRankIncrease(Node<
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformProtorosetteResolution(Node<SPACE_DIM>* pProtorosetteNode)
 {
+    this->ClearElementGeometryCache();
+
     // Double check we are dealing with a protorosette
     assert(pProtorosetteNode->rGetContainingElementIndices().size() == 4);
 
@@ -2889,6 +2951,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformProtorosetteResolution(No
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformRosetteRankDecrease(Node<SPACE_DIM>* pRosetteNode)
 {
+    this->ClearElementGeometryCache();
+
     unsigned rosette_rank = pRosetteNode->rGetContainingElementIndices().size();
 
     // Double check we're dealing with a rosette
@@ -161,6 +161,9 @@ protected:
      * Check if any elements have become intersected and correct this by implementing the appropriate
      * local remeshing operation (a T3 swap or node merge).
      *
+     * Elements are binned by bounding box using a VertexElementBoundingBoxGrid, so that each
+     * node is only tested against nearby elements.
+     *
      * @return whether to recheck the mesh again
      */
     bool CheckForIntersections();
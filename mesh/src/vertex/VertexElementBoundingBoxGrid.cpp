@@ -0,0 +1,240 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "VertexElementBoundingBoxGrid.hpp"
+#include <cassert>
+#include <cmath>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+VertexElementBoundingBoxGrid<ELEMENT_DIM, SPACE_DIM>::VertexElementBoundingBoxGrid()
+    : mOrigin(zero_vector<double>(SPACE_DIM)),
+      mBinWidth(1.0),
+      mNumBins(scalar_vector<unsigned>(SPACE_DIM, 0u))
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexElementBoundingBoxGrid<ELEMENT_DIM, SPACE_DIM>::GetBinCoordinate(const c_vector<double, SPACE_DIM>& rLocation, unsigned dimension) const
+{
+    double coordinate = floor((rLocation[dimension] - mOrigin[dimension])/mBinWidth);
+    if (coordinate < 0.0)
+    {
+        return 0;
+    }
+    else if (coordinate >= mNumBins[dimension])
+    {
+        return mNumBins[dimension] - 1;
+    }
+    return static_cast<unsigned>(coordinate);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexElementBoundingBoxGrid<ELEMENT_DIM, SPACE_DIM>::Build(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                                                                const std::vector<unsigned>& rElementIndices)
+{
+    mBins.clear();
+    if (rElementIndices.empty() || rMesh.GetNumNodes() == 0)
+    {
+        return false;
+    }
+
+    // Find the bounding box of the nodes
+    c_vector<double, SPACE_DIM> lower_corner = rMesh.GetNodeIteratorBegin()->rGetLocation();
+    c_vector<double, SPACE_DIM> upper_corner = lower_corner;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = rMesh.GetNodeIteratorBegin();
+         node_iter != rMesh.GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = node_iter->rGetLocation();
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            lower_corner[i] = std::min(lower_corner[i], r_location[i]);
+            upper_corner[i] = std::max(upper_corner[i], r_location[i]);
+        }
+    }
+
+    /*
+     * If the shortest vector between the corners differs from their difference, then
+     * the mesh is periodic and some pairs of nodes are closer via a periodic image.
+     */
+    c_vector<double, SPACE_DIM> span = upper_corner - lower_corner;
+    c_vector<double, SPACE_DIM> displacement = rMesh.GetVectorFromAtoB(lower_corner, upper_corner);
+    if (norm_inf(displacement - span) > 1e-10*(1.0 + norm_inf(span)))
+    {
+        return false;
+    }
+
+    // Compute the bounding box of each element and their mean width
+    mElementLowerCorners.resize(rMesh.GetNumAllElements());
+    mElementUpperCorners.resize(rMesh.GetNumAllElements());
+    double total_width = 0.0;
+    for (unsigned i=0; i<rElementIndices.size(); i++)
+    {
+        assert(i == 0 || rElementIndices[i] > rElementIndices[i-1]);
+
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = rMesh.GetElement(rElementIndices[i]);
+        c_vector<double, SPACE_DIM> element_lower_corner = p_element->GetNodeLocation(0);
+        c_vector<double, SPACE_DIM> element_upper_corner = element_lower_corner;
+        for (unsigned local_index=1; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            const c_vector<double, SPACE_DIM>& r_location = p_element->GetNodeLocation(local_index);
+            for (unsigned j=0; j<SPACE_DIM; j++)
+            {
+                element_lower_corner[j] = std::min(element_lower_corner[j], r_location[j]);
+                element_upper_corner[j] = std::max(element_upper_corner[j], r_location[j]);
+            }
+        }
+        mElementLowerCorners[rElementIndices[i]] = element_lower_corner;
+        mElementUpperCorners[rElementIndices[i]] = element_upper_corner;
+        total_width += norm_inf(element_upper_corner - element_lower_corner);
+    }
+
+    // Choose the bin width, ensuring there are at most a few bins per element
+    mBinWidth = total_width/rElementIndices.size();
+    if (mBinWidth <= 0.0)
+    {
+        mBinWidth = std::max(norm_inf(span), 1.0);
+    }
+    unsigned max_num_bins = 4*rElementIndices.size();
+    while (true)
+    {
+        double num_bins = 1.0;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            num_bins *= floor(span[i]/mBinWidth) + 1.0;
+        }
+        if (num_bins <= max_num_bins)
+        {
+            break;
+        }
+        mBinWidth *= 2.0;
+    }
+
+    mOrigin = lower_corner;
+    unsigned num_bins = 1;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        mNumBins[i] = static_cast<unsigned>(floor(span[i]/mBinWidth)) + 1;
+        num_bins *= mNumBins[i];
+    }
+    mBins.resize(num_bins);
+
+    // Enlarge the bounding boxes slightly to allow for round-off in the point-in-element test
+    double tolerance = 1e-8*mBinWidth;
+
+    // Add each element to every bin its bounding box overlaps
+    for (unsigned i=0; i<rElementIndices.size(); i++)
+    {
+        unsigned element_index = rElementIndices[i];
+        mElementLowerCorners[element_index] -= scalar_vector<double>(SPACE_DIM, tolerance);
+        mElementUpperCorners[element_index] += scalar_vector<double>(SPACE_DIM, tolerance);
+
+        c_vector<unsigned, SPACE_DIM> lower_bin;
+        c_vector<unsigned, SPACE_DIM> upper_bin;
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            lower_bin[j] = GetBinCoordinate(mElementLowerCorners[element_index], j);
+            upper_bin[j] = GetBinCoordinate(mElementUpperCorners[element_index], j);
+        }
+
+        // Loop over the block of bins between lower_bin and upper_bin
+        c_vector<unsigned, SPACE_DIM> bin = lower_bin;
+        bool finished = false;
+        while (!finished)
+        {
+            unsigned bin_index = 0;
+            for (unsigned j=SPACE_DIM; j-- > 0;)
+            {
+                bin_index = bin_index*mNumBins[j] + bin[j];
+            }
+            mBins[bin_index].push_back(element_index);
+
+            finished = true;
+            for (unsigned j=0; j<SPACE_DIM; j++)
+            {
+                if (bin[j] < upper_bin[j])
+                {
+                    bin[j]++;
+                    finished = false;
+                    break;
+                }
+                bin[j] = lower_bin[j];
+            }
+        }
+    }
+
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementBoundingBoxGrid<ELEMENT_DIM, SPACE_DIM>::GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint,
+                                                                               std::vector<unsigned>& rCandidates) const
+{
+    assert(!mBins.empty());
+    rCandidates.clear();
+
+    unsigned bin_index = 0;
+    for (unsigned j=SPACE_DIM; j-- > 0;)
+    {
+        bin_index = bin_index*mNumBins[j] + GetBinCoordinate(rPoint, j);
+    }
+
+    const std::vector<unsigned>& r_bin = mBins[bin_index];
+    for (unsigned i=0; i<r_bin.size(); i++)
+    {
+        unsigned element_index = r_bin[i];
+        bool is_inside_box = true;
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            if (rPoint[j] < mElementLowerCorners[element_index][j] || rPoint[j] > mElementUpperCorners[element_index][j])
+            {
+                is_inside_box = false;
+                break;
+            }
+        }
+        if (is_inside_box)
+        {
+            rCandidates.push_back(element_index);
+        }
+    }
+}
+
+// Explicit instantiation
+template class VertexElementBoundingBoxGrid<1,1>;
+template class VertexElementBoundingBoxGrid<1,2>;
+template class VertexElementBoundingBoxGrid<1,3>;
+template class VertexElementBoundingBoxGrid<2,2>;
+template class VertexElementBoundingBoxGrid<2,3>;
+template class VertexElementBoundingBoxGrid<3,3>;
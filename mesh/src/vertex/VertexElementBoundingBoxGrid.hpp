@@ -0,0 +1,115 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VERTEXELEMENTBOUNDINGBOXGRID_HPP_
+#define VERTEXELEMENTBOUNDINGBOXGRID_HPP_
+
+#include <vector>
+#include "UblasVectorInclude.hpp"
+#include "VertexMesh.hpp"
+
+/**
+ * A uniform grid of bins over the nodes of a vertex mesh, recording which elements
+ * have an axis-aligned bounding box overlapping each bin. Used by MutableVertexMesh
+ * to restrict point-in-element tests to elements whose bounding box contains the
+ * point, rather than testing every element.
+ *
+ * Bounding boxes are computed from node locations directly, so the grid can only be
+ * used if displacements between nodes are not affected by periodicity (see Build()).
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VertexElementBoundingBoxGrid
+{
+private:
+
+    /** The location of the lower corner of the grid. */
+    c_vector<double, SPACE_DIM> mOrigin;
+
+    /** The width of each bin. */
+    double mBinWidth;
+
+    /** The number of bins in each direction. */
+    c_vector<unsigned, SPACE_DIM> mNumBins;
+
+    /** For each bin, the indices of the elements whose bounding box overlaps it, in ascending order. */
+    std::vector<std::vector<unsigned> > mBins;
+
+    /** The lower corner of the (slightly enlarged) bounding box of each binned element, indexed by element index. */
+    std::vector<c_vector<double, SPACE_DIM> > mElementLowerCorners;
+
+    /** The upper corner of the (slightly enlarged) bounding box of each binned element, indexed by element index. */
+    std::vector<c_vector<double, SPACE_DIM> > mElementUpperCorners;
+
+    /**
+     * @param rLocation a location
+     * @param dimension a coordinate direction
+     * @return the index of the bin containing this location in the given direction, clamped to the grid.
+     */
+    unsigned GetBinCoordinate(const c_vector<double, SPACE_DIM>& rLocation, unsigned dimension) const;
+
+public:
+
+    /**
+     * Default constructor. Creates an empty grid.
+     */
+    VertexElementBoundingBoxGrid();
+
+    /**
+     * Bin a collection of elements of a mesh. The bin width is taken as the mean
+     * bounding-box width of the elements, enlarged if necessary so that there are
+     * no more than a few bins per element.
+     *
+     * The grid cannot be used, and false is returned, if there are no elements to bin
+     * or if the mesh is periodic and its nodes span more than half a period in some
+     * direction, since bounding boxes computed from node locations are then not
+     * meaningful.
+     *
+     * @param rMesh the mesh
+     * @param rElementIndices the indices of the elements to bin, in ascending order
+     * @return whether the grid can be used.
+     */
+    bool Build(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh, const std::vector<unsigned>& rElementIndices);
+
+    /**
+     * Get the binned elements whose bounding box contains a given point. Any binned
+     * element for which VertexMesh::ElementIncludesPoint() returns true is included.
+     *
+     * @param rPoint the point
+     * @param rCandidates filled with the indices of the elements, in ascending order
+     */
+    void GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint, std::vector<unsigned>& rCandidates) const;
+};
+
+#endif /*VERTEXELEMENTBOUNDINGBOXGRID_HPP_*/
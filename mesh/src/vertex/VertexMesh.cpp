@@ -584,6 +584,7 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
         delete mElements[i];
     }
     mElements.clear();
+    ClearElementGeometryCache();
 
     // Delete faces
     for (unsigned i = 0; i < mFaces.size(); i++)
@@ -1046,6 +1047,12 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetVolumeOfElement(unsigned index)
 {
     assert(SPACE_DIM == 2 || SPACE_DIM == 3); // LCOV_EXCL_LINE - code will be removed at compile time
 
+    if (!mElementVolumes.empty())
+    {
+        assert(index < mElementVolumes.size());
+        return mElementVolumes[index];
+    }
+
     // Get pointer to this element
     VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
 
@@ -1103,6 +1110,12 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetSurfaceAreaOfElement(unsigned inde
 {
     assert(SPACE_DIM == 2 || SPACE_DIM == 3); // LCOV_EXCL_LINE - code will be removed at compile time
 
+    if (!mElementSurfaceAreas.empty())
+    {
+        assert(index < mElementSurfaceAreas.size());
+        return mElementSurfaceAreas[index];
+    }
+
     // Get pointer to this element
     VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
 
@@ -1110,13 +1123,9 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetSurfaceAreaOfElement(unsigned inde
     if (SPACE_DIM == 2)
     {
         unsigned num_nodes = p_element->GetNumNodes();
-        unsigned this_node_index = p_element->GetNodeGlobalIndex(0);
         for (unsigned local_index = 0; local_index < num_nodes; local_index++)
         {
-            unsigned next_node_index = p_element->GetNodeGlobalIndex((local_index + 1) % num_nodes);
-
-            surface_area += this->GetDistanceBetweenNodes(this_node_index, next_node_index);
-            this_node_index = next_node_index;
+            surface_area += GetLengthOfElementEdge(p_element, local_index);
         }
     }
     else
@@ -1130,6 +1139,94 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetSurfaceAreaOfElement(unsigned inde
     return surface_area;
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetLengthOfElementEdge(VertexElement<ELEMENT_DIM, SPACE_DIM>* pElement, unsigned localIndex)
+{
+    assert(SPACE_DIM == 2); // LCOV_EXCL_LINE - code will be removed at compile time
+
+    // Use the cached length if there is one, checking that the element belongs to this mesh
+    unsigned elem_index = pElement->GetIndex();
+    if (!mElementEdgeLengths.empty() && elem_index < mElements.size() && mElements[elem_index] == pElement)
+    {
+        assert(mElementEdgeLengthOffsets[elem_index] + localIndex < mElementEdgeLengthOffsets[elem_index + 1]);
+        return mElementEdgeLengths[mElementEdgeLengthOffsets[elem_index] + localIndex];
+    }
+
+    unsigned next_local_index = (localIndex + 1) % (pElement->GetNumNodes());
+
+    return this->GetDistanceBetweenNodes(pElement->GetNodeGlobalIndex(localIndex), pElement->GetNodeGlobalIndex(next_local_index));
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::CacheElementGeometry()
+{
+    if (SPACE_DIM == 1)
+    {
+        return;
+    }
+    ClearElementGeometryCache();
+
+    unsigned num_elements = mElements.size();
+    std::vector<double> element_volumes(num_elements, 0.0);
+    std::vector<double> element_surface_areas(num_elements, 0.0);
+
+    // In 2D, first lay out and compute the edge lengths, which are then used for the perimeters
+    if (SPACE_DIM == 2)
+    {
+        std::vector<unsigned> edge_offsets(num_elements + 1, 0);
+        for (unsigned elem_index = 0; elem_index < num_elements; elem_index++)
+        {
+            unsigned num_edges = mElements[elem_index]->IsDeleted() ? 0 : mElements[elem_index]->GetNumNodes();
+            edge_offsets[elem_index + 1] = edge_offsets[elem_index] + num_edges;
+        }
+        std::vector<double> edge_lengths(edge_offsets.back(), 0.0);
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+        for (int elem_index = 0; elem_index < static_cast<int>(num_elements); elem_index++)
+        {
+            for (unsigned local_index = 0; local_index < edge_offsets[elem_index + 1] - edge_offsets[elem_index]; local_index++)
+            {
+                edge_lengths[edge_offsets[elem_index] + local_index] = GetLengthOfElementEdge(mElements[elem_index], local_index);
+            }
+        }
+
+        mElementEdgeLengthOffsets.swap(edge_offsets);
+        mElementEdgeLengths.swap(edge_lengths);
+    }
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif // CHASTE_OPENMP
+    for (int elem_index = 0; elem_index < static_cast<int>(num_elements); elem_index++)
+    {
+        if (!mElements[elem_index]->IsDeleted())
+        {
+            element_volumes[elem_index] = GetVolumeOfElement(elem_index);
+            element_surface_areas[elem_index] = GetSurfaceAreaOfElement(elem_index);
+        }
+    }
+
+    mElementVolumes.swap(element_volumes);
+    mElementSurfaceAreas.swap(element_surface_areas);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::ClearElementGeometryCache()
+{
+    mElementVolumes.clear();
+    mElementSurfaceAreas.clear();
+    mElementEdgeLengths.clear();
+    mElementEdgeLengthOffsets.clear();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMesh<ELEMENT_DIM, SPACE_DIM>::IsElementGeometryCached() const
+{
+    return !mElementVolumes.empty();
+}
+
 //////////////////////////////////////////////////////////////////////
 //                        2D-specific methods                       //
 //////////////////////////////////////////////////////////////////////
@@ -1452,10 +1549,7 @@ c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetPreviousEdgeG
     // We add an extra num_nodes_in_element-1 in the line below as otherwise this term can be negative, which breaks the % operator
     unsigned previous_local_index = (num_nodes_in_element + localIndex - 1) % num_nodes_in_element;
 
-    unsigned this_global_index = pElement->GetNodeGlobalIndex(localIndex);
-    unsigned previous_global_index = pElement->GetNodeGlobalIndex(previous_local_index);
-
-    double previous_edge_length = this->GetDistanceBetweenNodes(this_global_index, previous_global_index);
+    double previous_edge_length = GetLengthOfElementEdge(pElement, previous_local_index);
     assert(previous_edge_length > DBL_EPSILON);
 
     c_vector<double, SPACE_DIM> previous_edge_gradient = this->GetVectorFromAtoB(pElement->GetNodeLocation(previous_local_index), pElement->GetNodeLocation(localIndex)) / previous_edge_length;
@@ -1470,10 +1564,7 @@ c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNextEdgeGradi
 
     unsigned next_local_index = (localIndex + 1) % (pElement->GetNumNodes());
 
-    unsigned this_global_index = pElement->GetNodeGlobalIndex(localIndex);
-    unsigned next_global_index = pElement->GetNodeGlobalIndex(next_local_index);
-
-    double next_edge_length = this->GetDistanceBetweenNodes(this_global_index, next_global_index);
+    double next_edge_length = GetLengthOfElementEdge(pElement, localIndex);
     assert(next_edge_length > DBL_EPSILON);
 
     c_vector<double, SPACE_DIM> next_edge_gradient = this->GetVectorFromAtoB(pElement->GetNodeLocation(next_local_index), pElement->GetNodeLocation(localIndex)) / next_edge_length;
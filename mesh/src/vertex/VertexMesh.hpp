@@ -100,6 +100,25 @@ protected:
      */
     TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* mpDelaunayMesh;
 
+    /**
+     * Cached volume (area in 2D) of each element, indexed by element index. Empty
+     * unless CacheElementGeometry() has been called since the cache was last cleared.
+     */
+    std::vector<double> mElementVolumes;
+
+    /** Cached surface area (perimeter in 2D) of each element, indexed by element index. */
+    std::vector<double> mElementSurfaceAreas;
+
+    /**
+     * In 2D, the cached length of each element edge. The length of the edge from
+     * local node i to local node i+1 of element e is stored in entry
+     * mElementEdgeLengthOffsets[e] + i.
+     */
+    std::vector<double> mElementEdgeLengths;
+
+    /** The offset of each element's edges in mElementEdgeLengths, followed by the total number of edges. */
+    std::vector<unsigned> mElementEdgeLengthOffsets;
+
     /**
      * Solve node mapping method. This overridden method is required
      * as it is pure virtual in the base class.
@@ -404,6 +423,40 @@ public:
      */
     virtual double GetSurfaceAreaOfElement(unsigned index);
 
+    /**
+     * Compute the length of an edge of a 2D element.
+     *
+     * @param pElement  pointer to a specified vertex element
+     * @param localIndex  local index of a node in this element
+     *
+     * @return the length of the edge from this node to the next node (anticlockwise) in the element.
+     */
+    double GetLengthOfElementEdge(VertexElement<ELEMENT_DIM, SPACE_DIM>* pElement, unsigned localIndex);
+
+    /**
+     * Compute and store the volume (area in 2D) and surface area (perimeter in 2D) of
+     * every element and, in 2D, the length of every element edge, in parallel if
+     * OpenMP is available. Until ClearElementGeometryCache() is called,
+     * GetVolumeOfElement(), GetSurfaceAreaOfElement(), GetLengthOfElementEdge() and
+     * the edge gradient methods return or use these values.
+     *
+     * The cache is cleared by any change to the mesh connectivity made through this
+     * class or its subclasses, but not when nodes are moved directly. It is intended
+     * to be used around a block of code, such as a force calculation, during which
+     * nodes do not move. Does nothing in 1D.
+     */
+    void CacheElementGeometry();
+
+    /**
+     * Clear the cache created by CacheElementGeometry().
+     */
+    void ClearElementGeometryCache();
+
+    /**
+     * @return whether the element geometry is currently cached.
+     */
+    bool IsElementGeometryCached() const;
+
     /**
      * Compute the area gradient of a 2D element at one of its nodes.
      *
@@ -0,0 +1,384 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+
+#include "Hdf5MeshWriter.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::Hdf5MeshWriter(const std::string& rDirectory,
+                                                       const std::string& rBaseName,
+                                                       const bool clearOutputDir)
+    : AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>(rDirectory, rBaseName, clearOutputDir)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<typename Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::RowRun> Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::MakeRowRuns(const std::vector<unsigned>& rRows)
+{
+    std::vector<RowRun> runs;
+    for (unsigned i=0; i<rRows.size(); i++)
+    {
+        if (!runs.empty() && runs.back().first + runs.back().second == rRows[i])
+        {
+            runs.back().second++;
+        }
+        else
+        {
+            runs.push_back(RowRun(rRows[i], 1u));
+        }
+    }
+    return runs;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteDataset(hid_t fileId,
+                                                          const std::string& rName,
+                                                          hid_t dataType,
+                                                          hsize_t numRows,
+                                                          hsize_t numColumns,
+                                                          const std::vector<RowRun>& rRuns,
+                                                          const void* pData,
+                                                          hid_t transferPropertyList)
+{
+    hsize_t dataset_dims[2] = {numRows, numColumns};
+    hid_t file_space = H5Screate_simple(2, dataset_dims, nullptr);
+    hid_t dataset_id = H5Dcreate(fileId, rName.c_str(), dataType, file_space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (dataset_id < 0)
+    {
+        H5Sclose(file_space);
+        EXCEPTION("Could not create dataset '" << rName << "' in " << this->mBaseName << ".h5");
+    }
+
+    // Select the (possibly disjoint) rows which this process owns
+    hsize_t num_local_rows = 0;
+    H5Sselect_none(file_space);
+    for (unsigned i=0; i<rRuns.size(); i++)
+    {
+        hsize_t offset[2] = {rRuns[i].first, 0};
+        hsize_t count[2] = {rRuns[i].second, numColumns};
+        H5Sselect_hyperslab(file_space, H5S_SELECT_OR, offset, nullptr, count, nullptr);
+        num_local_rows += rRuns[i].second;
+    }
+
+    hid_t mem_space;
+    if (num_local_rows*numColumns != 0)
+    {
+        hsize_t mem_dims[1] = {num_local_rows*numColumns};
+        mem_space = H5Screate_simple(1, mem_dims, nullptr);
+    }
+    else
+    {
+        // Processes with nothing to write still take part in the collective call
+        mem_space = H5Screate(H5S_NULL);
+        H5Sselect_none(file_space);
+    }
+
+    herr_t err = H5Dwrite(dataset_id, dataType, mem_space, file_space, transferPropertyList, pData);
+
+    H5Sclose(mem_space);
+    H5Sclose(file_space);
+    H5Dclose(dataset_id);
+
+    if (err < 0)
+    {
+        EXCEPTION("Could not write dataset '" << rName << "' in " << this->mBaseName << ".h5");
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFiles()
+{
+    std::string file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName + ".h5";
+    hid_t file_id = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (file_id < 0)
+    {
+        EXCEPTION("Could not create " << file_name);
+    }
+
+    // Nodes
+    unsigned num_nodes = this->GetNumNodes();
+    std::vector<double> node_data;
+    node_data.reserve(num_nodes*SPACE_DIM);
+    for (unsigned item_num=0; item_num<num_nodes; item_num++)
+    {
+        std::vector<double> current_item = this->GetNextNode();
+        node_data.insert(node_data.end(), current_item.begin(), current_item.end());
+    }
+    WriteDataset(file_id, "Nodes", H5T_NATIVE_DOUBLE, num_nodes, SPACE_DIM,
+                 std::vector<RowRun>(1, RowRun(0, num_nodes)), node_data.data(), H5P_DEFAULT);
+
+    // Elements
+    unsigned num_elements = this->GetNumElements();
+    unsigned nodes_per_element = this->mNodesPerElement;
+    std::vector<unsigned> element_data;
+    std::vector<double> element_attributes(num_elements);
+    for (unsigned item_num=0; item_num<num_elements; item_num++)
+    {
+        ElementData current_item = this->GetNextElement();
+        if (item_num == 0)
+        {
+            // Readers report quadratic elements by the size of the first element
+            nodes_per_element = current_item.NodeIndices.size();
+            element_data.reserve(num_elements*nodes_per_element);
+        }
+        assert(current_item.NodeIndices.size() == nodes_per_element);
+        element_data.insert(element_data.end(), current_item.NodeIndices.begin(), current_item.NodeIndices.end());
+        element_attributes[item_num] = current_item.AttributeValue;
+    }
+    std::vector<RowRun> element_runs(1, RowRun(0, num_elements));
+    WriteDataset(file_id, "Elements", H5T_NATIVE_UINT, num_elements, nodes_per_element,
+                 element_runs, element_data.data(), H5P_DEFAULT);
+    WriteDataset(file_id, "ElementAttributes", H5T_NATIVE_DOUBLE, num_elements, 1,
+                 element_runs, element_attributes.data(), H5P_DEFAULT);
+
+    // Faces
+    unsigned num_faces = this->GetNumBoundaryFaces();
+    unsigned nodes_per_face = this->mNodesPerBoundaryElement;
+    std::vector<unsigned> face_data;
+    std::vector<double> face_attributes(num_faces);
+    for (unsigned item_num=0; item_num<num_faces; item_num++)
+    {
+        ElementData current_item = this->GetNextBoundaryElement();
+        if (item_num == 0)
+        {
+            nodes_per_face = current_item.NodeIndices.size();
+            face_data.reserve(num_faces*nodes_per_face);
+        }
+        assert(current_item.NodeIndices.size() == nodes_per_face);
+        face_data.insert(face_data.end(), current_item.NodeIndices.begin(), current_item.NodeIndices.end());
+        face_attributes[item_num] = current_item.AttributeValue;
+    }
+    std::vector<RowRun> face_runs(1, RowRun(0, num_faces));
+    WriteDataset(file_id, "Faces", H5T_NATIVE_UINT, num_faces, nodes_per_face,
+                 face_runs, face_data.data(), H5P_DEFAULT);
+    WriteDataset(file_id, "FaceAttributes", H5T_NATIVE_DOUBLE, num_faces, 1,
+                 face_runs, face_attributes.data(), H5P_DEFAULT);
+
+    // Node permutation, if the mesh (or the reader) has applied one
+    std::vector<unsigned> permutation;
+    if (this->mpMesh)
+    {
+        permutation = this->mpMesh->rGetNodePermutation();
+    }
+    else if (this->mpMeshReader->HasNodePermutation())
+    {
+        permutation = this->mpMeshReader->rGetNodePermutation();
+    }
+    if (!permutation.empty())
+    {
+        WriteDataset(file_id, "NodePermutation", H5T_NATIVE_UINT, permutation.size(), 1,
+                     std::vector<RowRun>(1, RowRun(0, permutation.size())), permutation.data(), H5P_DEFAULT);
+    }
+
+    H5Fclose(file_id);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                                                                 bool keepOriginalElementIndexing)
+{
+    DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* p_distributed_mesh = dynamic_cast<DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* >(&rMesh);
+    if (p_distributed_mesh == nullptr || PetscTools::IsSequential())
+    {
+        // The master process holds (or can gather) everything, so use the usual route through WriteFiles()
+        AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(rMesh, keepOriginalElementIndexing);
+        return;
+    }
+
+    this->mpMeshReader = nullptr;
+    this->mpMesh = &rMesh;
+    this->mpDistributedMesh = p_distributed_mesh;
+    this->mNumNodes = rMesh.GetNumNodes();
+    this->mNumElements = rMesh.GetNumElements();
+    this->mNumBoundaryElements = rMesh.GetNumBoundaryElements();
+    this->mNumCableElements = rMesh.GetNumCableElements();
+
+    WriteFilesUsingParallelHdf5();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5MeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingParallelHdf5()
+{
+    DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* p_mesh = this->mpDistributedMesh;
+    assert(p_mesh != nullptr);
+
+    // Every process opens the same file for collective access
+    std::string file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName + ".h5";
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl, PETSC_COMM_WORLD, MPI_INFO_NULL);
+    hid_t file_id = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    H5Pclose(fapl);
+    if (file_id < 0)
+    {
+        EXCEPTION("Could not create " << file_name);
+    }
+
+    hid_t transfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(transfer_plist, H5FD_MPIO_COLLECTIVE);
+
+    // Nodes: each process writes the nodes it owns (halo nodes are owned elsewhere)
+    std::vector<unsigned> owned_nodes;
+    owned_nodes.reserve(p_mesh->GetNumLocalNodes());
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator iter = p_mesh->GetNodeIteratorBegin();
+         iter != p_mesh->GetNodeIteratorEnd();
+         ++iter)
+    {
+        owned_nodes.push_back(iter->GetIndex());
+    }
+    std::sort(owned_nodes.begin(), owned_nodes.end());
+
+    std::vector<double> node_data;
+    node_data.reserve(owned_nodes.size()*SPACE_DIM);
+    for (unsigned i=0; i<owned_nodes.size(); i++)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = p_mesh->GetNode(owned_nodes[i])->rGetLocation();
+        node_data.insert(node_data.end(), r_location.begin(), r_location.end());
+    }
+    std::vector<RowRun> node_runs = MakeRowRuns(owned_nodes);
+    WriteDataset(file_id, "Nodes", H5T_NATIVE_DOUBLE, this->mNumNodes, SPACE_DIM,
+                 node_runs, node_data.data(), transfer_plist);
+
+    // Elements: each element is written by its designated owner only
+    std::vector<unsigned> owned_elements;
+    unsigned local_nodes_per_element = 0;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = p_mesh->GetElementIteratorBegin();
+         iter != p_mesh->GetElementIteratorEnd();
+         ++iter)
+    {
+        local_nodes_per_element = iter->GetNumNodes();
+        if (p_mesh->CalculateDesignatedOwnershipOfElement(iter->GetIndex()))
+        {
+            owned_elements.push_back(iter->GetIndex());
+        }
+    }
+    std::sort(owned_elements.begin(), owned_elements.end());
+
+    // Processes without elements can't tell whether the mesh is quadratic, so agree on the width
+    unsigned nodes_per_element;
+    MPI_Allreduce(&local_nodes_per_element, &nodes_per_element, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+    if (nodes_per_element == 0)
+    {
+        nodes_per_element = this->mNodesPerElement;
+    }
+
+    std::vector<unsigned> element_data;
+    std::vector<double> element_attributes;
+    element_data.reserve(owned_elements.size()*nodes_per_element);
+    element_attributes.reserve(owned_elements.size());
+    for (unsigned i=0; i<owned_elements.size(); i++)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = p_mesh->GetElement(owned_elements[i]);
+        for (unsigned j=0; j<nodes_per_element; j++)
+        {
+            element_data.push_back(p_element->GetNodeGlobalIndex(j));
+        }
+        element_attributes.push_back(p_element->GetAttribute());
+    }
+    std::vector<RowRun> element_runs = MakeRowRuns(owned_elements);
+    WriteDataset(file_id, "Elements", H5T_NATIVE_UINT, this->mNumElements, nodes_per_element,
+                 element_runs, element_data.data(), transfer_plist);
+    WriteDataset(file_id, "ElementAttributes", H5T_NATIVE_DOUBLE, this->mNumElements, 1,
+                 element_runs, element_attributes.data(), transfer_plist);
+
+    // Faces: as for elements
+    std::vector<unsigned> owned_faces;
+    unsigned local_nodes_per_face = 0;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::BoundaryElementIterator iter = p_mesh->GetBoundaryElementIteratorBegin();
+         iter != p_mesh->GetBoundaryElementIteratorEnd();
+         ++iter)
+    {
+        local_nodes_per_face = (*iter)->GetNumNodes();
+        if (p_mesh->CalculateDesignatedOwnershipOfBoundaryElement((*iter)->GetIndex()))
+        {
+            owned_faces.push_back((*iter)->GetIndex());
+        }
+    }
+    std::sort(owned_faces.begin(), owned_faces.end());
+
+    unsigned nodes_per_face;
+    MPI_Allreduce(&local_nodes_per_face, &nodes_per_face, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+    if (nodes_per_face == 0)
+    {
+        nodes_per_face = this->mNodesPerBoundaryElement;
+    }
+
+    std::vector<unsigned> face_data;
+    std::vector<double> face_attributes;
+    face_data.reserve(owned_faces.size()*nodes_per_face);
+    face_attributes.reserve(owned_faces.size());
+    for (unsigned i=0; i<owned_faces.size(); i++)
+    {
+        BoundaryElement<ELEMENT_DIM-1, SPACE_DIM>* p_face = p_mesh->GetBoundaryElement(owned_faces[i]);
+        for (unsigned j=0; j<nodes_per_face; j++)
+        {
+            face_data.push_back(p_face->GetNodeGlobalIndex(j));
+        }
+        face_attributes.push_back(p_face->GetAttribute());
+    }
+    std::vector<RowRun> face_runs = MakeRowRuns(owned_faces);
+    WriteDataset(file_id, "Faces", H5T_NATIVE_UINT, this->mNumBoundaryElements, nodes_per_face,
+                 face_runs, face_data.data(), transfer_plist);
+    WriteDataset(file_id, "FaceAttributes", H5T_NATIVE_DOUBLE, this->mNumBoundaryElements, 1,
+                 face_runs, face_attributes.data(), transfer_plist);
+
+    // Node permutation (replicated on every process): each process writes the entries for its own nodes
+    const std::vector<unsigned>& r_permutation = p_mesh->rGetNodePermutation();
+    if (!r_permutation.empty())
+    {
+        std::vector<unsigned> permutation_data;
+        permutation_data.reserve(owned_nodes.size());
+        for (unsigned i=0; i<owned_nodes.size(); i++)
+        {
+            permutation_data.push_back(r_permutation[owned_nodes[i]]);
+        }
+        WriteDataset(file_id, "NodePermutation", H5T_NATIVE_UINT, r_permutation.size(), 1,
+                     node_runs, permutation_data.data(), transfer_plist);
+    }
+
+    H5Pclose(transfer_plist);
+    H5Fclose(file_id);
+}
+
+// Explicit instantiation
+template class Hdf5MeshWriter<1,1>;
+template class Hdf5MeshWriter<1,2>;
+template class Hdf5MeshWriter<1,3>;
+template class Hdf5MeshWriter<2,2>;
+template class Hdf5MeshWriter<2,3>;
+template class Hdf5MeshWriter<3,3>;
@@ -0,0 +1,138 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef HDF5MESHWRITER_HPP_
+#define HDF5MESHWRITER_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <hdf5.h>
+
+#include "AbstractTetrahedralMeshWriter.hpp"
+
+/**
+ * A class for writing a Chaste mesh to a single HDF5 file (with extension .h5), which
+ * can be read back with Hdf5MeshReader.
+ *
+ * The file contains the following two-dimensional datasets, one row per item:
+ *  - "Nodes": the coordinates of each node (SPACE_DIM columns);
+ *  - "Elements": the node indices of each element;
+ *  - "ElementAttributes": the attribute of each element (one column);
+ *  - "Faces": the node indices of each boundary element;
+ *  - "FaceAttributes": the attribute of each boundary element (one column);
+ *  - "NodePermutation": only present if the mesh has applied a node permutation (one column).
+ *
+ * When a DistributedTetrahedralMesh is written in parallel every process writes
+ * the nodes and (designated) elements it owns straight into the shared file using
+ * collective hyperslab I/O, so that no data is funnelled through the master process.
+ * Cable elements are not written.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class Hdf5MeshWriter : public AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+
+    /** A run of consecutive rows in a dataset, stored as (first row, number of rows). */
+    typedef std::pair<hsize_t, hsize_t> RowRun;
+
+    /**
+     * Convert a sorted list of row indices into runs of consecutive rows.
+     *
+     * @param rRows  the (sorted, distinct) row indices
+     * @return the runs of consecutive rows covering rRows, in order
+     */
+    static std::vector<RowRun> MakeRowRuns(const std::vector<unsigned>& rRows);
+
+    /**
+     * Create a two-dimensional dataset in the file and write this process's rows into it.
+     * Collective if the file was opened for parallel access.
+     *
+     * @param fileId  the open HDF5 file
+     * @param rName  the name of the dataset
+     * @param dataType  the (native) type of the data, H5T_NATIVE_DOUBLE or H5T_NATIVE_UINT
+     * @param numRows  the total number of rows in the dataset
+     * @param numColumns  the number of columns in the dataset
+     * @param rRuns  the runs of rows which this process writes (possibly empty)
+     * @param pData  this process's rows, packed contiguously in the order given by rRuns
+     * @param transferPropertyList  the dataset transfer property list to use
+     */
+    void WriteDataset(hid_t fileId,
+                      const std::string& rName,
+                      hid_t dataType,
+                      hsize_t numRows,
+                      hsize_t numColumns,
+                      const std::vector<RowRun>& rRuns,
+                      const void* pData,
+                      hid_t transferPropertyList);
+
+    /**
+     * Write the node, element and face data owned by this process of a distributed
+     * mesh, using collective parallel I/O.
+     */
+    void WriteFilesUsingParallelHdf5();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rDirectory  the directory in which to write the mesh to file
+     * @param rBaseName  the base name of the file in which to write the mesh data
+     * @param clearOutputDir  whether to clean the directory (defaults to true)
+     */
+    Hdf5MeshWriter(const std::string& rDirectory,
+                   const std::string& rBaseName,
+                   const bool clearOutputDir=true);
+
+    /**
+     * Write the mesh file on the master process, using the mesh reader or (sequential) mesh
+     * set up by the base class.
+     */
+    void WriteFiles();
+
+    /**
+     * Write the file using a mesh.  Distributed meshes are written in parallel by all
+     * processes; anything else is written by the master process alone.
+     *
+     * @param rMesh the mesh
+     * @param keepOriginalElementIndexing  Whether to write the mesh with the same element ordering.
+     *                                     Elements are always written in their original order by this class.
+     */
+    void WriteFilesUsingMesh(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                             bool keepOriginalElementIndexing=true);
+};
+
+#endif // HDF5MESHWRITER_HPP_
@@ -0,0 +1,354 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <boost/cstdint.hpp>
+
+#include "VtuTimeSeriesWriter.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+#include "Version.hpp"
+
+/**
+ * @return the byte_order attribute for VTK XML files written on this machine.
+ */
+static std::string GetVtkByteOrder()
+{
+    const boost::uint16_t test_value = 1u;
+    return (*reinterpret_cast<const unsigned char*>(&test_value) == 1u) ? "LittleEndian" : "BigEndian";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::VtuTimeSeriesWriter(const std::string& rDirectory,
+                                                                 const std::string& rBaseName,
+                                                                 AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                                                                 bool cleanOutputDirectory)
+    : mOutputFileHandler(rDirectory, cleanOutputDirectory),
+      mBaseName(rBaseName),
+      mNumPoints(0),
+      mNumCells(0)
+{
+    DistributedVectorFactory* p_factory = rMesh.GetDistributedVectorFactory();
+    mLo = p_factory->GetLow();
+    mHi = p_factory->GetHigh();
+
+    // Each element is written by the owner of its lowest-numbered node, which always holds the element
+    std::vector<boost::int64_t> connectivity;
+    std::set<unsigned> halo_nodes;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = rMesh.GetElementIteratorBegin();
+         iter != rMesh.GetElementIteratorEnd();
+         ++iter)
+    {
+        unsigned lowest_index = iter->GetNodeGlobalIndex(0);
+        for (unsigned j=1; j<ELEMENT_DIM+1; j++)
+        {
+            lowest_index = std::min(lowest_index, iter->GetNodeGlobalIndex(j));
+        }
+        if (lowest_index < mLo || lowest_index >= mHi)
+        {
+            continue;
+        }
+        for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+        {
+            unsigned global_index = iter->GetNodeGlobalIndex(j);
+            connectivity.push_back(global_index);
+            if (global_index < mLo || global_index >= mHi)
+            {
+                halo_nodes.insert(global_index);
+            }
+        }
+        mNumCells++;
+    }
+    mHaloNodes.assign(halo_nodes.begin(), halo_nodes.end());
+    mNumPoints = (mHi - mLo) + mHaloNodes.size();
+
+    // Renumber the connectivity into this piece's points: owned nodes first, then halo nodes
+    for (unsigned i=0; i<connectivity.size(); i++)
+    {
+        unsigned global_index = connectivity[i];
+        if (global_index >= mLo && global_index < mHi)
+        {
+            connectivity[i] = global_index - mLo;
+        }
+        else
+        {
+            connectivity[i] = (mHi - mLo) + (std::lower_bound(mHaloNodes.begin(), mHaloNodes.end(), global_index) - mHaloNodes.begin());
+        }
+    }
+
+    // Work out which values each process needs from the others at every time step
+    unsigned num_procs = PetscTools::GetNumProcs();
+    mSendCounts.assign(num_procs, 0);
+    mSendOffsets.assign(num_procs, 0);
+    mReceiveCounts.assign(num_procs, 0);
+    mReceiveOffsets.assign(num_procs, 0);
+    if (PetscTools::IsParallel())
+    {
+        const std::vector<unsigned>& r_lows = p_factory->rGetGlobalLows();
+        for (unsigned i=0; i<mHaloNodes.size(); i++)
+        {
+            unsigned owner = (std::upper_bound(r_lows.begin(), r_lows.end(), mHaloNodes[i]) - r_lows.begin()) - 1;
+            mReceiveCounts[owner]++;
+        }
+        MPI_Alltoall(&mReceiveCounts[0], 1, MPI_INT, &mSendCounts[0], 1, MPI_INT, PETSC_COMM_WORLD);
+        for (unsigned rank=1; rank<num_procs; rank++)
+        {
+            mSendOffsets[rank] = mSendOffsets[rank-1] + mSendCounts[rank-1];
+            mReceiveOffsets[rank] = mReceiveOffsets[rank-1] + mReceiveCounts[rank-1];
+        }
+        mNodesToSend.resize(mSendOffsets[num_procs-1] + mSendCounts[num_procs-1]);
+
+        // Halo nodes are sorted, so they are already grouped by owner
+        std::vector<unsigned> halo_nodes_to_request(mHaloNodes);
+        MPI_Alltoallv(halo_nodes_to_request.empty() ? nullptr : &halo_nodes_to_request[0], &mReceiveCounts[0], &mReceiveOffsets[0], MPI_UNSIGNED,
+                      mNodesToSend.empty() ? nullptr : &mNodesToSend[0], &mSendCounts[0], &mSendOffsets[0], MPI_UNSIGNED,
+                      PETSC_COMM_WORLD);
+    }
+
+    // Encode the topology once
+    std::vector<double> points(3*mNumPoints, 0.0);
+    for (unsigned i=0; i<mNumPoints; i++)
+    {
+        unsigned global_index = (i < mHi - mLo) ? mLo + i : mHaloNodes[i - (mHi - mLo)];
+        const c_vector<double, SPACE_DIM>& r_location = rMesh.GetNodeOrHaloNode(global_index)->rGetLocation();
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            points[3*i + j] = r_location[j];
+        }
+    }
+
+    std::vector<boost::int64_t> offsets(mNumCells);
+    for (unsigned i=0; i<mNumCells; i++)
+    {
+        offsets[i] = (i+1)*(ELEMENT_DIM+1);
+    }
+
+    // VTK_LINE, VTK_TRIANGLE or VTK_TETRA
+    const boost::uint8_t cell_type = (ELEMENT_DIM == 1) ? 3u : ((ELEMENT_DIM == 2) ? 5u : 10u);
+    std::vector<boost::uint8_t> types(mNumCells, cell_type);
+
+    std::stringstream xml;
+    xml << "      <Points>\n";
+    xml << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << mTopologyData.size() << "\"/>\n";
+    AppendBlock(mTopologyData, points.data(), points.size()*sizeof(double));
+    xml << "      </Points>\n";
+    xml << "      <Cells>\n";
+    xml << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << mTopologyData.size() << "\"/>\n";
+    AppendBlock(mTopologyData, connectivity.data(), connectivity.size()*sizeof(boost::int64_t));
+    xml << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << mTopologyData.size() << "\"/>\n";
+    AppendBlock(mTopologyData, offsets.data(), offsets.size()*sizeof(boost::int64_t));
+    xml << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << mTopologyData.size() << "\"/>\n";
+    AppendBlock(mTopologyData, types.data(), types.size()*sizeof(boost::uint8_t));
+    xml << "      </Cells>\n";
+    mTopologyXml = xml.str();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::AppendBlock(std::string& rAppendedData, const void* pData, unsigned long long numBytes)
+{
+    // header_type="UInt64": each block is preceded by its size in bytes
+    boost::uint64_t header = numBytes;
+    rAppendedData.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (numBytes > 0)
+    {
+        rAppendedData.append(static_cast<const char*>(pData), numBytes);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::GetPieceFileName(unsigned step, unsigned rank) const
+{
+    std::stringstream file_name;
+    file_name << mBaseName << "_" << std::setw(6) << std::setfill('0') << step << "_" << rank << ".vtu";
+    return file_name.str();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::GetParallelFileName(unsigned step) const
+{
+    std::stringstream file_name;
+    file_name << mBaseName << "_" << std::setw(6) << std::setfill('0') << step << ".pvtu";
+    return file_name.str();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::GetCollectionFileName() const
+{
+    return mBaseName + ".pvd";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::AddPointData(const std::string& rName, const std::vector<double>& rData)
+{
+    if (rData.size() != mHi - mLo)
+    {
+        EXCEPTION("Point data '" << rName << "' has " << rData.size() << " values, but this process owns "
+                  << mHi - mLo << " nodes.");
+    }
+
+    std::vector<double> piece_data(rData);
+    piece_data.resize(mNumPoints);
+
+    if (PetscTools::IsParallel())
+    {
+        std::vector<double> send_data(mNodesToSend.size());
+        for (unsigned i=0; i<mNodesToSend.size(); i++)
+        {
+            send_data[i] = rData[mNodesToSend[i] - mLo];
+        }
+        // Received values go straight into the halo part of the piece data
+        MPI_Alltoallv(send_data.empty() ? nullptr : &send_data[0], &mSendCounts[0], &mSendOffsets[0], MPI_DOUBLE,
+                      mHaloNodes.empty() ? nullptr : &piece_data[mHi - mLo], &mReceiveCounts[0], &mReceiveOffsets[0], MPI_DOUBLE,
+                      PETSC_COMM_WORLD);
+    }
+
+    mPointData.push_back(std::make_pair(rName, piece_data));
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStep(double time)
+{
+    unsigned step = mTimes.size();
+
+    std::vector<std::string> names;
+    for (unsigned i=0; i<mPointData.size(); i++)
+    {
+        names.push_back(mPointData[i].first);
+    }
+    if (step == 0)
+    {
+        mPointDataNames = names;
+    }
+    else if (names != mPointDataNames)
+    {
+        mPointData.clear();
+        EXCEPTION("Every time step must have the same point data as the first one.");
+    }
+
+    // This process's piece: cached topology followed by this step's point data
+    std::string point_data_appended;
+    std::stringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n";
+    xml << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << GetVtkByteOrder() << "\" header_type=\"UInt64\">\n";
+    xml << "  <UnstructuredGrid>\n";
+    xml << "    <Piece NumberOfPoints=\"" << mNumPoints << "\" NumberOfCells=\"" << mNumCells << "\">\n";
+    xml << mTopologyXml;
+    xml << "      <PointData>\n";
+    for (unsigned i=0; i<mPointData.size(); i++)
+    {
+        xml << "        <DataArray type=\"Float64\" Name=\"" << mPointData[i].first << "\" format=\"appended\" offset=\""
+            << mTopologyData.size() + point_data_appended.size() << "\"/>\n";
+        AppendBlock(point_data_appended, mPointData[i].second.data(), mPointData[i].second.size()*sizeof(double));
+    }
+    xml << "      </PointData>\n";
+    xml << "    </Piece>\n";
+    xml << "  </UnstructuredGrid>\n";
+    xml << "  <AppendedData encoding=\"raw\">\n   _";
+
+    out_stream p_file = mOutputFileHandler.OpenOutputFile(GetPieceFileName(step, PetscTools::GetMyRank()),
+                                                          std::ios::out | std::ios::binary | std::ios::trunc);
+    const std::string header = xml.str();
+    p_file->write(header.data(), header.size());
+    p_file->write(mTopologyData.data(), mTopologyData.size());
+    p_file->write(point_data_appended.data(), point_data_appended.size());
+    *p_file << "\n  </AppendedData>\n</VTKFile>\n";
+    p_file->close();
+
+    mTimes.push_back(time);
+    mPointData.clear();
+
+    if (PetscTools::AmMaster())
+    {
+        WriteMasterFiles(step);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::WriteMasterFiles(unsigned step)
+{
+    std::string provenance = "<!-- " + ChasteBuildInfo::GetProvenanceString() + "-->\n";
+
+    out_stream p_pvtu_file = mOutputFileHandler.OpenOutputFile(GetParallelFileName(step));
+    *p_pvtu_file << "<?xml version=\"1.0\"?>\n" << provenance;
+    *p_pvtu_file << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"" << GetVtkByteOrder() << "\" header_type=\"UInt64\">\n";
+    *p_pvtu_file << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+    *p_pvtu_file << "    <PPointData>\n";
+    for (unsigned i=0; i<mPointDataNames.size(); i++)
+    {
+        *p_pvtu_file << "      <PDataArray type=\"Float64\" Name=\"" << mPointDataNames[i] << "\"/>\n";
+    }
+    *p_pvtu_file << "    </PPointData>\n";
+    *p_pvtu_file << "    <PPoints>\n";
+    *p_pvtu_file << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n";
+    *p_pvtu_file << "    </PPoints>\n";
+    for (unsigned rank=0; rank<PetscTools::GetNumProcs(); rank++)
+    {
+        *p_pvtu_file << "    <Piece Source=\"" << GetPieceFileName(step, rank) << "\"/>\n";
+    }
+    *p_pvtu_file << "  </PUnstructuredGrid>\n";
+    *p_pvtu_file << "</VTKFile>\n";
+    p_pvtu_file->close();
+
+    // Rewrite the whole collection so that it is valid while the simulation is still running
+    out_stream p_pvd_file = mOutputFileHandler.OpenOutputFile(GetCollectionFileName());
+    *p_pvd_file << "<?xml version=\"1.0\"?>\n" << provenance;
+    *p_pvd_file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << GetVtkByteOrder() << "\">\n";
+    *p_pvd_file << "  <Collection>\n";
+    *p_pvd_file << std::setprecision(20);
+    for (unsigned i=0; i<mTimes.size(); i++)
+    {
+        *p_pvd_file << "    <DataSet timestep=\"" << mTimes[i] << "\" group=\"\" part=\"0\" file=\"" << GetParallelFileName(i) << "\"/>\n";
+    }
+    *p_pvd_file << "  </Collection>\n";
+    *p_pvd_file << "</VTKFile>\n";
+    p_pvd_file->close();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VtuTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::GetNumTimeStepsWritten() const
+{
+    return mTimes.size();
+}
+
+// Explicit instantiation
+template class VtuTimeSeriesWriter<1,1>;
+template class VtuTimeSeriesWriter<1,2>;
+template class VtuTimeSeriesWriter<1,3>;
+template class VtuTimeSeriesWriter<2,2>;
+template class VtuTimeSeriesWriter<2,3>;
+template class VtuTimeSeriesWriter<3,3>;
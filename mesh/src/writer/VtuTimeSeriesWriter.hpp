@@ -0,0 +1,191 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VTUTIMESERIESWRITER_HPP_
+#define VTUTIMESERIESWRITER_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "AbstractTetrahedralMesh.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * Writes node-wise results on a fixed mesh as a VTK time series, directly from a running simulation.
+ *
+ * Every process writes its own piece of the mesh to <base>_<step>_<rank>.vtu for each time step, using
+ * appended raw binary data, and the master process writes <base>_<step>.pvtu, which ties the pieces
+ * together, and keeps <base>.pvd (a time-series collection that can be opened in ParaView) up to date.
+ * No data is gathered onto one process, and the VTK libraries are not needed.
+ *
+ * The mesh must not change while the writer is in use.  Each piece's points, connectivity, offsets
+ * and cell types are encoded once, at construction, so that writing a time step only involves packing
+ * the point data (and, in parallel, exchanging the values at nodes owned by other processes).
+ *
+ * Each element is written by the process which owns its lowest-numbered node.  A piece therefore
+ * contains the nodes which this process owns (in the order of the mesh's DistributedVectorFactory),
+ * followed by any other nodes of its elements.  Only the vertices of each element are written.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VtuTimeSeriesWriter : private boost::noncopyable
+{
+private:
+
+    /** Output file handler for the output directory. */
+    OutputFileHandler mOutputFileHandler;
+
+    /** The base name of the output files. */
+    std::string mBaseName;
+
+    /** The first global node index owned by this process. */
+    unsigned mLo;
+
+    /** One past the last global node index owned by this process. */
+    unsigned mHi;
+
+    /** The global indices of the nodes of this piece which are owned by other processes, in increasing order. */
+    std::vector<unsigned> mHaloNodes;
+
+    /** For each process, how many values this process sends it at each time step. */
+    std::vector<int> mSendCounts;
+
+    /** For each process, the offset of its values in the send buffer. */
+    std::vector<int> mSendOffsets;
+
+    /** For each process, how many halo values this process receives from it. */
+    std::vector<int> mReceiveCounts;
+
+    /** For each process, the offset of its values in the receive buffer (and so in mHaloNodes). */
+    std::vector<int> mReceiveOffsets;
+
+    /** The global indices of the owned nodes whose values are sent to other processes, grouped by process. */
+    std::vector<unsigned> mNodesToSend;
+
+    /** The number of points in this piece. */
+    unsigned mNumPoints;
+
+    /** The number of cells in this piece. */
+    unsigned mNumCells;
+
+    /** The XML describing the <Points> and <Cells> of this piece, with offsets into the appended data. */
+    std::string mTopologyXml;
+
+    /** The appended raw data for the points and cells of this piece. */
+    std::string mTopologyData;
+
+    /** The point data added for the next time step, as (name, values for every point of this piece). */
+    std::vector<std::pair<std::string, std::vector<double> > > mPointData;
+
+    /** The times of the steps written so far (used to rewrite the .pvd file). */
+    std::vector<double> mTimes;
+
+    /** The names of the point data arrays in the first time step written. */
+    std::vector<std::string> mPointDataNames;
+
+    /**
+     * Append a block of raw data to an appended data string, preceded by its length in bytes.
+     *
+     * @param rAppendedData  the appended data to add to
+     * @param pData  the data
+     * @param numBytes  the number of bytes of data
+     */
+    static void AppendBlock(std::string& rAppendedData, const void* pData, unsigned long long numBytes);
+
+    /**
+     * @return the name of the piece file written by a process at a time step (relative to the output directory).
+     *
+     * @param step  the time step index
+     * @param rank  the process rank
+     */
+    std::string GetPieceFileName(unsigned step, unsigned rank) const;
+
+    /**
+     * @return the name of the parallel file written at a time step (relative to the output directory).
+     *
+     * @param step  the time step index
+     */
+    std::string GetParallelFileName(unsigned step) const;
+
+    /**
+     * Master process only: write the .pvtu file for a time step and rewrite the .pvd collection file.
+     *
+     * @param step  the time step index
+     */
+    void WriteMasterFiles(unsigned step);
+
+public:
+
+    /**
+     * Constructor.  Collective: all processes must construct the writer.
+     *
+     * @param rDirectory  the output directory, relative to CHASTE_TEST_OUTPUT
+     * @param rBaseName  the base name of the output files
+     * @param rMesh  the mesh (which must not change while the writer is in use)
+     * @param cleanOutputDirectory  whether to clean the output directory (defaults to false)
+     */
+    VtuTimeSeriesWriter(const std::string& rDirectory,
+                        const std::string& rBaseName,
+                        AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                        bool cleanOutputDirectory=false);
+
+    /**
+     * Add a scalar field on the nodes to the next time step.  Collective in parallel (the values
+     * at halo nodes are fetched from the processes which own them).
+     *
+     * @param rName  the name of the field
+     * @param rData  the values at the nodes owned by this process, in global index order (as
+     *     held by a PETSc vector from the mesh's DistributedVectorFactory)
+     */
+    void AddPointData(const std::string& rName, const std::vector<double>& rData);
+
+    /**
+     * Write the point data added since the last time step as a new time step.
+     * Every time step must have the same fields (if not, the fields added are discarded and an
+     * exception is thrown).
+     *
+     * @param time  the simulation time of the step
+     */
+    void WriteTimeStep(double time);
+
+    /** @return the number of time steps written so far */
+    unsigned GetNumTimeStepsWritten() const;
+
+    /** @return the name of the time-series collection file (relative to the output directory) */
+    std::string GetCollectionFileName() const;
+};
+
+#endif // VTUTIMESERIESWRITER_HPP_
@@ -0,0 +1,172 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "XdmfTimeSeriesWriter.hpp"
+#include "AbstractTetrahedralMesh.hpp"
+#include "Exception.hpp"
+#include "Version.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::XdmfTimeSeriesWriter(const std::string& rDirectory,
+                                                                   const std::string& rBaseName,
+                                                                   const std::string& rDataPath,
+                                                                   const std::vector<std::string>& rVariableNames,
+                                                                   const bool clearOutputDir)
+    : XdmfMeshWriter<ELEMENT_DIM, SPACE_DIM>(rDirectory, rBaseName, clearOutputDir),
+      mDataPath(rDataPath),
+      mVariableNames(rVariableNames),
+      mNumNodes(0u),
+      mNumTimeStepsWritten(0u),
+      mClosingTagsPosition(0)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::WriteClosingTags(std::ostream& rStream)
+{
+    rStream << "    </Grid>\n";
+    rStream << "  </Domain>\n";
+    rStream << "</Xdmf>\n";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                                                                       bool keepOriginalElementIndexing)
+{
+    assert(keepOriginalElementIndexing);
+    if (mNumTimeStepsWritten > 0)
+    {
+        EXCEPTION("The mesh must be written before any time steps are added.");
+    }
+    mNumNodes = rMesh.GetNumNodes();
+
+    // The master gathers the whole mesh (in global node order, which is the order of the rows of
+    // the dataset) and writes it as a single chunk.  This also writes a master file with no data.
+    AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(rMesh, true);
+
+    if (PetscTools::AmMaster())
+    {
+        // Replace the master file with one which time steps can be appended to
+        out_stream p_file = this->mpOutputFileHandler->OpenOutputFile(this->mBaseName + ".xdmf");
+        *p_file << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>\n";
+        *p_file << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\">\n";
+        *p_file << "<!-- " + ChasteBuildInfo::GetProvenanceString() + "-->\n";
+        *p_file << "<Xdmf Version=\"2.0\" xmlns:xi=\"http://www.w3.org/2001/XInclude\">\n";
+        *p_file << "  <Domain>\n";
+        *p_file << "    <Grid CollectionType=\"Temporal\" GridType=\"Collection\">\n";
+        mClosingTagsPosition = p_file->tellp();
+        WriteClosingTags(*p_file);
+        p_file->close();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::AddTimeStep(double time, unsigned timeIndex, unsigned datasetLength)
+{
+    if (mNumNodes == 0u)
+    {
+        EXCEPTION("The mesh must be written before time steps are added.");
+    }
+    assert(timeIndex < datasetLength);
+
+    if (PetscTools::AmMaster())
+    {
+        std::stringstream step;
+        step << std::setprecision(std::numeric_limits<double>::digits10);
+        step << "      <Grid CollectionType=\"Spatial\" GridType=\"Collection\">\n";
+        step << "        <Time Value=\"" << time << "\"/>\n";
+
+        std::string indent = "          ";
+        if (mNumTimeStepsWritten == 0)
+        {
+            // The first step holds the mesh...
+            step << "        <Grid GridType=\"Uniform\" Name=\"Chunk_0\">\n";
+            step << "          <xi:include href=\"" << this->mBaseName << "_geometry_0.xml\"/>\n";
+            step << "          <xi:include href=\"" << this->mBaseName << "_topology_0.xml\"/>\n";
+        }
+        else
+        {
+            // ...which later steps refer to
+            step << "        <Grid GridType=\"Subset\" Section=\"All\">\n";
+        }
+
+        for (unsigned var_index=0; var_index<mVariableNames.size(); var_index++)
+        {
+            // The hyperslab selects [timeIndex, all nodes, var_index] from the whole dataset
+            step << indent << "<Attribute Center=\"Node\" Name=\"" << mVariableNames[var_index] << "\">\n";
+            step << indent << "  <DataItem Dimensions=\"1 " << mNumNodes << " 1\" ItemType=\"HyperSlab\">\n";
+            step << indent << "    <DataItem Dimensions=\"3 3\" Format=\"XML\">"
+                 << timeIndex << " 0 " << var_index << " 1 1 1 1 " << mNumNodes << " 1</DataItem>\n";
+            step << indent << "    <DataItem Dimensions=\"" << datasetLength << " " << mNumNodes << " " << mVariableNames.size()
+                 << "\" Format=\"HDF\" NumberType=\"Float\" Precision=\"8\">" << mDataPath << "</DataItem>\n";
+            step << indent << "  </DataItem>\n";
+            step << indent << "</Attribute>\n";
+        }
+
+        if (mNumTimeStepsWritten > 0)
+        {
+            step << indent << "<Grid GridType=\"Uniform\" Reference=\"XML\">/Xdmf/Domain/Grid/Grid/Grid[@Name=\"Chunk_0\"]</Grid>\n";
+        }
+        step << "        </Grid>\n";
+        step << "      </Grid>\n";
+
+        // Overwrite the closing tags with the new step, and put them back after it
+        out_stream p_file = this->mpOutputFileHandler->OpenOutputFile(this->mBaseName + ".xdmf", std::ios::in | std::ios::out);
+        p_file->seekp(mClosingTagsPosition);
+        *p_file << step.str();
+        mClosingTagsPosition = p_file->tellp();
+        WriteClosingTags(*p_file);
+        p_file->close();
+    }
+    mNumTimeStepsWritten++;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned XdmfTimeSeriesWriter<ELEMENT_DIM, SPACE_DIM>::GetNumTimeStepsWritten() const
+{
+    return mNumTimeStepsWritten;
+}
+
+// Explicit instantiation
+template class XdmfTimeSeriesWriter<1,1>;
+template class XdmfTimeSeriesWriter<1,2>;
+template class XdmfTimeSeriesWriter<1,3>;
+template class XdmfTimeSeriesWriter<2,2>;
+template class XdmfTimeSeriesWriter<2,3>;
+template class XdmfTimeSeriesWriter<3,3>;
@@ -0,0 +1,122 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef XDMFTIMESERIESWRITER_HPP_
+#define XDMFTIMESERIESWRITER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "XdmfMeshWriter.hpp"
+
+/**
+ * Writes the XDMF index for node-wise results which are being written to an HDF5 dataset (by an
+ * Hdf5DataWriter) during a simulation, so that the results can be visualized while the simulation
+ * runs and no conversion is needed afterwards.
+ *
+ * The geometry and topology are written once, by #WriteFilesUsingMesh, with the nodes in the order
+ * of their global indices (which is the row order of the HDF5 dataset).  Each call to #AddTimeStep
+ * then appends a grid which refers to one time step of the dataset (of shape time x node x variable,
+ * as written by Hdf5DataWriter) to the .xdmf master file, which is complete after every call.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class XdmfTimeSeriesWriter : public XdmfMeshWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+    /** The path of the HDF5 dataset, relative to the output directory (e.g. "../results.h5:/Data"). */
+    std::string mDataPath;
+
+    /** The names of the variables in the dataset, in the order in which they are stored. */
+    std::vector<std::string> mVariableNames;
+
+    /** The number of nodes in the mesh (the second dimension of the dataset). */
+    unsigned mNumNodes;
+
+    /** The number of time steps added so far. */
+    unsigned mNumTimeStepsWritten;
+
+    /** Master process only: where the closing tags start in the master file (they are overwritten by the next step). */
+    std::streampos mClosingTagsPosition;
+
+    /**
+     * Write the closing tags of the master file.
+     *
+     * @param rStream  the master file
+     */
+    static void WriteClosingTags(std::ostream& rStream);
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param rDirectory  the directory in which to write the files, relative to CHASTE_TEST_OUTPUT
+     * @param rBaseName  the base name of the files
+     * @param rDataPath  the path of the HDF5 dataset, relative to rDirectory, in XDMF form ("<file>.h5:/<dataset>")
+     * @param rVariableNames  the names of the variables in the dataset, in the order in which they are stored
+     * @param clearOutputDir  whether to clean the directory (defaults to false)
+     */
+    XdmfTimeSeriesWriter(const std::string& rDirectory,
+                         const std::string& rBaseName,
+                         const std::string& rDataPath,
+                         const std::vector<std::string>& rVariableNames,
+                         const bool clearOutputDir=false);
+
+    /**
+     * Write the geometry and topology of the mesh, and start a master file with no time steps.
+     * The whole mesh is written by the master process, in global node order.  Collective.
+     *
+     * @param rMesh the mesh
+     * @param keepOriginalElementIndexing  Whether to write the mesh with the same element ordering.
+     *                                     Must be true in this class.
+     */
+    void WriteFilesUsingMesh(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
+                             bool keepOriginalElementIndexing=true);
+
+    /**
+     * Add a time step to the master file.  Only the master process writes; the data should already
+     * have been written (and flushed) to the HDF5 file.
+     *
+     * @param time  the simulation time of the step
+     * @param timeIndex  the index of the step along the unlimited dimension of the dataset
+     * @param datasetLength  the length of the unlimited dimension of the dataset in the file, which
+     *     may be more than timeIndex+1 if the dataset was created with an estimated length
+     */
+    void AddTimeStep(double time, unsigned timeIndex, unsigned datasetLength);
+
+    /** @return the number of time steps added so far */
+    unsigned GetNumTimeStepsWritten() const;
+};
+
+#endif // XDMFTIMESERIESWRITER_HPP_
@@ -54,6 +54,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 
 #include "RandomNumberGenerator.hpp"
+#include "MeshSetupEventHandler.hpp"
 #include "Warnings.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
@@ -576,6 +577,45 @@ public:
 
     }
 
+    void TestNodeElementRegistrationAndSetupEvents()
+    {
+        MeshSetupEventHandler::Reset();
+
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
+        DistributedTetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        TetrahedralMesh<3,3> seq_mesh;
+        seq_mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Map the (possibly permuted) indices of the distributed mesh back to the original ones
+        std::vector<unsigned> original_index(mesh.GetNumNodes());
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            original_index[mesh.rGetNodePermutation().empty() ? i : mesh.rGetNodePermutation()[i]] = i;
+        }
+
+        // Every element and face touching an owned node is local, so owned nodes know all of them
+        for (AbstractTetrahedralMesh<3,3>::NodeIterator iter = mesh.GetNodeIteratorBegin();
+             iter != mesh.GetNodeIteratorEnd();
+             ++iter)
+        {
+            Node<3>* p_sequ_node = seq_mesh.GetNode(original_index[iter->GetIndex()]);
+            TS_ASSERT(iter->rGetContainingElementIndices() == p_sequ_node->rGetContainingElementIndices());
+            TS_ASSERT(iter->rGetContainingBoundaryElementIndices() == p_sequ_node->rGetContainingBoundaryElementIndices());
+            TS_ASSERT_EQUALS(iter->IsBoundaryNode(), p_sequ_node->IsBoundaryNode());
+        }
+
+        // The set-up phases have been timed
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, MeshSetupEventHandler::GetElapsedTime(MeshSetupEventHandler::PARTITION));
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, MeshSetupEventHandler::GetElapsedTime(MeshSetupEventHandler::NODES));
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, MeshSetupEventHandler::GetElapsedTime(MeshSetupEventHandler::ELEMENTS));
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, MeshSetupEventHandler::GetElapsedTime(MeshSetupEventHandler::BOUNDARY_ELEMENTS));
+        TS_ASSERT_LESS_THAN_EQUALS(0.0, MeshSetupEventHandler::GetElapsedTime(MeshSetupEventHandler::JACOBIANS));
+        MeshSetupEventHandler::Headings();
+        MeshSetupEventHandler::Report();
+    }
+
     void TestConstructionFromMeshReaderWithNodeAttributes()
     {
         TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_2mm_12_elements_with_node_attributes");
@@ -300,6 +300,76 @@ public:
         }
     }
 
+    void TestGeodesicDistances()
+    {
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_21_nodes_side/Cube21"); // 5x5x5mm cube (internode distance = 0.25mm)
+
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        DistributedTetrahedralMesh<3,3> parallel_mesh(DistributedTetrahedralMeshPartitionType::DUMB); // No reordering
+        parallel_mesh.ConstructFromMeshReader(mesh_reader);
+
+        unsigned far_index = 9260u;
+        c_vector<double,3> far_corner = mesh.GetNode(far_index)->rGetLocation();
+        std::vector<unsigned> map_far_corner;
+        map_far_corner.push_back(far_index);
+
+        DistanceMapCalculator<3,3> distance_calculator(mesh);
+        std::vector<double> edge_distances;
+        distance_calculator.ComputeDistanceMap(map_far_corner, edge_distances);
+
+        distance_calculator.SetUseGeodesicDistances();
+        std::vector<double> distances;
+        distance_calculator.ComputeDistanceMap(map_far_corner, distances);
+
+        DistanceMapCalculator<3,3> parallel_distance_calculator(parallel_mesh);
+        parallel_distance_calculator.SetUseGeodesicDistances();
+        std::vector<double> parallel_distances;
+        parallel_distance_calculator.ComputeDistanceMap(map_far_corner, parallel_distances);
+
+        // The fast marching update visits each node once in a convex mesh
+        TS_ASSERT_EQUALS(distance_calculator.mPopCounter, mesh.GetNumNodes());
+
+        double max_edge_error = 0.0;
+        double max_error = 0.0;
+        for (unsigned index=0; index<distances.size(); index++)
+        {
+            double euclidean_distance = norm_2(far_corner - mesh.GetNode(index)->rGetLocation());
+
+            // Between the straight-line distance and the shortest path along edges
+            TS_ASSERT_LESS_THAN_EQUALS(euclidean_distance, distances[index] + 1e-12);
+            TS_ASSERT_LESS_THAN_EQUALS(distances[index], edge_distances[index] + 1e-12);
+            TS_ASSERT_LESS_THAN_EQUALS(euclidean_distance, parallel_distances[index] + 1e-12);
+            TS_ASSERT_LESS_THAN_EQUALS(parallel_distances[index], edge_distances[index] + 1e-12);
+
+            max_edge_error = std::max(max_edge_error, edge_distances[index] - euclidean_distance);
+            max_error = std::max(max_error, distances[index] - euclidean_distance);
+            TS_ASSERT_LESS_THAN(parallel_distances[index] - euclidean_distance, 0.02);
+        }
+        // Along edges the error is up to 0.073mm; across elements it is about 0.010mm
+        TS_ASSERT_LESS_THAN(0.07, max_edge_error);
+        TS_ASSERT_LESS_THAN(max_error, 0.02);
+
+        // Distances from a face are exact
+        std::vector<unsigned> map_left;
+        for (unsigned index=0; index<mesh.GetNumNodes(); index++)
+        {
+            if (mesh.GetNode(index)->rGetLocation()[0] + 0.25 < 1e-6)
+            {
+                map_left.push_back(index);
+            }
+        }
+        distance_calculator.ComputeDistanceMap(map_left, distances);
+        for (unsigned index=0; index<distances.size(); index++)
+        {
+            TS_ASSERT_DELTA(distances[index], mesh.GetNode(index)->rGetLocation()[0] + 0.25, 1e-11);
+        }
+
+        // Point-to-point distances are still along edges
+        TS_ASSERT_DELTA(distance_calculator.SingleDistance(far_index, 0u), edge_distances[0], 1e-15);
+    }
+
     void TestDistancesWithEmptySource()
     {
         TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_21_nodes_side/Cube21"); // 5x5x5mm cube (internode distance = 0.25mm)
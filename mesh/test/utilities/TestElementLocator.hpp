@@ -0,0 +1,220 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTELEMENTLOCATOR_HPP_
+#define TESTELEMENTLOCATOR_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "ElementLocator.hpp"
+#include "TetrahedralMesh.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestElementLocator : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that the locator finds the same element as the linear search in the mesh, for every
+     * node location (which lie in several elements, so exercise the lowest-index rule) and for
+     * random points in a box a little larger than the mesh (so some are outside it).
+     */
+    template<unsigned DIM>
+    void CompareWithMesh(TetrahedralMesh<DIM,DIM>& rMesh, ElementLocator<DIM>& rLocator, unsigned numRandomPoints)
+    {
+        std::vector<ChastePoint<DIM> > points;
+        for (unsigned i=0; i<rMesh.GetNumNodes(); i++)
+        {
+            points.push_back(ChastePoint<DIM>(rMesh.GetNode(i)->rGetLocation()));
+        }
+
+        ChasteCuboid<DIM> bounding_box = rMesh.CalculateBoundingBox();
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned i=0; i<numRandomPoints; i++)
+        {
+            c_vector<double, DIM> location;
+            for (unsigned j=0; j<DIM; j++)
+            {
+                double width = bounding_box.GetWidth(j);
+                location[j] = bounding_box.rGetLowerCorner()[j] - 0.1*width + 1.2*width*p_gen->ranf();
+            }
+            points.push_back(ChastePoint<DIM>(location));
+        }
+
+        unsigned num_outside = 0;
+        for (unsigned i=0; i<points.size(); i++)
+        {
+            for (unsigned strict=0; strict<2; strict++)
+            {
+                bool in_mesh = true;
+                unsigned expected_index = UINT_MAX;
+                try
+                {
+                    expected_index = rMesh.GetContainingElementIndex(points[i], strict==1);
+                }
+                catch (Exception&)
+                {
+                    in_mesh = false;
+                }
+
+                if (in_mesh)
+                {
+                    TS_ASSERT_EQUALS(rLocator.GetContainingElementIndex(points[i], strict==1), expected_index);
+                }
+                else
+                {
+                    TS_ASSERT_THROWS_CONTAINS(rLocator.GetContainingElementIndex(points[i], strict==1), "is not in mesh - all elements tested");
+                    if (strict == 0)
+                    {
+                        num_outside++;
+                    }
+                }
+            }
+        }
+
+        // Make sure the random points did test the outside of the mesh
+        TS_ASSERT_LESS_THAN(0u, num_outside);
+    }
+
+public:
+
+    void TestLocate1d()
+    {
+        TrianglesMeshReader<1,1> mesh_reader("mesh/test/data/1D_0_to_1_100_elements");
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        ElementLocator<1> locator(mesh);
+        TS_ASSERT_EQUALS(locator.GetNumElements(), 100u);
+
+        // 100 elements, at most 8 per leaf, split in half each time
+        TS_ASSERT_EQUALS(locator.GetDepth(), 5u);
+
+        CompareWithMesh<1>(mesh, locator, 200);
+
+        ChastePoint<1> outside(-0.5);
+        TS_ASSERT_THROWS_THIS(locator.GetContainingElementIndex(outside),
+                              "Point [-0.5] is not in mesh - all elements tested");
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(outside), 0u);
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(ChastePoint<1>(1.5)), 99u);
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(ChastePoint<1>(0.505)), mesh.GetContainingElementIndex(ChastePoint<1>(0.505)));
+    }
+
+    void TestLocate2d()
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Leaves of a single element make the tree as deep as it gets
+        ElementLocator<2> locator(mesh, 1);
+        TS_ASSERT_EQUALS(locator.GetNumElements(), 128u);
+        TS_ASSERT_EQUALS(locator.GetDepth(), 8u);
+
+        CompareWithMesh<2>(mesh, locator, 1000);
+
+        // The nearest element agrees with the search over the whole mesh
+        ChastePoint<2> outside(1.2, 0.53);
+        TS_ASSERT_THROWS_THIS(locator.GetContainingElementIndex(outside),
+                              "Point [1.2,0.53] is not in mesh - all elements tested");
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(outside), mesh.GetNearestElementIndex(outside));
+        ChastePoint<2> below(0.31, -0.05);
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(below), mesh.GetNearestElementIndex(below));
+    }
+
+    void TestLocate3d()
+    {
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0, 0.5, 0.3);
+
+        ElementLocator<3> locator(mesh);
+        TS_ASSERT_EQUALS(locator.GetNumElements(), mesh.GetNumElements());
+
+        CompareWithMesh<3>(mesh, locator, 2000);
+
+        ChastePoint<3> outside(0.52, 0.27, 0.4);
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(outside), mesh.GetNearestElementIndex(outside));
+        ChastePoint<3> inside(0.52, 0.27, 0.13);
+        TS_ASSERT_EQUALS(locator.GetNearestElementIndex(inside), mesh.GetContainingElementIndex(inside));
+    }
+
+    void TestNearestElementOnGradedMesh()
+    {
+        /*
+         * Grade a regular mesh strongly towards one corner, so that elements near the corner are
+         * tiny and those far from it are long and thin, and check that the nearest element to each
+         * of a set of points in and around the mesh agrees with the linear search.
+         */
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.05, 1.0, 1.0);
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            c_vector<double, 2>& r_location = mesh.GetNode(i)->rGetModifiableLocation();
+            r_location[0] = pow(r_location[0], 4);
+            r_location[1] = 0.1*pow(r_location[1], 3);
+        }
+        mesh.RefreshMesh();
+
+        ElementLocator<2> locator(mesh, 2);
+
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned i=0; i<500; i++)
+        {
+            // Points on a ring around the mesh, some near and some far from it
+            double angle = 2.0*M_PI*p_gen->ranf();
+            double radius = 0.001 + 2.0*pow(p_gen->ranf(), 3);
+            ChastePoint<2> point(0.5 + (0.5 + radius)*cos(angle), 0.05 + (0.05 + radius)*sin(angle));
+            TS_ASSERT_EQUALS(locator.GetNearestElementIndex(point), mesh.GetNearestElementIndex(point));
+        }
+    }
+
+    void TestEmptyMesh()
+    {
+        TetrahedralMesh<2,2> mesh;
+        ElementLocator<2> locator(mesh);
+        TS_ASSERT_EQUALS(locator.GetNumElements(), 0u);
+        TS_ASSERT_EQUALS(locator.GetDepth(), 0u);
+
+        ChastePoint<2> point(0.0, 0.0);
+        TS_ASSERT_THROWS_THIS(locator.GetContainingElementIndex(point),
+                              "Point [0,0] is not in mesh - all elements tested");
+        TS_ASSERT_THROWS_THIS(locator.GetNearestElementIndex(point),
+                              "Point [0,0] is not in mesh - all elements tested");
+    }
+};
+
+#endif /*TESTELEMENTLOCATOR_HPP_*/
@@ -45,6 +45,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexMeshWriter.hpp"
 #include "MutableVertexMesh.hpp"
 #include "HoneycombVertexMeshGenerator.hpp"
+#include "ToroidalHoneycombVertexMeshGenerator.hpp"
+#include "VertexElementBoundingBoxGrid.hpp"
 #include "ArchiveOpener.hpp"
 
 //This test is always run sequentially (never in parallel)
@@ -1821,6 +1823,57 @@ public:
         TS_ASSERT_EQUALS(new_distance, 10.0);
     }
 
+    void TestVertexElementBoundingBoxGrid()
+    {
+        HoneycombVertexMeshGenerator mesh_generator(6, 6);
+        MutableVertexMesh<2,2>* p_mesh = mesh_generator.GetMesh();
+
+        std::vector<unsigned> element_indices;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            element_indices.push_back(elem_index);
+        }
+
+        VertexElementBoundingBoxGrid<2,2> grid;
+        TS_ASSERT_EQUALS(grid.Build(*p_mesh, std::vector<unsigned>()), false);
+        TS_ASSERT_EQUALS(grid.Build(*p_mesh, element_indices), true);
+
+        // Every element containing a test point is a candidate, and candidates are in ascending order
+        std::vector<unsigned> candidates;
+        for (unsigned i=0; i<=20; i++)
+        {
+            for (unsigned j=0; j<=20; j++)
+            {
+                c_vector<double, 2> point;
+                point[0] = 0.3*i - 0.5;
+                point[1] = 0.3*j - 0.5;
+
+                grid.GetCandidateElements(point, candidates);
+                TS_ASSERT(std::is_sorted(candidates.begin(), candidates.end()));
+                TS_ASSERT_LESS_THAN(candidates.size(), 5u);
+
+                for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+                {
+                    if (p_mesh->ElementIncludesPoint(point, elem_index))
+                    {
+                        TS_ASSERT(std::find(candidates.begin(), candidates.end(), elem_index) != candidates.end());
+                    }
+                }
+            }
+        }
+
+        // The grid cannot be used on a periodic mesh spanning the whole period
+        ToroidalHoneycombVertexMeshGenerator toroidal_generator(4, 4);
+        Toroidal2dVertexMesh* p_toroidal_mesh = toroidal_generator.GetToroidalMesh();
+
+        std::vector<unsigned> toroidal_element_indices;
+        for (unsigned elem_index=0; elem_index<p_toroidal_mesh->GetNumElements(); elem_index++)
+        {
+            toroidal_element_indices.push_back(elem_index);
+        }
+        TS_ASSERT_EQUALS(grid.Build(*p_toroidal_mesh, toroidal_element_indices), false);
+    }
+
     void TestHandleHighOrderJunctions()
     {
         //\todo need to re-implement this
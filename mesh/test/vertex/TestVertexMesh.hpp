@@ -46,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexMesh.hpp"
 #include "ArchiveOpener.hpp"
 #include "MutableMesh.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
 //This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
 
@@ -1375,6 +1376,68 @@ public:
         TS_ASSERT_DELTA(element_perimeter_gradient[1], 1.0, 1e-6);
     }
 
+    void TestCacheElementGeometry()
+    {
+        // Create a small honeycomb mesh and perturb its nodes so that the elements are irregular
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2>& r_location = p_mesh->GetNode(node_index)->rGetModifiableLocation();
+            r_location[0] += 0.01*(node_index%3);
+            r_location[1] -= 0.02*(node_index%5);
+        }
+
+        // Store the uncached geometry
+        TS_ASSERT_EQUALS(p_mesh->IsElementGeometryCached(), false);
+        std::vector<double> areas;
+        std::vector<double> perimeters;
+        std::vector<double> edge_lengths;
+        std::vector<c_vector<double, 2> > perimeter_gradients;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = p_mesh->GetElement(elem_index);
+            areas.push_back(p_mesh->GetVolumeOfElement(elem_index));
+            perimeters.push_back(p_mesh->GetSurfaceAreaOfElement(elem_index));
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                edge_lengths.push_back(p_mesh->GetLengthOfElementEdge(p_element, local_index));
+                perimeter_gradients.push_back(p_mesh->GetPerimeterGradientOfElementAtNode(p_element, local_index));
+            }
+        }
+
+        // The cached geometry should agree with the uncached geometry
+        p_mesh->CacheElementGeometry();
+        TS_ASSERT_EQUALS(p_mesh->IsElementGeometryCached(), true);
+        unsigned edge_count = 0;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = p_mesh->GetElement(elem_index);
+            TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(elem_index), areas[elem_index], 1e-12);
+            TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(elem_index), perimeters[elem_index], 1e-12);
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                TS_ASSERT_DELTA(p_mesh->GetLengthOfElementEdge(p_element, local_index), edge_lengths[edge_count], 1e-12);
+
+                c_vector<double, 2> gradient = p_mesh->GetPerimeterGradientOfElementAtNode(p_element, local_index);
+                TS_ASSERT_DELTA(gradient[0], perimeter_gradients[edge_count][0], 1e-12);
+                TS_ASSERT_DELTA(gradient[1], perimeter_gradients[edge_count][1], 1e-12);
+                edge_count++;
+            }
+        }
+        TS_ASSERT_EQUALS(edge_count, edge_lengths.size());
+
+        // Test that the cache may be cleared explicitly
+        p_mesh->ClearElementGeometryCache();
+        TS_ASSERT_EQUALS(p_mesh->IsElementGeometryCached(), false);
+
+        // Test that any change to the mesh connectivity clears the cache
+        p_mesh->CacheElementGeometry();
+        p_mesh->DivideEdge(p_mesh->GetElement(0)->GetNode(0), p_mesh->GetElement(0)->GetNode(1));
+        TS_ASSERT_EQUALS(p_mesh->IsElementGeometryCached(), false);
+        TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(0), areas[0], 1e-12);
+    }
+
     void TestMeshGetWidthAndBoundingBoxMethod()
     {
         // Test method with a regular mesh with hexagonal elements of edge length 1/sqrt(3.0)
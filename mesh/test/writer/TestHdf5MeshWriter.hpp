@@ -0,0 +1,180 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTHDF5MESHWRITER_HPP_
+#define _TESTHDF5MESHWRITER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "Hdf5MeshWriter.hpp"
+#include "Hdf5MeshReader.hpp"
+#include "GenericMeshReader.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "TetrahedralMesh.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestHdf5MeshWriter : public CxxTest::TestSuite
+{
+public:
+
+    void TestWriteFromReaderAndReadBack()
+    {
+        TrianglesMeshReader<3,3> triangles_reader("mesh/test/data/cube_136_elements");
+        Hdf5MeshWriter<3,3> writer("TestHdf5MeshWriter", "cube_136_elements");
+        writer.WriteFilesUsingMeshReader(triangles_reader);
+        PetscTools::Barrier("TestWriteFromReaderAndReadBack");
+
+        OutputFileHandler handler("TestHdf5MeshWriter", false);
+        Hdf5MeshReader<3,3> reader(handler.GetOutputDirectoryFullPath() + "cube_136_elements");
+        triangles_reader.Reset();
+
+        TS_ASSERT_EQUALS(reader.GetNumNodes(), triangles_reader.GetNumNodes());
+        TS_ASSERT_EQUALS(reader.GetNumElements(), triangles_reader.GetNumElements());
+        TS_ASSERT_EQUALS(reader.GetNumFaces(), triangles_reader.GetNumFaces());
+        TS_ASSERT_EQUALS(reader.GetOrderOfElements(), 1u);
+        TS_ASSERT_EQUALS(reader.IsFileFormatBinary(), true);
+        TS_ASSERT_EQUALS(reader.HasNodePermutation(), false);
+
+        std::vector<std::vector<double> > expected_nodes;
+        std::vector<ElementData> expected_elements;
+        std::vector<ElementData> expected_faces;
+        for (unsigned i=0; i<reader.GetNumNodes(); i++)
+        {
+            std::vector<double> expected = triangles_reader.GetNextNode();
+            expected_nodes.push_back(expected);
+            std::vector<double> node = reader.GetNextNode();
+            TS_ASSERT_EQUALS(node.size(), 3u);
+            for (unsigned j=0; j<3; j++)
+            {
+                TS_ASSERT_DELTA(node[j], expected[j], 1e-12);
+            }
+        }
+        for (unsigned i=0; i<reader.GetNumElements(); i++)
+        {
+            ElementData expected = triangles_reader.GetNextElementData();
+            expected_elements.push_back(expected);
+            ElementData element = reader.GetNextElementData();
+            TS_ASSERT_EQUALS(element.NodeIndices, expected.NodeIndices);
+        }
+        for (unsigned i=0; i<reader.GetNumFaces(); i++)
+        {
+            ElementData expected = triangles_reader.GetNextFaceData();
+            expected_faces.push_back(expected);
+            ElementData face = reader.GetNextFaceData();
+            TS_ASSERT_EQUALS(face.NodeIndices, expected.NodeIndices);
+        }
+        TS_ASSERT_THROWS_CONTAINS(reader.GetNextNode(), "is beyond the end of dataset 'Nodes'");
+
+        // Random access moves the sequential read position
+        TS_ASSERT_EQUALS(reader.GetElementData(100).NodeIndices, expected_elements[100].NodeIndices);
+        TS_ASSERT_EQUALS(reader.GetNextElementData().NodeIndices, expected_elements[101].NodeIndices);
+        TS_ASSERT_EQUALS(reader.GetElementData(3).NodeIndices, expected_elements[3].NodeIndices);
+        TS_ASSERT_DELTA(reader.GetNode(17)[2], expected_nodes[17][2], 1e-12);
+        TS_ASSERT_EQUALS(reader.GetFaceData(5).NodeIndices, expected_faces[5].NodeIndices);
+
+        reader.Reset();
+        TS_ASSERT_EQUALS(reader.GetNextFaceData().NodeIndices, expected_faces[0].NodeIndices);
+    }
+
+    void TestWriteParallelMeshAndReconstruct()
+    {
+        TrianglesMeshReader<2,2> triangles_reader("mesh/test/data/disk_984_elements");
+        DistributedTetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(triangles_reader);
+
+        // Element attributes survive the round trip
+        for (AbstractTetrahedralMesh<2,2>::ElementIterator iter = mesh.GetElementIteratorBegin();
+             iter != mesh.GetElementIteratorEnd();
+             ++iter)
+        {
+            iter->SetAttribute(iter->GetIndex() % 3);
+        }
+
+        Hdf5MeshWriter<2,2> writer("TestHdf5MeshWriter", "disk_984_elements", false);
+        writer.WriteFilesUsingMesh(mesh);
+
+        OutputFileHandler handler("TestHdf5MeshWriter", false);
+        std::string base_name = handler.GetOutputDirectoryFullPath() + "disk_984_elements";
+        std::shared_ptr<AbstractMeshReader<2,2> > p_reader = GenericMeshReader<2,2>(base_name);
+        TS_ASSERT((std::dynamic_pointer_cast<Hdf5MeshReader<2,2> >(p_reader)));
+        TS_ASSERT_EQUALS(p_reader->GetNumElementAttributes(), 1u);
+
+        TetrahedralMesh<2,2> mesh_from_file;
+        mesh_from_file.ConstructFromMeshReader(*p_reader);
+        TS_ASSERT_EQUALS(mesh_from_file.GetNumNodes(), mesh.GetNumNodes());
+        TS_ASSERT_EQUALS(mesh_from_file.GetNumElements(), mesh.GetNumElements());
+        TS_ASSERT_EQUALS(mesh_from_file.GetNumBoundaryElements(), mesh.GetNumBoundaryElements());
+        TetrahedralMesh<2,2> original_mesh;
+        triangles_reader.Reset();
+        original_mesh.ConstructFromMeshReader(triangles_reader);
+        TS_ASSERT_DELTA(mesh_from_file.GetVolume(), original_mesh.GetVolume(), 1e-12);
+
+        // The file is in the mesh's (possibly permuted) numbering
+        for (AbstractMesh<2,2>::NodeIterator iter = mesh.GetNodeIteratorBegin();
+             iter != mesh.GetNodeIteratorEnd();
+             ++iter)
+        {
+            c_vector<double, 2> location = mesh_from_file.GetNode(iter->GetIndex())->rGetLocation();
+            TS_ASSERT_DELTA(location[0], iter->rGetLocation()[0], 1e-12);
+            TS_ASSERT_DELTA(location[1], iter->rGetLocation()[1], 1e-12);
+        }
+        for (AbstractTetrahedralMesh<2,2>::ElementIterator iter = mesh.GetElementIteratorBegin();
+             iter != mesh.GetElementIteratorEnd();
+             ++iter)
+        {
+            TS_ASSERT_DELTA(mesh_from_file.GetElement(iter->GetIndex())->GetAttribute(), iter->GetIndex() % 3, 1e-12);
+        }
+
+        // Any permutation is stored, and only reported if asked for
+        Hdf5MeshReader<2,2> permuted_reader(base_name, true);
+        TS_ASSERT_EQUALS(permuted_reader.HasNodePermutation(), !mesh.rGetNodePermutation().empty());
+        TS_ASSERT_EQUALS(permuted_reader.rGetNodePermutation(), mesh.rGetNodePermutation());
+    }
+
+    void TestExceptions()
+    {
+        TS_ASSERT_THROWS_THIS((Hdf5MeshReader<2,2>("mesh/test/data/no_such_file")),
+                              "Could not open data file: mesh/test/data/no_such_file.h5");
+
+        // The file written above holds a 3d mesh
+        OutputFileHandler handler("TestHdf5MeshWriter", false);
+        std::string base_name = handler.GetOutputDirectoryFullPath() + "cube_136_elements";
+        TS_ASSERT_THROWS_CONTAINS((Hdf5MeshReader<2,2>(base_name)), "Space dimension of mesh file");
+        TS_ASSERT_THROWS_CONTAINS((Hdf5MeshReader<2,3>(base_name)), "which does not match the element dimension 2");
+    }
+};
+
+#endif /*_TESTHDF5MESHWRITER_HPP_*/
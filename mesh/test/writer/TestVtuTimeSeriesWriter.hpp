@@ -0,0 +1,176 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTVTUTIMESERIESWRITER_HPP_
+#define _TESTVTUTIMESERIESWRITER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "VtuTimeSeriesWriter.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestVtuTimeSeriesWriter : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Read the appended data blocks of a .vtu file written by VtuTimeSeriesWriter.
+     *
+     * @param rFileName  the full path of the file
+     * @param rHeader  filled with the XML before the appended data
+     * @return the blocks (without their UInt64 length headers)
+     */
+    std::vector<std::string> ReadAppendedBlocks(const std::string& rFileName, std::string& rHeader)
+    {
+        std::ifstream file(rFileName.c_str(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::string::size_type start = contents.find("<AppendedData encoding=\"raw\">");
+        start = contents.find('_', start) + 1;
+        rHeader = contents.substr(0, start);
+
+        std::vector<std::string> blocks;
+        std::string::size_type end = contents.find("\n  </AppendedData>", start);
+        while (start < end)
+        {
+            unsigned long long num_bytes;
+            memcpy(&num_bytes, contents.data() + start, sizeof(num_bytes));
+            start += sizeof(num_bytes);
+            blocks.push_back(contents.substr(start, num_bytes));
+            start += num_bytes;
+        }
+        return blocks;
+    }
+
+public:
+
+    void TestWriteTimeSeries()
+    {
+        TrianglesMeshReader<2,2> reader("mesh/test/data/2D_0_to_1mm_200_elements");
+        DistributedTetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(reader);
+
+        VtuTimeSeriesWriter<2,2> writer("TestVtuTimeSeriesWriter", "series", mesh, true);
+        TS_ASSERT_EQUALS(writer.GetCollectionFileName(), "series.pvd");
+
+        // Write the x coordinate, and then twice it, at the nodes owned by this process
+        DistributedVectorFactory* p_factory = mesh.GetDistributedVectorFactory();
+        std::vector<double> x;
+        for (unsigned index=p_factory->GetLow(); index<p_factory->GetHigh(); index++)
+        {
+            x.push_back(mesh.GetNode(index)->rGetLocation()[0]);
+        }
+        std::vector<double> two_x(x);
+        for (unsigned i=0; i<two_x.size(); i++)
+        {
+            two_x[i] *= 2.0;
+        }
+        writer.AddPointData("x", x);
+        writer.AddPointData("two_x", two_x);
+        writer.WriteTimeStep(0.0);
+        writer.AddPointData("x", x);
+        writer.AddPointData("two_x", two_x);
+        writer.WriteTimeStep(0.25);
+        TS_ASSERT_EQUALS(writer.GetNumTimeStepsWritten(), 2u);
+
+        // Every time step must have the same fields
+        writer.AddPointData("x", x);
+        TS_ASSERT_THROWS_THIS(writer.WriteTimeStep(0.5), "Every time step must have the same point data as the first one.");
+        std::stringstream message;
+        message << "Point data 'x' has " << x.size()+1 << " values, but this process owns " << x.size() << " nodes.";
+        TS_ASSERT_THROWS_THIS(writer.AddPointData("x", std::vector<double>(x.size()+1)), message.str());
+
+        // Each process's piece holds the points of its elements, including those owned by other processes
+        PetscTools::Barrier("TestWriteTimeSeries");
+        OutputFileHandler handler("TestVtuTimeSeriesWriter", false);
+        std::stringstream piece_name;
+        piece_name << "series_000000_" << PetscTools::GetMyRank() << ".vtu";
+        std::string header;
+        std::vector<std::string> blocks = ReadAppendedBlocks(handler.FindFile(piece_name.str()).GetAbsolutePath(), header);
+
+        // Points, connectivity, offsets, types, x and two_x
+        TS_ASSERT_EQUALS(blocks.size(), 6u);
+        unsigned num_points = blocks[0].size()/(3*sizeof(double));
+        unsigned num_cells = blocks[3].size();
+        TS_ASSERT_LESS_THAN_EQUALS(x.size(), num_points);
+        TS_ASSERT_EQUALS(blocks[1].size(), 3*num_cells*sizeof(long long));
+        TS_ASSERT_EQUALS(blocks[4].size(), num_points*sizeof(double));
+        std::stringstream piece_header;
+        piece_header << "<Piece NumberOfPoints=\"" << num_points << "\" NumberOfCells=\"" << num_cells << "\">";
+        TS_ASSERT_DIFFERS(header.find(piece_header.str()), std::string::npos);
+
+        const double* p_points = reinterpret_cast<const double*>(blocks[0].data());
+        const double* p_x = reinterpret_cast<const double*>(blocks[4].data());
+        const double* p_two_x = reinterpret_cast<const double*>(blocks[5].data());
+        for (unsigned i=0; i<num_points; i++)
+        {
+            TS_ASSERT_DELTA(p_x[i], p_points[3*i], 1e-12);
+            TS_ASSERT_DELTA(p_two_x[i], 2.0*p_points[3*i], 1e-12);
+            TS_ASSERT_DELTA(p_points[3*i+2], 0.0, 1e-12);
+        }
+        const unsigned char* p_types = reinterpret_cast<const unsigned char*>(blocks[3].data());
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            TS_ASSERT_EQUALS(p_types[i], 5u); // VTK_TRIANGLE
+        }
+
+        // Each element is written by exactly one process
+        unsigned total_num_cells;
+        MPI_Allreduce(&num_cells, &total_num_cells, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_cells, mesh.GetNumElements());
+
+        // The master writes the parallel files and the collection
+        if (PetscTools::AmMaster())
+        {
+            std::ifstream pvd(handler.FindFile("series.pvd").GetAbsolutePath().c_str());
+            std::string contents((std::istreambuf_iterator<char>(pvd)), std::istreambuf_iterator<char>());
+            TS_ASSERT_DIFFERS(contents.find("<DataSet timestep=\"0\" group=\"\" part=\"0\" file=\"series_000000.pvtu\"/>"), std::string::npos);
+            TS_ASSERT_DIFFERS(contents.find("<DataSet timestep=\"0.25\" group=\"\" part=\"0\" file=\"series_000001.pvtu\"/>"), std::string::npos);
+
+            std::ifstream pvtu(handler.FindFile("series_000001.pvtu").GetAbsolutePath().c_str());
+            std::string pvtu_contents((std::istreambuf_iterator<char>(pvtu)), std::istreambuf_iterator<char>());
+            TS_ASSERT_DIFFERS(pvtu_contents.find("<PDataArray type=\"Float64\" Name=\"two_x\"/>"), std::string::npos);
+            std::stringstream last_piece;
+            last_piece << "<Piece Source=\"series_000001_" << PetscTools::GetNumProcs()-1 << ".vtu\"/>";
+            TS_ASSERT_DIFFERS(pvtu_contents.find(last_piece.str()), std::string::npos);
+        }
+    }
+};
+
+#endif /*_TESTVTUTIMESERIESWRITER_HPP_*/
@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TetrahedralMesh.hpp"
 #include "VtkMeshWriter.hpp"
 #include "XdmfMeshWriter.hpp"
+#include "XdmfTimeSeriesWriter.hpp"
 #include "DistributedTetrahedralMesh.hpp"
 #include "MixedDimensionMesh.hpp"
 #include "QuadraticMesh.hpp"
@@ -965,6 +966,59 @@ public:
         }
 #endif // _MSC_VER
      }
+
+    void TestXdmfTimeSeriesWriter()
+    {
+#ifndef _MSC_VER
+        TrianglesMeshReader<3,3> reader("mesh/test/data/simple_cube");
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(reader);
+
+        std::vector<std::string> variable_names;
+        variable_names.push_back("V");
+        variable_names.push_back("Phi_e");
+        XdmfTimeSeriesWriter<3,3> writer("TestXdmfMeshWriter", "simple_cube_series", "../results.h5:/Data", variable_names);
+        TS_ASSERT_THROWS_THIS(writer.AddTimeStep(0.0, 0u, 5u), "The mesh must be written before time steps are added.");
+        writer.WriteFilesUsingMesh(mesh);
+
+        // The mesh is written by the master, in the same way as for a mesh reader
+        FileComparison(OutputFileHandler::GetChasteTestOutputDirectory() + "TestXdmfMeshWriter/simple_cube_series_geometry_0.xml",
+                       "mesh/test/data/TestXdmfMeshWriter/simple_cube_geometry_0.xml").CompareFiles();
+        FileComparison(OutputFileHandler::GetChasteTestOutputDirectory() + "TestXdmfMeshWriter/simple_cube_series_topology_0.xml",
+                       "mesh/test/data/TestXdmfMeshWriter/simple_cube_topology_0.xml").CompareFiles();
+
+        // The master file is complete after each step
+        FileFinder master_file("TestXdmfMeshWriter/simple_cube_series.xdmf", RelativeTo::ChasteTestOutput);
+        for (unsigned step=0; step<3; step++)
+        {
+            writer.AddTimeStep(0.5*step, step+1, 5u);
+            TS_ASSERT_EQUALS(writer.GetNumTimeStepsWritten(), step+1);
+            PetscTools::Barrier("TestXdmfTimeSeriesWriter");
+
+            std::ifstream file(master_file.GetAbsolutePath().c_str());
+            std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            TS_ASSERT_EQUALS(contents.substr(contents.size()-46), "      </Grid>\n    </Grid>\n  </Domain>\n</Xdmf>\n");
+            TS_ASSERT_EQUALS(contents.find("<Grid GridType=\"Uniform\" Name=\"Chunk_0\">"), contents.rfind("<Grid GridType=\"Uniform\" Name=\"Chunk_0\">"));
+            TS_ASSERT_DIFFERS(contents.find("<xi:include href=\"simple_cube_series_geometry_0.xml\"/>"), std::string::npos);
+
+            // Each step selects its row of the dataset for each variable
+            std::stringstream time_value;
+            time_value << "<Time Value=\"" << 0.5*step << "\"/>";
+            TS_ASSERT_DIFFERS(contents.find(time_value.str()), std::string::npos);
+            std::stringstream phi_e_selection;
+            phi_e_selection << "<DataItem Dimensions=\"3 3\" Format=\"XML\">" << step+1 << " 0 1 1 1 1 1 " << mesh.GetNumNodes() << " 1</DataItem>";
+            TS_ASSERT_DIFFERS(contents.find(phi_e_selection.str()), std::string::npos);
+            // The whole dataset is declared with its length in the file, not the number of steps so far
+            std::stringstream dataset;
+            dataset << "<DataItem Dimensions=\"5 " << mesh.GetNumNodes()
+                    << " 2\" Format=\"HDF\" NumberType=\"Float\" Precision=\"8\">../results.h5:/Data</DataItem>";
+            TS_ASSERT_DIFFERS(contents.find(dataset.str()), std::string::npos);
+            PetscTools::Barrier("TestXdmfTimeSeriesWriter");
+        }
+
+        TS_ASSERT_THROWS_THIS(writer.WriteFilesUsingMesh(mesh), "The mesh must be written before any time steps are added.");
+#endif // _MSC_VER
+    }
 };
 
 #endif //_TESTXMLMESHWRITERS_HPP_
@@ -46,6 +46,29 @@ AbstractOdeSystem::~AbstractOdeSystem()
 {
 }
 
+void AbstractOdeSystem::EvaluateYDerivativesBatch(double time,
+                                                  const std::vector<AbstractOdeSystem*>& rSystems,
+                                                  const double* pY,
+                                                  const double* pParameters,
+                                                  double* pDY)
+{
+    const unsigned batch_size = rSystems.size();
+    std::vector<double> y(mNumberOfStateVariables);
+    std::vector<double> dy(mNumberOfStateVariables);
+    for (unsigned i=0; i<batch_size; i++)
+    {
+        for (unsigned j=0; j<mNumberOfStateVariables; j++)
+        {
+            y[j] = pY[j*batch_size + i];
+        }
+        rSystems[i]->EvaluateYDerivatives(time, y, dy);
+        for (unsigned j=0; j<mNumberOfStateVariables; j++)
+        {
+            pDY[j*batch_size + i] = dy[j];
+        }
+    }
+}
+
 bool AbstractOdeSystem::CalculateStoppingEvent(double time, const std::vector<double>& rY)
 {
     return false;
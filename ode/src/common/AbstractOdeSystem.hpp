@@ -177,6 +177,29 @@ public:
     virtual void EvaluateYDerivatives(double time, const std::vector<double>& rY,
                                       std::vector<double>& rDY)=0;
 
+    /**
+     * Method to evaluate the derivatives of a batch of systems of the same type
+     * as this one, as used by RungeKutta4BatchOdeSolver. This is called on one
+     * member of the batch. The state variables, parameters and derivatives are
+     * stored as structures of arrays: for a batch of size N, entry j*N+i holds
+     * variable (or parameter) j of system i.
+     *
+     * The default implementation calls EvaluateYDerivatives() on each system in
+     * turn. Subclasses may override it with a loop over the batch that the
+     * compiler can vectorise, reading the parameters from pParameters.
+     *
+     * @param time  the current time
+     * @param rSystems  the systems in the batch
+     * @param pY  the current values of the state variables of the batch
+     * @param pParameters  the parameters of the batch
+     * @param pDY  storage for the derivatives of the batch; will be filled in on return
+     */
+    virtual void EvaluateYDerivativesBatch(double time,
+                                           const std::vector<AbstractOdeSystem*>& rSystems,
+                                           const double* pY,
+                                           const double* pParameters,
+                                           double* pDY);
+
     /**
      * CalculateStoppingEvent() - can be overloaded if the ODE is to be solved
      * only until a particular event (for example, only until the y value becomes
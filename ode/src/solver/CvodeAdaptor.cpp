@@ -595,6 +595,11 @@ void CvodeAdaptor::CheckForStoppingEvents()
     mCheckForRoots = true;
 }
 
+bool CvodeAdaptor::GetCheckForStoppingEvents()
+{
+    return mCheckForRoots;
+}
+
 void CvodeAdaptor::SetMaxSteps(long int numSteps)
 {
     mMaxSteps = numSteps;
@@ -316,6 +316,12 @@ public:
      */
     void CheckForStoppingEvents();
 
+    /**
+     * @return whether the solver checks for stopping events using CVODE's
+     * rootfinding functionality (see CheckForStoppingEvents()).
+     */
+    bool GetCheckForStoppingEvents();
+
     /**
      * Change the maximum number of steps to be taken by the solver
      * in its attempt to reach the next output time.  Default is 500.
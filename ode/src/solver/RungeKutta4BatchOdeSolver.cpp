@@ -0,0 +1,174 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "RungeKutta4BatchOdeSolver.hpp"
+#include "Exception.hpp"
+#include "TimeStepper.hpp"
+
+void RungeKutta4BatchOdeSolver::SolveAndUpdateStateVariables(const std::vector<AbstractOdeSystem*>& rSystems,
+                                                             double startTime,
+                                                             double endTime,
+                                                             double timeStep)
+{
+    assert(endTime > startTime);
+    assert(timeStep > 0.0);
+
+    const unsigned batch_size = rSystems.size();
+    mStoppingEventOccurred.assign(batch_size, 0);
+    mStoppingTimes.assign(batch_size, DOUBLE_UNSET);
+    if (batch_size == 0)
+    {
+        return;
+    }
+
+    AbstractOdeSystem* p_first_system = rSystems[0];
+    const unsigned num_equations = p_first_system->GetNumberOfStateVariables();
+    const unsigned num_parameters = p_first_system->GetNumberOfParameters();
+    const unsigned size = num_equations*batch_size;
+
+    mY.resize(size);
+    mK1.resize(size);
+    mK2.resize(size);
+    mK3.resize(size);
+    mYki.resize(size);
+    mDy.resize(size);
+    mParameters.resize(num_parameters*batch_size);
+
+    // Gather the state variables and parameters of each system
+    for (unsigned i=0; i<batch_size; i++)
+    {
+        const std::vector<double>& r_y = rSystems[i]->rGetStateVariables();
+        if (r_y.size() != num_equations)
+        {
+            EXCEPTION("SolveAndUpdateStateVariables() called but the state variable vector in the ODE system is not set up");
+        }
+        if (rSystems[i]->CalculateStoppingEvent(startTime, r_y) == true)
+        {
+            EXCEPTION("(Solve without sampling) Stopping event is true for initial condition");
+        }
+        for (unsigned j=0; j<num_equations; j++)
+        {
+            mY[j*batch_size + i] = r_y[j];
+        }
+        for (unsigned p=0; p<num_parameters; p++)
+        {
+            mParameters[p*batch_size + i] = rSystems[i]->GetParameter(p);
+        }
+    }
+
+    unsigned num_stopped = 0;
+    mSingleY.resize(num_equations);
+
+    TimeStepper stepper(startTime, endTime, timeStep);
+    while (!stepper.IsTimeAtEnd() && num_stopped < batch_size)
+    {
+        const double dt = stepper.GetNextTimeStep();
+        const double time = stepper.GetTime();
+
+        // The arithmetic below matches RungeKutta4IvpOdeSolver::CalculateNextYValue() exactly
+        p_first_system->EvaluateYDerivativesBatch(time, rSystems, &mY[0], mParameters.empty() ? nullptr : &mParameters[0], &mDy[0]);
+        for (unsigned k=0; k<size; k++)
+        {
+            mK1[k] = dt*mDy[k];
+            mYki[k] = mY[k] + 0.5*mK1[k];
+        }
+
+        p_first_system->EvaluateYDerivativesBatch(time+0.5*dt, rSystems, &mYki[0], mParameters.empty() ? nullptr : &mParameters[0], &mDy[0]);
+        for (unsigned k=0; k<size; k++)
+        {
+            mK2[k] = dt*mDy[k];
+            mYki[k] = mY[k] + 0.5*mK2[k];
+        }
+
+        p_first_system->EvaluateYDerivativesBatch(time+0.5*dt, rSystems, &mYki[0], mParameters.empty() ? nullptr : &mParameters[0], &mDy[0]);
+        for (unsigned k=0; k<size; k++)
+        {
+            mK3[k] = dt*mDy[k];
+            mYki[k] = mY[k] + mK3[k];
+        }
+
+        p_first_system->EvaluateYDerivativesBatch(time+dt, rSystems, &mYki[0], mParameters.empty() ? nullptr : &mParameters[0], &mDy[0]);
+        for (unsigned k=0; k<size; k++)
+        {
+            mY[k] += (mK1[k]+2*mK2[k]+2*mK3[k]+dt*mDy[k])/6.0;
+        }
+
+        stepper.AdvanceOneTimeStep();
+
+        // Systems whose stopping event occurs keep the state reached at this time
+        for (unsigned i=0; i<batch_size; i++)
+        {
+            if (!mStoppingEventOccurred[i])
+            {
+                for (unsigned j=0; j<num_equations; j++)
+                {
+                    mSingleY[j] = mY[j*batch_size + i];
+                }
+                if (rSystems[i]->CalculateStoppingEvent(stepper.GetTime(), mSingleY) == true)
+                {
+                    rSystems[i]->SetStateVariables(mSingleY);
+                    mStoppingTimes[i] = stepper.GetTime();
+                    mStoppingEventOccurred[i] = 1;
+                    num_stopped++;
+                }
+            }
+        }
+    }
+
+    // Scatter the results back to the systems that ran to the end
+    for (unsigned i=0; i<batch_size; i++)
+    {
+        if (!mStoppingEventOccurred[i])
+        {
+            std::vector<double>& r_y = rSystems[i]->rGetStateVariables();
+            for (unsigned j=0; j<num_equations; j++)
+            {
+                r_y[j] = mY[j*batch_size + i];
+            }
+        }
+    }
+}
+
+bool RungeKutta4BatchOdeSolver::StoppingEventOccurred(unsigned index) const
+{
+    assert(index < mStoppingEventOccurred.size());
+    return mStoppingEventOccurred[index];
+}
+
+double RungeKutta4BatchOdeSolver::GetStoppingTime(unsigned index) const
+{
+    assert(index < mStoppingTimes.size());
+    return mStoppingTimes[index];
+}
@@ -0,0 +1,122 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _RUNGEKUTTA4BATCHODESOLVER_HPP_
+#define _RUNGEKUTTA4BATCHODESOLVER_HPP_
+
+#include <vector>
+
+#include "AbstractOdeSystem.hpp"
+
+/**
+ * Solves a batch of ODE systems of the same type (for example, one per cell
+ * in a cell-based simulation) together, using the same Runge Kutta 4th order
+ * method and time stepping as RungeKutta4IvpOdeSolver.
+ *
+ * Rather than solving each system in turn, the state variables and parameters
+ * of all the systems are gathered into structure-of-arrays buffers, in which
+ * entry j*N+i holds variable j of system i for a batch of size N. The right-hand
+ * side is then evaluated for the whole batch at once through
+ * AbstractOdeSystem::EvaluateYDerivativesBatch(), which ODE systems can override
+ * with a loop the compiler can vectorise. The results are identical to those
+ * obtained by solving each system with RungeKutta4IvpOdeSolver.
+ */
+class RungeKutta4BatchOdeSolver
+{
+private:
+
+    /** Working memory: the state variables of the batch. */
+    std::vector<double> mY;
+
+    /** Working memory: the parameters of the batch. */
+    std::vector<double> mParameters;
+
+    /** Working memory: expression k1 in the RK4 method. */
+    std::vector<double> mK1;
+
+    /** Working memory: expression k2 in the RK4 method. */
+    std::vector<double> mK2;
+
+    /** Working memory: expression k3 in the RK4 method. */
+    std::vector<double> mK3;
+
+    /** Working memory: expression yki in the RK4 method. */
+    std::vector<double> mYki;
+
+    /** Working memory: the derivatives of the batch. */
+    std::vector<double> mDy;
+
+    /** Working memory: the state variables of a single system, used to check for stopping events. */
+    std::vector<double> mSingleY;
+
+    /** Whether each system in the last batch solved stopped due to its stopping event. */
+    std::vector<unsigned char> mStoppingEventOccurred;
+
+    /** The time at which each system in the last batch solved stopped, if it did. */
+    std::vector<double> mStoppingTimes;
+
+public:
+
+    /**
+     * Solve a batch of ODE systems from startTime to endTime, updating the state
+     * variables of each. As with AbstractIvpOdeSolver::SolveAndUpdateStateVariable(),
+     * a system whose stopping event occurs is left at the time it stopped.
+     *
+     * @param rSystems  the ODE systems to solve, which must all be of the same concrete type
+     * @param startTime  the time at which the current state variables are specified
+     * @param endTime  the time to which the systems should be solved
+     * @param timeStep  the time step to use
+     */
+    void SolveAndUpdateStateVariables(const std::vector<AbstractOdeSystem*>& rSystems,
+                                      double startTime,
+                                      double endTime,
+                                      double timeStep);
+
+    /**
+     * @return whether the given system in the last batch solved stopped due to its stopping event
+     *
+     * @param index  the index of the system within the batch
+     */
+    bool StoppingEventOccurred(unsigned index) const;
+
+    /**
+     * @return the time at which the given system in the last batch solved stopped
+     *
+     * @param index  the index of the system within the batch
+     */
+    double GetStoppingTime(unsigned index) const;
+};
+
+#endif //_RUNGEKUTTA4BATCHODESOLVER_HPP_
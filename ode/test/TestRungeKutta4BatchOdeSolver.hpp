@@ -0,0 +1,151 @@
+/*
+
+Copyright (c) 2005-2019, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTRUNGEKUTTA4BATCHODESOLVER_HPP_
+#define _TESTRUNGEKUTTA4BATCHODESOLVER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "RungeKutta4BatchOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "OdeSecondOrder.hpp"
+#include "OdeSecondOrderWithEvents.hpp"
+#include "ParameterisedOde.hpp"
+#include "FakePetscSetup.hpp"
+
+class TestRungeKutta4BatchOdeSolver : public CxxTest::TestSuite
+{
+public:
+
+    void TestBatchMatchesIndividualSolves()
+    {
+        // A batch of systems with different initial conditions
+        const unsigned batch_size = 5;
+        std::vector<OdeSecondOrder> batch_odes(batch_size);
+        std::vector<OdeSecondOrder> single_odes(batch_size);
+        std::vector<AbstractOdeSystem*> systems;
+        for (unsigned i=0; i<batch_size; i++)
+        {
+            std::vector<double> initial_conditions(2);
+            initial_conditions[0] = 1.0 + i;
+            initial_conditions[1] = -0.5*i;
+            batch_odes[i].SetStateVariables(initial_conditions);
+            single_odes[i].SetStateVariables(initial_conditions);
+            systems.push_back(&batch_odes[i]);
+        }
+
+        // Use a time step which does not divide the interval, so the last step is shortened
+        RungeKutta4BatchOdeSolver batch_solver;
+        batch_solver.SolveAndUpdateStateVariables(systems, 0.0, 1.05, 0.1);
+
+        RungeKutta4IvpOdeSolver rk4_solver;
+        for (unsigned i=0; i<batch_size; i++)
+        {
+            rk4_solver.SolveAndUpdateStateVariable(&single_odes[i], 0.0, 1.05, 0.1);
+            TS_ASSERT_EQUALS(batch_solver.StoppingEventOccurred(i), false);
+            for (unsigned j=0; j<2; j++)
+            {
+                TS_ASSERT_DELTA(batch_odes[i].rGetStateVariables()[j], single_odes[i].rGetStateVariables()[j], 1e-15);
+            }
+        }
+
+        // Solving an empty batch does nothing
+        std::vector<AbstractOdeSystem*> no_systems;
+        TS_ASSERT_THROWS_NOTHING(batch_solver.SolveAndUpdateStateVariables(no_systems, 0.0, 1.0, 0.1));
+    }
+
+    void TestBatchWithParameters()
+    {
+        std::vector<ParameterisedOde> odes(3);
+        std::vector<AbstractOdeSystem*> systems;
+        for (unsigned i=0; i<odes.size(); i++)
+        {
+            odes[i].SetParameter("a", 2.0*i);
+            systems.push_back(&odes[i]);
+        }
+
+        RungeKutta4BatchOdeSolver batch_solver;
+        batch_solver.SolveAndUpdateStateVariables(systems, 0.0, 1.0, 0.01);
+
+        // Exact solution is y = a*t
+        for (unsigned i=0; i<odes.size(); i++)
+        {
+            TS_ASSERT_DELTA(odes[i].rGetStateVariables()[0], 2.0*i, 1e-12);
+        }
+    }
+
+    void TestBatchWithStoppingEvents()
+    {
+        // Solutions are y0 = A*cos(t+phi), stopping when y0 < 0; each system has a different phase
+        const unsigned batch_size = 3;
+        std::vector<OdeSecondOrderWithEvents> batch_odes(batch_size);
+        std::vector<OdeSecondOrderWithEvents> single_odes(batch_size);
+        std::vector<AbstractOdeSystem*> systems;
+        for (unsigned i=0; i<batch_size; i++)
+        {
+            std::vector<double> initial_conditions(2);
+            initial_conditions[0] = cos(0.3*i);
+            initial_conditions[1] = -sin(0.3*i);
+            batch_odes[i].SetStateVariables(initial_conditions);
+            single_odes[i].SetStateVariables(initial_conditions);
+            systems.push_back(&batch_odes[i]);
+        }
+
+        RungeKutta4BatchOdeSolver batch_solver;
+        batch_solver.SolveAndUpdateStateVariables(systems, 0.0, 2.0, 0.001);
+
+        RungeKutta4IvpOdeSolver rk4_solver;
+        for (unsigned i=0; i<batch_size; i++)
+        {
+            rk4_solver.SolveAndUpdateStateVariable(&single_odes[i], 0.0, 2.0, 0.001);
+
+            TS_ASSERT_EQUALS(batch_solver.StoppingEventOccurred(i), true);
+            TS_ASSERT_DELTA(batch_solver.GetStoppingTime(i), rk4_solver.GetStoppingTime(), 1e-12);
+            TS_ASSERT_DELTA(batch_solver.GetStoppingTime(i), M_PI_2 - 0.3*i, 0.001);
+            for (unsigned j=0; j<2; j++)
+            {
+                TS_ASSERT_DELTA(batch_odes[i].rGetStateVariables()[j], single_odes[i].rGetStateVariables()[j], 1e-15);
+            }
+        }
+
+        // A stopping event that is already true is an error, as for the other solvers
+        TS_ASSERT_THROWS_THIS(batch_solver.SolveAndUpdateStateVariables(systems, 2.0, 3.0, 0.001),
+                              "(Solve without sampling) Stopping event is true for initial condition");
+    }
+};
+
+#endif //_TESTRUNGEKUTTA4BATCHODESOLVER_HPP_
@@ -40,7 +40,9 @@ FineCoarseMeshPair<DIM>::FineCoarseMeshPair(AbstractTetrahedralMesh<DIM,DIM>& rF
     : mrFineMesh(rFineMesh),
       mrCoarseMesh(rCoarseMesh),
       mpFineMeshBoxCollection(nullptr),
-      mpCoarseMeshBoxCollection(nullptr)
+      mpCoarseMeshBoxCollection(nullptr),
+      mpFineMeshElementLocator(nullptr),
+      mpCoarseMeshElementLocator(nullptr)
 {
     ResetStatisticsVariables();
 }
@@ -72,6 +74,11 @@ void FineCoarseMeshPair<DIM>::DeleteFineBoxCollection()
         delete mpFineMeshBoxCollection;
         mpFineMeshBoxCollection = nullptr;
     }
+    if (mpFineMeshElementLocator != nullptr)
+    {
+        delete mpFineMeshElementLocator;
+        mpFineMeshElementLocator = nullptr;
+    }
 }
 
 template<unsigned DIM>
@@ -82,6 +89,11 @@ void FineCoarseMeshPair<DIM>::DeleteCoarseBoxCollection()
         delete mpCoarseMeshBoxCollection;
         mpCoarseMeshBoxCollection = nullptr;
     }
+    if (mpCoarseMeshElementLocator != nullptr)
+    {
+        delete mpCoarseMeshElementLocator;
+        mpCoarseMeshElementLocator = nullptr;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -91,12 +103,14 @@ void FineCoarseMeshPair<DIM>::DeleteCoarseBoxCollection()
 template<unsigned DIM>
 void FineCoarseMeshPair<DIM>::SetUpBoxesOnFineMesh(double boxWidth)
 {
+    DeleteFineBoxCollection();
     SetUpBoxes(mrFineMesh, boxWidth, mpFineMeshBoxCollection);
 }
 
 template<unsigned DIM>
 void FineCoarseMeshPair<DIM>::SetUpBoxesOnCoarseMesh(double boxWidth)
 {
+    DeleteCoarseBoxCollection();
     SetUpBoxes(mrCoarseMesh, boxWidth, mpCoarseMeshBoxCollection);
 }
 
@@ -350,10 +364,14 @@ void FineCoarseMeshPair<DIM>::ComputeFineElementAndWeightForGivenPoint(ChastePoi
         {
             if (safeMode)
             {
-                // Try the remaining elements
+                // Try the remaining elements, using the point location index rather than testing each in turn
+                if (mpFineMeshElementLocator == nullptr)
+                {
+                    mpFineMeshElementLocator = new ElementLocator<DIM>(mrFineMesh);
+                }
                 try
                 {
-                    elem_index = mrFineMesh.GetContainingElementIndex(rPoint, false);
+                    elem_index = mpFineMeshElementLocator->GetContainingElementIndex(rPoint, false);
                     weight = mrFineMesh.GetElement(elem_index)->CalculateInterpolationWeights(rPoint);
                     mStatisticsCounters[0]++;
 
@@ -361,7 +379,14 @@ void FineCoarseMeshPair<DIM>::ComputeFineElementAndWeightForGivenPoint(ChastePoi
                 catch (Exception&) // not_in_mesh
                 {
                     // The point is not in ANY element, so store the nearest element and corresponding weights
-                    elem_index = mrFineMesh.GetNearestElementIndexFromTestElements(rPoint,test_element_indices);
+                    if (test_element_indices.empty())
+                    {
+                        elem_index = mpFineMeshElementLocator->GetNearestElementIndex(rPoint);
+                    }
+                    else
+                    {
+                        elem_index = mrFineMesh.GetNearestElementIndexFromTestElements(rPoint,test_element_indices);
+                    }
                     weight = mrFineMesh.GetElement(elem_index)->CalculateInterpolationWeights(rPoint);
 
                     mNotInMesh.push_back(index);
@@ -521,17 +546,28 @@ unsigned FineCoarseMeshPair<DIM>::ComputeCoarseElementForGivenPoint(ChastePoint<
         {
             if (safeMode)
             {
-                // Try the remaining elements
+                // Try the remaining elements, using the point location index rather than testing each in turn
+                if (mpCoarseMeshElementLocator == nullptr)
+                {
+                    mpCoarseMeshElementLocator = new ElementLocator<DIM>(mrCoarseMesh);
+                }
                 try
                 {
-                    elem_index = mrCoarseMesh.GetContainingElementIndex(rPoint, false);
+                    elem_index = mpCoarseMeshElementLocator->GetContainingElementIndex(rPoint, false);
 
                     mStatisticsCounters[0]++;
                 }
                 catch (Exception&) // not_in_mesh
                 {
                     // The point is not in ANY element, so store the nearest element and corresponding weights
-                    elem_index = mrCoarseMesh.GetNearestElementIndexFromTestElements(rPoint,test_element_indices);
+                    if (test_element_indices.empty())
+                    {
+                        elem_index = mpCoarseMeshElementLocator->GetNearestElementIndex(rPoint);
+                    }
+                    else
+                    {
+                        elem_index = mrCoarseMesh.GetNearestElementIndexFromTestElements(rPoint,test_element_indices);
+                    }
                     mStatisticsCounters[1]++;
                 }
             }
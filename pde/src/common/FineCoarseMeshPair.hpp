@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractTetrahedralMesh.hpp"
 #include "DistributedBoxCollection.hpp"
+#include "ElementLocator.hpp"
 #include "QuadraturePointsGroup.hpp"
 #include "GaussianQuadratureRule.hpp"
 #include "Warnings.hpp"
@@ -126,6 +127,19 @@ private:
      */
     DistributedBoxCollection<DIM>* mpCoarseMeshBoxCollection;
 
+    /**
+     * Point location index over the fine mesh elements, used in safe mode in place of
+     * testing every element when a point is not in the elements of its local boxes.
+     * Built when first needed and destroyed with the fine box collection.
+     */
+    ElementLocator<DIM>* mpFineMeshElementLocator;
+
+    /**
+     * Point location index over the coarse mesh elements, as for mpFineMeshElementLocator.
+     * Built when first needed and destroyed with the coarse box collection.
+     */
+    ElementLocator<DIM>* mpCoarseMeshElementLocator;
+
     /**
      * The containing elements and corresponding weights in the fine
      * mesh for the set of points given. The points may have been
@@ -394,14 +408,14 @@ public:
     }
 
     /**
-     * Destroy the box collection for the fine mesh - can be used to free memory once
-     * ComputeFineElementsAndWeightsForCoarseQuadPoints (etc) has been called.
+     * Destroy the box collection (and any point location index) for the fine mesh - can be used
+     * to free memory once ComputeFineElementsAndWeightsForCoarseQuadPoints (etc) has been called.
      */
     void DeleteFineBoxCollection();
 
     /**
-     * Destroy the box collection for the coarse mesh - can be used to free memory once
-     * ComputeCoarseElementsForFineNodes (etc) has been called.
+     * Destroy the box collection (and any point location index) for the coarse mesh - can be used
+     * to free memory once ComputeCoarseElementsForFineNodes (etc) has been called.
      */
     void DeleteCoarseBoxCollection();
 
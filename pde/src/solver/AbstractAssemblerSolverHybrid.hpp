@@ -92,6 +92,20 @@ public:
     {
     }
 
+    /**
+     * Reset the boundary conditions container, for example so that a solver (and its
+     * linear system) can be reused for a sequence of problems on the same mesh whose
+     * boundary conditions differ.
+     *
+     * @param pBoundaryConditions  the new boundary conditions container
+     */
+    void ResetBoundaryConditionsContainer(BoundaryConditionsContainer<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>* pBoundaryConditions)
+    {
+        assert(pBoundaryConditions);
+        mpBoundaryConditions = pBoundaryConditions;
+        mNaturalNeumannSurfaceTermAssembler.ResetBoundaryConditionsContainer(pBoundaryConditions);
+    }
+
     /**
      * Implementation of AbstractLinearPdeSolver::SetupLinearSystem, using the assembler that this class
      * also inherits from. Concrete classes inheriting from both this class and